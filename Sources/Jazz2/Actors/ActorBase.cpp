@@ -421,6 +421,25 @@ namespace Jazz2::Actors
 		}
 	}
 
+	bool ActorBase::IsGroundEmpty(const AABBf& aabb, TileCollisionParams& params)
+	{
+		// Actors are standing on solid ground most of the time, so ask the tile map how far down it is first and skip
+		// the full probe (and the solid object query) when it's within the area anyway. Tall areas of actors with
+		// reduced tileset collisions are tested only at the bottom, the same way IsPositionEmpty() tests them.
+		Tiles::TileMap* tiles = (GetState(ActorState::CollideWithTileset) ? _levelHandler->TileMap() : nullptr);
+		if (tiles != nullptr) {
+			float top = aabb.T;
+			if (GetState(ActorState::CollideWithTilesetReduced) && aabb.B - aabb.T >= 20.0f) {
+				top = aabb.B - std::max(14.0f, (aabb.B - aabb.T) - 10.0f);
+			}
+			float height = aabb.B - top;
+			if (tiles->GetGroundDistance(aabb.L, aabb.R, top, height, params.Downwards) < height) {
+				return false;
+			}
+		}
+		return _levelHandler->IsPositionEmpty(this, aabb, params);
+	}
+
 	void ActorBase::UpdateHitbox(std::int32_t w, std::int32_t h)
 	{
 		if (_currentAnimation == nullptr) {
@@ -1357,15 +1376,15 @@ namespace Jazz2::Actors
 		ContentResolver::Get().PreloadMetadataAsync(path);
 	}
 
-	void ActorBase::RequestMetadata(StringView path, bool forceIndexed)
+	void ActorBase::RequestMetadata(const ResourceId& id, bool forceIndexed)
 	{
-		_metadata = ContentResolver::Get().RequestMetadata(path, forceIndexed);
+		_metadata = ContentResolver::Get().RequestMetadata(id, forceIndexed);
 	}
 
 #if !defined(WITH_COROUTINES)
-	void ActorBase::RequestMetadataAsync(StringView path, bool forceIndexed)
+	void ActorBase::RequestMetadataAsync(const ResourceId& id, bool forceIndexed)
 	{
-		_metadata = ContentResolver::Get().RequestMetadata(path, forceIndexed);
+		_metadata = ContentResolver::Get().RequestMetadata(id, forceIndexed);
 	}
 #endif
 
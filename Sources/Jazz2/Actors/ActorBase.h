@@ -1,7 +1,9 @@
 #pragma once
 
+#include "ActorPool.h"
 #include "../EventType.h"
 #include "../LightEmitter.h"
+#include "../ResourceId.h"
 #include "../Resources.h"
 #include "../Tiles/TileCollisionParams.h"
 
@@ -98,7 +100,8 @@ namespace Jazz2::Actors
 		/** @brief Actor is facing left */
 		IsFacingLeft = 0x1000,
 
-		//Reserved = 0x2000,
+		/** @brief Actor can emit lights, @ref ActorBase::OnEmitLights() is called only if this flag is set */
+		EmitsLights = 0x2000,
 
 		/** @brief Actor should be preserved when state is rolled back to checkpoint */
 		PreserveOnRollback = 0x4000,
@@ -562,7 +565,7 @@ namespace Jazz2::Actors
 		virtual void OnUpdateHitbox();
 		/** @brief Called when the object needs to be drawn */
 		virtual bool OnDraw(RenderQueue& renderQueue);
-		/** @brief Called when emitting lights */
+		/** @brief Called when emitting lights, overriding actors have to set @ref ActorState::EmitsLights */
 		virtual void OnEmitLights(SmallVectorImpl<LightEmitter>& lights) { }
 		/** @brief Called when the object hits a floor */
 		virtual void OnHitFloor(float timeMult);
@@ -580,6 +583,8 @@ namespace Jazz2::Actors
 
 		/** @brief Performs standard movement behavior */
 		void TryStandardMovement(float timeMult, Tiles::TileCollisionParams& params);
+		/** @brief Returns `true` if there is no ground in a given area, the tile map is asked for the ground distance before the full probe */
+		bool IsGroundEmpty(const AABBf& aabb, Tiles::TileCollisionParams& params);
 		/** @brief Updates hitbox to a given size */
 		void UpdateHitbox(std::int32_t w, std::int32_t h);
 		/** @brief Updates frozen state of the object */
@@ -621,18 +626,18 @@ namespace Jazz2::Actors
 		/**
 		 * @brief Loads specified metadata and its linked assets
 		 *
-		 * @param path          Relative path to the metadata asset
+		 * @param id            Relative path to the metadata asset
 		 * @param forceIndexed  Load linked graphics as indexed (for shader-based recoloring, e.g., the player)
 		 */
-		void RequestMetadata(StringView path, bool forceIndexed = false);
+		void RequestMetadata(const ResourceId& id, bool forceIndexed = false);
 
 		/** @brief Loads specified metadata and its linked assets asynchronously if supported */
 #if defined(WITH_COROUTINES)
-		auto RequestMetadataAsync(StringView path, bool forceIndexed = false)
+		auto RequestMetadataAsync(const ResourceId& id, bool forceIndexed = false)
 		{
 			struct awaitable {
 				ActorBase* actor;
-				const StringView& path;
+				ResourceId id;
 				bool forceIndexed;
 
 				bool await_ready() {
@@ -640,16 +645,16 @@ namespace Jazz2::Actors
 				}
 				void await_suspend(std::coroutine_handle<> handle) {
 					// TODO: implement async
-					auto metadata = ContentResolver::Get().RequestMetadata(path, forceIndexed);
+					auto metadata = ContentResolver::Get().RequestMetadata(id, forceIndexed);
 					actor->_metadata = metadata;
 					handle();
 				}
 				void await_resume() { }
 			};
-			return awaitable{this, path, forceIndexed};
+			return awaitable{this, id, forceIndexed};
 		}
 #else
-		void RequestMetadataAsync(StringView path, bool forceIndexed = false);
+		void RequestMetadataAsync(const ResourceId& id, bool forceIndexed = false);
 #endif
 
 		/** @brief Sets actor state */
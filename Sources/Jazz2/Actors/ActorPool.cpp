@@ -0,0 +1,206 @@
+﻿#include "ActorPool.h"
+
+#include "../../nCine/tracy.h"
+
+#include <algorithm>
+
+#include <Asserts.h>
+#include <Containers/SmallVector.h>
+#include <Threading/Spinlock.h>
+
+using namespace Death::Containers;
+using namespace Death::Threading;
+
+namespace Jazz2::Actors
+{
+	namespace
+	{
+		struct FreeBlock {
+			FreeBlock* Next;
+		};
+
+		struct Slab {
+			Slab* Next;
+			std::size_t BlockCount;
+		};
+
+		struct SizeClass {
+			FreeBlock* FreeList;
+			Slab* Slabs;
+		};
+
+		static constexpr std::size_t SizeClassCount = ActorPool::MaxBlockSize / ActorPool::Granularity;
+		// Slab header is padded, so the first block is aligned to the allocation granularity
+		static constexpr std::size_t SlabHeaderSize = (sizeof(Slab) + ActorPool::Granularity - 1) & ~(ActorPool::Granularity - 1);
+
+		Spinlock _lock;
+		SizeClass _classes[SizeClassCount];
+		ActorPool::Statistics _stats;
+
+		constexpr std::size_t GetSizeClass(std::size_t size)
+		{
+			return (size - 1) / ActorPool::Granularity;
+		}
+
+		void AllocateSlab(SizeClass& sizeClass, std::size_t blockSize)
+		{
+			std::uint8_t* memory = static_cast<std::uint8_t*>(::operator new(ActorPool::SlabSize));
+			Slab* slab = reinterpret_cast<Slab*>(memory);
+			slab->BlockCount = (ActorPool::SlabSize - SlabHeaderSize) / blockSize;
+			slab->Next = sizeClass.Slabs;
+			sizeClass.Slabs = slab;
+			_stats.SlabCount++;
+
+			// Thread all blocks of the new slab to the free list in address order
+			std::uint8_t* first = memory + SlabHeaderSize;
+			FreeBlock* next = sizeClass.FreeList;
+			for (std::size_t i = slab->BlockCount; i > 0; i--) {
+				FreeBlock* block = reinterpret_cast<FreeBlock*>(first + (i - 1) * blockSize);
+				block->Next = next;
+				next = block;
+			}
+			sizeClass.FreeList = next;
+		}
+	}
+
+	void* ActorPool::Allocate(std::size_t size)
+	{
+		if (size == 0 || size > MaxBlockSize) {
+			_lock.lock();
+			_stats.FallbackAllocations++;
+			_lock.unlock();
+			return ::operator new(size);
+		}
+
+		std::size_t index = GetSizeClass(size);
+		SizeClass& sizeClass = _classes[index];
+
+		_lock.lock();
+		if DEATH_UNLIKELY(sizeClass.FreeList == nullptr) {
+			AllocateSlab(sizeClass, (index + 1) * Granularity);
+		}
+		FreeBlock* block = sizeClass.FreeList;
+		sizeClass.FreeList = block->Next;
+		_stats.BlocksInUse++;
+		_stats.PooledAllocations++;
+		_lock.unlock();
+
+		return block;
+	}
+
+	void ActorPool::Deallocate(void* ptr, std::size_t size) noexcept
+	{
+		if (ptr == nullptr) {
+			return;
+		}
+		if (size == 0 || size > MaxBlockSize) {
+			::operator delete(ptr);
+			return;
+		}
+
+		SizeClass& sizeClass = _classes[GetSizeClass(size)];
+		FreeBlock* block = static_cast<FreeBlock*>(ptr);
+
+		_lock.lock();
+		block->Next = sizeClass.FreeList;
+		sizeClass.FreeList = block;
+		_stats.BlocksInUse--;
+		_lock.unlock();
+	}
+
+	void ActorPool::Trim()
+	{
+		ZoneScopedC(0x4876AF);
+
+		struct SlabInfo {
+			std::uint8_t* Begin;
+			std::uint8_t* End;
+			Slab* Owner;
+			std::size_t FreeCount;
+		};
+
+		SmallVector<SlabInfo, 0> slabs;
+		std::size_t releasedCount = 0;
+
+		_lock.lock();
+		for (std::size_t i = 0; i < SizeClassCount; i++) {
+			SizeClass& sizeClass = _classes[i];
+			if (sizeClass.Slabs == nullptr) {
+				continue;
+			}
+
+			std::size_t blockSize = (i + 1) * Granularity;
+
+			slabs.clear();
+			for (Slab* slab = sizeClass.Slabs; slab != nullptr; slab = slab->Next) {
+				std::uint8_t* begin = reinterpret_cast<std::uint8_t*>(slab) + SlabHeaderSize;
+				slabs.push_back({ begin, begin + slab->BlockCount * blockSize, slab, 0 });
+			}
+			std::sort(slabs.begin(), slabs.end(), [](const SlabInfo& a, const SlabInfo& b) {
+				return a.Begin < b.Begin;
+			});
+
+			auto findSlab = [&slabs](const void* ptr) -> SlabInfo* {
+				auto it = std::upper_bound(slabs.begin(), slabs.end(), static_cast<const std::uint8_t*>(ptr), [](const std::uint8_t* p, const SlabInfo& info) {
+					return p < info.Begin;
+				});
+				DEATH_DEBUG_ASSERT(it != slabs.begin());
+				return &*(it - 1);
+			};
+
+			// Count free blocks of each slab, the slab can be released only if all its blocks are free
+			for (FreeBlock* block = sizeClass.FreeList; block != nullptr; block = block->Next) {
+				findSlab(block)->FreeCount++;
+			}
+
+			bool anyEmpty = false;
+			for (auto& info : slabs) {
+				if (info.FreeCount == info.Owner->BlockCount) {
+					anyEmpty = true;
+					break;
+				}
+			}
+			if (!anyEmpty) {
+				continue;
+			}
+
+			// Drop blocks of empty slabs from the free list, keeping the order of the rest
+			FreeBlock** link = &sizeClass.FreeList;
+			while (*link != nullptr) {
+				SlabInfo* info = findSlab(*link);
+				if (info->FreeCount == info->Owner->BlockCount) {
+					*link = (*link)->Next;
+				} else {
+					link = &(*link)->Next;
+				}
+			}
+
+			Slab** slabLink = &sizeClass.Slabs;
+			while (*slabLink != nullptr) {
+				Slab* slab = *slabLink;
+				SlabInfo* info = findSlab(reinterpret_cast<std::uint8_t*>(slab) + SlabHeaderSize);
+				if (info->FreeCount == slab->BlockCount) {
+					*slabLink = slab->Next;
+					::operator delete(slab);
+					releasedCount++;
+				} else {
+					slabLink = &slab->Next;
+				}
+			}
+		}
+		_stats.SlabCount -= releasedCount;
+		std::size_t blocksInUse = _stats.BlocksInUse;
+		std::size_t slabCount = _stats.SlabCount;
+		_lock.unlock();
+
+		LOGD("Released {} actor slabs ({} KB), {} slabs still reserved by {} live blocks", releasedCount, releasedCount * SlabSize / 1024, slabCount, blocksInUse);
+	}
+
+	ActorPool::Statistics ActorPool::GetStatistics()
+	{
+		_lock.lock();
+		Statistics stats = _stats;
+		_lock.unlock();
+		return stats;
+	}
+}
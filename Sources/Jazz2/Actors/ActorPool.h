@@ -0,0 +1,121 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace Jazz2::Actors
+{
+	/**
+		@brief Slab allocator for short-lived actors
+
+		Actors are allocated together with their `std::shared_ptr` control block through @ref ActorAllocator, so
+		one spawn is one allocation from a size-segregated free list instead of a general heap allocation.
+		Each size class owns a list of fixed-size slabs; freed blocks go back to the free list of their class and
+		are reused by the next actor of a similar size. Slabs that became completely empty are released in bulk
+		by @ref Trim(), which is called when a level ends. Allocations larger than @ref MaxBlockSize go directly
+		to the general allocator.
+	*/
+	class ActorPool
+	{
+	public:
+		/** @brief Size of one slab in bytes */
+		static constexpr std::size_t SlabSize = 64 * 1024;
+		/** @brief Allocation granularity and block alignment in bytes */
+		static constexpr std::size_t Granularity = 16;
+		/** @brief Maximum block size served from slabs */
+		static constexpr std::size_t MaxBlockSize = 4096;
+
+		/** @brief Allocation statistics */
+		struct Statistics {
+			/** @brief Number of blocks currently in use */
+			std::size_t BlocksInUse;
+			/** @brief Number of slabs currently reserved */
+			std::size_t SlabCount;
+			/** @brief Total number of allocations served from slabs */
+			std::uint64_t PooledAllocations;
+			/** @brief Total number of allocations that were too large and went to the general allocator */
+			std::uint64_t FallbackAllocations;
+		};
+
+		ActorPool() = delete;
+		~ActorPool() = delete;
+
+		/** @brief Allocates a block of the specified size */
+		static void* Allocate(std::size_t size);
+		/** @brief Returns a block of the specified size back to the pool */
+		static void Deallocate(void* ptr, std::size_t size) noexcept;
+		/** @brief Releases all slabs that contain no live blocks */
+		static void Trim();
+		/** @brief Returns current allocation statistics */
+		static Statistics GetStatistics();
+
+		/**
+			@brief Trims the pool when destroyed
+
+			Intended to be the first member of a level handler, so it's destroyed after all actors of the level.
+		*/
+		class LevelScope
+		{
+		public:
+			LevelScope() = default;
+			~LevelScope() {
+				Trim();
+			}
+
+			LevelScope(const LevelScope&) = delete;
+			LevelScope& operator=(const LevelScope&) = delete;
+		};
+	};
+
+	/**
+		@brief Standard allocator that serves single-object allocations from @ref ActorPool
+
+		Meant to be used with `std::allocate_shared()`, which rebinds it to the combined control block and object
+		type. Array allocations fall back to the general allocator.
+	*/
+	template<typename T>
+	class ActorAllocator
+	{
+	public:
+		using value_type = T;
+
+		ActorAllocator() noexcept = default;
+		template<typename U>
+		ActorAllocator(const ActorAllocator<U>&) noexcept {}
+
+		T* allocate(std::size_t n) {
+			static_assert(alignof(T) <= ActorPool::Granularity, "Over-aligned types cannot be allocated from ActorPool");
+			if (n == 1) {
+				return static_cast<T*>(ActorPool::Allocate(sizeof(T)));
+			}
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		}
+
+		void deallocate(T* ptr, std::size_t n) noexcept {
+			if (n == 1) {
+				ActorPool::Deallocate(ptr, sizeof(T));
+			} else {
+				::operator delete(ptr);
+			}
+		}
+
+		template<typename U>
+		bool operator==(const ActorAllocator<U>&) const noexcept {
+			return true;
+		}
+		template<typename U>
+		bool operator!=(const ActorAllocator<U>&) const noexcept {
+			return false;
+		}
+	};
+
+	/** @brief Creates a new actor instance allocated from @ref ActorPool */
+	template<typename T, typename... Args>
+	inline std::shared_ptr<T> CreateActor(Args&&... args)
+	{
+		return std::allocate_shared<T>(ActorAllocator<T>(), std::forward<Args>(args)...);
+	}
+}
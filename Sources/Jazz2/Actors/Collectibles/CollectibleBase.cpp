@@ -21,6 +21,7 @@ namespace Jazz2::Actors::Collectibles
 	{
 		_elasticity = 0.6f;
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::SkipPerPixelCollisions, true);
 
 		Vector2f pos = _pos;
@@ -100,7 +100,7 @@ namespace Jazz2::Actors::Bosses
 						SetTransition((AnimState)1073741826, false, [this]() {
 							PlaySfx("ThrowFireball"_s);
 
-							std::shared_ptr<Fireball> fireball = std::make_shared<Fireball>();
+							std::shared_ptr<Fireball> fireball = CreateActor<Fireball>();
 							uint8_t fireballParams[2] = { _theme, (uint8_t)(IsFacingLeft() ? 1 : 0) };
 							fireball->OnActivated(ActorActivationDetails(
 								_levelHandler,
@@ -221,6 +221,7 @@ namespace Jazz2::Actors::Bosses
 		SetFacingLeft(details.Params[1] != 0);
 		_timeLeft = 90.0f;
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::IsInvulnerable, true);
 		SetState(ActorState::CanBeFrozen | ActorState::ApplyGravitation, false);
 		CanCollideWithShots = false;
@@ -48,7 +48,7 @@ namespace Jazz2::Actors::Bosses
 		async_await RequestMetadataAsync("Boss/Bolly"_s);
 		SetAnimation(AnimState::Idle);
 
-		_bottom = std::make_shared<BollyPart>();
+		_bottom = CreateActor<BollyPart>();
 		std::uint8_t bottomParams[1] = { 1 };
 		_bottom->OnActivated(ActorActivationDetails(
 			_levelHandler,
@@ -57,7 +57,7 @@ namespace Jazz2::Actors::Bosses
 		));
 		_levelHandler->AddActor(_bottom);
 
-		/*_turret = std::make_shared<BollyPart>();
+		/*_turret = CreateActor<BollyPart>();
 		uint8_t turretParams[1] = { 2 };
 		_turret->OnActivated({
 			.LevelHandler = _levelHandler,
@@ -68,7 +68,7 @@ namespace Jazz2::Actors::Bosses
 
 		std::int32_t chainLength = (_levelHandler->GetDifficulty() < GameDifficulty::Hard ? NormalChainLength : HardChainLength);
 		for (std::int32_t i = 0; i < chainLength; i++) {
-			_chain[i] = std::make_shared<BollyPart>();
+			_chain[i] = CreateActor<BollyPart>();
 			std::uint8_t chainParams[1] = { (std::uint8_t)((i % 3) == 2 ? 3 : 4) };
 			_chain[i]->OnActivated(ActorActivationDetails(
 				_levelHandler,
@@ -273,7 +273,7 @@ namespace Jazz2::Actors::Bosses
 		if (found) {
 			Vector2f diff = (targetPos - _pos).Normalized();
 
-			std::shared_ptr<Rocket> rocket = std::make_shared<Rocket>();
+			std::shared_ptr<Rocket> rocket = CreateActor<Rocket>();
 			rocket->OnActivated(ActorActivationDetails(
 				_levelHandler,
 				Vector3i((std::int32_t)_pos.X + (IsFacingLeft() ? 10 : -10), (std::int32_t)_pos.Y + 10, _renderer.layer() - 4)
@@ -326,6 +326,7 @@ namespace Jazz2::Actors::Bosses
 
 	Task<bool> Bolly::Rocket::OnActivatedAsync(const ActorActivationDetails& details)
 	{
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::IsInvulnerable, true);
 		SetState(ActorState::CanBeFrozen | ActorState::ApplyGravitation, false);
 		CanCollideWithShots = false;
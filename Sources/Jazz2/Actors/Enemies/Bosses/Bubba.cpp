@@ -85,7 +85,7 @@ namespace Jazz2::Actors::Bosses
 								float x = (IsFacingLeft() ? -16.0f : 16.0f);
 								float y = -5.0f;
 
-								std::shared_ptr<Fireball> fireball = std::make_shared<Fireball>();
+								std::shared_ptr<Fireball> fireball = CreateActor<Fireball>();
 								uint8_t fireballParams[1] = { (uint8_t)(IsFacingLeft() ? 1 : 0) };
 								fireball->OnActivated(ActorActivationDetails(
 									_levelHandler,
@@ -288,6 +288,7 @@ namespace Jazz2::Actors::Bosses
 		_speed.X = (IsFacingLeft() ? -4.8f : 4.8f);
 		_timeLeft = 50.0f;
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::IsInvulnerable, true);
 		SetState(ActorState::CanBeFrozen | ActorState::ApplyGravitation, false);
 		CanCollideWithShots = false;
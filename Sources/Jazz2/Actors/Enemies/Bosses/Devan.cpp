@@ -152,7 +152,7 @@ namespace Jazz2::Actors::Bosses
 					SetState(ActorState::IsInvulnerable, true);
 					SetState(ActorState::CanBeFrozen, false);
 
-					std::shared_ptr<DisarmedGun> gun = std::make_shared<DisarmedGun>();
+					std::shared_ptr<DisarmedGun> gun = CreateActor<DisarmedGun>();
 					std::uint8_t gunParams[1] = { (std::uint8_t)(IsFacingLeft() ? 1 : 0) };
 					gun->OnActivated(ActorActivationDetails(
 						_levelHandler,
@@ -236,7 +236,7 @@ namespace Jazz2::Actors::Bosses
 				SetTransition(DemonSpewFireball, false, [this]() {
 					PlaySfx("SpitFireball"_s);
 
-					std::shared_ptr<Fireball> fireball = std::make_shared<Fireball>();
+					std::shared_ptr<Fireball> fireball = CreateActor<Fireball>();
 					std::uint8_t fireballParams[1] = { (std::uint8_t)(IsFacingLeft() ? 1 : 0) };
 					fireball->OnActivated(ActorActivationDetails(
 						_levelHandler,
@@ -399,7 +399,7 @@ namespace Jazz2::Actors::Bosses
 		PlaySfx("Shoot"_s);
 
 		SetTransition(ShootInProgress, false, [this]() {
-			std::shared_ptr<Bullet> bullet = std::make_shared<Bullet>();
+			std::shared_ptr<Bullet> bullet = CreateActor<Bullet>();
 			std::uint8_t fireballParams[1] = { (std::uint8_t)(IsFacingLeft() ? 1 : 0) };
 			bullet->OnActivated(ActorActivationDetails(
 				_levelHandler,
@@ -516,6 +516,7 @@ namespace Jazz2::Actors::Bosses
 		SetFacingLeft(details.Params[0] != 0);
 		_speed.X = (IsFacingLeft() ? -8.0f : 8.0f);
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::IsInvulnerable, true);
 		SetState(ActorState::CanBeFrozen | ActorState::ApplyGravitation, false);
 		CanCollideWithShots = false;
@@ -579,6 +580,7 @@ namespace Jazz2::Actors::Bosses
 		_speed.Y = 3.5f;
 		_timeLeft = 50.0f;
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::IsInvulnerable, true);
 		SetState(ActorState::CanBeFrozen | ActorState::ApplyGravitation, false);
 
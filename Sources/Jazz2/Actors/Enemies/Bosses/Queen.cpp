@@ -54,7 +54,7 @@ namespace Jazz2::Actors::Bosses
 		SetAnimation(AnimState::Idle);
 
 		// Invisible block above the queen
-		_block = std::make_shared<InvisibleBlock>();
+		_block = CreateActor<InvisibleBlock>();
 		_block->OnActivated(ActorActivationDetails(
 			_levelHandler,
 			Vector3i((std::int32_t)_pos.X, (std::int32_t)_pos.Y, _renderer.layer() + 1)
@@ -145,7 +145,7 @@ namespace Jazz2::Actors::Bosses
 								}
 							}
 
-							std::shared_ptr<Brick> brick = std::make_shared<Brick>();
+							std::shared_ptr<Brick> brick = CreateActor<Brick>();
 							brick->OnActivated(ActorActivationDetails(
 								_levelHandler,
 								Vector3i((std::int32_t)(player->GetPos().X + Random().NextFloat(-50.0f, 50.0f)), (std::int32_t)(_pos.Y - 200.0f), _renderer.layer() - 20)
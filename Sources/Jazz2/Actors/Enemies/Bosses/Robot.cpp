@@ -173,7 +173,7 @@ namespace Jazz2::Actors::Bosses
 			return;
 		}
 
-		std::shared_ptr<SpikeBall> spikeBall = std::make_shared<SpikeBall>();
+		std::shared_ptr<SpikeBall> spikeBall = CreateActor<SpikeBall>();
 		uint8_t spikeBallParams[1] = { (uint8_t)(IsFacingLeft() ? 1 : 0) };
 		spikeBall->OnActivated(ActorActivationDetails(
 			_levelHandler,
@@ -212,6 +212,7 @@ namespace Jazz2::Actors::Bosses
 	{
 		SetFacingLeft(details.Params[0] != 0);
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::IsInvulnerable | ActorState::SkipPerPixelCollisions, true);
 		SetState(ActorState::CanBeFrozen, false);
 		CanCollideWithShots = false;
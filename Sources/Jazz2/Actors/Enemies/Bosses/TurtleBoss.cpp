@@ -79,7 +79,7 @@ namespace Jazz2::Actors::Bosses
 					_state = StateTransition;
 					SetAnimation(AnimState::Idle);
 					SetTransition((AnimState)1073741824, false, [this]() {
-						_mace = std::make_shared<Mace>();
+						_mace = CreateActor<Mace>();
 						_mace->OnActivated(ActorActivationDetails(
 							_levelHandler,
 							Vector3i((std::int32_t)_pos.X, (std::int32_t)_pos.Y, _renderer.layer() + 2)
@@ -149,7 +149,7 @@ namespace Jazz2::Actors::Bosses
 			shellSpeedY = -0.98f;
 		}
 
-		std::shared_ptr<Enemies::TurtleShell> shell = std::make_shared<Enemies::TurtleShell>();
+		std::shared_ptr<Enemies::TurtleShell> shell = CreateActor<Enemies::TurtleShell>();
 		uint8_t shellParams[9];
 		EventParamsWriter writer(shellParams);
 		writer.SetFloat(0, _speed.X * 1.1f);
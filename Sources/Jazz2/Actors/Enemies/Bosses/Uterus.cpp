@@ -64,7 +64,7 @@ namespace Jazz2::Actors::Bosses
 		_hasShield = true;
 
 		for (std::int32_t i = 0; i < std::int32_t(arraySize(_shields)); i++) {
-			_shields[i] = std::make_shared<ShieldPart>();
+			_shields[i] = CreateActor<ShieldPart>();
 			_shields[i]->Phase = (fTwoPi * i / std::int32_t(arraySize(_shields)));
 			_shields[i]->OnActivated(ActorActivationDetails(
 				_levelHandler,
@@ -99,7 +99,7 @@ namespace Jazz2::Actors::Bosses
 					float force = Random().NextFloat(-15.0f, 15.0f);
 
 					// TODO: Implement Crab spawn animation
-					std::shared_ptr<Enemies::Crab> crab = std::make_shared<Enemies::Crab>();
+					std::shared_ptr<Enemies::Crab> crab = CreateActor<Enemies::Crab>();
 					crab->OnActivated(ActorActivationDetails(
 						_levelHandler,
 						Vector3i((std::int32_t)_pos.X, (std::int32_t)_pos.Y, _renderer.layer() - 4)
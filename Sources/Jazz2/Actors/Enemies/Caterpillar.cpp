@@ -65,7 +65,7 @@ namespace Jazz2::Actors::Enemies
 
 					SetAnimation((AnimState)5);
 					SetTransition((AnimState)4, true, [this]() {
-						std::shared_ptr<Smoke> smoke = std::make_shared<Smoke>();
+						std::shared_ptr<Smoke> smoke = CreateActor<Smoke>();
 						smoke->OnActivated(ActorActivationDetails(
 							_levelHandler,
 							Vector3i((std::int32_t)_pos.X - 26, (std::int32_t)_pos.Y - 18, _renderer.layer() + 20)
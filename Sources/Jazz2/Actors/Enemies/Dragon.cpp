@@ -90,7 +90,7 @@ namespace Jazz2::Actors::Enemies
 						});
 					} else {
 						if (_attackTime <= 0.0f) {
-							std::shared_ptr<Fire> fire = std::make_shared<Fire>();
+							std::shared_ptr<Fire> fire = CreateActor<Fire>();
 							uint8_t fireParams[1];
 							fireParams[0] = (IsFacingLeft() ? 1 : 0);
 							fire->OnActivated(ActorActivationDetails(
@@ -132,6 +132,7 @@ namespace Jazz2::Actors::Enemies
 
 	Task<bool> Dragon::Fire::OnActivatedAsync(const ActorActivationDetails& details)
 	{
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::IsInvulnerable, true);
 		SetState(ActorState::CanBeFrozen | ActorState::ApplyGravitation, false);
 		// Collide with player ammo if Reforged
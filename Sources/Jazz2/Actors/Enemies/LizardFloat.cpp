@@ -62,7 +62,7 @@ namespace Jazz2::Actors::Enemies
 		SetFacingLeft(Random().NextBool());
 		SetAnimation(AnimState::Idle);
 
-		_copter = std::make_shared<Environment::Copter>();
+		_copter = CreateActor<Environment::Copter>();
 		uint8_t copterParams[1];
 		copterParams[0] = 1;
 		_copter->OnActivated(ActorActivationDetails(
@@ -120,7 +120,7 @@ namespace Jazz2::Actors::Enemies
 
 			if (distance < 280.0f && _attackTime <= 0.0f) {
 				SetTransition(AnimState::TransitionAttack, false, [this]() {
-					std::shared_ptr<Environment::Bomb> bomb = std::make_shared<Environment::Bomb>();
+					std::shared_ptr<Environment::Bomb> bomb = CreateActor<Environment::Bomb>();
 					uint8_t bombParams[2];
 					bombParams[0] = (uint8_t)(_theme + 1);
 					bombParams[1] = (IsFacingLeft() ? 1 : 0);
@@ -181,7 +181,7 @@ namespace Jazz2::Actors::Enemies
 
 			TryGenerateRandomDrop();
 		} else {
-			std::shared_ptr<Lizard> lizard = std::make_shared<Lizard>();
+			std::shared_ptr<Lizard> lizard = CreateActor<Lizard>();
 			std::uint8_t lizardParams[3];
 			lizardParams[0] = _theme;
 			lizardParams[1] = 1;
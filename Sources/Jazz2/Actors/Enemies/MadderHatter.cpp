@@ -63,7 +63,7 @@ namespace Jazz2::Actors::Enemies
 						SetTransition((AnimState)1073741824, false, [this]() {
 							PlaySfx("Spit"_s);
 
-							std::shared_ptr<BulletSpit> bulletSpit = std::make_shared<BulletSpit>();
+							std::shared_ptr<BulletSpit> bulletSpit = CreateActor<BulletSpit>();
 							uint8_t bulletSpitParams[1];
 							bulletSpitParams[0] = (IsFacingLeft() ? 1 : 0);
 							bulletSpit->OnActivated(ActorActivationDetails(
@@ -104,7 +104,7 @@ namespace Jazz2::Actors::Enemies
 							SetFacingLeft(targetPos.X < _pos.X);
 
 							SetTransition((AnimState)1073741826, false, [this, distance]() {
-								std::shared_ptr<Banana> banana = std::make_shared<Banana>();
+								std::shared_ptr<Banana> banana = CreateActor<Banana>();
 								uint8_t bananaParams[3];
 								bananaParams[0] = (IsFacingLeft() ? 1 : 0);
 								bananaParams[1] = distance & 0xff;
@@ -130,7 +130,7 @@ namespace Jazz2::Actors::Enemies
 						SetFacingLeft(targetPos.X < _pos.X);
 
 						SetTransition((AnimState)1073741826, false, [this, distance]() {
-							std::shared_ptr<Banana> banana = std::make_shared<Banana>();
+							std::shared_ptr<Banana> banana = CreateActor<Banana>();
 							uint8_t bananaParams[3];
 							bananaParams[0] = (IsFacingLeft() ? 1 : 0);
 							bananaParams[1] = distance & 0xff;
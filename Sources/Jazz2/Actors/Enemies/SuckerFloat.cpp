@@ -80,7 +80,7 @@ namespace Jazz2::Actors::Enemies
 				dir = (shotSpeed.Y > 0.0f ? Direction::Down : Direction::Up);
 			}
 
-			std::shared_ptr<Sucker> sucker = std::make_shared<Sucker>();
+			std::shared_ptr<Sucker> sucker = CreateActor<Sucker>();
 			std::uint8_t suckerParams[1] = { (std::uint8_t)dir };
 			sucker->OnActivated(ActorActivationDetails(
 				_levelHandler,
@@ -80,7 +80,7 @@ namespace Jazz2::Actors::Enemies
 				SetTransition(AnimState::TransitionAttack, true, [this]() {
 					Vector2f bulletPos = Vector2f(_pos.X + (IsFacingLeft() ? -24.0f : 24.0f), _pos.Y);
 
-					std::shared_ptr<MagicBullet> magicBullet = std::make_shared<MagicBullet>(this);
+					std::shared_ptr<MagicBullet> magicBullet = CreateActor<MagicBullet>(this);
 					magicBullet->OnActivated(ActorActivationDetails(
 						_levelHandler,
 						Vector3i((std::int32_t)bulletPos.X, (std::int32_t)bulletPos.Y, _renderer.layer() + 1)
@@ -143,6 +143,7 @@ namespace Jazz2::Actors::Enemies
 
 	Task<bool> Witch::MagicBullet::OnActivatedAsync(const ActorActivationDetails& details)
 	{
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::IsInvulnerable | ActorState::SkipPerPixelCollisions, true);
 		SetState(ActorState::CanBeFrozen | ActorState::CollideWithTileset | ActorState::ApplyGravitation, false);
 
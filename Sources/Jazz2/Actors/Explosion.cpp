@@ -12,7 +12,7 @@ namespace Jazz2::Actors
 
 	void Explosion::Create(ILevelHandler* levelHandler, const Vector3i& pos, Type type, float scale)
 	{
-		std::shared_ptr<Explosion> explosion = std::make_shared<Explosion>();
+		std::shared_ptr<Explosion> explosion = CreateActor<Explosion>();
 		std::uint8_t explosionParams[8];
 		EventParamsWriter writer(explosionParams);
 		writer.SetUint16(0, (std::uint16_t)type);
@@ -32,10 +32,12 @@ namespace Jazz2::Actors
 		_type = (Type)params.GetUint16(0);
 		_scale = params.GetFloat(4);
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::ForceDisableCollisions, true);
 		SetState(ActorState::CanBeFrozen | ActorState::CollideWithTileset | ActorState::CollideWithOtherActors | ActorState::ApplyGravitation, false);
 
-		async_await RequestMetadataAsync("Common/Explosions"_s);
+		static constexpr ResourceId MetadataId = "Common/Explosions"_s;
+		async_await RequestMetadataAsync(MetadataId);
 
 		// IceShrapnels are randomized below
 		if (_type != Type::IceShrapnel) {
@@ -18,6 +18,7 @@ namespace Jazz2::Actors::Lighting
 		_radiusFar = (float)params.GetUint16(4);
 		_phase = 0.6f;
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::ForceDisableCollisions, true);
 		SetState(ActorState::CanBeFrozen | ActorState::CollideWithTileset | ActorState::CollideWithOtherActors | ActorState::ApplyGravitation, false);
 
@@ -23,6 +23,7 @@ namespace Jazz2::Actors::Lighting
 
 		_phase = sync * fPiOver2 + _speed * _levelHandler->GetElapsedFrames();
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::ForceDisableCollisions, true);
 		SetState(ActorState::CanBeFrozen | ActorState::CollideWithTileset | ActorState::CollideWithOtherActors | ActorState::ApplyGravitation, false);
 
@@ -15,6 +15,7 @@ namespace Jazz2::Actors::Lighting
 		_radiusNear = (float)params.GetUint16(2);
 		_radiusFar = (float)params.GetUint16(4);
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::ForceDisableCollisions, true);
 		SetState(ActorState::CanBeFrozen | ActorState::CollideWithTileset | ActorState::CollideWithOtherActors | ActorState::ApplyGravitation, false);
 
@@ -44,13 +44,13 @@ namespace Jazz2::Actors::Multiplayer
 		// Actors that render through something else than their own sprite need a specialized representation
 		// that replays those visuals on the receiving side; everything else is a generic remote actor
 		if (metadataPath == "Weapon/Electro"_s) {
-			return std::make_shared<RemoteElectroShot>();
+			return CreateActor<RemoteElectroShot>();
 		}
 		if (metadataPath == "Weapon/Thunderbolt"_s) {
-			return std::make_shared<RemoteThunderbolt>();
+			return CreateActor<RemoteThunderbolt>();
 		}
 
-		return std::make_shared<RemoteActor>();
+		return CreateActor<RemoteActor>();
 	}
 
 	RemoteActor::~RemoteActor()
@@ -13,6 +13,7 @@ namespace Jazz2::Actors::Multiplayer
 	{
 		// The sprite stays hidden, but the particle trail follows the position, so it has to keep interpolating
 		_alwaysInterpolate = true;
+		SetState(ActorState::EmitsLights, true);
 	}
 
 	void RemoteElectroShot::AssignMetadata(std::uint8_t flags, ActorState state, StringView path, AnimState anim, float rotation, float scaleX, float scaleY, ActorRendererType rendererType)
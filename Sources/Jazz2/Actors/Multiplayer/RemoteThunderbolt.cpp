@@ -9,6 +9,7 @@ namespace Jazz2::Actors::Multiplayer
 	RemoteThunderbolt::RemoteThunderbolt()
 		: _lightProgress(0.0f), _muzzleFlash(false)
 	{
+		SetState(ActorState::EmitsLights, true);
 	}
 
 	void RemoteThunderbolt::AssignMetadata(std::uint8_t flags, ActorState state, StringView path, AnimState anim, float rotation, float scaleX, float scaleY, ActorRendererType rendererType)
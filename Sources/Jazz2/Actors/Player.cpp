@@ -228,6 +228,7 @@ namespace Jazz2::Actors
 
 	Task<bool> Player::OnActivatedAsync(const ActorActivationDetails& details)
 	{
+		SetState(ActorState::EmitsLights, true);
 		_playerTypeOriginal = (PlayerType)details.Params[0];
 		_playerType = _playerTypeOriginal;
 		_playerIndex = details.Params[1];
@@ -897,7 +898,7 @@ namespace Jazz2::Actors
 			_suspendType == SuspendType::None && _currentSpecialMove == SpecialMoveType::None && _activeModifier == Modifier::None) {
 			AABBf gapProbe = AABBf(AABBInner.L + 6.0f, AABBInner.B + 4.0f, AABBInner.R - 6.0f, AABBInner.B + 44.0f);
 			TileCollisionParams params = { TileDestructType::None, true };
-			if (_levelHandler->IsPositionEmpty(this, gapProbe, params)) {
+			if (IsGroundEmpty(gapProbe, params)) {
 				_speed.Y = -1.5f * LegacyVerticalSpeedScale;
 			}
 		}
@@ -2398,8 +2399,8 @@ namespace Jazz2::Actors
 						AABBf aabbR = AABBf(AABBInner.R - 4, AABBInner.B - 10, AABBInner.R - 2, AABBInner.B + 28);
 						TileCollisionParams params = { TileDestructType::None, true };
 						if (IsFacingLeft()
-							? (_levelHandler->IsPositionEmpty(this, aabbL, params) && !_levelHandler->IsPositionEmpty(this, aabbR, params))
-							: (!_levelHandler->IsPositionEmpty(this, aabbL, params) && _levelHandler->IsPositionEmpty(this, aabbR, params))) {
+							? (IsGroundEmpty(aabbL, params) && !IsGroundEmpty(aabbR, params))
+							: (!IsGroundEmpty(aabbL, params) && IsGroundEmpty(aabbR, params))) {
 
 							_inLedgeTransition = true;
 							if (_playerType == PlayerType::Spaz) {
@@ -3060,7 +3061,7 @@ namespace Jazz2::Actors
 	{
 		AABBf aabb = AABBf(_pos.X - 14, _pos.Y + 8 - 12, _pos.X + 14, _pos.Y + 8 + 12 + 100);
 		TileCollisionParams params = { TileDestructType::None, true };
-		return _levelHandler->IsPositionEmpty(this, aabb, params);
+		return IsGroundEmpty(aabb, params);
 	}
 
 	void Player::OnPerishInner()
@@ -3128,7 +3129,7 @@ namespace Jazz2::Actors
 				std::uint8_t playerParams[6] = { (std::uint8_t)_playerType, (std::uint8_t)(IsFacingLeft() ? 1 : 0),
 					(std::uint8_t)(furColor & 0xFF), (std::uint8_t)((furColor >> 8) & 0xFF),
 					(std::uint8_t)((furColor >> 16) & 0xFF), (std::uint8_t)((furColor >> 24) & 0xFF) };
-				std::shared_ptr<PlayerCorpse> corpse = std::make_shared<PlayerCorpse>();
+				std::shared_ptr<PlayerCorpse> corpse = CreateActor<PlayerCorpse>();
 				corpse->OnActivated(ActorActivationDetails(
 					_levelHandler,
 					Vector3i(_pos.X, _pos.Y, _renderer.layer() - 40),
@@ -3217,7 +3218,7 @@ namespace Jazz2::Actors
 		float angle;
 		GetFirePointAndAngle(initialPos, gunspotPos, angle);
 
-		std::shared_ptr<T> shot = std::make_shared<T>();
+		std::shared_ptr<T> shot = CreateActor<T>();
 		std::uint8_t shotParams[1] = { _inventory.WeaponUpgrades[(std::int32_t)weaponType] };
 		shot->OnActivated(ActorActivationDetails(
 			_levelHandler,
@@ -3245,7 +3246,7 @@ namespace Jazz2::Actors
 		uint8_t shotParams[1] = { _inventory.WeaponUpgrades[(std::int32_t)WeaponType::RF] };
 
 		if ((_inventory.WeaponUpgrades[(std::int32_t)WeaponType::RF] & 0x1) != 0) {
-			std::shared_ptr<Weapons::RFShot> shot1 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot1 = CreateActor<Weapons::RFShot>();
 			shot1->OnActivated(ActorActivationDetails(
 				_levelHandler,
 				initialPos,
@@ -3254,7 +3255,7 @@ namespace Jazz2::Actors
 			shot1->OnFire(shared_from_this(), gunspotPos, _speed, angle - 0.3f, IsFacingLeft());
 			_levelHandler->AddActor(shot1);
 
-			std::shared_ptr<Weapons::RFShot> shot2 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot2 = CreateActor<Weapons::RFShot>();
 			shot2->OnActivated(ActorActivationDetails(
 				_levelHandler,
 				initialPos,
@@ -3263,7 +3264,7 @@ namespace Jazz2::Actors
 			shot2->OnFire(shared_from_this(), gunspotPos, _speed, angle, IsFacingLeft());
 			_levelHandler->AddActor(shot2);
 
-			std::shared_ptr<Weapons::RFShot> shot3 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot3 = CreateActor<Weapons::RFShot>();
 			shot3->OnActivated(ActorActivationDetails(
 				_levelHandler,
 				initialPos,
@@ -3272,7 +3273,7 @@ namespace Jazz2::Actors
 			shot3->OnFire(shared_from_this(), gunspotPos, _speed, angle + 0.3f, IsFacingLeft());
 			_levelHandler->AddActor(shot3);
 		} else {
-			std::shared_ptr<Weapons::RFShot> shot1 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot1 = CreateActor<Weapons::RFShot>();
 			shot1->OnActivated(ActorActivationDetails(
 				_levelHandler,
 				initialPos,
@@ -3281,7 +3282,7 @@ namespace Jazz2::Actors
 			shot1->OnFire(shared_from_this(), gunspotPos, _speed, angle - 0.26f, IsFacingLeft());
 			_levelHandler->AddActor(shot1);
 
-			std::shared_ptr<Weapons::RFShot> shot2 = std::make_shared<Weapons::RFShot>();
+			std::shared_ptr<Weapons::RFShot> shot2 = CreateActor<Weapons::RFShot>();
 			shot2->OnActivated(ActorActivationDetails(
 				_levelHandler,
 				initialPos,
@@ -3304,7 +3305,7 @@ namespace Jazz2::Actors
 
 		uint8_t shotParams[1] = { _inventory.WeaponUpgrades[(std::int32_t)WeaponType::Pepper] };
 
-		std::shared_ptr<Weapons::PepperShot> shot1 = std::make_shared<Weapons::PepperShot>();
+		std::shared_ptr<Weapons::PepperShot> shot1 = CreateActor<Weapons::PepperShot>();
 		shot1->OnActivated(ActorActivationDetails(
 			_levelHandler,
 			initialPos,
@@ -3313,7 +3314,7 @@ namespace Jazz2::Actors
 		shot1->OnFire(shared_from_this(), gunspotPos, _speed, angle - Random().NextFloat(-0.2f, 0.2f), IsFacingLeft());
 		_levelHandler->AddActor(shot1);
 
-		std::shared_ptr<Weapons::PepperShot> shot2 = std::make_shared<Weapons::PepperShot>();
+		std::shared_ptr<Weapons::PepperShot> shot2 = CreateActor<Weapons::PepperShot>();
 		shot2->OnActivated(ActorActivationDetails(
 			_levelHandler,
 			initialPos,
@@ -3329,7 +3330,7 @@ namespace Jazz2::Actors
 
 	void Player::FireWeaponTNT()
 	{
-		std::shared_ptr<Weapons::TNT> tnt = std::make_shared<Weapons::TNT>();
+		std::shared_ptr<Weapons::TNT> tnt = CreateActor<Weapons::TNT>();
 		tnt->OnActivated(ActorActivationDetails(
 			_levelHandler,
 			Vector3i((std::int32_t)_pos.X, (std::int32_t)_pos.Y, _renderer.layer() - 2)
@@ -3353,7 +3354,7 @@ namespace Jazz2::Actors
 		float angle;
 		GetFirePointAndAngle(initialPos, gunspotPos, angle);
 
-		std::shared_ptr<Weapons::Thunderbolt> shot = std::make_shared<Weapons::Thunderbolt>();
+		std::shared_ptr<Weapons::Thunderbolt> shot = CreateActor<Weapons::Thunderbolt>();
 		uint8_t shotParams[1] = { _inventory.WeaponUpgrades[(std::int32_t)WeaponType::Thunderbolt] };
 		shot->OnActivated(ActorActivationDetails(
 			_levelHandler,
@@ -4675,7 +4676,7 @@ namespace Jazz2::Actors
 			return false;
 		}
 
-		_spawnedBird = std::make_shared<Environment::Bird>();
+		_spawnedBird = CreateActor<Environment::Bird>();
 		std::uint8_t birdParams[2] = { type, (std::uint8_t)_playerIndex };
 		_spawnedBird->OnActivated(ActorActivationDetails(
 			_levelHandler,
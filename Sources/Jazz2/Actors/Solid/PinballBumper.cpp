@@ -18,6 +18,7 @@ namespace Jazz2::Actors::Solid
 	{
 		std::uint8_t theme = details.Params[0];
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::CollideWithTileset | ActorState::IsSolidObject | ActorState::ApplyGravitation, false);
 
 		async_await RequestMetadataAsync("Object/PinballBumper"_s);
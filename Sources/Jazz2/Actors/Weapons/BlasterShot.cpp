@@ -23,10 +23,12 @@ namespace Jazz2::Actors::Weapons
 
 		_upgrades = details.Params[0];
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::SkipPerPixelCollisions, true);
 		SetState(ActorState::ApplyGravitation, false);
 
-		async_await RequestMetadataAsync("Weapon/Blaster"_s);
+		static constexpr ResourceId MetadataId = "Weapon/Blaster"_s;
+		async_await RequestMetadataAsync(MetadataId);
 
 		AnimState state = AnimState::Idle;
 		if ((_upgrades & 0x01) != 0) {
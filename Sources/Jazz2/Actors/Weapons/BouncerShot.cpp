@@ -19,9 +19,11 @@ namespace Jazz2::Actors::Weapons
 	{
 		async_await ShotBase::OnActivatedAsync(details);
 
+		SetState(ActorState::EmitsLights, true);
 		_upgrades = details.Params[0];
 
-		async_await RequestMetadataAsync("Weapon/Bouncer"_s);
+		static constexpr ResourceId MetadataId = "Weapon/Bouncer"_s;
+		async_await RequestMetadataAsync(MetadataId);
 
 		AnimState state = AnimState::Idle;
 		if ((_upgrades & 0x1) != 0) {
@@ -25,10 +25,12 @@ namespace Jazz2::Actors::Weapons
 		_strength = 4;
 		_timeLeft = 55;
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::SkipPerPixelCollisions, true);
 		SetState(ActorState::ApplyGravitation, false);
 
-		async_await RequestMetadataAsync("Weapon/Electro"_s);
+		static constexpr ResourceId MetadataId = "Weapon/Electro"_s;
+		async_await RequestMetadataAsync(MetadataId);
 		// The animation state carries the variant to remote clients (the sprite itself is never drawn); fall back
 		// to the base state if the metadata doesn't define the powered-up one
 		if ((_upgrades & 0x1) == 0 || !SetAnimation(PoweredUpAnimState)) {
@@ -24,11 +24,13 @@ namespace Jazz2::Actors::Weapons
 
 		_upgrades = details.Params[0];
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::SkipPerPixelCollisions, true);
 		SetState(ActorState::ApplyGravitation, false);
 		_strength = 0;
 
-		async_await RequestMetadataAsync("Weapon/Freezer"_s);
+		static constexpr ResourceId MetadataId = "Weapon/Freezer"_s;
+		async_await RequestMetadataAsync(MetadataId);
 
 		AnimState state = AnimState::Idle;
 		if ((_upgrades & 0x01) != 0) {
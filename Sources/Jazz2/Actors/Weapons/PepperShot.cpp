@@ -22,10 +22,12 @@ namespace Jazz2::Actors::Weapons
 		_upgrades = details.Params[0];
 		_strength = 1;
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::SkipPerPixelCollisions, true);
 		SetState(ActorState::ApplyGravitation, false);
 
-		async_await RequestMetadataAsync("Weapon/Pepper"_s);
+		static constexpr ResourceId MetadataId = "Weapon/Pepper"_s;
+		async_await RequestMetadataAsync(MetadataId);
 
 		AnimState state = AnimState::Idle;
 		if ((_upgrades & 0x01) != 0) {
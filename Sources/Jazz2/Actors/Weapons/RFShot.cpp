@@ -20,9 +20,11 @@ namespace Jazz2::Actors::Weapons
 		_upgrades = details.Params[0];
 		_strength = 2;
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::ApplyGravitation, false);
 
-		async_await RequestMetadataAsync("Weapon/RF"_s);
+		static constexpr ResourceId MetadataId = "Weapon/RF"_s;
+		async_await RequestMetadataAsync(MetadataId);
 
 		AnimState state = AnimState::Idle;
 		if ((_upgrades & 0x1) != 0) {
@@ -26,9 +26,11 @@ namespace Jazz2::Actors::Weapons
 
 		_upgrades = details.Params[0];
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::ApplyGravitation, false);
 
-		async_await RequestMetadataAsync("Weapon/Seeker"_s);
+		static constexpr ResourceId MetadataId = "Weapon/Seeker"_s;
+		async_await RequestMetadataAsync(MetadataId);
 
 		AnimState state = AnimState::Idle;
 		if ((_upgrades & 0x1) != 0) {
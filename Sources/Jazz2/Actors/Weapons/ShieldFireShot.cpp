@@ -21,10 +21,12 @@ namespace Jazz2::Actors::Weapons
 	{
 		async_await ShotBase::OnActivatedAsync(details);
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::SkipPerPixelCollisions, true);
 		SetState(ActorState::ApplyGravitation, false);
 
-		async_await RequestMetadataAsync("Weapon/ShieldFire"_s);
+		static constexpr ResourceId MetadataId = "Weapon/ShieldFire"_s;
+		async_await RequestMetadataAsync(MetadataId);
 
 		_timeLeft = 30;
 		_strength = 1;
@@ -24,7 +24,8 @@ namespace Jazz2::Actors::Weapons
 		SetState(ActorState::SkipPerPixelCollisions, true);
 		SetState(ActorState::ApplyGravitation, false);
 
-		async_await RequestMetadataAsync("Weapon/ShieldWater"_s);
+		static constexpr ResourceId MetadataId = "Weapon/ShieldWater"_s;
+		async_await RequestMetadataAsync(MetadataId);
 
 		_timeLeft = 35;
 		_strength = 2;
@@ -28,10 +28,12 @@ namespace Jazz2::Actors::Weapons
 		_timeLeft = 200.0f;
 		_preexplosionTime = (int)_timeLeft / 16;
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::CollideWithTileset | ActorState::CollideWithOtherActors | ActorState::CollideWithSolidObjects | ActorState::ApplyGravitation, false);
 
 
-		async_await RequestMetadataAsync("Weapon/TNT"_s);
+		static constexpr ResourceId MetadataId = "Weapon/TNT"_s;
+		async_await RequestMetadataAsync(MetadataId);
 
 		SetAnimation(AnimState::Idle);
 
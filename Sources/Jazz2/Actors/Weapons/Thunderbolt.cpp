@@ -23,9 +23,11 @@ namespace Jazz2::Actors::Weapons
 		_initialLayer = _renderer.layer();
 		_strength = 2;
 		_health = INT32_MAX;
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::ApplyGravitation, false);
 
-		async_await RequestMetadataAsync("Weapon/Thunderbolt"_s);
+		static constexpr ResourceId MetadataId = "Weapon/Thunderbolt"_s;
+		async_await RequestMetadataAsync(MetadataId);
 
 		SetAnimation((AnimState)(Random().NextBool() ? 1 : 0));
 
@@ -21,9 +21,11 @@ namespace Jazz2::Actors::Weapons
 		_strength = 1;
 		_upgrades = details.Params[0];
 
+		SetState(ActorState::EmitsLights, true);
 		SetState(ActorState::ApplyGravitation, false);
 
-		async_await RequestMetadataAsync("Weapon/Toaster"_s);
+		static constexpr ResourceId MetadataId = "Weapon/Toaster"_s;
+		async_await RequestMetadataAsync(MetadataId);
 
 		AnimState state = AnimState::Idle;
 		if ((_upgrades & 0x01) != 0) {
@@ -0,0 +1,195 @@
+// Spawns and destroys actor-sized objects through the general heap and through ActorPool and compares their time and frame-time spread
+// Built with -DNCINE_BUILD_BENCHMARKS=ON, usage: ActorPoolBenchmark [--frames <count>] [--spawns <count>] [--resident <count>]
+
+#include "Jazz2/Actors/ActorPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace Jazz2::Actors;
+
+namespace
+{
+	// Small xorshift generator, so the spawn stream doesn't depend on the standard library implementation
+	struct Random
+	{
+		std::uint32_t State;
+
+		std::uint32_t Next(std::uint32_t count)
+		{
+			State ^= State << 13;
+			State ^= State >> 17;
+			State ^= State << 5;
+			return State % count;
+		}
+	};
+
+	struct FakeActorBase
+	{
+		std::uint32_t Id;
+
+		virtual ~FakeActorBase() {}
+	};
+
+	// Stands in for one actor class, sizes match those of shots, explosions, enemies and collectibles in the game
+	template<std::size_t Size>
+	struct FakeActor : FakeActorBase
+	{
+		std::uint8_t Payload[Size - sizeof(FakeActorBase)];
+
+		FakeActor(std::uint32_t id)
+		{
+			Id = id;
+			// Actor constructors initialize most of their fields
+			std::memset(Payload, 0, sizeof(Payload));
+		}
+	};
+
+	struct LiveActor
+	{
+		std::shared_ptr<FakeActorBase> Actor;
+		std::int32_t ExpiresAt;
+	};
+
+	template<bool Pooled, std::size_t Size>
+	std::shared_ptr<FakeActorBase> Spawn(std::uint32_t id)
+	{
+		if (Pooled) {
+			return CreateActor<FakeActor<Size>>(id);
+		} else {
+			return std::make_shared<FakeActor<Size>>(id);
+		}
+	}
+
+	template<bool Pooled>
+	std::shared_ptr<FakeActorBase> SpawnOfKind(std::uint32_t kind, std::uint32_t id)
+	{
+		switch (kind) {
+			case 0: return Spawn<Pooled, 1168>(id);	// Explosion
+			case 1: return Spawn<Pooled, 1200>(id);	// BlasterShot, ToasterShot
+			case 2: return Spawn<Pooled, 1208>(id);	// BouncerShot, SeekerShot
+			case 3: return Spawn<Pooled, 1184>(id);	// Gem and ammo collectibles
+			default: return Spawn<Pooled, 1160>(id);	// Turtle, Bird
+		}
+	}
+
+	struct Result
+	{
+		double TotalMs;
+		double MeanMs;
+		double StdDevMs;
+		double WorstMs;
+		std::uint64_t Operations;
+		std::uint64_t Checksum;
+	};
+
+	template<bool Pooled>
+	Result Run(std::int32_t frames, std::int32_t spawnsPerFrame, std::int32_t resident)
+	{
+		Random random = { 0x9E3779B9u };
+		std::vector<LiveActor> live;
+		// Unrelated allocations the game makes between spawns (strings, vectors, render commands), so the general
+		// heap is as fragmented as it is in a running level
+		std::vector<std::unique_ptr<std::uint8_t[]>> churn(256);
+		std::vector<double> frameMs;
+		frameMs.reserve(frames);
+
+		std::uint32_t nextId = 0;
+		std::uint64_t operations = 0;
+		std::uint64_t checksum = 0;
+
+		// Enemies and collectibles that live for the whole level
+		for (std::int32_t i = 0; i < resident; i++) {
+			live.push_back({ SpawnOfKind<Pooled>(3 + random.Next(2), nextId++), frames });
+		}
+
+		for (std::int32_t frame = 0; frame < frames; frame++) {
+			for (std::int32_t i = 0; i < 16; i++) {
+				churn[random.Next(std::uint32_t(churn.size()))].reset(new std::uint8_t[32 + random.Next(480)]);
+			}
+
+			auto start = std::chrono::steady_clock::now();
+			// Shots and explosions, most of them live for less than a second
+			for (std::int32_t i = 0; i < spawnsPerFrame; i++) {
+				live.push_back({ SpawnOfKind<Pooled>(random.Next(3), nextId++), frame + 4 + std::int32_t(random.Next(56)) });
+				operations++;
+			}
+			for (std::size_t i = 0; i < live.size(); ) {
+				if (live[i].ExpiresAt <= frame) {
+					checksum += live[i].Actor->Id;
+					live[i] = std::move(live.back());
+					live.pop_back();
+					operations++;
+				} else {
+					i++;
+				}
+			}
+			frameMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		}
+
+		live.clear();
+		if (Pooled) {
+			ActorPool::Trim();
+		}
+
+		Result result = { };
+		for (double ms : frameMs) {
+			result.TotalMs += ms;
+			result.WorstMs = std::max(result.WorstMs, ms);
+		}
+		result.MeanMs = result.TotalMs / frames;
+		for (double ms : frameMs) {
+			result.StdDevMs += (ms - result.MeanMs) * (ms - result.MeanMs);
+		}
+		result.StdDevMs = std::sqrt(result.StdDevMs / frames);
+		result.Operations = operations;
+		result.Checksum = checksum;
+		return result;
+	}
+
+	void Print(const char* name, const Result& result, const Result* reference)
+	{
+		std::printf("  %-13s %8.3f ms total, %6.2f M ops/s, frame %6.2f us +- %6.2f us, worst %7.2f us",
+			name, result.TotalMs, result.Operations / result.TotalMs / 1000.0, result.MeanMs * 1000.0, result.StdDevMs * 1000.0, result.WorstMs * 1000.0);
+		if (reference != nullptr) {
+			std::printf(" (%.2fx)", reference->TotalMs / result.TotalMs);
+		}
+		std::printf("\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::int32_t frames = 20000;
+	std::int32_t spawnsPerFrame = 20;
+	std::int32_t resident = 400;
+	for (std::int32_t i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			frames = std::atoi(argv[++i]);
+		} else if (std::strcmp(argv[i], "--spawns") == 0 && i + 1 < argc) {
+			spawnsPerFrame = std::atoi(argv[++i]);
+		} else if (std::strcmp(argv[i], "--resident") == 0 && i + 1 < argc) {
+			resident = std::atoi(argv[++i]);
+		} else {
+			std::fprintf(stderr, "Usage: %s [--frames <count>] [--spawns <count>] [--resident <count>]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Result heap = Run<false>(frames, spawnsPerFrame, resident);
+	Result pooled = Run<true>(frames, spawnsPerFrame, resident);
+	bool matches = (heap.Checksum == pooled.Checksum && heap.Operations == pooled.Operations);
+
+	std::printf("%d frames, %d spawns per frame, %d resident actors\n", frames, spawnsPerFrame, resident);
+	Print("general heap:", heap, nullptr);
+	Print("ActorPool:", pooled, &heap);
+	std::printf("  results %s\n", matches ? "match" : "DIFFER");
+	return (matches ? 0 : 1);
+}
@@ -22,8 +22,7 @@
 
 #pragma once
 
-#include "../../nCine/Primitives/AABB.h"
-#include "../../nCine/Primitives/Vector2.h"
+#include "IBroadPhase.h"
 
 #include <Containers/SmallVector.h>
 
@@ -31,13 +30,8 @@ using namespace Death::Containers;
 
 namespace Jazz2::Collisions
 {
-	using nCine::AABBf;
-	using nCine::Vector2f;
-
 	/** @{ @name Constants */
 
-	/** @brief Invalid node */
-	constexpr std::int32_t NullNode = -1;
 	/** @brief Length units per meter */
 	constexpr float LengthUnitsPerMeter = 1.0f;
 	/** @brief AABB size extension to fat AABB */
@@ -23,25 +23,12 @@
 #pragma once
 
 #include "DynamicTree.h"
+#include "IBroadPhase.h"
 
 #include <algorithm>
 
 namespace Jazz2::Collisions
 {
-	/**
-		@brief A potentially overlapping pair of proxies reported by the broad-phase
-		
-		Holds the two proxy IDs of objects whose fat AABBs were found to overlap during @ref
-		DynamicTreeBroadPhase::UpdatePairs(). It identifies candidates that the client should examine with an exact
-		narrow-phase test, rather than a confirmed collision.
-	*/
-	struct CollisionPair {
-		/** @brief Proxy ID of the first node */
-		std::int32_t ProxyIdA;
-		/** @brief Proxy ID of the second node */
-		std::int32_t ProxyIdB;
-	};
-
 	/**
 		@brief Broad-phase for collision detection
 		
@@ -49,24 +36,24 @@ namespace Jazz2::Collisions
 		This broad-phase does not persist pairs. Instead, this reports potentially new pairs.
 		It is up to the client to consume the new pairs and to track subsequent overlap.
 	*/
-	class DynamicTreeBroadPhase
+	class DynamicTreeBroadPhase : public IBroadPhase
 	{
 		friend class DynamicTree;
 
 	public:
 		/** @brief Creates a new instance */
 		DynamicTreeBroadPhase();
-		~DynamicTreeBroadPhase();
+		~DynamicTreeBroadPhase() override;
 
 		/**
 		 * @brief Creates a proxy with an initial AABB
 		 * 
 		 * Pairs are not reported until @ref UpdatePairs() is called
 		 */
-		std::int32_t CreateProxy(const AABBf& aabb, void* userData);
+		std::int32_t CreateProxy(const AABBf& aabb, void* userData) override;
 
 		/** @brief Destroys a proxy */
-		void DestroyProxy(std::int32_t proxyId);
+		void DestroyProxy(std::int32_t proxyId) override;
 
 		/**
 		 * @brief Moves a proxy with a swepted AABB
@@ -76,27 +63,31 @@ namespace Jazz2::Collisions
 		 *
 		 * @return `true` if the proxy was re-inserted.
 		 */
-		void MoveProxy(std::int32_t proxyId, const AABBf& aabb, Vector2f displacement);
+		void MoveProxy(std::int32_t proxyId, const AABBf& aabb, Vector2f displacement) override;
 
 		/** @brief Triggers a re-processing of it's pairs on the next call to @ref UpdatePairs() */
-		void TouchProxy(std::int32_t proxyId);
+		void TouchProxy(std::int32_t proxyId) override;
 
 		/** @brief Returns the fat AABB for a proxy */
 		const AABBf& GetFatAABB(std::int32_t proxyId) const;
 
 		/** @brief Returns a user data from a proxy */
-		void* GetUserData(std::int32_t proxyId) const;
+		void* GetUserData(std::int32_t proxyId) const override;
 
 		/** @brief Tests overlap of fat AABBs */
 		bool TestOverlap(std::int32_t proxyIdA, std::int32_t proxyIdB) const;
 
 		/** @brief Returns the number of proxies */
-		std::int32_t GetProxyCount() const;
+		std::int32_t GetProxyCount() const override;
 
 		/** @brief Updates the pairs */
 		template <typename T>
 		void UpdatePairs(T* callback);
 
+		void UpdatePairs(IPairCallback* callback) override {
+			UpdatePairs<IPairCallback>(callback);
+		}
+
 		/**
 		 * @brief Queries an AABB for overlapping proxies
 		 * 
@@ -105,6 +96,10 @@ namespace Jazz2::Collisions
 		template <typename T>
 		void Query(T* callback, const AABBf& aabb) const;
 
+		void Query(IQueryCallback* callback, const AABBf& aabb) const override {
+			_tree.Query(callback, aabb);
+		}
+
 		// Ray-cast against the proxies in the tree. This relies on the callback
 		// to perform a exact ray-cast in the case were the proxy contains a shape.
 		// The callback also performs the any collision filtering. This has performance
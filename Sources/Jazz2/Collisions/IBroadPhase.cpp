@@ -0,0 +1,14 @@
+﻿#include "IBroadPhase.h"
+#include "DynamicTreeBroadPhase.h"
+#include "SpatialHashGrid.h"
+
+namespace Jazz2::Collisions
+{
+	std::unique_ptr<IBroadPhase> IBroadPhase::Create(BroadPhaseType type)
+	{
+		switch (type) {
+			case BroadPhaseType::SpatialHashGrid: return std::make_unique<SpatialHashGrid>();
+			default: return std::make_unique<DynamicTreeBroadPhase>();
+		}
+	}
+}
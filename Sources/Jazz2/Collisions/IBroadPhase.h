@@ -0,0 +1,88 @@
+﻿#pragma once
+
+#include "../../nCine/Primitives/AABB.h"
+#include "../../nCine/Primitives/Vector2.h"
+
+#include <memory>
+
+namespace Jazz2::Collisions
+{
+	using nCine::AABBf;
+	using nCine::Vector2f;
+
+	/** @brief Invalid node (proxy ID) */
+	constexpr std::int32_t NullNode = -1;
+
+	/**
+		@brief A potentially overlapping pair of proxies reported by the broad-phase
+		
+		Holds the two proxy IDs of objects whose (fat) AABBs were found to overlap during
+		@ref IBroadPhase::UpdatePairs(). It identifies candidates that the client should examine with an exact
+		narrow-phase test, rather than a confirmed collision.
+	*/
+	struct CollisionPair {
+		/** @brief Proxy ID of the first node */
+		std::int32_t ProxyIdA;
+		/** @brief Proxy ID of the second node */
+		std::int32_t ProxyIdB;
+	};
+
+	/** @brief Implementation of collision broad-phase, see @ref IBroadPhase::Create() */
+	enum class BroadPhaseType {
+		DynamicTree,				/**< Dynamic AABB tree, see @ref DynamicTreeBroadPhase */
+		SpatialHashGrid				/**< Spatial hash grid with tile-sized cells, see @ref SpatialHashGrid */
+	};
+
+	/**
+		@brief Interface of collision broad-phase
+
+		The broad-phase tracks proxies (axis-aligned bounding boxes with attached user data) and reports potentially
+		overlapping pairs and volume queries. It doesn't persist pairs, it only reports potentially new pairs on each
+		call to @ref UpdatePairs(). Exact (narrow-phase) tests are up to the caller.
+	*/
+	class IBroadPhase
+	{
+	public:
+		/** @brief Callback interface of @ref Query() */
+		class IQueryCallback
+		{
+		public:
+			/** @brief Called for each proxy that potentially overlaps the query, returns `false` to stop the query */
+			virtual bool OnCollisionQuery(std::int32_t proxyId) = 0;
+		};
+
+		/** @brief Callback interface of @ref UpdatePairs() */
+		class IPairCallback
+		{
+		public:
+			/** @brief Called for each potentially overlapping pair */
+			virtual void OnPairAdded(void* userDataA, void* userDataB) = 0;
+		};
+
+		virtual ~IBroadPhase() {}
+
+		/** @brief Creates a new broad-phase of the specified type */
+		static std::unique_ptr<IBroadPhase> Create(BroadPhaseType type);
+
+		/**
+		 * @brief Creates a proxy with an initial AABB
+		 *
+		 * Pairs are not reported until @ref UpdatePairs() is called
+		 */
+		virtual std::int32_t CreateProxy(const AABBf& aabb, void* userData) = 0;
+		/** @brief Destroys a proxy */
+		virtual void DestroyProxy(std::int32_t proxyId) = 0;
+		/** @brief Moves a proxy with a swepted AABB, pairs of the proxy are re-processed on the next call to @ref UpdatePairs() */
+		virtual void MoveProxy(std::int32_t proxyId, const AABBf& aabb, Vector2f displacement) = 0;
+		/** @brief Triggers a re-processing of it's pairs on the next call to @ref UpdatePairs() */
+		virtual void TouchProxy(std::int32_t proxyId) = 0;
+		/** @brief Returns a user data from a proxy */
+		virtual void* GetUserData(std::int32_t proxyId) const = 0;
+		/** @brief Returns the number of proxies */
+		virtual std::int32_t GetProxyCount() const = 0;
+		/** @brief Reports all potentially overlapping pairs of proxies that moved since the last call */
+		virtual void UpdatePairs(IPairCallback* callback) = 0;
+		/** @brief Queries an AABB for overlapping proxies */
+		virtual void Query(IQueryCallback* callback, const AABBf& aabb) const = 0;
+	};
+}
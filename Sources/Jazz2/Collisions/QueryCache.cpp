@@ -0,0 +1,62 @@
+﻿#include "QueryCache.h"
+
+#include <cstring>
+
+namespace Jazz2::Collisions
+{
+	QueryCache::QueryCache()
+		: _generation(1)
+	{
+		for (Slot& slot : _slots) {
+			slot.Generation = 0;
+		}
+	}
+
+	void QueryCache::Invalidate()
+	{
+		_results.clear();
+		if DEATH_UNLIKELY(++_generation == 0) {
+			// Generation wrapped around, reset all slots to avoid false hits
+			for (Slot& slot : _slots) {
+				slot.Generation = 0;
+			}
+			_generation = 1;
+		}
+	}
+
+	bool QueryCache::TryGet(const AABBf& aabb, ArrayView<void* const>& result) const
+	{
+		const Slot& slot = _slots[GetSlotIndex(aabb)];
+		if (slot.Generation != _generation || std::memcmp(&slot.Aabb, &aabb, sizeof(AABBf)) != 0) {
+			return false;
+		}
+
+		result = arrayView(_results.data() + slot.Offset, std::size_t(slot.Count));
+		return true;
+	}
+
+	void QueryCache::Store(const AABBf& aabb, ArrayView<void* const> result)
+	{
+		if (_results.size() + result.size() > MaxCachedResults) {
+			return;
+		}
+
+		Slot& slot = _slots[GetSlotIndex(aabb)];
+		slot.Aabb = aabb;
+		slot.Generation = _generation;
+		slot.Offset = std::int32_t(_results.size());
+		slot.Count = std::int32_t(result.size());
+		_results.append(result.begin(), result.end());
+	}
+
+	std::uint32_t QueryCache::GetSlotIndex(const AABBf& aabb)
+	{
+		std::uint32_t bits[4];
+		std::memcpy(bits, &aabb, sizeof(bits));
+		std::uint32_t hash = bits[0] * 0x9E3779B1u;
+		hash = (hash ^ bits[1]) * 0x85EBCA77u;
+		hash = (hash ^ bits[2]) * 0xC2B2AE3Du;
+		hash = (hash ^ bits[3]) * 0x27D4EB2Fu;
+		return (hash >> 16) & (SlotCount - 1);
+	}
+}
@@ -0,0 +1,53 @@
+﻿#pragma once
+
+#include "IBroadPhase.h"
+
+#include <Containers/ArrayView.h>
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+
+namespace Jazz2::Collisions
+{
+	/**
+		@brief Cache of broad-phase query results
+
+		Remembers user data of all proxies found by recent volume queries, so repeated queries with the same AABB are
+		answered without walking the broad-phase again. Cached results are valid only while the broad-phase is not
+		modified, so the cache has to be invalidated whenever a proxy is created, moved or destroyed. Exact
+		(narrow-phase) tests are not cached, so they always see the current state of the objects.
+	*/
+	class QueryCache
+	{
+	public:
+		/** @brief Number of cache slots, must be power of two */
+		static constexpr std::int32_t SlotCount = 64;
+		/** @brief Maximum number of cached results between invalidations */
+		static constexpr std::int32_t MaxCachedResults = 8192;
+
+		/** @brief Creates a new instance */
+		QueryCache();
+
+		/** @brief Drops all cached results, must be called whenever the broad-phase changes */
+		void Invalidate();
+
+		/** @brief Returns cached results of a query with the specified AABB, or `false` if they are not cached */
+		bool TryGet(const AABBf& aabb, ArrayView<void* const>& result) const;
+		/** @brief Stores results of a query with the specified AABB */
+		void Store(const AABBf& aabb, ArrayView<void* const> result);
+
+	private:
+		struct Slot {
+			AABBf Aabb;
+			std::uint32_t Generation;
+			std::int32_t Offset;
+			std::int32_t Count;
+		};
+
+		Slot _slots[SlotCount];
+		SmallVector<void*, 0> _results;
+		std::uint32_t _generation;
+
+		static std::uint32_t GetSlotIndex(const AABBf& aabb);
+	};
+}
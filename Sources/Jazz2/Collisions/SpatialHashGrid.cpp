@@ -0,0 +1,268 @@
+﻿#include "SpatialHashGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <Asserts.h>
+
+namespace Jazz2::Collisions
+{
+	SpatialHashGrid::SpatialHashGrid(float cellSize, std::int32_t bucketCount)
+		: _invCellSize(1.0f / cellSize), _bucketMask(std::uint32_t(bucketCount - 1)), _freeList(NullNode), _proxyCount(0), _queryStamp(0)
+	{
+		DEATH_DEBUG_ASSERT((bucketCount & (bucketCount - 1)) == 0, "Bucket count must be power of two", );
+		_buckets.resize(bucketCount);
+	}
+
+	SpatialHashGrid::~SpatialHashGrid()
+	{
+	}
+
+	std::int32_t SpatialHashGrid::CreateProxy(const AABBf& aabb, void* userData)
+	{
+		std::int32_t proxyId;
+		if (_freeList != NullNode) {
+			proxyId = _freeList;
+			_freeList = _proxies[proxyId].NextFree;
+		} else {
+			proxyId = std::int32_t(_proxies.size());
+			_proxies.emplace_back();
+		}
+
+		Proxy& proxy = _proxies[proxyId];
+		proxy.Aabb = aabb;
+		proxy.UserData = userData;
+		proxy.Cells = GetCellRange(aabb);
+		proxy.NextFree = NullNode;
+		proxy.QueryStamp = 0;
+		proxy.Moved = false;
+		InsertToCells(proxyId);
+		++_proxyCount;
+
+		TouchProxy(proxyId);
+		return proxyId;
+	}
+
+	void SpatialHashGrid::DestroyProxy(std::int32_t proxyId)
+	{
+		for (std::int32_t& movedId : _moveBuffer) {
+			if (movedId == proxyId) {
+				movedId = NullNode;
+			}
+		}
+
+		RemoveFromCells(proxyId);
+
+		Proxy& proxy = _proxies[proxyId];
+		proxy.UserData = nullptr;
+		proxy.Moved = false;
+		proxy.NextFree = _freeList;
+		_freeList = proxyId;
+		--_proxyCount;
+	}
+
+	void SpatialHashGrid::MoveProxy(std::int32_t proxyId, const AABBf& aabb, Vector2f displacement)
+	{
+		// Displacement is not needed, the grid is cheap to update every frame, so no fat AABBs are used
+		Proxy& proxy = _proxies[proxyId];
+		proxy.Aabb = aabb;
+
+		CellRange cells = GetCellRange(aabb);
+		if (cells != proxy.Cells) {
+			RemoveFromCells(proxyId);
+			proxy.Cells = cells;
+			InsertToCells(proxyId);
+		}
+
+		TouchProxy(proxyId);
+	}
+
+	void SpatialHashGrid::TouchProxy(std::int32_t proxyId)
+	{
+		Proxy& proxy = _proxies[proxyId];
+		if (!proxy.Moved) {
+			proxy.Moved = true;
+			_moveBuffer.push_back(proxyId);
+		}
+	}
+
+	void SpatialHashGrid::UpdatePairs(IPairCallback* callback)
+	{
+		_pairBuffer.clear();
+
+		for (std::int32_t queryId : _moveBuffer) {
+			if (queryId == NullNode) {
+				continue;
+			}
+
+			const Proxy& queryProxy = _proxies[queryId];
+			ForEachCandidate(queryProxy.Cells, [&](std::int32_t proxyId) {
+				if (proxyId == queryId) {
+					return true;
+				}
+				const Proxy& proxy = _proxies[proxyId];
+				if (proxy.Moved && proxyId > queryId) {
+					// Both proxies are moving, avoid duplicate pairs
+					return true;
+				}
+				if (queryProxy.Aabb.Overlaps(proxy.Aabb)) {
+					_pairBuffer.push_back({ std::min(proxyId, queryId), std::max(proxyId, queryId) });
+				}
+				return true;
+			});
+		}
+
+		// Sort the pair buffer to expose duplicates and to report pairs in deterministic order
+		std::sort(_pairBuffer.begin(), _pairBuffer.end(), [](const CollisionPair& a, const CollisionPair& b) {
+			return (a.ProxyIdA < b.ProxyIdA || (a.ProxyIdA == b.ProxyIdA && a.ProxyIdB < b.ProxyIdB));
+		});
+
+		std::size_t i = 0;
+		while (i < _pairBuffer.size()) {
+			const CollisionPair& primaryPair = _pairBuffer[i];
+			callback->OnPairAdded(_proxies[primaryPair.ProxyIdA].UserData, _proxies[primaryPair.ProxyIdB].UserData);
+			++i;
+
+			while (i < _pairBuffer.size() && _pairBuffer[i].ProxyIdA == primaryPair.ProxyIdA && _pairBuffer[i].ProxyIdB == primaryPair.ProxyIdB) {
+				++i;
+			}
+		}
+
+		for (std::int32_t proxyId : _moveBuffer) {
+			if (proxyId != NullNode) {
+				_proxies[proxyId].Moved = false;
+			}
+		}
+		_moveBuffer.clear();
+	}
+
+	void SpatialHashGrid::Query(IQueryCallback* callback, const AABBf& aabb) const
+	{
+		ForEachCandidate(GetCellRange(aabb), [&](std::int32_t proxyId) {
+			if (_proxies[proxyId].Aabb.Overlaps(aabb)) {
+				return callback->OnCollisionQuery(proxyId);
+			}
+			return true;
+		});
+	}
+
+	SpatialHashGrid::CellRange SpatialHashGrid::GetCellRange(const AABBf& aabb) const
+	{
+		// Coordinates are clamped to keep even degenerate boxes in a representable range
+		constexpr float Limit = float(1 << 24);
+		return {
+			std::int32_t(std::floor(std::clamp(aabb.L * _invCellSize, -Limit, Limit))),
+			std::int32_t(std::floor(std::clamp(aabb.T * _invCellSize, -Limit, Limit))),
+			std::int32_t(std::floor(std::clamp(aabb.R * _invCellSize, -Limit, Limit))),
+			std::int32_t(std::floor(std::clamp(aabb.B * _invCellSize, -Limit, Limit)))
+		};
+	}
+
+	std::uint32_t SpatialHashGrid::GetBucketIndex(std::int32_t x, std::int32_t y) const
+	{
+		return ((std::uint32_t(x) * 73856093u) ^ (std::uint32_t(y) * 19349663u)) & _bucketMask;
+	}
+
+	void SpatialHashGrid::InsertToCells(std::int32_t proxyId)
+	{
+		Proxy& proxy = _proxies[proxyId];
+		const CellRange& cells = proxy.Cells;
+		std::int64_t cellCount = std::int64_t(cells.MaxX - cells.MinX + 1) * std::int64_t(cells.MaxY - cells.MinY + 1);
+		proxy.Oversized = (cellCount > MaxCellsPerProxy);
+		if (proxy.Oversized) {
+			_oversized.push_back(proxyId);
+			return;
+		}
+
+		for (std::int32_t y = cells.MinY; y <= cells.MaxY; y++) {
+			for (std::int32_t x = cells.MinX; x <= cells.MaxX; x++) {
+				_buckets[GetBucketIndex(x, y)].push_back(proxyId);
+			}
+		}
+	}
+
+	void SpatialHashGrid::RemoveFromCells(std::int32_t proxyId)
+	{
+		auto removeFrom = [proxyId](auto& list) {
+			for (std::size_t i = 0; i < list.size(); i++) {
+				if (list[i] == proxyId) {
+					list[i] = list.back();
+					list.pop_back();
+					return;
+				}
+			}
+		};
+
+		const Proxy& proxy = _proxies[proxyId];
+		if (proxy.Oversized) {
+			removeFrom(_oversized);
+			return;
+		}
+
+		// The proxy was added once per cell, so it's also removed once per cell, even if more cells share a bucket
+		const CellRange& cells = proxy.Cells;
+		for (std::int32_t y = cells.MinY; y <= cells.MaxY; y++) {
+			for (std::int32_t x = cells.MinX; x <= cells.MaxX; x++) {
+				removeFrom(_buckets[GetBucketIndex(x, y)]);
+			}
+		}
+	}
+
+	std::uint32_t SpatialHashGrid::NextQueryStamp() const
+	{
+		if DEATH_UNLIKELY(++_queryStamp == 0) {
+			// Stamps wrapped around, reset all of them to avoid false positives
+			for (const Proxy& proxy : _proxies) {
+				proxy.QueryStamp = 0;
+			}
+			_queryStamp = 1;
+		}
+		return _queryStamp;
+	}
+
+	template<typename Func>
+	void SpatialHashGrid::ForEachCandidate(const CellRange& cells, Func&& func) const
+	{
+		// Each proxy is reported only once, even if it overlaps more cells or more cells share a bucket
+		std::uint32_t stamp = NextQueryStamp();
+
+		for (std::int32_t proxyId : _oversized) {
+			const Proxy& proxy = _proxies[proxyId];
+			proxy.QueryStamp = stamp;
+			if (!func(proxyId)) {
+				return;
+			}
+		}
+
+		std::int64_t cellCount = std::int64_t(cells.MaxX - cells.MinX + 1) * std::int64_t(cells.MaxY - cells.MinY + 1);
+		if (cellCount > std::int64_t(_bucketMask) + 1) {
+			// The query covers more cells than there are buckets, so visit each bucket just once
+			for (const auto& bucket : _buckets) {
+				for (std::int32_t proxyId : bucket) {
+					const Proxy& proxy = _proxies[proxyId];
+					if (proxy.QueryStamp != stamp) {
+						proxy.QueryStamp = stamp;
+						if (!func(proxyId)) {
+							return;
+						}
+					}
+				}
+			}
+			return;
+		}
+
+		for (std::int32_t y = cells.MinY; y <= cells.MaxY; y++) {
+			for (std::int32_t x = cells.MinX; x <= cells.MaxX; x++) {
+				for (std::int32_t proxyId : _buckets[GetBucketIndex(x, y)]) {
+					const Proxy& proxy = _proxies[proxyId];
+					if (proxy.QueryStamp != stamp) {
+						proxy.QueryStamp = stamp;
+						if (!func(proxyId)) {
+							return;
+						}
+					}
+				}
+			}
+		}
+	}
+}
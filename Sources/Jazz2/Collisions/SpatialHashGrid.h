@@ -0,0 +1,102 @@
+﻿#pragma once
+
+#include "IBroadPhase.h"
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+
+namespace Jazz2::Collisions
+{
+	/**
+		@brief Broad-phase based on a spatial hash grid
+
+		Space is divided into uniform square cells (tile-sized by default) that are hashed into a fixed number of
+		buckets, each bucket holds IDs of all proxies that overlap any of its cells. It's well suited for many small
+		actors of similar size that move every frame, because moving a proxy within its cells costs only an AABB
+		update. Proxies spanning too many cells are kept in a separate list that is checked by every query.
+	*/
+	class SpatialHashGrid : public IBroadPhase
+	{
+	public:
+		/** @brief Default cell size in world units */
+		static constexpr float DefaultCellSize = 32.0f;
+		/** @brief Default number of hash buckets, must be power of two */
+		static constexpr std::int32_t DefaultBucketCount = 4096;
+		/** @brief Maximum number of cells a proxy can span before it's treated as oversized */
+		static constexpr std::int32_t MaxCellsPerProxy = 64;
+
+		/** @brief Creates a new instance */
+		SpatialHashGrid(float cellSize = DefaultCellSize, std::int32_t bucketCount = DefaultBucketCount);
+		~SpatialHashGrid() override;
+
+		std::int32_t CreateProxy(const AABBf& aabb, void* userData) override;
+		void DestroyProxy(std::int32_t proxyId) override;
+		void MoveProxy(std::int32_t proxyId, const AABBf& aabb, Vector2f displacement) override;
+		void TouchProxy(std::int32_t proxyId) override;
+		void* GetUserData(std::int32_t proxyId) const override;
+		std::int32_t GetProxyCount() const override;
+		void UpdatePairs(IPairCallback* callback) override;
+		void Query(IQueryCallback* callback, const AABBf& aabb) const override;
+
+		/** @brief Returns the AABB of a proxy */
+		const AABBf& GetAABB(std::int32_t proxyId) const;
+
+	private:
+		struct CellRange {
+			std::int32_t MinX, MinY, MaxX, MaxY;
+
+			bool operator==(const CellRange& other) const {
+				return (MinX == other.MinX && MinY == other.MinY && MaxX == other.MaxX && MaxY == other.MaxY);
+			}
+			bool operator!=(const CellRange& other) const {
+				return !operator==(other);
+			}
+		};
+
+		struct Proxy {
+			AABBf Aabb;
+			void* UserData;
+			CellRange Cells;
+			std::int32_t NextFree;
+			mutable std::uint32_t QueryStamp;
+			bool Moved;
+			bool Oversized;
+		};
+
+		float _invCellSize;
+		std::uint32_t _bucketMask;
+		SmallVector<SmallVector<std::int32_t, 4>, 0> _buckets;
+		SmallVector<std::int32_t, 0> _oversized;
+		SmallVector<Proxy, 0> _proxies;
+		std::int32_t _freeList;
+		std::int32_t _proxyCount;
+		SmallVector<std::int32_t, 0> _moveBuffer;
+		SmallVector<CollisionPair, 0> _pairBuffer;
+		mutable std::uint32_t _queryStamp;
+
+		CellRange GetCellRange(const AABBf& aabb) const;
+		std::uint32_t GetBucketIndex(std::int32_t x, std::int32_t y) const;
+		void InsertToCells(std::int32_t proxyId);
+		void RemoveFromCells(std::int32_t proxyId);
+		std::uint32_t NextQueryStamp() const;
+
+		template<typename Func>
+		void ForEachCandidate(const CellRange& cells, Func&& func) const;
+	};
+
+	inline void* SpatialHashGrid::GetUserData(std::int32_t proxyId) const
+	{
+		return _proxies[proxyId].UserData;
+	}
+
+	inline const AABBf& SpatialHashGrid::GetAABB(std::int32_t proxyId) const
+	{
+		return _proxies[proxyId].Aabb;
+	}
+
+	inline std::int32_t SpatialHashGrid::GetProxyCount() const
+	{
+		return _proxyCount;
+	}
+}
@@ -0,0 +1,353 @@
+// Replays actor AABB operations through every broad-phase implementation and compares their time and results
+// Built with -DNCINE_BUILD_BENCHMARKS=ON, usage: BroadPhaseBenchmark [--load <stream>] [--save <stream>] [--frames <count>] [--actors <count>]
+
+#include "Jazz2/Collisions/IBroadPhase.h"
+#include "Jazz2/Collisions/DynamicTreeBroadPhase.h"
+#include "Jazz2/Collisions/SpatialHashGrid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+using namespace Jazz2::Collisions;
+
+namespace
+{
+	// ---- Stream of recorded operations ----
+
+	enum class OpType : std::uint8_t {
+		Create,
+		Move,
+		Destroy,
+		Query,
+		UpdatePairs
+	};
+
+	struct Op {
+		OpType Type;
+		std::int32_t Actor;
+		float L, T, R, B;
+		float Dx, Dy;
+	};
+
+	struct Stream {
+		std::vector<Op> Ops;
+		std::int32_t FrameCount = 0;
+		std::int32_t MaxActors = 0;
+	};
+
+	constexpr std::uint32_t StreamSignature = 0x53504842;	// "BHPS"
+
+	bool SaveStream(const char* path, const Stream& stream)
+	{
+		std::ofstream file(path, std::ios::binary);
+		if (!file) {
+			return false;
+		}
+		std::uint32_t opCount = std::uint32_t(stream.Ops.size());
+		file.write(reinterpret_cast<const char*>(&StreamSignature), sizeof(StreamSignature));
+		file.write(reinterpret_cast<const char*>(&stream.FrameCount), sizeof(stream.FrameCount));
+		file.write(reinterpret_cast<const char*>(&stream.MaxActors), sizeof(stream.MaxActors));
+		file.write(reinterpret_cast<const char*>(&opCount), sizeof(opCount));
+		file.write(reinterpret_cast<const char*>(stream.Ops.data()), std::streamsize(opCount * sizeof(Op)));
+		return bool(file);
+	}
+
+	bool LoadStream(const char* path, Stream& stream)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			return false;
+		}
+		std::uint32_t signature = 0, opCount = 0;
+		file.read(reinterpret_cast<char*>(&signature), sizeof(signature));
+		file.read(reinterpret_cast<char*>(&stream.FrameCount), sizeof(stream.FrameCount));
+		file.read(reinterpret_cast<char*>(&stream.MaxActors), sizeof(stream.MaxActors));
+		file.read(reinterpret_cast<char*>(&opCount), sizeof(opCount));
+		if (!file || signature != StreamSignature) {
+			return false;
+		}
+		stream.Ops.resize(opCount);
+		file.read(reinterpret_cast<char*>(stream.Ops.data()), std::streamsize(opCount * sizeof(Op)));
+		return bool(file);
+	}
+
+	// ---- Synthetic stream resembling a busy level ----
+
+	struct Xorshift {
+		std::uint32_t State;
+
+		std::uint32_t Next() {
+			State ^= State << 13;
+			State ^= State >> 17;
+			State ^= State << 5;
+			return State;
+		}
+		float NextFloat(float min, float max) {
+			return min + (max - min) * float(Next() & 0xFFFFFF) / float(0x1000000);
+		}
+	};
+
+	Stream SynthesizeStream(std::int32_t frameCount, std::int32_t actorCount)
+	{
+		// Level of 256x64 tiles, mostly static pickups and enemies, some of them walking, and short-lived projectiles
+		constexpr float LevelWidth = 256 * 32.0f, LevelHeight = 64 * 32.0f;
+
+		struct SimActor {
+			bool Alive;
+			bool Projectile;
+			float X, Y, W, H, Vx, Vy;
+			std::int32_t Life;
+		};
+
+		Xorshift random{0x2545F491};
+		Stream stream;
+		std::vector<SimActor> actors;
+		std::vector<std::int32_t> freeSlots;
+
+		auto spawn = [&](bool projectile, float x, float y) {
+			std::int32_t id;
+			if (!freeSlots.empty()) {
+				id = freeSlots.back();
+				freeSlots.pop_back();
+			} else {
+				id = std::int32_t(actors.size());
+				actors.emplace_back();
+			}
+			SimActor& a = actors[id];
+			a.Alive = true;
+			a.Projectile = projectile;
+			a.X = x; a.Y = y;
+			a.W = (projectile ? 8.0f : random.NextFloat(16.0f, 48.0f));
+			a.H = (projectile ? 6.0f : random.NextFloat(16.0f, 48.0f));
+			a.Vx = (projectile ? (random.Next() & 1 ? 8.0f : -8.0f) : ((random.Next() & 3) == 0 ? random.NextFloat(-2.0f, 2.0f) : 0.0f));
+			a.Vy = (projectile ? random.NextFloat(-0.5f, 0.5f) : 0.0f);
+			a.Life = (projectile ? 40 + std::int32_t(random.Next() % 40) : -1);
+			stream.Ops.push_back({ OpType::Create, id, a.X - a.W * 0.5f, a.Y - a.H * 0.5f, a.X + a.W * 0.5f, a.Y + a.H * 0.5f, 0.0f, 0.0f });
+			stream.MaxActors = std::max(stream.MaxActors, std::int32_t(actors.size()));
+		};
+
+		for (std::int32_t i = 0; i < actorCount; i++) {
+			spawn(false, random.NextFloat(0.0f, LevelWidth), random.NextFloat(0.0f, LevelHeight));
+		}
+
+		for (std::int32_t frame = 0; frame < frameCount; frame++) {
+			// A few players firing every frame
+			for (std::int32_t p = 0; p < 4; p++) {
+				if (random.Next() % 3 == 0) {
+					spawn(true, random.NextFloat(0.0f, LevelWidth), random.NextFloat(0.0f, LevelHeight));
+				}
+			}
+
+			for (std::int32_t id = 0; id < std::int32_t(actors.size()); id++) {
+				SimActor& a = actors[id];
+				if (!a.Alive) {
+					continue;
+				}
+				if (a.Life >= 0 && --a.Life < 0) {
+					a.Alive = false;
+					freeSlots.push_back(id);
+					stream.Ops.push_back({ OpType::Destroy, id, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f });
+					continue;
+				}
+				if (a.Vx != 0.0f || a.Vy != 0.0f) {
+					a.X += a.Vx; a.Y += a.Vy;
+					if (a.X < 0.0f || a.X > LevelWidth) {
+						a.Vx = -a.Vx;
+					}
+					stream.Ops.push_back({ OpType::Move, id, a.X - a.W * 0.5f, a.Y - a.H * 0.5f, a.X + a.W * 0.5f, a.Y + a.H * 0.5f, a.Vx, a.Vy });
+				}
+			}
+
+			// Enemies looking for targets and explosions
+			for (std::int32_t q = 0; q < 64; q++) {
+				float x = random.NextFloat(0.0f, LevelWidth), y = random.NextFloat(0.0f, LevelHeight);
+				float r = ((q & 7) == 0 ? 160.0f : 24.0f);
+				stream.Ops.push_back({ OpType::Query, -1, x - r, y - r, x + r, y + r, 0.0f, 0.0f });
+			}
+
+			stream.Ops.push_back({ OpType::UpdatePairs, -1, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f });
+			stream.FrameCount++;
+		}
+
+		return stream;
+	}
+
+	// ---- Replay ----
+
+	struct ReplayResult {
+		double TotalMs = 0.0;
+		double WorstFrameMs = 0.0;
+		std::uint64_t PairChecksum = 0;
+		std::uint64_t QueryChecksum = 0;
+		std::uint64_t PairCount = 0;
+		std::uint64_t QueryHitCount = 0;
+	};
+
+	struct ActorData {
+		std::int32_t Index;
+		std::int32_t ProxyId;
+		AABBf Aabb;
+	};
+
+	struct PairCallback : IBroadPhase::IPairCallback {
+		ReplayResult* Result;
+
+		void OnPairAdded(void* userDataA, void* userDataB) override {
+			// Mimic the narrow-phase, so implementations with different fat AABBs produce the same result
+			auto* a = static_cast<ActorData*>(userDataA);
+			auto* b = static_cast<ActorData*>(userDataB);
+			if (a->Aabb.Overlaps(b->Aabb)) {
+				std::uint64_t lo = std::uint64_t(std::min(a->Index, b->Index)), hi = std::uint64_t(std::max(a->Index, b->Index));
+				// Order-independent checksum
+				Result->PairChecksum += (lo * 0x9E3779B97F4A7C15ull) ^ (hi * 0xC2B2AE3D27D4EB4Full);
+				Result->PairCount++;
+			}
+		}
+	};
+
+	struct QueryCallback : IBroadPhase::IQueryCallback {
+		const IBroadPhase* BroadPhase;
+		const AABBf* Aabb;
+		ReplayResult* Result;
+
+		bool OnCollisionQuery(std::int32_t proxyId) override {
+			auto* actor = static_cast<ActorData*>(BroadPhase->GetUserData(proxyId));
+			if (actor->Aabb.Overlaps(*Aabb)) {
+				Result->QueryChecksum += std::uint64_t(actor->Index + 1) * 0x9E3779B97F4A7C15ull;
+				Result->QueryHitCount++;
+			}
+			return true;
+		}
+	};
+
+	ReplayResult Replay(IBroadPhase& broadPhase, const Stream& stream)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		ReplayResult result;
+		std::vector<ActorData> actors(std::size_t(stream.MaxActors));
+		for (std::int32_t i = 0; i < stream.MaxActors; i++) {
+			actors[i].Index = i;
+			actors[i].ProxyId = NullNode;
+		}
+
+		PairCallback pairCallback;
+		pairCallback.Result = &result;
+
+		auto frameStart = Clock::now();
+		for (const Op& op : stream.Ops) {
+			switch (op.Type) {
+				case OpType::Create: {
+					ActorData& actor = actors[op.Actor];
+					actor.Aabb = AABBf(op.L, op.T, op.R, op.B);
+					actor.ProxyId = broadPhase.CreateProxy(actor.Aabb, &actor);
+					break;
+				}
+				case OpType::Move: {
+					ActorData& actor = actors[op.Actor];
+					actor.Aabb = AABBf(op.L, op.T, op.R, op.B);
+					broadPhase.MoveProxy(actor.ProxyId, actor.Aabb, Vector2f(op.Dx, op.Dy));
+					break;
+				}
+				case OpType::Destroy: {
+					ActorData& actor = actors[op.Actor];
+					broadPhase.DestroyProxy(actor.ProxyId);
+					actor.ProxyId = NullNode;
+					break;
+				}
+				case OpType::Query: {
+					AABBf aabb(op.L, op.T, op.R, op.B);
+					QueryCallback queryCallback;
+					queryCallback.BroadPhase = &broadPhase;
+					queryCallback.Aabb = &aabb;
+					queryCallback.Result = &result;
+					broadPhase.Query(&queryCallback, aabb);
+					break;
+				}
+				case OpType::UpdatePairs: {
+					broadPhase.UpdatePairs(&pairCallback);
+					auto frameEnd = Clock::now();
+					double frameMs = std::chrono::duration<double, std::milli>(frameEnd - frameStart).count();
+					result.TotalMs += frameMs;
+					result.WorstFrameMs = std::max(result.WorstFrameMs, frameMs);
+					frameStart = frameEnd;
+					break;
+				}
+			}
+		}
+		return result;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const char* loadPath = nullptr;
+	const char* savePath = nullptr;
+	std::int32_t frameCount = 3000;
+	std::int32_t actorCount = 2000;
+
+	for (std::int32_t i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--load") == 0 && i + 1 < argc) {
+			loadPath = argv[++i];
+		} else if (std::strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+			savePath = argv[++i];
+		} else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			frameCount = std::atoi(argv[++i]);
+		} else if (std::strcmp(argv[i], "--actors") == 0 && i + 1 < argc) {
+			actorCount = std::atoi(argv[++i]);
+		}
+	}
+
+	Stream stream;
+	if (loadPath != nullptr) {
+		if (!LoadStream(loadPath, stream)) {
+			std::printf("Cannot load stream from \"%s\"\n", loadPath);
+			return 1;
+		}
+	} else {
+		stream = SynthesizeStream(frameCount, actorCount);
+	}
+	if (savePath != nullptr && !SaveStream(savePath, stream)) {
+		std::printf("Cannot save stream to \"%s\"\n", savePath);
+		return 1;
+	}
+
+	std::printf("Broad-phase benchmark: %d frames, %zu operations, up to %d actors\n\n", stream.FrameCount, stream.Ops.size(), stream.MaxActors);
+
+	struct Candidate {
+		const char* Name;
+		BroadPhaseType Type;
+	};
+	const Candidate candidates[] = {
+		{ "DynamicTree", BroadPhaseType::DynamicTree },
+		{ "SpatialHashGrid", BroadPhaseType::SpatialHashGrid }
+	};
+
+	bool first = true, consistent = true;
+	ReplayResult reference;
+	for (const Candidate& candidate : candidates) {
+		std::unique_ptr<IBroadPhase> broadPhase = IBroadPhase::Create(candidate.Type);
+		ReplayResult result = Replay(*broadPhase, stream);
+		std::printf("%-16s total %9.2f ms, %7.4f ms/frame, worst frame %7.4f ms, %llu pairs, %llu query hits\n", candidate.Name,
+			result.TotalMs, result.TotalMs / std::max(stream.FrameCount, 1), result.WorstFrameMs,
+			(unsigned long long)result.PairCount, (unsigned long long)result.QueryHitCount);
+
+		if (first) {
+			reference = result;
+			first = false;
+		} else if (result.PairChecksum != reference.PairChecksum || result.QueryChecksum != reference.QueryChecksum ||
+				   result.PairCount != reference.PairCount || result.QueryHitCount != reference.QueryHitCount) {
+			std::printf("  -> results differ from %s\n", candidates[0].Name);
+			consistent = false;
+		}
+	}
+
+	std::printf("\nResults are %s\n", consistent ? "consistent" : "INCONSISTENT");
+	return (consistent ? 0 : 1);
+}
@@ -6,6 +6,7 @@
 #include "JJ2Level.h"
 #include "JJ2Strings.h"
 #include "JJ2Tileset.h"
+#include "ParallelConversion.h"
 
 #include <Containers/GrowableArray.h>
 #include <Containers/StringConcatenable.h>
@@ -26,6 +27,9 @@ namespace Jazz2::Compatibility
 			`hh24` has no levels in the table of known ones below, which is exactly why the filter follows each
 			episode's chain instead of trusting that table to be complete.
 		*/
+		/** @brief Maximum number of converted levels or tilesets waiting to be completed in order */
+		constexpr std::int32_t MaxPendingFiles = 16;
+
 		static const StringView OriginalEpisodes[] = {
 			"prince"_s, "rescue"_s, "flash"_s, "monk"_s, "share"_s,
 			"xmas98"_s, "xmas99"_s, "secretf"_s, "hh17"_s, "hh18"_s, "hh24"_s
@@ -326,6 +330,10 @@ namespace Jazz2::Compatibility
 	}
 
 	HashMap<String, bool> usedTilesets, usedMusic;
+	SmallVector<String, 0> levelsToConvert;
+	// Output file is named by the lowercased level name only, so levels whose names differ only in case
+	// would be written to the same file by two workers at once
+	HashMap<String, String> queuedLevels;
 
 	// What the filter allows through is decided up front, because it depends on the directory as a whole:
 	// which levels each episode can reach can only be answered once every level's file is known
@@ -448,46 +456,13 @@ namespace Jazz2::Compatibility
 					}
 				}
 
-				Compatibility::JJ2Level level;
-				if (level.Open(item, false)) {
-					String fullPath;
-					auto it = knownLevels.find(level.LevelName);
-					if (it != knownLevels.end()) {
-						if (it->second.second().empty()) {
-							fullPath = fs::CombinePath({ episodesPath, it->second.first(), String(level.LevelName + ".j2l"_s) });
-						} else {
-							fullPath = fs::CombinePath({ episodesPath, it->second.first(), String(it->second.second() + '_' + level.LevelName + ".j2l"_s) });
-						}
-					} else {
-						fullPath = fs::CombinePath({ episodesPath, "unknown"_s, String(level.LevelName + ".j2l"_s) });
-					}
-
-					fs::CreateDirectories(fs::GetDirectoryName(fullPath));
-					level.Convert(fullPath, eventConverter, LevelTokenConversion);
-
-					usedTilesets.emplace(level.Tileset, true);
-					for (auto& extraTileset : level.ExtraTilesets) {
-						usedTilesets.emplace(extraTileset.Name, true);
-					}
-					if (!level.Music.empty()) {
-						// Recorded exactly as the converted level will ask for it: the original data leaves the
-						// extension off its own music, and JJ2Level::Convert fills in ".j2b" (see there)
-						String music = StringUtils::lowercase(level.Music);
-						if (music.find('.') == nullptr) {
-							music += ".j2b"_s;
-						}
-						usedMusic.emplace(std::move(music), true);
-					}
-
-					// Also copy level script file if exists
-					StringView foundDot = item.findLastOr('.', item.end());
-					String scriptPath = item.prefix(foundDot.begin()) + ".j2as"_s;
-					auto adjustedPath = fs::FindPathCaseInsensitive(scriptPath);
-					if (fs::IsReadableFile(adjustedPath)) {
-						foundDot = fullPath.findLastOr('.', fullPath.end());
-						fs::Copy(adjustedPath, String(fullPath.prefix(foundDot.begin()) + ".j2as"_s));
-					}
+				auto queued = queuedLevels.emplace(NormalizeLevelToken(item), item);
+				if (!queued.second) {
+					LOGW("Level \"{}\" would be converted to the same file as \"{}\", skipping", item, queued.first->second);
+					continue;
 				}
+
+				levelsToConvert.emplace_back(item);
 			}
 		}
 #if defined(DEATH_DEBUG)
@@ -503,6 +478,74 @@ namespace Jazz2::Compatibility
 #endif
 	}
 
+	// Levels don't depend on each other, so they are converted on worker threads - only what they reference
+	// is collected afterwards, in the order they were found, so the result doesn't depend on the scheduling
+	struct ConvertedLevel {
+		bool Converted = false;
+		String Tileset;
+		SmallVector<String, 0> ExtraTilesets;
+		String Music;
+	};
+
+	std::int32_t levelCount = (std::int32_t)levelsToConvert.size();
+	ConvertInParallel<ConvertedLevel>(levelCount, MaxPendingFiles, [&](std::int32_t index) {
+		ConvertedLevel result;
+		StringView item = levelsToConvert[index];
+		Compatibility::JJ2Level level;
+		if (level.Open(item, false)) {
+			String fullPath;
+			auto it = knownLevels.find(level.LevelName);
+			if (it != knownLevels.end()) {
+				if (it->second.second().empty()) {
+					fullPath = fs::CombinePath({ episodesPath, it->second.first(), String(level.LevelName + ".j2l"_s) });
+				} else {
+					fullPath = fs::CombinePath({ episodesPath, it->second.first(), String(it->second.second() + '_' + level.LevelName + ".j2l"_s) });
+				}
+			} else {
+				fullPath = fs::CombinePath({ episodesPath, "unknown"_s, String(level.LevelName + ".j2l"_s) });
+			}
+
+			fs::CreateDirectories(fs::GetDirectoryName(fullPath));
+			level.Convert(fullPath, eventConverter, LevelTokenConversion);
+
+			result.Converted = true;
+			result.Tileset = level.Tileset;
+			for (auto& extraTileset : level.ExtraTilesets) {
+				result.ExtraTilesets.push_back(extraTileset.Name);
+			}
+			if (!level.Music.empty()) {
+				// Recorded exactly as the converted level will ask for it: the original data leaves the
+				// extension off its own music, and JJ2Level::Convert fills in ".j2b" (see there)
+				result.Music = StringUtils::lowercase(level.Music);
+				if (result.Music.find('.') == nullptr) {
+					result.Music += ".j2b"_s;
+				}
+			}
+
+			// Also copy level script file if exists
+			StringView foundDot = item.findLastOr('.', item.end());
+			String scriptPath = item.prefix(foundDot.begin()) + ".j2as"_s;
+			auto adjustedPath = fs::FindPathCaseInsensitive(scriptPath);
+			if (fs::IsReadableFile(adjustedPath)) {
+				foundDot = fullPath.findLastOr('.', fullPath.end());
+				fs::Copy(adjustedPath, String(fullPath.prefix(foundDot.begin()) + ".j2as"_s));
+			}
+		}
+		return result;
+	}, [&](std::int32_t index, ConvertedLevel& result) {
+		if (!result.Converted) {
+			return;
+		}
+		LOGD("[{}/{}] Converted level \"{}\"", index + 1, levelCount, levelsToConvert[index]);
+		usedTilesets.emplace(std::move(result.Tileset), true);
+		for (auto& extraTileset : result.ExtraTilesets) {
+			usedTilesets.emplace(std::move(extraTileset), true);
+		}
+		if (!result.Music.empty()) {
+			usedMusic.emplace(std::move(result.Music), true);
+		}
+	});
+
 	if (options.CopyUsedMusic && !usedMusic.empty()) {
 		// The music is not converted, only carried over - but only what the levels that survived the filter
 		// ask for, the same way the tilesets are. The game looks for it in a "Music" directory of its own,
@@ -536,16 +579,30 @@ namespace Jazz2::Compatibility
 			fs::CreateDirectories(tilesetsPath);
 		}
 
+		SmallVector<StringView, 0> tilesetsToConvert;
+		tilesetsToConvert.reserve(usedTilesets.size());
 		for (auto& pair : usedTilesets) {
-			String tilesetPath = fs::CombinePath(sourcePath, String(pair.first + ".j2t"_s));
+			tilesetsToConvert.push_back(pair.first);
+		}
+
+		std::int32_t tilesetCount = (std::int32_t)tilesetsToConvert.size();
+		ConvertInParallel<bool>(tilesetCount, MaxPendingFiles, [&](std::int32_t index) {
+			StringView name = tilesetsToConvert[index];
+			String tilesetPath = fs::CombinePath(sourcePath, String(name + ".j2t"_s));
 			auto adjustedPath = fs::FindPathCaseInsensitive(tilesetPath);
 			if (fs::IsReadableFile(adjustedPath)) {
 				Compatibility::JJ2Tileset tileset;
 				if (tileset.Open(adjustedPath, false)) {
-					tileset.Convert(fs::CombinePath({ tilesetsPath, String(pair.first + ".j2t"_s) }));
+					tileset.Convert(fs::CombinePath({ tilesetsPath, String(name + ".j2t"_s) }));
+					return true;
 				}
 			}
-		}
+			return false;
+		}, [&](std::int32_t index, bool converted) {
+			if (converted) {
+				LOGD("[{}/{}] Converted tileset \"{}\"", index + 1, tilesetCount, tilesetsToConvert[index]);
+			}
+		});
 	}
 	}
 }
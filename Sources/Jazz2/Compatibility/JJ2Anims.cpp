@@ -2,11 +2,13 @@
 #include "JJ2Anims.Palettes.h"
 #include "JJ2Block.h"
 #include "AnimSetMapping.h"
+#include "ParallelConversion.h"
 
 #include <algorithm>
 #include <cstdlib>
 
 #include <Containers/GrowableArray.h>
+#include <Containers/Pair.h>
 #include <Containers/StringConcatenable.h>
 #include <IO/FileSystem.h>
 #include <IO/FileStream.h>
@@ -22,6 +24,9 @@ namespace Jazz2::Compatibility
 		// so a sheet that fits here needs no per-platform variant of the converted assets.
 		constexpr std::int32_t MaxTextureSize = 1024;
 
+		// Number of unpacked sets or encoded sprite sheets that can wait to be written at the same time
+		constexpr std::int32_t MaxPendingJobs = 32;
+
 		std::int32_t NextPowerOfTwo(std::int32_t value)
 		{
 			std::int32_t result = 1;
@@ -171,8 +176,10 @@ namespace Jazz2::Compatibility
 
 		DEATH_ASSERT(headerLen == s->GetPosition(), "Invalid header size", JJ2Version::Unknown);
 
-		// Read content
+		// Read content, every set is only read here and unpacked later, so the sets can be unpacked in parallel
 		bool isStreamComplete = true;
+		SmallVector<SetSection, 0> sets;
+		sets.reserve(setCount);
 
 		for (std::int32_t i = 0; i < setCount; i++) {
 			if (s->GetPosition() >= s->GetSize()) {
@@ -181,198 +188,53 @@ namespace Jazz2::Compatibility
 				break;
 			}
 
+			SetSection set;
+			set.Index = i;
 			std::uint32_t magicANIM = s->ReadValueAsLE<std::uint32_t>();
-			std::uint8_t animCount = s->ReadValue<std::uint8_t>();
-			std::uint8_t sndCount = s->ReadValue<std::uint8_t>();
+			set.AnimCount = s->ReadValue<std::uint8_t>();
+			set.SndCount = s->ReadValue<std::uint8_t>();
 			/*std::uint16_t frameCount =*/ s->ReadValueAsLE<std::uint16_t>();
 			/*std::uint32_t cumulativeSndIndex =*/ s->ReadValueAsLE<std::uint32_t>();
-			std::int32_t infoBlockLenC = s->ReadValueAsLE<std::int32_t>();
-			std::int32_t infoBlockLenU = s->ReadValueAsLE<std::int32_t>();
-			std::int32_t frameDataBlockLenC = s->ReadValueAsLE<std::int32_t>();
-			std::int32_t frameDataBlockLenU = s->ReadValueAsLE<std::int32_t>();
-			std::int32_t imageDataBlockLenC = s->ReadValueAsLE<std::int32_t>();
-			std::int32_t imageDataBlockLenU = s->ReadValueAsLE<std::int32_t>();
-			std::int32_t sampleDataBlockLenC = s->ReadValueAsLE<std::int32_t>();
-			std::int32_t sampleDataBlockLenU = s->ReadValueAsLE<std::int32_t>();
-
-			JJ2Block infoBlock(s, infoBlockLenC, infoBlockLenU);
-			JJ2Block frameDataBlock(s, frameDataBlockLenC, frameDataBlockLenU);
-			JJ2Block imageDataBlock(s, imageDataBlockLenC, imageDataBlockLenU);
-			JJ2Block sampleDataBlock(s, sampleDataBlockLenC, sampleDataBlockLenU);
+			// Compressed and uncompressed length of info, frame data, image data and sample data blocks
+			for (std::int32_t j = 0; j < 8; j++) {
+				set.BlockLengths[j] = s->ReadValueAsLE<std::int32_t>();
+			}
+
+			set.DataSize = set.BlockLengths[0] + set.BlockLengths[2] + set.BlockLengths[4] + set.BlockLengths[6];
+			set.Data = std::make_unique<std::uint8_t[]>(set.DataSize);
+			s->Read(set.Data.get(), set.DataSize);
 
 			if (magicANIM != 0x4D494E41) {
 				LOGD("Header for set {} is incorrect (bad magic value), skipping", i);
 				continue;
 			}
 
-			for (std::uint16_t j = 0; j < animCount; j++) {
-				AnimSection& anim = anims.emplace_back();
-				anim.Set = i;
-				anim.Anim = j;
-				anim.FrameCount = infoBlock.ReadUInt16();
-				anim.FrameRate = infoBlock.ReadUInt16();
-				anim.Frames.resize(anim.FrameCount);
-
-				// Skip the rest, seems to be 0x00000000 for all headers
-				infoBlock.DiscardBytes(4);
-
-				if (anim.FrameCount > 0) {
-					for (std::uint16_t k = 0; k < anim.FrameCount; k++) {
-						AnimFrameSection& frame = anim.Frames[k];
-
-						frame.SizeX = frameDataBlock.ReadInt16();
-						frame.SizeY = frameDataBlock.ReadInt16();
-						frame.ColdspotX = frameDataBlock.ReadInt16();
-						frame.ColdspotY = frameDataBlock.ReadInt16();
-						frame.HotspotX = frameDataBlock.ReadInt16();
-						frame.HotspotY = frameDataBlock.ReadInt16();
-						frame.GunspotX = frameDataBlock.ReadInt16();
-						frame.GunspotY = frameDataBlock.ReadInt16();
-
-						frame.ImageAddr = frameDataBlock.ReadInt32();
-						frame.MaskAddr = frameDataBlock.ReadInt32();
-
-						// Adjust normalized position
-						// In the output images, we want to make the hotspot and image size constant.
-						anim.NormalizedHotspotX = std::max((std::int16_t)-frame.HotspotX, anim.NormalizedHotspotX);
-						anim.NormalizedHotspotY = std::max((std::int16_t)-frame.HotspotY, anim.NormalizedHotspotY);
-
-						anim.LargestOffsetX = std::max((std::int16_t)(frame.SizeX + frame.HotspotX), anim.LargestOffsetX);
-						anim.LargestOffsetY = std::max((std::int16_t)(frame.SizeY + frame.HotspotY), anim.LargestOffsetY);
-
-						anim.AdjustedSizeX = std::max(
-							(std::int16_t)(anim.NormalizedHotspotX + anim.LargestOffsetX),
-							anim.AdjustedSizeX
-						);
-						anim.AdjustedSizeY = std::max(
-							(std::int16_t)(anim.NormalizedHotspotY + anim.LargestOffsetY),
-							anim.AdjustedSizeY
-						);
-
-						std::int32_t dpos = (frame.ImageAddr + 4);
-
-						imageDataBlock.SeekTo(dpos - 4);
-						std::uint16_t width2 = imageDataBlock.ReadUInt16();
-						imageDataBlock.SeekTo(dpos - 2);
-						/*std::uint16_t height2 =*/ imageDataBlock.ReadUInt16();
-
-						frame.DrawTransparent = (width2 & 0x8000) > 0;
-
-						std::int32_t pxRead = 0;
-						std::int32_t pxTotal = (frame.SizeX * frame.SizeY);
-						bool lastOpEmpty = true;
-
-						frame.ImageData = std::make_unique<std::uint8_t[]>(pxTotal);
-
-						imageDataBlock.SeekTo(dpos);
-
-						while (pxRead < pxTotal) {
-							std::uint8_t op = imageDataBlock.ReadByte();
-							if (op < 0x80) {
-								// Skip the given number of pixels, writing them with the transparent color 0, array should be already zeroed
-								pxRead += op;
-							} else if (op == 0x80) {
-								// Skip until the end of the line, array should be already zeroed
-								std::uint16_t linePxLeft = (std::uint16_t)(frame.SizeX - pxRead % frame.SizeX);
-								if (pxRead % frame.SizeX == 0 && !lastOpEmpty) {
-									linePxLeft = 0;
-								}
-
-								pxRead += linePxLeft;
-							} else {
-								// Copy specified amount of pixels (ignoring the high bit)
-								std::uint16_t bytesToRead = (std::uint16_t)(op & 0x7F);
-								imageDataBlock.ReadRawBytes(frame.ImageData.get() + pxRead, bytesToRead);
-								pxRead += bytesToRead;
-							}
-
-							lastOpEmpty = (op == 0x80);
-						}
-
-						// TODO: Sprite mask
-						/*frame.MaskData = std::make_unique<std::uint8_t[]>(pxTotal);
-
-						if (frame.MaskAddr != 0xFFFFFFFF) {
-							imageDataBlock.SeekTo(frame.MaskAddr);
-							pxRead = 0;
-							while (pxRead < pxTotal) {
-								std::uint8_t b = imageDataBlock.ReadByte();
-								for (std::uint8_t bit = 0; bit < 8 && (pxRead + bit) < pxTotal; ++bit) {
-									frame.MaskData[pxRead + bit] = ((b & (1 << (7 - bit))) != 0);
-								}
-								pxRead += 8;
-							}
-						}*/
-					}
-				}
-			}
-
-			if (i == 65 && animCount > 5) {
+			if (i == 65 && set.AnimCount > 5) {
 				seemsLikeCC = true;
 			}
 
-			for (std::uint16_t j = 0; j < sndCount; j++) {
-				SampleSection& sample = samples.emplace_back();
-				sample.IdInSet = j;
-				sample.Set = i;
-
-				std::int32_t totalSize = sampleDataBlock.ReadInt32();
-				std::uint32_t magicRIFF = sampleDataBlock.ReadUInt32();
-				std::int32_t chunkSize = sampleDataBlock.ReadInt32();
-				// "ASFF" for 1.20, "AS  " for 1.24
-				std::uint32_t format = sampleDataBlock.ReadUInt32();
-				DEATH_ASSERT(format == 0x46465341 || format == 0x20205341, "Invalid sound format", JJ2Version::Unknown);
-				bool isASFF = (format == 0x46465341);
-
-				std::uint32_t magicSAMP = sampleDataBlock.ReadUInt32();
-				/*std::uint32_t sampSize =*/ sampleDataBlock.ReadUInt32();
-				DEATH_ASSERT(magicRIFF == 0x46464952 && magicSAMP == 0x504D4153, "Invalid sound format", JJ2Version::Unknown);
-
-				// Padding/unknown data #1
-				// For set 0 sample 0:
-				//       1.20                           1.24
-				//  +00  00 00 00 00 00 00 00 00   +00  40 00 00 00 00 00 00 00
-				//  +08  00 00 00 00 00 00 00 00   +08  00 00 00 00 00 00 00 00
-				//  +10  00 00 00 00 00 00 00 00   +10  00 00 00 00 00 00 00 00
-				//  +18  00 00 00 00               +18  00 00 00 00 00 00 00 00
-				//                                 +20  00 00 00 00 00 40 FF 7F
-				sampleDataBlock.DiscardBytes(40 - (isASFF ? 12 : 0));
-				if (isASFF) {
-					// All 1.20 samples seem to be 8-bit. Some of them are among those
-					// for which 1.24 reads as 24-bit but that might just be a mistake.
-					sampleDataBlock.DiscardBytes(2);
-					sample.Multiplier = 0;
-				} else {
-					// for 1.24. 1.20 has "20 40" instead in s0s0 which makes no sense
-					sample.Multiplier = sampleDataBlock.ReadUInt16();
-				}
-				// Unknown. s0s0 1.20: 00 80, 1.24: 80 00
-				sampleDataBlock.DiscardBytes(2);
-
-				/*uint32_t payloadSize =*/ sampleDataBlock.ReadUInt32();
-				// Padding #2, all zeroes in both
-				sampleDataBlock.DiscardBytes(8);
-
-				sample.SampleRate = sampleDataBlock.ReadUInt32();
-				sample.DataSize = chunkSize - 76 + (isASFF ? 12 : 0);
-
-				sample.Data = std::make_unique<std::uint8_t[]>(sample.DataSize);
-				sampleDataBlock.ReadRawBytes(sample.Data.get(), sample.DataSize);
-				// Padding #3
-				sampleDataBlock.DiscardBytes(4);
-
-				/*if (sample.Data.Length < actualDataSize) {
-					Log.Write(LogType.Warning, "Sample " + j + " in set " + i + " was shorter than expected! Expected "
-						+ actualDataSize + " bytes, but read " + sample.Data.Length + " instead.");
-				}*/
-
-				if (totalSize > chunkSize + 12) {
-					// Sample data is probably aligned to X bytes since the next sample doesn't always appear right after the first ends.
-					LOGW("Adjusting read offset of sample {} in set {} by {} bytes.", j, i, (totalSize - chunkSize - 12));
+			sets.push_back(std::move(set));
+		}
 
-					sampleDataBlock.DiscardBytes(totalSize - chunkSize - 12);
-				}
+		// Sets are appended in the original order, no matter which of them was unpacked first
+		bool allSetsValid = true;
+		ConvertInParallel<UnpackedSet>((std::int32_t)sets.size(), MaxPendingJobs, [&sets](std::int32_t index) {
+			UnpackedSet result;
+			result.IsValid = UnpackSet(sets[index], result.Anims, result.Samples);
+			return result;
+		}, [&sets, &anims, &samples, &allSetsValid](std::int32_t index, UnpackedSet& result) {
+			sets[index].Data = nullptr;
+			allSetsValid &= result.IsValid;
+			for (auto& anim : result.Anims) {
+				anims.push_back(std::move(anim));
+			}
+			for (auto& sample : result.Samples) {
+				samples.push_back(std::move(sample));
 			}
+		});
+
+		if (!allSetsValid) {
+			return JJ2Version::Unknown;
 		}
 
 		// Detect version to import
@@ -417,6 +279,182 @@ namespace Jazz2::Compatibility
 		return version;
 	}
 
+	bool JJ2Anims::UnpackSet(const SetSection& set, SmallVectorImpl<AnimSection>& anims, SmallVectorImpl<SampleSection>& samples)
+	{
+		std::unique_ptr<Stream> s = std::make_unique<MemoryStream>(set.Data.get(), set.DataSize);
+		JJ2Block infoBlock(s, set.BlockLengths[0], set.BlockLengths[1]);
+		JJ2Block frameDataBlock(s, set.BlockLengths[2], set.BlockLengths[3]);
+		JJ2Block imageDataBlock(s, set.BlockLengths[4], set.BlockLengths[5]);
+		JJ2Block sampleDataBlock(s, set.BlockLengths[6], set.BlockLengths[7]);
+
+		for (std::uint16_t j = 0; j < set.AnimCount; j++) {
+			AnimSection& anim = anims.emplace_back();
+			anim.Set = set.Index;
+			anim.Anim = j;
+			anim.FrameCount = infoBlock.ReadUInt16();
+			anim.FrameRate = infoBlock.ReadUInt16();
+			anim.Frames.resize(anim.FrameCount);
+
+			// Skip the rest, seems to be 0x00000000 for all headers
+			infoBlock.DiscardBytes(4);
+
+			if (anim.FrameCount > 0) {
+				for (std::uint16_t k = 0; k < anim.FrameCount; k++) {
+					AnimFrameSection& frame = anim.Frames[k];
+
+					frame.SizeX = frameDataBlock.ReadInt16();
+					frame.SizeY = frameDataBlock.ReadInt16();
+					frame.ColdspotX = frameDataBlock.ReadInt16();
+					frame.ColdspotY = frameDataBlock.ReadInt16();
+					frame.HotspotX = frameDataBlock.ReadInt16();
+					frame.HotspotY = frameDataBlock.ReadInt16();
+					frame.GunspotX = frameDataBlock.ReadInt16();
+					frame.GunspotY = frameDataBlock.ReadInt16();
+
+					frame.ImageAddr = frameDataBlock.ReadInt32();
+					frame.MaskAddr = frameDataBlock.ReadInt32();
+
+					// Adjust normalized position
+					// In the output images, we want to make the hotspot and image size constant.
+					anim.NormalizedHotspotX = std::max((std::int16_t)-frame.HotspotX, anim.NormalizedHotspotX);
+					anim.NormalizedHotspotY = std::max((std::int16_t)-frame.HotspotY, anim.NormalizedHotspotY);
+
+					anim.LargestOffsetX = std::max((std::int16_t)(frame.SizeX + frame.HotspotX), anim.LargestOffsetX);
+					anim.LargestOffsetY = std::max((std::int16_t)(frame.SizeY + frame.HotspotY), anim.LargestOffsetY);
+
+					anim.AdjustedSizeX = std::max(
+						(std::int16_t)(anim.NormalizedHotspotX + anim.LargestOffsetX),
+						anim.AdjustedSizeX
+					);
+					anim.AdjustedSizeY = std::max(
+						(std::int16_t)(anim.NormalizedHotspotY + anim.LargestOffsetY),
+						anim.AdjustedSizeY
+					);
+
+					std::int32_t dpos = (frame.ImageAddr + 4);
+
+					imageDataBlock.SeekTo(dpos - 4);
+					std::uint16_t width2 = imageDataBlock.ReadUInt16();
+					imageDataBlock.SeekTo(dpos - 2);
+					/*std::uint16_t height2 =*/ imageDataBlock.ReadUInt16();
+
+					frame.DrawTransparent = (width2 & 0x8000) > 0;
+
+					std::int32_t pxRead = 0;
+					std::int32_t pxTotal = (frame.SizeX * frame.SizeY);
+					bool lastOpEmpty = true;
+
+					frame.ImageData = std::make_unique<std::uint8_t[]>(pxTotal);
+
+					imageDataBlock.SeekTo(dpos);
+
+					while (pxRead < pxTotal) {
+						std::uint8_t op = imageDataBlock.ReadByte();
+						if (op < 0x80) {
+							// Skip the given number of pixels, writing them with the transparent color 0, array should be already zeroed
+							pxRead += op;
+						} else if (op == 0x80) {
+							// Skip until the end of the line, array should be already zeroed
+							std::uint16_t linePxLeft = (std::uint16_t)(frame.SizeX - pxRead % frame.SizeX);
+							if (pxRead % frame.SizeX == 0 && !lastOpEmpty) {
+								linePxLeft = 0;
+							}
+
+							pxRead += linePxLeft;
+						} else {
+							// Copy specified amount of pixels (ignoring the high bit)
+							std::uint16_t bytesToRead = (std::uint16_t)(op & 0x7F);
+							imageDataBlock.ReadRawBytes(frame.ImageData.get() + pxRead, bytesToRead);
+							pxRead += bytesToRead;
+						}
+
+						lastOpEmpty = (op == 0x80);
+					}
+
+					// TODO: Sprite mask
+					/*frame.MaskData = std::make_unique<std::uint8_t[]>(pxTotal);
+
+					if (frame.MaskAddr != 0xFFFFFFFF) {
+						imageDataBlock.SeekTo(frame.MaskAddr);
+						pxRead = 0;
+						while (pxRead < pxTotal) {
+							std::uint8_t b = imageDataBlock.ReadByte();
+							for (std::uint8_t bit = 0; bit < 8 && (pxRead + bit) < pxTotal; ++bit) {
+								frame.MaskData[pxRead + bit] = ((b & (1 << (7 - bit))) != 0);
+							}
+							pxRead += 8;
+						}
+					}*/
+				}
+			}
+		}
+
+		for (std::uint16_t j = 0; j < set.SndCount; j++) {
+			SampleSection& sample = samples.emplace_back();
+			sample.IdInSet = j;
+			sample.Set = set.Index;
+
+			std::int32_t totalSize = sampleDataBlock.ReadInt32();
+			std::uint32_t magicRIFF = sampleDataBlock.ReadUInt32();
+			std::int32_t chunkSize = sampleDataBlock.ReadInt32();
+			// "ASFF" for 1.20, "AS  " for 1.24
+			std::uint32_t format = sampleDataBlock.ReadUInt32();
+			DEATH_ASSERT(format == 0x46465341 || format == 0x20205341, "Invalid sound format", false);
+			bool isASFF = (format == 0x46465341);
+
+			std::uint32_t magicSAMP = sampleDataBlock.ReadUInt32();
+			/*std::uint32_t sampSize =*/ sampleDataBlock.ReadUInt32();
+			DEATH_ASSERT(magicRIFF == 0x46464952 && magicSAMP == 0x504D4153, "Invalid sound format", false);
+
+			// Padding/unknown data #1
+			// For set 0 sample 0:
+			//       1.20                           1.24
+			//  +00  00 00 00 00 00 00 00 00   +00  40 00 00 00 00 00 00 00
+			//  +08  00 00 00 00 00 00 00 00   +08  00 00 00 00 00 00 00 00
+			//  +10  00 00 00 00 00 00 00 00   +10  00 00 00 00 00 00 00 00
+			//  +18  00 00 00 00               +18  00 00 00 00 00 00 00 00
+			//                                 +20  00 00 00 00 00 40 FF 7F
+			sampleDataBlock.DiscardBytes(40 - (isASFF ? 12 : 0));
+			if (isASFF) {
+				// All 1.20 samples seem to be 8-bit. Some of them are among those
+				// for which 1.24 reads as 24-bit but that might just be a mistake.
+				sampleDataBlock.DiscardBytes(2);
+				sample.Multiplier = 0;
+			} else {
+				// for 1.24. 1.20 has "20 40" instead in s0s0 which makes no sense
+				sample.Multiplier = sampleDataBlock.ReadUInt16();
+			}
+			// Unknown. s0s0 1.20: 00 80, 1.24: 80 00
+			sampleDataBlock.DiscardBytes(2);
+
+			/*uint32_t payloadSize =*/ sampleDataBlock.ReadUInt32();
+			// Padding #2, all zeroes in both
+			sampleDataBlock.DiscardBytes(8);
+
+			sample.SampleRate = sampleDataBlock.ReadUInt32();
+			sample.DataSize = chunkSize - 76 + (isASFF ? 12 : 0);
+
+			sample.Data = std::make_unique<std::uint8_t[]>(sample.DataSize);
+			sampleDataBlock.ReadRawBytes(sample.Data.get(), sample.DataSize);
+			// Padding #3
+			sampleDataBlock.DiscardBytes(4);
+
+			/*if (sample.Data.Length < actualDataSize) {
+				Log.Write(LogType.Warning, "Sample " + j + " in set " + i + " was shorter than expected! Expected "
+					+ actualDataSize + " bytes, but read " + sample.Data.Length + " instead.");
+			}*/
+
+			if (totalSize > chunkSize + 12) {
+				// Sample data is probably aligned to X bytes since the next sample doesn't always appear right after the first ends.
+				LOGW("Adjusting read offset of sample {} in set {} by {} bytes.", j, set.Index, (totalSize - chunkSize - 12));
+
+				sampleDataBlock.DiscardBytes(totalSize - chunkSize - 12);
+			}
+		}
+
+		return true;
+	}
+
 	void JJ2Anims::ImportAnimations(PakWriter& pakWriter, JJ2Version version, SmallVectorImpl<AnimSection>& anims)
 	{
 		if (anims.empty()) {
@@ -427,6 +465,7 @@ namespace Jazz2::Compatibility
 
 		AnimSetMapping animMapping = AnimSetMapping::GetAnimMapping(version);
 
+		SmallVector<Pair<AnimSection*, AnimSetMapping::Entry*>, 0> jobs;
 		for (auto& anim : anims) {
 			if (anim.FrameCount == 0) {
 				continue;
@@ -436,244 +475,246 @@ namespace Jazz2::Compatibility
 			if (entry == nullptr || entry->Category == AnimSetMapping::Discard) {
 				continue;
 			}
+			if (entry->Name.empty()) {
+				LOGE("Entry name is empty");
+				continue;
+			}
 
-			std::int32_t sizeX = (anim.AdjustedSizeX + AddBorder * 2);
-			std::int32_t sizeY = (anim.AdjustedSizeY + AddBorder * 2);
-			// Determine the frame configuration to use. Each asset should fit into a texture of
-			// MaxTextureSize², the smallest limit among the supported platforms.
-			if (anim.FrameCount > 1) {
-				// Pick the grid whose texture wastes the least memory once it is rounded up to power-of-two
-				// dimensions. Graphics hardware that cannot sample non-power-of-two textures has to pad them,
-				// and a layout chosen only to be roughly square lands just past a power of two surprisingly
-				// often - a 669x552 sheet occupies a 1024x1024 texture, so almost two thirds of it is unused.
-				// Choosing by padded area instead usually fills the texture almost completely, at no cost to
-				// platforms that sample the sheet at its exact size.
-				std::int32_t bestColumns = 0, bestRows = 0;
-				std::int64_t bestCost = INT64_MAX;
-				// If no layout fits (kept below as a fallback), take the one that pads to the smallest
-				// texture anyway - a mildly oversized square sheet still beats a FrameCount x 1 strip
-				std::int32_t fallbackColumns = 0, fallbackRows = 0;
-				std::int64_t fallbackCost = INT64_MAX;
-				// The configuration is stored in a byte per axis, so neither may exceed 255
-				const std::int32_t maxColumns = std::min<std::int32_t>(anim.FrameCount, 255);
-				for (std::int32_t columns = 1; columns <= maxColumns; columns++) {
-					const std::int32_t rows = (anim.FrameCount + columns - 1) / columns;
-					if (rows > 255) {
-						continue;
-					}
-					const std::int32_t width = columns * sizeX;
-					const std::int32_t height = rows * sizeY;
-					const std::int64_t paddedArea = std::int64_t(NextPowerOfTwo(width)) * NextPowerOfTwo(height);
-					if (width > MaxTextureSize || height > MaxTextureSize) {
-						if (paddedArea < fallbackCost) {
-							fallbackCost = paddedArea;
-							fallbackColumns = columns;
-							fallbackRows = rows;
-						}
-						continue;
-					}
+			jobs.emplace_back(&anim, entry);
+		}
 
-					// Prefer the layout that pads to the smallest texture; among equals prefer the one that
-					// wastes fewer cells in the grid itself, then the more square one, so the choice is stable
-					const std::int64_t emptyCells = std::int64_t(columns) * rows - anim.FrameCount;
-					const std::int64_t cost = (paddedArea * 1024 + emptyCells * 16) * 1024 + std::abs(width - height);
-					if (cost < bestCost) {
-						bestCost = cost;
-						bestColumns = columns;
-						bestRows = rows;
-					}
+		// Sprite sheets are encoded in parallel, but always added to the .pak file in the same order
+		ConvertInParallel<std::unique_ptr<Stream>>((std::int32_t)jobs.size(), MaxPendingJobs, [&jobs](std::int32_t index) {
+			return ConvertAnimation(*jobs[index].first(), jobs[index].second());
+		}, [&jobs, &pakWriter](std::int32_t index, std::unique_ptr<Stream>& so) {
+			const AnimSetMapping::Entry* entry = jobs[index].second();
+			String filename = fs::CombinePath({ "Animations"_s, entry->Category, String(entry->Name + ".aura"_s) });
+			so->Seek(0, SeekOrigin::Begin);
+			bool success = pakWriter.AddFile(*so, filename, PakPreferredCompression::Auto);
+			DEATH_ASSERT(success, "Failed to add file to .pak container", );
+		});
+	}
+
+	std::unique_ptr<Stream> JJ2Anims::ConvertAnimation(AnimSection& anim, AnimSetMapping::Entry* entry)
+	{
+		std::int32_t sizeX = (anim.AdjustedSizeX + AddBorder * 2);
+		std::int32_t sizeY = (anim.AdjustedSizeY + AddBorder * 2);
+		// Determine the frame configuration to use. Each asset should fit into a texture of
+		// MaxTextureSize², the smallest limit among the supported platforms.
+		if (anim.FrameCount > 1) {
+			// Pick the grid whose texture wastes the least memory once it is rounded up to power-of-two
+			// dimensions. Graphics hardware that cannot sample non-power-of-two textures has to pad them,
+			// and a layout chosen only to be roughly square lands just past a power of two surprisingly
+			// often - a 669x552 sheet occupies a 1024x1024 texture, so almost two thirds of it is unused.
+			// Choosing by padded area instead usually fills the texture almost completely, at no cost to
+			// platforms that sample the sheet at its exact size.
+			std::int32_t bestColumns = 0, bestRows = 0;
+			std::int64_t bestCost = INT64_MAX;
+			// If no layout fits (kept below as a fallback), take the one that pads to the smallest
+			// texture anyway - a mildly oversized square sheet still beats a FrameCount x 1 strip
+			std::int32_t fallbackColumns = 0, fallbackRows = 0;
+			std::int64_t fallbackCost = INT64_MAX;
+			// The configuration is stored in a byte per axis, so neither may exceed 255
+			const std::int32_t maxColumns = std::min<std::int32_t>(anim.FrameCount, 255);
+			for (std::int32_t columns = 1; columns <= maxColumns; columns++) {
+				const std::int32_t rows = (anim.FrameCount + columns - 1) / columns;
+				if (rows > 255) {
+					continue;
 				}
-				if (bestColumns == 0) {
-					LOGW("No frame configuration of {}:{} fits into a {}x{} texture ({} frames of {}x{})",
-						anim.Set, anim.Anim, MaxTextureSize, MaxTextureSize, anim.FrameCount, sizeX, sizeY);
-					bestColumns = (fallbackColumns > 0 ? fallbackColumns : maxColumns);
-					bestRows = (fallbackRows > 0 ? fallbackRows : 255);
+				const std::int32_t width = columns * sizeX;
+				const std::int32_t height = rows * sizeY;
+				const std::int64_t paddedArea = std::int64_t(NextPowerOfTwo(width)) * NextPowerOfTwo(height);
+				if (width > MaxTextureSize || height > MaxTextureSize) {
+					if (paddedArea < fallbackCost) {
+						fallbackCost = paddedArea;
+						fallbackColumns = columns;
+						fallbackRows = rows;
+					}
+					continue;
 				}
 
-				anim.FrameConfigurationX = (std::uint8_t)bestColumns;
-				anim.FrameConfigurationY = (std::uint8_t)bestRows;
-			} else {
-				anim.FrameConfigurationX = (std::uint8_t)anim.FrameCount;
-				anim.FrameConfigurationY = 1;
+				// Prefer the layout that pads to the smallest texture; among equals prefer the one that
+				// wastes fewer cells in the grid itself, then the more square one, so the choice is stable
+				const std::int64_t emptyCells = std::int64_t(columns) * rows - anim.FrameCount;
+				const std::int64_t cost = (paddedArea * 1024 + emptyCells * 16) * 1024 + std::abs(width - height);
+				if (cost < bestCost) {
+					bestCost = cost;
+					bestColumns = columns;
+					bestRows = rows;
+				}
 			}
-
-			// TODO: Hardcoded name
-			bool applyToasterPowerUpFix = (entry->Category == "Object"_s && entry->Name == "powerup_upgrade_toaster"_s);
-			if (applyToasterPowerUpFix) {
-				LOGI("Applying \"Toaster PowerUp\" palette fix to {}:{}", anim.Set, anim.Anim);
+			if (bestColumns == 0) {
+				LOGW("No frame configuration of {}:{} fits into a {}x{} texture ({} frames of {}x{})",
+					anim.Set, anim.Anim, MaxTextureSize, MaxTextureSize, anim.FrameCount, sizeX, sizeY);
+				bestColumns = (fallbackColumns > 0 ? fallbackColumns : maxColumns);
+				bestRows = (fallbackRows > 0 ? fallbackRows : 255);
 			}
 
-			bool applyVineFix = (entry->Category == "Object"_s && entry->Name == "vine"_s);
-			if (applyVineFix) {
-				LOGI("Applying \"Vine\" palette fix to {}:{}", anim.Set, anim.Anim);
-			}
+			anim.FrameConfigurationX = (std::uint8_t)bestColumns;
+			anim.FrameConfigurationY = (std::uint8_t)bestRows;
+		} else {
+			anim.FrameConfigurationX = (std::uint8_t)anim.FrameCount;
+			anim.FrameConfigurationY = 1;
+		}
 
-			bool applyFlyCarrotFix = (entry->Category == "Pickup"_s && entry->Name == "carrot_fly"_s);
-			if (applyFlyCarrotFix) {
-				// This image has 4 wrong pixels that should be transparent
-				LOGI("Applying \"Fly Carrot\" image fix to {}:{}", anim.Set, anim.Anim);
-			}
+		// TODO: Hardcoded name
+		bool applyToasterPowerUpFix = (entry->Category == "Object"_s && entry->Name == "powerup_upgrade_toaster"_s);
+		if (applyToasterPowerUpFix) {
+			LOGI("Applying \"Toaster PowerUp\" palette fix to {}:{}", anim.Set, anim.Anim);
+		}
 
-			bool playerFlareFix = ((entry->Category == "Jazz"_s || entry->Category == "Spaz"_s) && (entry->Name == "shoot_ver"_s || entry->Name == "vine_shoot_up"_s));
-			if (playerFlareFix) {
-				// This image has already applied weapon flare, remove it
-				LOGI("Applying \"Player Flare\" image fix to {}:{}", anim.Set, anim.Anim);
-			}
+		bool applyVineFix = (entry->Category == "Object"_s && entry->Name == "vine"_s);
+		if (applyVineFix) {
+			LOGI("Applying \"Vine\" palette fix to {}:{}", anim.Set, anim.Anim);
+		}
 
-			String filename;
-			if (entry->Name.empty()) {
-				LOGE("Entry name is empty");
-				continue;
-			}
+		bool applyFlyCarrotFix = (entry->Category == "Pickup"_s && entry->Name == "carrot_fly"_s);
+		if (applyFlyCarrotFix) {
+			// This image has 4 wrong pixels that should be transparent
+			LOGI("Applying \"Fly Carrot\" image fix to {}:{}", anim.Set, anim.Anim);
+		}
 
-			filename = fs::CombinePath({ "Animations"_s, entry->Category, String(entry->Name + ".aura"_s) });
+		bool playerFlareFix = ((entry->Category == "Jazz"_s || entry->Category == "Spaz"_s) && (entry->Name == "shoot_ver"_s || entry->Name == "vine_shoot_up"_s));
+		if (playerFlareFix) {
+			// This image has already applied weapon flare, remove it
+			LOGI("Applying \"Player Flare\" image fix to {}:{}", anim.Set, anim.Anim);
+		}
 
-			// Pack the frames tightly when they fit that way, otherwise keep the regular grid
-			SmallVector<PackedFrame, 0> packedFrames;
-			std::int32_t sheetWidth = 0, sheetHeight = 0;
-			const bool tightlyPacked = PackFramesTightly(anim, AddBorder, packedFrames, sheetWidth, sheetHeight);
-			if (!tightlyPacked) {
-				sheetWidth = sizeX * anim.FrameConfigurationX;
-				sheetHeight = sizeY * anim.FrameConfigurationY;
-			}
+		// Pack the frames tightly when they fit that way, otherwise keep the regular grid
+		SmallVector<PackedFrame, 0> packedFrames;
+		std::int32_t sheetWidth = 0, sheetHeight = 0;
+		const bool tightlyPacked = PackFramesTightly(anim, AddBorder, packedFrames, sheetWidth, sheetHeight);
+		if (!tightlyPacked) {
+			sheetWidth = sizeX * anim.FrameConfigurationX;
+			sheetHeight = sizeY * anim.FrameConfigurationY;
+		}
 
-			std::int32_t stride = sheetWidth;
-			std::unique_ptr<std::uint8_t[]> pixels = std::make_unique<std::uint8_t[]>(sheetWidth * sheetHeight * 4);
+		std::int32_t stride = sheetWidth;
+		std::unique_ptr<std::uint8_t[]> pixels = std::make_unique<std::uint8_t[]>(sheetWidth * sheetHeight * 4);
 
-			for (std::int32_t j = 0; j < (std::int32_t)anim.Frames.size(); j++) {
-				auto& frame = anim.Frames[j];
+		for (std::int32_t j = 0; j < (std::int32_t)anim.Frames.size(); j++) {
+			auto& frame = anim.Frames[j];
 
-				std::int32_t offsetX = anim.NormalizedHotspotX + frame.HotspotX;
-				std::int32_t offsetY = anim.NormalizedHotspotY + frame.HotspotY;
+			std::int32_t offsetX = anim.NormalizedHotspotX + frame.HotspotX;
+			std::int32_t offsetY = anim.NormalizedHotspotY + frame.HotspotY;
 
-				// Where this frame's top-left corner lands in the sheet
-				std::int32_t frameBaseX, frameBaseY;
-				if (tightlyPacked) {
-					frameBaseX = packedFrames[j].X;
-					frameBaseY = packedFrames[j].Y;
-				} else {
-					frameBaseX = (j % anim.FrameConfigurationX) * sizeX + offsetX;
-					frameBaseY = (j / anim.FrameConfigurationX) * sizeY + offsetY;
-				}
+			// Where this frame's top-left corner lands in the sheet
+			std::int32_t frameBaseX, frameBaseY;
+			if (tightlyPacked) {
+				frameBaseX = packedFrames[j].X;
+				frameBaseY = packedFrames[j].Y;
+			} else {
+				frameBaseX = (j % anim.FrameConfigurationX) * sizeX + offsetX;
+				frameBaseY = (j / anim.FrameConfigurationX) * sizeY + offsetY;
+			}
 
-				for (std::int32_t y = 0; y < frame.SizeY; y++) {
-					for (std::int32_t x = 0; x < frame.SizeX; x++) {
-						std::int32_t targetX = frameBaseX + x + (tightlyPacked ? 0 : AddBorder);
-						std::int32_t targetY = frameBaseY + y + (tightlyPacked ? 0 : AddBorder);
-						std::uint8_t colorIdx = frame.ImageData[frame.SizeX * y + x];
+			for (std::int32_t y = 0; y < frame.SizeY; y++) {
+				for (std::int32_t x = 0; x < frame.SizeX; x++) {
+					std::int32_t targetX = frameBaseX + x + (tightlyPacked ? 0 : AddBorder);
+					std::int32_t targetY = frameBaseY + y + (tightlyPacked ? 0 : AddBorder);
+					std::uint8_t colorIdx = frame.ImageData[frame.SizeX * y + x];
 
-						// Apply palette fixes
-						if (applyToasterPowerUpFix) {
-							if ((x >= 3 && y >= 4 && x <= 15 && y <= 20) || (x >= 2 && y >= 7 && x <= 15 && y <= 19)) {
-								colorIdx = ToasterPowerUpFix[colorIdx];
-							}
-						} else if (applyVineFix) {
-							if (colorIdx == 128) {
-								colorIdx = 0;
-							}
-						} else if (applyFlyCarrotFix) {
-							if (colorIdx >= 68 && colorIdx <= 70) {
-								colorIdx = 0;
-							}
-						} else if (playerFlareFix) {
-							if (j == 0 && y < 14 && (colorIdx == 15 || (colorIdx >= 40 && colorIdx <= 42))) {
-								colorIdx = 0;
-							}
+					// Apply palette fixes
+					if (applyToasterPowerUpFix) {
+						if ((x >= 3 && y >= 4 && x <= 15 && y <= 20) || (x >= 2 && y >= 7 && x <= 15 && y <= 19)) {
+							colorIdx = ToasterPowerUpFix[colorIdx];
 						}
+					} else if (applyVineFix) {
+						if (colorIdx == 128) {
+							colorIdx = 0;
+						}
+					} else if (applyFlyCarrotFix) {
+						if (colorIdx >= 68 && colorIdx <= 70) {
+							colorIdx = 0;
+						}
+					} else if (playerFlareFix) {
+						if (j == 0 && y < 14 && (colorIdx == 15 || (colorIdx >= 40 && colorIdx <= 42))) {
+							colorIdx = 0;
+						}
+					}
 
-						if (entry->Palette == JJ2DefaultPalette::Menu) {
-							const Color& src = MenuPalette[colorIdx];
-							std::uint8_t a;
-							if (colorIdx == 0) {
-								a = 0;
-							} else if (frame.DrawTransparent) {
-								a = 140 * src.A / 255;
-							} else {
-								a = src.A;
-							}
-
-							pixels[(stride * targetY + targetX) * 4] = src.R;
-							pixels[(stride * targetY + targetX) * 4 + 1] = src.G;
-							pixels[(stride * targetY + targetX) * 4 + 2] = src.B;
-							pixels[(stride * targetY + targetX) * 4 + 3] = a;
+					if (entry->Palette == JJ2DefaultPalette::Menu) {
+						const Color& src = MenuPalette[colorIdx];
+						std::uint8_t a;
+						if (colorIdx == 0) {
+							a = 0;
+						} else if (frame.DrawTransparent) {
+							a = 140 * src.A / 255;
 						} else {
-							std::uint8_t a;
-							if (colorIdx == 0) {
-								a = 0;
-							} else if (frame.DrawTransparent) {
-								a = 140;
-							} else {
-								a = 255;
-							}
+							a = src.A;
+						}
 
-							pixels[(stride * targetY + targetX) * 4] = colorIdx;
-							pixels[(stride * targetY + targetX) * 4 + 1] = colorIdx;
-							pixels[(stride * targetY + targetX) * 4 + 2] = colorIdx;
-							pixels[(stride * targetY + targetX) * 4 + 3] = a;
+						pixels[(stride * targetY + targetX) * 4] = src.R;
+						pixels[(stride * targetY + targetX) * 4 + 1] = src.G;
+						pixels[(stride * targetY + targetX) * 4 + 2] = src.B;
+						pixels[(stride * targetY + targetX) * 4 + 3] = a;
+					} else {
+						std::uint8_t a;
+						if (colorIdx == 0) {
+							a = 0;
+						} else if (frame.DrawTransparent) {
+							a = 140;
+						} else {
+							a = 255;
 						}
+
+						pixels[(stride * targetY + targetX) * 4] = colorIdx;
+						pixels[(stride * targetY + targetX) * 4 + 1] = colorIdx;
+						pixels[(stride * targetY + targetX) * 4 + 2] = colorIdx;
+						pixels[(stride * targetY + targetX) * 4 + 3] = a;
 					}
 				}
 			}
+		}
 
-			bool applyLoriLiftFix = (entry->Category == "Lori"_s && (entry->Name == "lift"_s || entry->Name == "lift_start"_s || entry->Name == "lift_end"_s));
-			if (applyLoriLiftFix) {
-				LOGI("Applying \"Lori\" hotspot fix to {}:{}", anim.Set, anim.Anim);
-				anim.NormalizedHotspotX = 20;
-				anim.NormalizedHotspotY = 4;
-			}
+		bool applyLoriLiftFix = (entry->Category == "Lori"_s && (entry->Name == "lift"_s || entry->Name == "lift_start"_s || entry->Name == "lift_end"_s));
+		if (applyLoriLiftFix) {
+			LOGI("Applying \"Lori\" hotspot fix to {}:{}", anim.Set, anim.Anim);
+			anim.NormalizedHotspotX = 20;
+			anim.NormalizedHotspotY = 4;
+		}
 
-			MemoryStream so(16384);
-			std::int32_t totalPixels = sheetWidth * sheetHeight;
-			std::int32_t outChannels = 4;
-			std::unique_ptr<std::uint8_t[]> packed;
-			const std::uint8_t* outData = pixels.get();
-			// Indexed sprites (default Sprite palette) keep the palette index in the red channel and are recolored
-			// in-game through the palette texture. Save them with the fewest channels so no per-pixel work is
-			// needed at load: 1 (index only), or 2 (index + alpha) when any pixel is partially transparent
-			// (DrawTransparent). True-color palettes (e.g., Menu) stay RGBA.
-			if (entry->Palette == JJ2DefaultPalette::Sprite) {
-				bool hasPartialAlpha = false;
+		std::unique_ptr<Stream> so = std::make_unique<MemoryStream>(16384);
+		std::int32_t totalPixels = sheetWidth * sheetHeight;
+		std::int32_t outChannels = 4;
+		std::unique_ptr<std::uint8_t[]> packed;
+		const std::uint8_t* outData = pixels.get();
+		// Indexed sprites (default Sprite palette) keep the palette index in the red channel and are recolored
+		// in-game through the palette texture. Save them with the fewest channels so no per-pixel work is
+		// needed at load: 1 (index only), or 2 (index + alpha) when any pixel is partially transparent
+		// (DrawTransparent). True-color palettes (e.g., Menu) stay RGBA.
+		if (entry->Palette == JJ2DefaultPalette::Sprite) {
+			bool hasPartialAlpha = false;
+			for (std::int32_t i = 0; i < totalPixels; i++) {
+				std::uint8_t a = pixels[(i * 4) + 3];
+				if (a != 0 && a != 255) {
+					hasPartialAlpha = true;
+					break;
+				}
+			}
+			outChannels = (hasPartialAlpha ? 2 : 1);
+			packed = std::make_unique<std::uint8_t[]>(totalPixels * outChannels);
+			if (outChannels == 2) {
 				for (std::int32_t i = 0; i < totalPixels; i++) {
-					std::uint8_t a = pixels[(i * 4) + 3];
-					if (a != 0 && a != 255) {
-						hasPartialAlpha = true;
-						break;
-					}
+					packed[(i * 2) + 0] = pixels[(i * 4) + 0]; // palette index (red channel)
+					packed[(i * 2) + 1] = pixels[(i * 4) + 3]; // alpha
 				}
-				outChannels = (hasPartialAlpha ? 2 : 1);
-				packed = std::make_unique<std::uint8_t[]>(totalPixels * outChannels);
-				if (outChannels == 2) {
-					for (std::int32_t i = 0; i < totalPixels; i++) {
-						packed[(i * 2) + 0] = pixels[(i * 4) + 0]; // palette index (red channel)
-						packed[(i * 2) + 1] = pixels[(i * 4) + 3]; // alpha
-					}
-				} else {
-					for (std::int32_t i = 0; i < totalPixels; i++) {
-						packed[i] = pixels[(i * 4) + 0]; // palette index (red channel)
-					}
+			} else {
+				for (std::int32_t i = 0; i < totalPixels; i++) {
+					packed[i] = pixels[(i * 4) + 0]; // palette index (red channel)
 				}
-				outData = packed.get();
 			}
+			outData = packed.get();
+		}
 
-			PackedSheet packedSheet;
-			if (tightlyPacked) {
-				packedSheet.Frames = &packedFrames;
-				packedSheet.Width = sheetWidth;
-				packedSheet.Height = sheetHeight;
-			}
-			WriteImageToStream(so, outData, sizeX, sizeY, outChannels, anim, entry, packedSheet);
-			so.Seek(0, SeekOrigin::Begin);
-			bool success = pakWriter.AddFile(so, filename, PakPreferredCompression::Deflate);
-			DEATH_ASSERT(success, "Failed to add file to .pak container", );
-
-			/*if (!string.IsNullOrEmpty(data.Name) && !data.SkipNormalMap) {
-				PngWriter normalMap = NormalMapGenerator.FromSprite(img,
-						new Point(currentAnim.FrameConfigurationX, currentAnim.FrameConfigurationY),
-						!data.AllowRealtimePalette && data.Palette == JJ2DefaultPalette.ByIndex ? JJ2DefaultPalette.Sprite : null);
-
-				normalMap.Save(filename.Replace(".png", ".n.png"));
-			}*/
+		PackedSheet packedSheet;
+		if (tightlyPacked) {
+			packedSheet.Frames = &packedFrames;
+			packedSheet.Width = sheetWidth;
+			packedSheet.Height = sheetHeight;
 		}
+		WriteImageToStream(*so, outData, sizeX, sizeY, outChannels, anim, entry, packedSheet);
+		return so;
 	}
 
 	void JJ2Anims::ImportAudioSamples(PakWriter& pakWriter, JJ2Version version, SmallVectorImpl<SampleSection>& samples)
@@ -739,7 +780,7 @@ namespace Jazz2::Compatibility
 			}
 
 			so.Seek(0, SeekOrigin::Begin);
-			bool success = pakWriter.AddFile(so, filename, PakPreferredCompression::Deflate);
+			bool success = pakWriter.AddFile(so, filename, PakPreferredCompression::Auto);
 			DEATH_ASSERT(success, "Failed to add file to .pak container", );
 		}
 	}
@@ -103,6 +103,21 @@ namespace Jazz2::Compatibility
 			std::unique_ptr<std::uint8_t[]> Data;
 			std::uint16_t Multiplier;
 		};
+
+		struct SetSection {
+			std::int32_t Index;
+			std::uint8_t AnimCount;
+			std::uint8_t SndCount;
+			std::int32_t BlockLengths[8];
+			std::unique_ptr<std::uint8_t[]> Data;
+			std::int32_t DataSize;
+		};
+
+		struct UnpackedSet {
+			SmallVector<AnimSection, 0> Anims;
+			SmallVector<SampleSection, 0> Samples;
+			bool IsValid;
+		};
 #endif
 
 		JJ2Anims();
@@ -117,7 +132,11 @@ namespace Jazz2::Compatibility
 		static bool PackFramesTightly(const AnimSection& anim, std::int32_t border,
 			SmallVector<PackedFrame, 0>& packed, std::int32_t& sheetWidth, std::int32_t& sheetHeight);
 
+		/** @brief Decompresses and parses all animations and samples of one set, thread-safe */
+		static bool UnpackSet(const SetSection& set, SmallVectorImpl<AnimSection>& anims, SmallVectorImpl<SampleSection>& samples);
 		static void ImportAnimations(PakWriter& pakWriter, JJ2Version version, SmallVectorImpl<AnimSection>& anims);
+		/** @brief Lays out and encodes the sprite sheet of one animation, thread-safe */
+		static std::unique_ptr<Stream> ConvertAnimation(AnimSection& anim, AnimSetMapping::Entry* entry);
 		static void ImportAudioSamples(PakWriter& pakWriter, JJ2Version version, SmallVectorImpl<SampleSection>& samples);
 
 		static void WriteImageToFile(StringView targetPath, const std::uint8_t* data, std::int32_t width, std::int32_t height, std::int32_t channelCount, const AnimSection& anim, AnimSetMapping::Entry* entry);
@@ -175,7 +175,7 @@ namespace Jazz2::Compatibility
 		}
 
 		so.Seek(0, SeekOrigin::Begin);
-		bool success = pakWriter.AddFile(so, targetPath, PakPreferredCompression::Deflate);
+		bool success = pakWriter.AddFile(so, targetPath, PakPreferredCompression::Auto);
 		DEATH_ASSERT(success, "Cannot add file to .pak container", );
 	}
 
@@ -224,7 +224,7 @@ namespace Jazz2::Compatibility
 		JJ2Anims::WriteImageContent(so, pixels.get(), width, height, 4);
 
 		so.Seek(0, SeekOrigin::Begin);
-		bool success = pakWriter.AddFile(so, targetPath, PakPreferredCompression::Deflate);
+		bool success = pakWriter.AddFile(so, targetPath, PakPreferredCompression::Auto);
 		DEATH_ASSERT(success, "Cannot add file to .pak container", );
 	}
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+﻿#pragma once
+
+#include "../../Main.h"
+
+#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+#	include "../../nCine/Threading/Thread.h"
+#	include "../../nCine/Threading/ThreadSync.h"
+#endif
+
+#include <algorithm>
+#include <memory>
+
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+
+namespace Jazz2::Compatibility
+{
+	/**
+		@brief Runs independent conversion jobs on worker threads and completes them in their original order
+
+		@p convert is called as `TResult(std::int32_t index)` on a worker thread for every job in range
+		`[0, count)`, so it must not touch anything shared without synchronization. @p complete is then called as
+		`void(std::int32_t index, TResult& result)` on the calling thread, strictly in order of the indices, so
+		anything it writes (e.g., to a `.pak` file) doesn't depend on how the jobs were scheduled. Workers don't
+		run ahead of the oldest job not completed yet by more than @p maxPending jobs, which bounds the memory
+		held by results waiting to be completed. Without thread support, the jobs are converted and completed
+		one by one on the calling thread.
+	*/
+	template<class TResult, class TConvert, class TComplete>
+	void ConvertInParallel(std::int32_t count, std::int32_t maxPending, TConvert&& convert, TComplete&& complete)
+	{
+		if (count <= 0) {
+			return;
+		}
+
+#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		std::int32_t threadCount = std::min(std::min((std::int32_t)nCine::Thread::GetProcessorCount(), maxPending), count);
+		if (threadCount > 1) {
+			struct SharedState {
+				nCine::Mutex Mutex;
+				nCine::CondVariable Changed;
+				SmallVector<std::unique_ptr<TResult>, 0> Results;
+				std::int32_t NextToConvert;
+				std::int32_t NextToComplete;
+			};
+
+			SharedState state;
+			state.Results.resize(count);
+			state.NextToConvert = 0;
+			state.NextToComplete = 0;
+
+			auto worker = [&state, &convert, count, maxPending]() {
+				state.Mutex.Lock();
+				while (true) {
+					while (state.NextToConvert < count && state.NextToConvert >= state.NextToComplete + maxPending) {
+						state.Changed.Wait(state.Mutex);
+					}
+					if (state.NextToConvert >= count) {
+						break;
+					}
+
+					std::int32_t index = state.NextToConvert++;
+					state.Mutex.Unlock();
+					std::unique_ptr<TResult> result = std::make_unique<TResult>(convert(index));
+					state.Mutex.Lock();
+
+					state.Results[index] = std::move(result);
+					state.Changed.Broadcast();
+				}
+				state.Mutex.Unlock();
+			};
+
+			SmallVector<nCine::Thread, 0> threads;
+			threads.reserve(threadCount);
+			for (std::int32_t i = 0; i < threadCount; i++) {
+				threads.emplace_back(worker);
+			}
+
+			for (std::int32_t i = 0; i < count; i++) {
+				state.Mutex.Lock();
+				while (state.Results[i] == nullptr) {
+					state.Changed.Wait(state.Mutex);
+				}
+				std::unique_ptr<TResult> result = std::move(state.Results[i]);
+				state.NextToComplete = i + 1;
+				state.Changed.Broadcast();
+				state.Mutex.Unlock();
+
+				complete(i, *result);
+			}
+
+			for (auto& thread : threads) {
+				thread.Join();
+			}
+			return;
+		}
+#endif
+
+		for (std::int32_t i = 0; i < count; i++) {
+			TResult result = convert(i);
+			complete(i, result);
+		}
+	}
+}
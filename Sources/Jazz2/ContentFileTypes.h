@@ -22,5 +22,6 @@ namespace Jazz2
 		static constexpr std::uint8_t Highscores = 7;
 		static constexpr std::uint8_t Video = 8;
 		static constexpr std::uint8_t Font = 9;
+		static constexpr std::uint8_t ScriptBytecode = 10;
 	};
 }
@@ -53,6 +53,162 @@ namespace Jazz2
 	// are invalidated (12 = the switch from embedded sources to ShaderCompiler-generated artifacts)
 	static constexpr std::uint64_t ShadersVersion = 13;
 
+	// Mounted .paks are mapped into memory as a whole, so opening a file from them doesn't cost any syscalls,
+	// only on 64-bit targets where the address space isn't a concern
+	static constexpr bool UseMemoryMappedPaks = (sizeof(void*) >= 8);
+
+	// Default budgets of metadata, graphics and sound caches, assets that the current level doesn't reference are kept
+	// across level changes up to these. Consoles with a small heap keep only the referenced ones.
+#if defined(DEATH_TARGET_PS2) || defined(DEATH_TARGET_PSP) || defined(DEATH_TARGET_VITA) || defined(DEATH_TARGET_PS3) || \
+	defined(DEATH_TARGET_WII) || defined(DEATH_TARGET_GAMECUBE) || defined(DEATH_TARGET_DREAMCAST)
+	static constexpr std::uint64_t DefaultCacheBudgets[] = { 0, 0, 0 };
+#elif defined(DEATH_TARGET_32BIT) || defined(DEATH_TARGET_ANDROID) || defined(DEATH_TARGET_SWITCH)
+	static constexpr std::uint64_t DefaultCacheBudgets[] = { 1 * 1024 * 1024, 64 * 1024 * 1024, 32 * 1024 * 1024 };
+#else
+	static constexpr std::uint64_t DefaultCacheBudgets[] = { 4 * 1024 * 1024, 256 * 1024 * 1024, 128 * 1024 * 1024 };
+#endif
+
+	// Appends unreferenced resources of the cache that have to be released to fit the budget to `evicted`, least
+	// recently used first. Resources already in `evicted` are released anyway, so they don't count. Keeps it sorted.
+	template<class TMap, class TFlags>
+	static void SelectEvictions(const TMap& cache, TFlags referencedFlag, std::uint64_t residentSize, std::uint64_t budget, SmallVector<const void*, 0>& evicted)
+	{
+		struct Candidate {
+			std::uint32_t LastUsed;
+			std::uint32_t Size;
+			const void* Resource;
+		};
+
+		std::sort(evicted.begin(), evicted.end());
+
+		SmallVector<Candidate, 0> candidates;
+		for (const auto& [key, resource] : cache) {
+			if ((resource->Flags & referencedFlag) == referencedFlag) {
+				continue;
+			}
+			if (std::binary_search(evicted.begin(), evicted.end(), (const void*)resource.get())) {
+				residentSize -= resource->ResidentSize;
+				continue;
+			}
+			candidates.push_back({ resource->LastUsed, resource->ResidentSize, resource.get() });
+		}
+
+		if (residentSize > budget) {
+			std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+				return a.LastUsed < b.LastUsed;
+			});
+			for (const auto& candidate : candidates) {
+				if (residentSize <= budget) {
+					break;
+				}
+				evicted.push_back(candidate.Resource);
+				residentSize -= candidate.Size;
+			}
+			std::sort(evicted.begin(), evicted.end());
+		}
+	}
+
+	// Releases resources selected by SelectEvictions() and returns how many of them there were
+	template<class TMap>
+	static std::uint32_t ReleaseEvicted(TMap& cache, const SmallVector<const void*, 0>& evicted, std::uint64_t& residentSize)
+	{
+		if (evicted.empty()) {
+			return 0;
+		}
+
+		std::uint32_t count = 0;
+		auto it = cache.begin();
+		while (it != cache.end()) {
+			if (std::binary_search(evicted.begin(), evicted.end(), (const void*)it->second.get())) {
+				residentSize -= it->second->ResidentSize;
+				it = cache.erase(it);
+				count++;
+			} else {
+				++it;
+			}
+		}
+		return count;
+	}
+
+	// Removes resource IDs pointing to resources released by ReleaseEvicted()
+	template<class TMap>
+	static void ForgetEvicted(TMap& ids, const SmallVector<const void*, 0>& evicted)
+	{
+		if (evicted.empty()) {
+			return;
+		}
+
+		auto it = ids.begin();
+		while (it != ids.end()) {
+			if (std::binary_search(evicted.begin(), evicted.end(), (const void*)it->second.Resource)) {
+				it = ids.erase(it);
+			} else {
+				++it;
+			}
+		}
+	}
+
+	// Both variants of metadata are cached separately, so they need different keys (see RequestMetadata())
+	static std::uint64_t GetMetadataIdKey(const ResourceId& id, bool forceIndexed)
+	{
+		return (forceIndexed ? ~id.GetHash() : id.GetHash());
+	}
+
+	// Graphics are cached per palette offset (see RequestGraphics())
+	static std::uint64_t GetGraphicsIdKey(const ResourceId& id, std::uint16_t cacheKeyOffset)
+	{
+		return id.GetHash() ^ ((std::uint64_t)(cacheKeyOffset + 1) * 0x9E3779B97F4A7C15ull);
+	}
+
+#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+	struct ContentResolver::PreloadedMetadata
+	{
+		PreloadState State;
+		bool Succeeded;
+		Json::Value Document;
+		// Sprite sheets queued along with the metadata, ProcessPreloadedAssets() waits for all of them
+		SmallVector<String, 0> GraphicsPaths;
+	};
+
+	struct ContentResolver::PreloadedGraphics
+	{
+		PreloadState State;
+		bool Succeeded;
+		DecodedGraphics Result;
+	};
+
+	// Lists ".aura" sprite sheets that RequestMetadata() loads right away for the document (i.e., not deferred ones),
+	// other formats need the texture loader, which can't be used outside of the main thread
+	static void CollectPreloadableGraphics(const Json::Value& doc, SmallVector<String, 0>& paths)
+	{
+		const auto& animations = doc["Animations"];
+		if (!animations.isObject()) {
+			return;
+		}
+
+		bool deferredByDefault = false;
+		doc["Deferred"].get(deferredByDefault);
+
+		for (auto it = animations.begin(); it != animations.end(); ++it) {
+			std::string_view assetPath;
+			if ((*it)["Path"].get(assetPath) != Json::SUCCESS || assetPath.empty()) {
+				continue;
+			}
+
+			bool deferred = deferredByDefault;
+			(*it)["Deferred"].get(deferred);
+			if (deferred) {
+				continue;
+			}
+
+			String assetPathNormalized = fs::ToNativeSeparators(assetPath);
+			if (fs::GetExtension(assetPathNormalized) == "aura"_s && std::find(paths.begin(), paths.end(), assetPathNormalized) == paths.end()) {
+				paths.push_back(std::move(assetPathNormalized));
+			}
+		}
+	}
+#endif
+
 	ContentResolver& ContentResolver::Get()
 	{
 		static ContentResolver current;
@@ -61,26 +217,47 @@ namespace Jazz2
 
 	ContentResolver::ContentResolver()
 		: _isHeadless(false), _isLoading(false), _isContentPrebaked(false), _cachedMetadata(64), _cachedGraphics(256),
+			_metadataById(64), _graphicsById(256),
 #if defined(WITH_AUDIO)
 			_cachedSounds(192),
 #endif
 			_palettes{}, _paletteDirtyFirstRow(0), _paletteDirtyLastRow(PaletteCount - 1), _paletteRowRefCount{},
-			_paletteRowColor{}, _paletteRowScheme{}
+			_paletteRowColor{}, _paletteRowScheme{}, _cacheStats{}, _usageClock(0)
+#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+			, _preloadShuttingDown(false), _preloadThreadCount(0), _preloadBatchActive(false), _preloadStallMs(0.0f),
+			_preloadedMetadataCount(0), _preloadedGraphicsCount(0)
+#endif
 	{
+		for (std::int32_t i = 0; i < (std::int32_t)CacheType::Count; i++) {
+			_cacheStats[i].Budget = DefaultCacheBudgets[i];
+		}
+
 		InitializePaths();
 	}
 
 	ContentResolver::~ContentResolver()
 	{
+#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		StopPreloadThreads();
+#endif
 	}
 
 	void ContentResolver::Release()
 	{
+#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		StopPreloadThreads();
+#endif
+
 		_cachedMetadata.clear();
 		_cachedGraphics.clear();
+		_metadataById.clear();
+		_graphicsById.clear();
 #if defined(WITH_AUDIO)
 		_cachedSounds.clear();
 #endif
+		for (std::int32_t i = 0; i < (std::int32_t)CacheType::Count; i++) {
+			_cacheStats[i].ResidentSize = 0;
+		}
 
 		for (std::int32_t i = 0; i < (std::int32_t)FontType::Count; i++) {
 			_fonts[i] = nullptr;
@@ -413,9 +590,9 @@ namespace Jazz2
 				continue;
 			}
 
-			auto& pak = _mountedPaks.emplace_back(std::make_unique<PakFile>(item));
+			auto& pak = _mountedPaks.emplace_back(std::make_unique<PakFile>(item, UseMemoryMappedPaks));
 			if (pak->IsValid()) {
-				LOGI("File \"{}\" mounted successfully", item);
+				LOGI("File \"{}\" mounted successfully{}", item, pak->IsMemoryMapped() ? " (memory-mapped)" : "");
 			} else {
 				LOGE("Failed to mount file \"{}\"", item);
 				_mountedPaks.pop_back();
@@ -428,9 +605,9 @@ namespace Jazz2
 				continue;
 			}
 
-			auto& pak = _mountedPaks.emplace_back(std::make_unique<PakFile>(item));
+			auto& pak = _mountedPaks.emplace_back(std::make_unique<PakFile>(item, UseMemoryMappedPaks));
 			if (pak->IsValid()) {
-				LOGI("File \"{}\" mounted successfully", item);
+				LOGI("File \"{}\" mounted successfully{}", item, pak->IsMemoryMapped() ? " (memory-mapped)" : "");
 			} else {
 				LOGE("Failed to mount file \"{}\"", item);
 				_mountedPaks.pop_back();
@@ -492,76 +669,97 @@ namespace Jazz2
 
 	void ContentResolver::EndLoading()
 	{
-#if defined(DEATH_DEBUG)
-		std::int32_t metadataKept = 0, metadataReleased = 0;
-		std::int32_t animationsKept = 0, animationsReleased = 0;
-		std::int32_t soundsKept = 0, soundsReleased = 0;
+		auto& metadataStats = _cacheStats[(std::int32_t)CacheType::Metadata];
+		auto& graphicsStats = _cacheStats[(std::int32_t)CacheType::Graphics];
+		auto& soundsStats = _cacheStats[(std::int32_t)CacheType::Sounds];
+
+		// Referenced resources are never released, the rest stays cached until the budget is exceeded
+		SmallVector<const void*, 0> evictedGraphics;
+		SelectEvictions(_cachedGraphics, GenericGraphicResourceFlags::Referenced, graphicsStats.ResidentSize, graphicsStats.Budget, evictedGraphics);
+		SmallVector<const void*, 0> evictedSounds;
+#if defined(WITH_AUDIO)
+		SelectEvictions(_cachedSounds, GenericSoundResourceFlags::Referenced, soundsStats.ResidentSize, soundsStats.Budget, evictedSounds);
 #endif
 
-		// Release unreferenced metadata
-		{
-			auto it = _cachedMetadata.begin();
-			while (it != _cachedMetadata.end()) {
-				if ((it->second->Flags & MetadataFlags::Referenced) != MetadataFlags::Referenced) {
-					it = _cachedMetadata.erase(it);
-#if defined(DEATH_DEBUG)
-					metadataReleased++;
-#endif
-				} else {
-					++it;
-#if defined(DEATH_DEBUG)
-					metadataKept++;
-#endif
+		// Metadata points directly to graphics and sounds, so it has to go together with them. Referenced metadata
+		// always marks everything it points to as referenced too, so only unreferenced metadata can be affected.
+		SmallVector<const void*, 0> evictedMetadata;
+		if (!evictedGraphics.empty() || !evictedSounds.empty()) {
+			for (const auto& [key, metadata] : _cachedMetadata) {
+				if ((metadata->Flags & MetadataFlags::Referenced) == MetadataFlags::Referenced) {
+					continue;
 				}
-			}
-		}
 
-		// Released unreferenced graphics
-		{
-			auto it = _cachedGraphics.begin();
-			while (it != _cachedGraphics.end()) {
-				if ((it->second->Flags & GenericGraphicResourceFlags::Referenced) != GenericGraphicResourceFlags::Referenced) {
-					it = _cachedGraphics.erase(it);
-#if defined(DEATH_DEBUG)
-					animationsReleased++;
-#endif
-				} else {
-					++it;
-#if defined(DEATH_DEBUG)
-					animationsKept++;
+				bool pointsToEvicted = false;
+				for (const auto& animation : metadata->Animations) {
+					if (animation.Base != nullptr && std::binary_search(evictedGraphics.begin(), evictedGraphics.end(), (const void*)animation.Base)) {
+						pointsToEvicted = true;
+						break;
+					}
+				}
+#if defined(WITH_AUDIO)
+				for (auto it = metadata->Sounds.begin(); it != metadata->Sounds.end() && !pointsToEvicted; ++it) {
+					for (const auto* base : it->second.Buffers) {
+						if (std::binary_search(evictedSounds.begin(), evictedSounds.end(), (const void*)base)) {
+							pointsToEvicted = true;
+							break;
+						}
+					}
+				}
 #endif
+				if (pointsToEvicted) {
+					evictedMetadata.push_back(metadata.get());
 				}
 			}
 		}
+		SelectEvictions(_cachedMetadata, MetadataFlags::Referenced, metadataStats.ResidentSize, metadataStats.Budget, evictedMetadata);
 
+		// Metadata first, so nothing points to released graphics and sounds even for a moment
+		std::uint32_t metadataReleased = ReleaseEvicted(_cachedMetadata, evictedMetadata, metadataStats.ResidentSize);
+		std::uint32_t graphicsReleased = ReleaseEvicted(_cachedGraphics, evictedGraphics, graphicsStats.ResidentSize);
+		ForgetEvicted(_metadataById, evictedMetadata);
+		ForgetEvicted(_graphicsById, evictedGraphics);
 #if defined(WITH_AUDIO)
-		// Released unreferenced sounds
-		{
-			auto it = _cachedSounds.begin();
-			while (it != _cachedSounds.end()) {
-				if ((it->second->Flags & GenericSoundResourceFlags::Referenced) != GenericSoundResourceFlags::Referenced) {
-					it = _cachedSounds.erase(it);
-#	if defined(DEATH_DEBUG)
-					soundsReleased++;
-#	endif
-				} else {
-					++it;
-#	if defined(DEATH_DEBUG)
-					soundsKept++;
-#	endif
-				}
-			}
-		}
+		std::uint32_t soundsReleased = ReleaseEvicted(_cachedSounds, evictedSounds, soundsStats.ResidentSize);
+#else
+		std::uint32_t soundsReleased = 0;
 #endif
+		metadataStats.Evictions += metadataReleased;
+		graphicsStats.Evictions += graphicsReleased;
+		soundsStats.Evictions += soundsReleased;
 
-#if defined(DEATH_DEBUG)
-		LOGW("Metadata: {}|{}, Animations: {}|{}, Sounds: {}|{}", metadataKept, metadataReleased,
-			animationsKept, animationsReleased, soundsKept, soundsReleased);
+		LOGI("Metadata: {} cached, {} released, {} KB ({:.1f}% hits) | Graphics: {} cached, {} released, {} KB ({:.1f}% hits) | Sounds: {} cached, {} released, {} KB ({:.1f}% hits)",
+			_cachedMetadata.size(), metadataReleased, metadataStats.ResidentSize / 1024, metadataStats.GetHitRate() * 100.0f,
+			_cachedGraphics.size(), graphicsReleased, graphicsStats.ResidentSize / 1024, graphicsStats.GetHitRate() * 100.0f,
+#if defined(WITH_AUDIO)
+			_cachedSounds.size(),
+#else
+			0,
 #endif
+			soundsReleased, soundsStats.ResidentSize / 1024, soundsStats.GetHitRate() * 100.0f);
 
 		_isLoading = false;
 	}
 
+	void ContentResolver::SetCacheBudget(CacheType type, std::uint64_t bytes)
+	{
+		_cacheStats[(std::int32_t)type].Budget = bytes;
+	}
+
+	ContentResolver::CacheStatistics ContentResolver::GetCacheStatistics(CacheType type) const
+	{
+		CacheStatistics stats = _cacheStats[(std::int32_t)type];
+		switch (type) {
+			case CacheType::Metadata: stats.Count = (std::uint32_t)_cachedMetadata.size(); break;
+			case CacheType::Graphics: stats.Count = (std::uint32_t)_cachedGraphics.size(); break;
+#if defined(WITH_AUDIO)
+			case CacheType::Sounds: stats.Count = (std::uint32_t)_cachedSounds.size(); break;
+#endif
+			default: stats.Count = 0; break;
+		}
+		return stats;
+	}
+
 	void ContentResolver::OverridePathHandler(Function<String(StringView)>&& callback)
 	{
 		_pathHandler = std::move(callback);
@@ -569,54 +767,355 @@ namespace Jazz2
 
 	void ContentResolver::PreloadMetadataAsync(StringView path)
 	{
-		// TODO: Reimplement async preloading
+#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		String pathNormalized = fs::ToNativeSeparators(path);
+		if (_cachedMetadata.find(pathNormalized) != _cachedMetadata.end()) {
+			// Already loaded, it only needs to be marked as referenced
+			RequestMetadata(pathNormalized);
+			return;
+		}
+
+		if (_preloadThreadCount == 0) {
+			StartPreloadThreads();
+		}
+
+		_preloadMutex.Lock();
+		if (_preloadedMetadata.find(pathNormalized) != _preloadedMetadata.end()) {
+			_preloadMutex.Unlock();
+			return;
+		}
+
+		if (!_preloadBatchActive) {
+			_preloadBatchActive = true;
+			_preloadStartTime = TimeStamp::now();
+			_preloadStallMs = 0.0f;
+			_preloadedMetadataCount = 0;
+			_preloadedGraphicsCount = 0;
+		}
+
+		auto& entry = _preloadedMetadata.emplace(pathNormalized, std::make_unique<PreloadedMetadata>()).first->second;
+		entry->State = PreloadState::Queued;
+		_preloadQueue.push_back({ std::move(pathNormalized), false });
+		_preloadMutex.Unlock();
+		_preloadQueueChanged.Signal();
+#else
 		RequestMetadata(path);
+#endif
 	}
 
-	Metadata* ContentResolver::RequestMetadata(StringView path, bool forceIndexed)
+	void ContentResolver::ProcessPreloadedAssets(float timeBudgetMs)
 	{
-		auto pathNormalized = fs::ToNativeSeparators(path);
-		// Indexed metadata (animations loaded with keepIndexed for runtime recoloring) is cached under a separate
-		// key - "*" can't appear in a real path - so a baked load of the same path can't shadow the indexed variant
-		// the player needs (and vice versa). Without this, whichever variant loads first wins for everyone.
-		String cacheKey = (forceIndexed ? String(pathNormalized + "*"_s) : String(pathNormalized));
-		auto it = _cachedMetadata.find(cacheKey);
-		if (it != _cachedMetadata.end()) {
-			// Already loaded - Mark as referenced
-			it->second->Flags |= MetadataFlags::Referenced;
-
-			for (const auto& resource : it->second->Animations) {
-				// Deferred animations that were never looked up have nothing to mark yet, the ones that were
-				// must be marked, because the metadata keeps pointing at them for as long as it stays cached
-				if (resource.Base != nullptr) {
-					resource.Base->Flags |= GenericGraphicResourceFlags::Referenced;
+#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		if (_preloadThreadCount == 0) {
+			return;
+		}
+
+		TimeStamp start = TimeStamp::now();
+		while (true) {
+			String path;
+
+			_preloadMutex.Lock();
+			for (const auto& [key, entry] : _preloadedMetadata) {
+				if (entry->State != PreloadState::Done) {
+					continue;
+				}
+				// Only metadata with all sprite sheets decoded, so this never has to wait for a worker
+				bool graphicsReady = true;
+				for (const auto& graphicsPath : entry->GraphicsPaths) {
+					auto it = _preloadedGraphics.find(graphicsPath);
+					if (it != _preloadedGraphics.end() && it->second->State != PreloadState::Done) {
+						graphicsReady = false;
+						break;
+					}
+				}
+				if (graphicsReady) {
+					path = key;
+					break;
 				}
 			}
 
-#if defined(WITH_AUDIO)
-			for (const auto& [key, resource] : it->second->Sounds) {
-				for (const auto& base : resource.Buffers) {
-					base->Flags |= GenericSoundResourceFlags::Referenced;
+			if (path.empty() && _preloadedMetadata.empty()) {
+				// Sheets that are left have nobody to claim them anymore - they were already cached when
+				// their metadata was loaded, so they can be dropped as soon as workers are done with them
+				auto it = _preloadedGraphics.begin();
+				while (it != _preloadedGraphics.end()) {
+					if (it->second->State != PreloadState::InProgress) {
+						it = _preloadedGraphics.erase(it);
+					} else {
+						++it;
+					}
 				}
 			}
-#endif
+			bool batchFinished = (_preloadBatchActive && _preloadedMetadata.empty() && _preloadedGraphics.empty());
+			if (batchFinished) {
+				_preloadBatchActive = false;
+			}
+			_preloadMutex.Unlock();
+
+			if (batchFinished) {
+				LOGI("Preloaded {} metadata and {} sprite sheets in {:.1f} ms, main thread stalled for {:.1f} ms", _preloadedMetadataCount,
+					_preloadedGraphicsCount, _preloadStartTime.millisecondsSince(), _preloadStallMs);
+			}
+			if (path.empty()) {
+				break;
+			}
+
+			RequestMetadata(path);
 
-			return it->second.get();
+			if (start.millisecondsSince() >= timeBudgetMs) {
+				break;
+			}
 		}
+#endif
+	}
 
-		// Try to load it
-		auto s = OpenContentFile(fs::CombinePath("Metadata"_s, String(pathNormalized + ".res"_s)));
+	bool ContentResolver::ReadMetadataDocument(StringView path, Json::Value& doc)
+	{
+		auto s = OpenContentFile(fs::CombinePath("Metadata"_s, String(path + ".res"_s)));
 		auto fileSize = s->GetSize();
 		if (fileSize < 4 || fileSize > 64 * 1024 * 1024) {
 			// 64 MB file size limit
 			if (s->IsValid()) {
 				LOGE("Cannot load metadata \"{}\" with unexpected file size of {} bytes", path, fileSize);
 			}
-			return nullptr;
+			return false;
 		}
 
 		auto buffer = std::make_unique<char[]>(fileSize);
 		s->Read(buffer.get(), fileSize);
+		s->Dispose();
+
+		Json::CharReaderBuilder builder;
+		auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
+		std::string errors;
+		if (!reader->parse(buffer.get(), buffer.get() + fileSize, &doc, &errors)) {
+			doc = Json::Value();
+		}
+		return true;
+	}
+
+	ContentResolver::PreloadResult ContentResolver::TakePreloadedMetadata(StringView path, Json::Value& doc)
+	{
+#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		if (_preloadThreadCount == 0) {
+			return PreloadResult::NotQueued;
+		}
+
+		_preloadMutex.Lock();
+		auto it = _preloadedMetadata.find(String::nullTerminatedView(path));
+		if (it == _preloadedMetadata.end()) {
+			_preloadMutex.Unlock();
+			return PreloadResult::NotQueued;
+		}
+		PreloadedMetadata* entry = it->second.get();
+		if (entry->State == PreloadState::Queued) {
+			// No worker got to it yet, loading it right away is faster than waiting in the queue
+			_preloadedMetadata.erase(it);
+			_preloadMutex.Unlock();
+			return PreloadResult::NotQueued;
+		}
+
+		WaitForPreloadedEntry(entry->State);
+		PreloadResult result = (entry->Succeeded ? PreloadResult::Loaded : PreloadResult::Failed);
+		doc = std::move(entry->Document);
+		if (entry->Succeeded) {
+			_preloadedMetadataCount++;
+		}
+		_preloadedMetadata.erase(String::nullTerminatedView(path));
+		_preloadMutex.Unlock();
+		return result;
+#else
+		return PreloadResult::NotQueued;
+#endif
+	}
+
+	ContentResolver::PreloadResult ContentResolver::TakePreloadedGraphics(StringView path, DecodedGraphics& result)
+	{
+#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		if (_preloadThreadCount == 0) {
+			return PreloadResult::NotQueued;
+		}
+
+		_preloadMutex.Lock();
+		auto it = _preloadedGraphics.find(String::nullTerminatedView(path));
+		if (it == _preloadedGraphics.end()) {
+			_preloadMutex.Unlock();
+			return PreloadResult::NotQueued;
+		}
+		PreloadedGraphics* entry = it->second.get();
+		if (entry->State == PreloadState::Queued) {
+			// No worker got to it yet, loading it right away is faster than waiting in the queue
+			_preloadedGraphics.erase(it);
+			_preloadMutex.Unlock();
+			return PreloadResult::NotQueued;
+		}
+
+		WaitForPreloadedEntry(entry->State);
+		PreloadResult status = (entry->Succeeded ? PreloadResult::Loaded : PreloadResult::Failed);
+		result = std::move(entry->Result);
+		if (entry->Succeeded) {
+			_preloadedGraphicsCount++;
+		}
+		_preloadedGraphics.erase(String::nullTerminatedView(path));
+		_preloadMutex.Unlock();
+		return status;
+#else
+		return PreloadResult::NotQueued;
+#endif
+	}
+
+#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+	void ContentResolver::StartPreloadThreads()
+	{
+		// Leave one core for the main thread
+		std::uint32_t processorCount = Thread::GetProcessorCount();
+		_preloadThreadCount = std::clamp(processorCount > 1 ? processorCount - 1 : 1u, 1u, MaxPreloadThreads);
+		_preloadShuttingDown = false;
+
+		for (std::uint32_t i = 0; i < _preloadThreadCount; i++) {
+			_preloadThreads[i] = Thread(ContentResolver::OnPreloadThread, this);
+			_preloadThreads[i].SetName("Asset preload");
+		}
+
+		LOGD("Started {} asset preload threads", _preloadThreadCount);
+	}
+
+	void ContentResolver::StopPreloadThreads()
+	{
+		if (_preloadThreadCount == 0) {
+			return;
+		}
+
+		_preloadMutex.Lock();
+		_preloadShuttingDown = true;
+		_preloadQueue.clear();
+		_preloadMutex.Unlock();
+		_preloadQueueChanged.Broadcast();
+
+		for (std::uint32_t i = 0; i < _preloadThreadCount; i++) {
+			_preloadThreads[i].Join();
+		}
+		_preloadThreadCount = 0;
+
+		_preloadedMetadata.clear();
+		_preloadedGraphics.clear();
+	}
+
+	void ContentResolver::WaitForPreloadedEntry(const PreloadState& state)
+	{
+		if (state == PreloadState::Done) {
+			return;
+		}
+
+		TimeStamp waitStart = TimeStamp::now();
+		do {
+			_preloadEntryFinished.Wait(_preloadMutex);
+		} while (state != PreloadState::Done);
+		_preloadStallMs += waitStart.millisecondsSince();
+	}
+
+	void ContentResolver::OnPreloadThread(void* param)
+	{
+		ContentResolver* _this = static_cast<ContentResolver*>(param);
+
+		_this->_preloadMutex.Lock();
+		while (true) {
+			while (_this->_preloadQueue.empty() && !_this->_preloadShuttingDown) {
+				_this->_preloadQueueChanged.Wait(_this->_preloadMutex);
+			}
+			if (_this->_preloadShuttingDown) {
+				break;
+			}
+
+			PreloadJob job = std::move(_this->_preloadQueue[0]);
+			_this->_preloadQueue.erase(_this->_preloadQueue.begin());
+
+			// The main thread takes over entries that are still queued when it needs them, and entries are never
+			// removed while they are in progress, so the entry stays valid even without holding the lock
+			if (job.IsGraphics) {
+				auto it = _this->_preloadedGraphics.find(job.Path);
+				if (it == _this->_preloadedGraphics.end() || it->second->State != PreloadState::Queued) {
+					continue;
+				}
+				PreloadedGraphics* entry = it->second.get();
+				entry->State = PreloadState::InProgress;
+				_this->_preloadMutex.Unlock();
+
+				auto s = _this->OpenContentFile(fs::CombinePath("Animations"_s, job.Path));
+				bool succeeded = DecodeGraphicsAura(s, true, entry->Result);
+				s = nullptr;
+
+				_this->_preloadMutex.Lock();
+				entry->Succeeded = succeeded;
+				entry->State = PreloadState::Done;
+			} else {
+				auto it = _this->_preloadedMetadata.find(job.Path);
+				if (it == _this->_preloadedMetadata.end() || it->second->State != PreloadState::Queued) {
+					continue;
+				}
+				PreloadedMetadata* entry = it->second.get();
+				entry->State = PreloadState::InProgress;
+				_this->_preloadMutex.Unlock();
+
+				SmallVector<String, 0> graphicsPaths;
+				bool succeeded = _this->ReadMetadataDocument(job.Path, entry->Document);
+				if (succeeded) {
+					CollectPreloadableGraphics(entry->Document, graphicsPaths);
+				}
+
+				_this->_preloadMutex.Lock();
+				// Sprite sheets are queued as separate jobs, so other workers can decode them in parallel
+				for (const auto& graphicsPath : graphicsPaths) {
+					if (_this->_preloadedGraphics.find(graphicsPath) == _this->_preloadedGraphics.end()) {
+						auto& graphicsEntry = _this->_preloadedGraphics.emplace(graphicsPath, std::make_unique<PreloadedGraphics>()).first->second;
+						graphicsEntry->State = PreloadState::Queued;
+						_this->_preloadQueue.push_back({ graphicsPath, true });
+					}
+				}
+				if (!graphicsPaths.empty()) {
+					_this->_preloadQueueChanged.Broadcast();
+				}
+				entry->GraphicsPaths = std::move(graphicsPaths);
+				entry->Succeeded = succeeded;
+				entry->State = PreloadState::Done;
+			}
+
+			_this->_preloadEntryFinished.Broadcast();
+		}
+		_this->_preloadMutex.Unlock();
+	}
+#endif
+
+	Metadata* ContentResolver::RequestMetadata(const ResourceId& id, bool forceIndexed)
+	{
+		// Steady-state requests are resolved by the precomputed hash, without building the cache key. The stored path
+		// is compared too, so paths with colliding hashes can't resolve to each other (the later one then always takes
+		// the path-keyed lookup below).
+		std::uint64_t idKey = GetMetadataIdKey(id, forceIndexed);
+		auto idIt = _metadataById.find(idKey);
+		if (idIt != _metadataById.end() && id.Matches(idIt->second.Path)) {
+			return ReferenceCachedMetadata(idIt->second.Resource);
+		}
+
+		auto pathNormalized = fs::ToNativeSeparators(id.GetPath());
+		// Indexed metadata (animations loaded with keepIndexed for runtime recoloring) is cached under a separate
+		// key - "*" can't appear in a real path - so a baked load of the same path can't shadow the indexed variant
+		// the player needs (and vice versa). Without this, whichever variant loads first wins for everyone.
+		String cacheKey = (forceIndexed ? String(pathNormalized + "*"_s) : String(pathNormalized));
+		auto it = _cachedMetadata.find(cacheKey);
+		if (it != _cachedMetadata.end()) {
+			_metadataById.emplace(idKey, ResourceIdEntry<Metadata>{it->second.get(), id.GetPath()});
+			return ReferenceCachedMetadata(it->second.get());
+		}
+
+		_cacheStats[(std::int32_t)CacheType::Metadata].Misses++;
+
+		// Try to load it, unless a preload worker has already done it
+		Json::Value doc;
+		PreloadResult preloaded = TakePreloadedMetadata(pathNormalized, doc);
+		if (preloaded == PreloadResult::Failed || (preloaded == PreloadResult::NotQueued && !ReadMetadataDocument(pathNormalized, doc))) {
+			return nullptr;
+		}
 
 		bool multipleAnimsNoStatesWarning = false;
 
@@ -626,10 +1125,7 @@ namespace Jazz2
 		metadata->CacheKey = std::move(cacheKey);
 		metadata->Flags |= MetadataFlags::Referenced;
 
-		Json::CharReaderBuilder builder;
-		auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
-		Json::Value doc; std::string errors;
-		if (reader->parse(buffer.get(), buffer.get() + fileSize, &doc, &errors)) {
+		if (doc.isObject()) {
 			metadata->BoundingBox = GetVector2iFromJson(doc["BoundingBox"], Vector2i(InvalidValue, InvalidValue));
 
 			// A file can declare all of its animations deferred at once, and any single entry can opt in or out
@@ -737,7 +1233,7 @@ namespace Jazz2
 								// Additional checks only for Debug configuration
 								for (const auto& anim : metadata->Animations) {
 									if (anim.State == (AnimState)state) {
-										LOGW("Animation state {} defined twice in file \"{}\"", state, path);
+										LOGW("Animation state {} defined twice in file \"{}\"", state, id.GetPath());
 										break;
 									}
 								}
@@ -749,7 +1245,7 @@ namespace Jazz2
 					} else if (count > 1) {
 						if (!multipleAnimsNoStatesWarning) {
 							multipleAnimsNoStatesWarning = true;
-							LOGW("Multiple animations defined but no states specified in file \"{}\"", path);
+							LOGW("Multiple animations defined but no states specified in file \"{}\"", id.GetPath());
 						}
 					} else {
 						graphics.State = AnimState::Default;
@@ -784,11 +1280,15 @@ namespace Jazz2
 								auto it = _cachedSounds.find(assetPathNormalized);
 								if (it != _cachedSounds.end()) {
 									it->second->Flags |= GenericSoundResourceFlags::Referenced;
+									it->second->LastUsed = ++_usageClock;
+									_cacheStats[(std::int32_t)CacheType::Sounds].Hits++;
 									sound.Buffers.push_back(it->second.get());
 								} else {
 									auto s = OpenContentFile(fs::CombinePath("Animations"_s, assetPathNormalized));
 									auto res = _cachedSounds.emplace(assetPathNormalized, std::make_unique<GenericSoundResource>(std::move(s), assetPathNormalized));
 									res.first->second->Flags |= GenericSoundResourceFlags::Referenced;
+									_cacheStats[(std::int32_t)CacheType::Sounds].Misses++;
+									TrackCachedResource(CacheType::Sounds, *res.first->second);
 									sound.Buffers.push_back(res.first->second.get());
 								}
 							}
@@ -800,7 +1300,42 @@ namespace Jazz2
 			}
 		}
 
-		return _cachedMetadata.emplace(metadata->CacheKey, std::move(metadata)).first->second.get();
+		// Linked graphics and sounds are counted in their own caches
+		metadata->ResidentSize = (std::uint32_t)(sizeof(Metadata) + metadata->Path.size() + metadata->CacheKey.size() +
+			metadata->Animations.size() * sizeof(GraphicResource) + metadata->DeferredAnimations.size() * sizeof(DeferredGraphicResource) +
+			metadata->Sounds.size() * (sizeof(String) + sizeof(SoundResource)));
+		TrackCachedResource(CacheType::Metadata, *metadata);
+		Metadata* result = _cachedMetadata.emplace(metadata->CacheKey, std::move(metadata)).first->second.get();
+		_metadataById.emplace(idKey, ResourceIdEntry<Metadata>{result, id.GetPath()});
+		return result;
+	}
+
+	Metadata* ContentResolver::ReferenceCachedMetadata(Metadata* metadata)
+	{
+		// Already loaded - Mark as referenced
+		metadata->Flags |= MetadataFlags::Referenced;
+		metadata->LastUsed = ++_usageClock;
+		_cacheStats[(std::int32_t)CacheType::Metadata].Hits++;
+
+		for (const auto& resource : metadata->Animations) {
+			// Deferred animations that were never looked up have nothing to mark yet, the ones that were
+			// must be marked, because the metadata keeps pointing at them for as long as it stays cached
+			if (resource.Base != nullptr) {
+				resource.Base->Flags |= GenericGraphicResourceFlags::Referenced;
+				resource.Base->LastUsed = _usageClock;
+			}
+		}
+
+#if defined(WITH_AUDIO)
+		for (const auto& [key, resource] : metadata->Sounds) {
+			for (const auto& base : resource.Buffers) {
+				base->Flags |= GenericSoundResourceFlags::Referenced;
+				base->LastUsed = _usageClock;
+			}
+		}
+#endif
+
+		return metadata;
 	}
 
 	bool ContentResolver::ResolveAnimation(Metadata& metadata, GraphicResource& animation)
@@ -828,7 +1363,7 @@ namespace Jazz2
 		return true;
 	}
 
-	GenericGraphicResource* ContentResolver::RequestGraphics(StringView path, std::uint16_t paletteOffset, bool keepIndexed)
+	GenericGraphicResource* ContentResolver::RequestGraphics(const ResourceId& id, std::uint16_t paletteOffset, bool keepIndexed)
 	{
 		// First resources are requested, reset _isLoading flag, because palette should be already applied
 		_isLoading = false;
@@ -836,16 +1371,28 @@ namespace Jazz2
 		// Indexed sprites don't bake a palette, so they're cached under a dedicated key (independent of paletteOffset)
 		std::uint16_t cacheKeyOffset = (keepIndexed ? IndexedGraphicsCacheKey : paletteOffset);
 
-		auto pathNormalized = fs::ToNativeSeparators(path);
+		// Steady-state requests are resolved by the precomputed hash and the stored path, see RequestMetadata()
+		std::uint64_t idKey = GetGraphicsIdKey(id, cacheKeyOffset);
+		auto idIt = _graphicsById.find(idKey);
+		if (idIt != _graphicsById.end() && id.Matches(idIt->second.Path)) {
+			return ReferenceCachedGraphics(idIt->second.Resource);
+		}
+
+		auto pathNormalized = fs::ToNativeSeparators(id.GetPath());
 		auto it = _cachedGraphics.find(Pair(String::nullTerminatedView(pathNormalized), cacheKeyOffset));
 		if (it != _cachedGraphics.end()) {
-			// Already loaded - Mark as referenced
-			it->second->Flags |= GenericGraphicResourceFlags::Referenced;
-			return it->second.get();
+			_graphicsById.emplace(idKey, ResourceIdEntry<GenericGraphicResource>{it->second.get(), id.GetPath()});
+			return ReferenceCachedGraphics(it->second.get());
 		}
 
+		_cacheStats[(std::int32_t)CacheType::Graphics].Misses++;
+
 		if (fs::GetExtension(pathNormalized) == "aura"_s) {
-			return RequestGraphicsAura(pathNormalized, paletteOffset, keepIndexed);
+			GenericGraphicResource* graphics = RequestGraphicsAura(pathNormalized, paletteOffset, keepIndexed);
+			if (graphics != nullptr) {
+				_graphicsById.emplace(idKey, ResourceIdEntry<GenericGraphicResource>{graphics, id.GetPath()});
+			}
+			return graphics;
 		}
 
 		auto s = OpenContentFile(fs::CombinePath("Animations"_s, String(pathNormalized + ".res"_s)));
@@ -853,7 +1400,7 @@ namespace Jazz2
 		if (fileSize < 4 || fileSize > 64 * 1024 * 1024) {
 			// 64 MB file size limit, also if not found try to use cache
 			if (s->IsValid()) {
-				LOGE("Cannot load animation \"{}\" with unexpected file size of {} bytes", path, fileSize);
+				LOGE("Cannot load animation \"{}\" with unexpected file size of {} bytes", id.GetPath(), fileSize);
 			}
 			return nullptr;
 		}
@@ -971,21 +1518,50 @@ namespace Jazz2
 #if defined(DEATH_DEBUG)
 				MigrateGraphics(pathNormalized);
 #endif
-				return _cachedGraphics.emplace(Pair(String(pathNormalized), cacheKeyOffset), std::move(graphics)).first->second.get();
+				graphics->ResidentSize = (graphics->Mask != nullptr ? (w * h + 7) / 8 : 0) +
+					(graphics->TextureDiffuse != nullptr ? graphics->TextureDiffuse->GetDataSize() : 0);
+				TrackCachedResource(CacheType::Graphics, *graphics);
+				GenericGraphicResource* result = _cachedGraphics.emplace(Pair(String(pathNormalized), cacheKeyOffset), std::move(graphics)).first->second.get();
+				_graphicsById.emplace(idKey, ResourceIdEntry<GenericGraphicResource>{result, id.GetPath()});
+				return result;
 			}
 		}
 
 		return nullptr;
 	}
 
+	GenericGraphicResource* ContentResolver::ReferenceCachedGraphics(GenericGraphicResource* graphics)
+	{
+		// Already loaded - Mark as referenced
+		graphics->Flags |= GenericGraphicResourceFlags::Referenced;
+		graphics->LastUsed = ++_usageClock;
+		_cacheStats[(std::int32_t)CacheType::Graphics].Hits++;
+		return graphics;
+	}
+
 	GenericGraphicResource* ContentResolver::RequestGraphicsAura(StringView path, std::uint16_t paletteOffset, bool keepIndexed)
 	{
-		auto s = OpenContentFile(fs::CombinePath("Animations"_s, path));
+		// Preload workers always decode sheets as indexed, because that's how metadata requests them
+		DecodedGraphics decoded;
+		PreloadResult preloaded = (keepIndexed ? TakePreloadedGraphics(path, decoded) : PreloadResult::NotQueued);
+		if (preloaded == PreloadResult::NotQueued) {
+			auto s = OpenContentFile(fs::CombinePath("Animations"_s, path));
+			if (!DecodeGraphicsAura(s, keepIndexed, decoded)) {
+				return nullptr;
+			}
+		} else if (preloaded == PreloadResult::Failed) {
+			return nullptr;
+		}
+
+		return CreateGraphicsAura(path, paletteOffset, keepIndexed, decoded);
+	}
 
+	bool ContentResolver::DecodeGraphicsAura(std::unique_ptr<Stream>& s, bool keepIndexed, DecodedGraphics& result)
+	{
 		auto fileSize = s->GetSize();
 		if (fileSize < 16 || fileSize > 64 * 1024 * 1024) {
 			// 64 MB file size limit, also if not found try to use cache
-			return nullptr;
+			return false;
 		}
 
 		std::uint64_t signature1 = s->ReadValueAsLE<std::uint64_t>();
@@ -994,7 +1570,7 @@ namespace Jazz2
 		std::uint8_t flags = s->ReadValue<std::uint8_t>();
 
 		if (signature1 != 0xB8EF8498E2BFBBEF || signature2 != 0x208F || version != 2 || (flags & 0x80) != 0x80) {
-			return nullptr;
+			return false;
 		}
 
 		std::uint8_t channelCount = s->ReadValue<std::uint8_t>();
@@ -1045,39 +1621,18 @@ namespace Jazz2
 		// for 4 bytes/pixel meant allocating four times what an 8-bit sheet needs.
 		// Only a sprite that keeps its indices needs no expansion; everything else is either baked in place or
 		// uploaded as RGBA, both of which read the buffer as 4 bytes/pixel. The condition mirrors exactly the
-		// one that sets GenericGraphicResourceFlags::Indexed below.
+		// one that sets GenericGraphicResourceFlags::Indexed in CreateGraphicsAura().
 		const bool willStayIndexed = (keepIndexed && (flags & 0x01) != 0x01);
 		const std::uint32_t sourceStride = (willStayIndexed ? channelCount : PixelSize);
 		std::unique_ptr<std::uint8_t[]> pixels = std::make_unique<std::uint8_t[]>(width * height * sourceStride + 3);
 
 		ReadImageFromFile(s, pixels.get(), width, height, channelCount);
 
-		std::unique_ptr<GenericGraphicResource> graphics = std::make_unique<GenericGraphicResource>();
-		graphics->Flags |= GenericGraphicResourceFlags::Referenced;
-
-		const std::uint32_t* palette = _palettes + paletteOffset;
-		bool linearSampling = false;
-		bool needsMask = true;
-		if ((flags & 0x01) == 0x01) {
-			palette = nullptr;
-			linearSampling = true;
-		}
-		if ((flags & 0x02) == 0x02) {
-			needsMask = false;
-		}
-
-		// Keep the raw palette indices in the texture (red channel) instead of baking colors, so the sprite can be
-		// recolored at draw time by the PaletteRemap shader. Only meaningful for actually palette-based sprites.
-		if (keepIndexed && palette != nullptr) {
-			palette = nullptr;
-			graphics->Flags |= GenericGraphicResourceFlags::Indexed;
-		}
-
-		if (needsMask) {
+		if ((flags & 0x02) != 0x02) {
 			// One bit per pixel: collision only tests solidity against MaskAlphaThreshold
 			const std::uint32_t maskBytes = (width * height + 7) / 8;
-			graphics->Mask = std::make_unique<std::uint8_t[]>(maskBytes);
-			std::memset(graphics->Mask.get(), 0, maskBytes);
+			result.Mask = std::make_unique<std::uint8_t[]>(maskBytes);
+			std::memset(result.Mask.get(), 0, maskBytes);
 			for (std::uint32_t i = 0; i < width * height; i++) {
 				// The decoded buffer is tightly packed to `channelCount` bytes/pixel: a 1-channel (index-only)
 				// sprite is opaque except index 0 (transparent), a 2-channel sprite has explicit alpha in green,
@@ -1091,10 +1646,67 @@ namespace Jazz2
 					alpha = pixels[(i * channelCount) + 3];
 				}
 				if (alpha > MaskAlphaThreshold) {
-					graphics->Mask[i >> 3] |= std::uint8_t(1) << (i & 7);
+					result.Mask[i >> 3] |= std::uint8_t(1) << (i & 7);
 				}
 			}
 		}
+
+		result.Pixels = std::move(pixels);
+		result.FrameRects = std::move(frameRects);
+		result.Width = width;
+		result.Height = height;
+		result.FrameDimensions = Vector2i(frameDimensionsX, frameDimensionsY);
+		result.FrameConfiguration = Vector2i(frameConfigurationX, frameConfigurationY);
+		result.FrameCount = frameCount;
+		result.AnimDuration = animDuration;
+		result.Flags = flags;
+		result.ChannelCount = channelCount;
+
+		if (hotspotX != UINT16_MAX || hotspotY != UINT16_MAX) {
+			result.Hotspot = Vector2i(hotspotX, hotspotY);
+		} else {
+			result.Hotspot = Vector2i();
+		}
+
+		if (coldspotX != UINT16_MAX || coldspotY != UINT16_MAX) {
+			result.Coldspot = Vector2i(coldspotX, coldspotY);
+		} else {
+			result.Coldspot = Vector2i(InvalidValue, InvalidValue);
+		}
+
+		if (gunspotX != UINT16_MAX || gunspotY != UINT16_MAX) {
+			result.Gunspot = Vector2i(gunspotX, gunspotY);
+		} else {
+			result.Gunspot = Vector2i(InvalidValue, InvalidValue);
+		}
+
+		return true;
+	}
+
+	GenericGraphicResource* ContentResolver::CreateGraphicsAura(StringView path, std::uint16_t paletteOffset, bool keepIndexed, DecodedGraphics& decoded)
+	{
+		std::unique_ptr<GenericGraphicResource> graphics = std::make_unique<GenericGraphicResource>();
+		graphics->Flags |= GenericGraphicResourceFlags::Referenced;
+
+		const std::uint32_t width = decoded.Width;
+		const std::uint32_t height = decoded.Height;
+		const std::uint32_t channelCount = decoded.ChannelCount;
+		std::uint8_t* pixels = decoded.Pixels.get();
+
+		const std::uint32_t* palette = _palettes + paletteOffset;
+		bool linearSampling = false;
+		if ((decoded.Flags & 0x01) == 0x01) {
+			palette = nullptr;
+			linearSampling = true;
+		}
+
+		// Keep the raw palette indices in the texture (red channel) instead of baking colors, so the sprite can be
+		// recolored at draw time by the PaletteRemap shader. Only meaningful for actually palette-based sprites.
+		if (keepIndexed && palette != nullptr) {
+			palette = nullptr;
+			graphics->Flags |= GenericGraphicResourceFlags::Indexed;
+		}
+
 		if (palette != nullptr) {
 			// Expanded from the back: the destination stride (RGBA) is never narrower than the decoded one, so
 			// working downwards guarantees a pixel is read before anything can be written over it. Reading at
@@ -1130,41 +1742,30 @@ namespace Jazz2
 			// Don't load textures in headless mode, only collision masks
 			if ((graphics->Flags & GenericGraphicResourceFlags::Indexed) == GenericGraphicResourceFlags::Indexed) {
 				bool paletteBaseTransparent = (((_palettes[paletteOffset] >> 24) & 0xFF) == 0);
-				graphics->TextureDiffuse = CreateIndexedTexture(path.data(), pixels.get(), width, height, channelCount, paletteBaseTransparent);
+				graphics->TextureDiffuse = CreateIndexedTexture(path.data(), pixels, width, height, channelCount, paletteBaseTransparent);
 			} else {
 				graphics->TextureDiffuse = std::make_unique<Texture>(path.data(), Texture::Format::RGBA8, width, height);
-				graphics->TextureDiffuse->LoadFromTexels(pixels.get(), 0, 0, width, height);
+				graphics->TextureDiffuse->LoadFromTexels(pixels, 0, 0, width, height);
 			}
 			graphics->TextureDiffuse->SetMinFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
 			graphics->TextureDiffuse->SetMagFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
 		}
 
 		// AnimDuration is multiplied by 256 before saving, so divide it here back
-		graphics->AnimDuration = animDuration / 256.0f;
-		graphics->FrameDimensions = Vector2i(frameDimensionsX, frameDimensionsY);
-		graphics->FrameConfiguration = Vector2i(frameConfigurationX, frameConfigurationY);
-		graphics->FrameCount = frameCount;
-		graphics->FrameRects = std::move(frameRects);
+		graphics->AnimDuration = decoded.AnimDuration / 256.0f;
+		graphics->FrameDimensions = decoded.FrameDimensions;
+		graphics->FrameConfiguration = decoded.FrameConfiguration;
+		graphics->FrameCount = decoded.FrameCount;
+		graphics->FrameRects = std::move(decoded.FrameRects);
+		graphics->Mask = std::move(decoded.Mask);
 		// The collision mask covers the whole sheet, so its rows are as wide as the sheet
 		graphics->MaskStride = (std::int32_t)width;
-
-		if (hotspotX != UINT16_MAX || hotspotY != UINT16_MAX) {
-			graphics->Hotspot = Vector2i(hotspotX, hotspotY);
-		} else {
-			graphics->Hotspot = Vector2i();
-		}
-
-		if (coldspotX != UINT16_MAX || coldspotY != UINT16_MAX) {
-			graphics->Coldspot = Vector2i(coldspotX, coldspotY);
-		} else {
-			graphics->Coldspot = Vector2i(InvalidValue, InvalidValue);
-		}
-
-		if (gunspotX != UINT16_MAX || gunspotY != UINT16_MAX) {
-			graphics->Gunspot = Vector2i(gunspotX, gunspotY);
-		} else {
-			graphics->Gunspot = Vector2i(InvalidValue, InvalidValue);
-		}
+		graphics->Hotspot = decoded.Hotspot;
+		graphics->Coldspot = decoded.Coldspot;
+		graphics->Gunspot = decoded.Gunspot;
+		graphics->ResidentSize = (graphics->Mask != nullptr ? (width * height + 7) / 8 : 0) +
+			(graphics->TextureDiffuse != nullptr ? graphics->TextureDiffuse->GetDataSize() : 0);
+		TrackCachedResource(CacheType::Graphics, *graphics);
 
 		// Indexed sprites are cached under a dedicated key (matching the lookup in RequestGraphics) so they don't
 		// collide with the baked variant of the same sprite
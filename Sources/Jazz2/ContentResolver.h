@@ -5,6 +5,7 @@
 #include "GameDifficulty.h"
 #include "LevelDescriptor.h"
 #include "PlayerType.h"
+#include "ResourceId.h"
 #include "Resources.h"
 #include "UI/Font.h"
 
@@ -13,6 +14,12 @@
 #include "../nCine/Graphics/Texture.h"
 #include "../nCine/Base/HashMap.h"
 
+#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+#	include "../nCine/Base/TimeStamp.h"
+#	include "../nCine/Threading/Thread.h"
+#	include "../nCine/Threading/ThreadSync.h"
+#endif
+
 #include <Containers/Function.h>
 #include <Containers/Pair.h>
 #include <Containers/Reference.h>
@@ -28,6 +35,11 @@ namespace ShaderCompiler
 	struct Program;
 }
 
+namespace Json
+{
+	class Value;
+}
+
 namespace nCine
 {
 	class RenderCommand;
@@ -116,6 +128,36 @@ namespace Jazz2
 
 		/** @} */
 
+		/** @brief Cache of loaded assets */
+		enum class CacheType {
+			Metadata,				/**< Metadata */
+			Graphics,				/**< Textures and collision masks */
+			Sounds,					/**< Audio buffers */
+
+			Count					/**< Number of caches */
+		};
+
+		/** @brief Statistics of a cache of loaded assets */
+		struct CacheStatistics {
+			/** @brief Memory taken by all cached assets in bytes */
+			std::uint64_t ResidentSize;
+			/** @brief Budget in bytes, see @ref SetCacheBudget() */
+			std::uint64_t Budget;
+			/** @brief Number of cached assets */
+			std::uint32_t Count;
+			/** @brief Number of requests served from the cache */
+			std::uint32_t Hits;
+			/** @brief Number of requests that had to load the asset */
+			std::uint32_t Misses;
+			/** @brief Number of assets released to fit the budget */
+			std::uint32_t Evictions;
+
+			/** @brief Returns ratio of requests served from the cache */
+			float GetHitRate() const {
+				return (Hits + Misses > 0 ? (float)Hits / (float)(Hits + Misses) : 0.0f);
+			}
+		};
+
 		/** @brief Returns static instance of main content resolver */
 		static ContentResolver& Get();
 
@@ -166,30 +208,63 @@ namespace Jazz2
 		
 		/** @brief Marks beginning of the loading assets */
 		void BeginLoading();
-		/** @brief Marks end of the loading assets */
+		/**
+		 * @brief Marks end of the loading assets
+		 *
+		 * Assets that weren't requested since @ref BeginLoading() are kept for later, until their cache exceeds its
+		 * budget --- then the least recently used ones are released first.
+		 */
 		void EndLoading();
 
+		/**
+		 * @brief Sets the budget of specified cache in bytes
+		 *
+		 * Assets that are referenced by the current level are never released, so they alone can exceed the budget.
+		 * The rest is kept across level changes as long as the whole cache fits. Zero keeps only referenced assets.
+		 */
+		void SetCacheBudget(CacheType type, std::uint64_t bytes);
+		/** @brief Returns statistics of specified cache */
+		CacheStatistics GetCacheStatistics(CacheType type) const;
+
 		/** @brief Overrides the default path handler */
 		void OverridePathHandler(Function<String(StringView)>&& callback);
 
-		/** @brief Preloads specified metadata and its linked assets to cache */
+		/**
+		 * @brief Preloads specified metadata and its linked assets to cache
+		 *
+		 * The metadata file is parsed and its (non-deferred) sprite sheets are decompressed on background threads,
+		 * so the call returns immediately. @ref RequestMetadata() then waits only for the entry it needs, and
+		 * @ref ProcessPreloadedAssets() finishes the rest on the main thread in small slices. Without thread support,
+		 * the metadata is loaded synchronously.
+		 */
 		void PreloadMetadataAsync(StringView path);
+		/**
+		 * @brief Turns assets preloaded in the background into cached resources, until the time budget runs out
+		 *
+		 * Should be called once per frame on the main thread, so textures are created and uploaded over several
+		 * frames instead of stalling the first frame that needs them.
+		 */
+		void ProcessPreloadedAssets(float timeBudgetMs);
 		/**
 		 * @brief Loads specified metadata and its linked assets (cached)
 		 *
-		 * @param path          Relative path to the metadata asset
+		 * @param id            Relative path to the metadata asset
 		 * @param forceIndexed  Load all linked graphics as indexed (palette not baked) so they can be recolored at draw
 		 *                      time - used for the player so each player can have a custom color scheme
+		 *
+		 * Already cached metadata is found by the precomputed hash of @p id and a comparison of its path.
 		 */
-		Metadata* RequestMetadata(StringView path, bool forceIndexed = false);
+		Metadata* RequestMetadata(const ResourceId& id, bool forceIndexed = false);
 		/**
 		 * @brief Loads specified graphics asset (cached)
 		 *
-		 * @param path           Relative path to the graphics asset
+		 * @param id             Relative path to the graphics asset
 		 * @param paletteOffset  Index of the first palette color used to bake the sprite (ignored when `keepIndexed`)
 		 * @param keepIndexed    Keep raw palette indices in the texture (don't bake the palette) for shader recoloring
+		 *
+		 * Already cached graphics are found by the precomputed hash of @p id and a comparison of its path.
 		 */
-		GenericGraphicResource* RequestGraphics(StringView path, std::uint16_t paletteOffset, bool keepIndexed = false);
+		GenericGraphicResource* RequestGraphics(const ResourceId& id, std::uint16_t paletteOffset, bool keepIndexed = false);
 		/**
 		 * @brief Loads the graphics of a deferred animation entry and returns whether they are ready to be drawn
 		 *
@@ -353,7 +428,47 @@ namespace Jazz2
 		// from any real paletteOffset so indexed and baked variants of the same sprite are cached separately
 		static constexpr std::uint16_t IndexedGraphicsCacheKey = UINT16_MAX;
 
+		// Sprite sheet read from an ".aura" file and decompressed, but not turned into a resource yet, so that part
+		// can run on a preload worker; only palette baking and texture creation have to stay on the main thread
+		struct DecodedGraphics {
+			std::unique_ptr<std::uint8_t[]> Pixels;
+			std::unique_ptr<std::uint8_t[]> Mask;
+			SmallVector<Resources::FrameRect, 0> FrameRects;
+			std::uint32_t Width;
+			std::uint32_t Height;
+			Vector2i FrameDimensions;
+			Vector2i FrameConfiguration;
+			Vector2i Hotspot;
+			Vector2i Coldspot;
+			Vector2i Gunspot;
+			std::uint16_t FrameCount;
+			std::uint16_t AnimDuration;
+			std::uint8_t Flags;
+			std::uint8_t ChannelCount;
+		};
+
+		enum class PreloadResult {
+			NotQueued,
+			Loaded,
+			Failed
+		};
+
+		// Reads and parses "Metadata/<path>.res", returns false if the file is missing or has unexpected size. A file
+		// that can't be parsed leaves `doc` null. Called also from preload workers, so it mustn't touch any cache.
+		bool ReadMetadataDocument(StringView path, Json::Value& doc);
+		// Marks cached metadata and everything it points to as referenced
+		Metadata* ReferenceCachedMetadata(Metadata* metadata);
+		// Marks cached graphics as referenced
+		GenericGraphicResource* ReferenceCachedGraphics(GenericGraphicResource* graphics);
 		GenericGraphicResource* RequestGraphicsAura(StringView path, std::uint16_t paletteOffset, bool keepIndexed = false);
+		// Reads the header and decompresses the sheet (and its collision mask if it has one), thread-safe
+		static bool DecodeGraphicsAura(std::unique_ptr<Stream>& s, bool keepIndexed, DecodedGraphics& result);
+		// Bakes the palette if needed, creates the texture and adds the resource to the cache, main thread only
+		GenericGraphicResource* CreateGraphicsAura(StringView path, std::uint16_t paletteOffset, bool keepIndexed, DecodedGraphics& decoded);
+		// Takes the result of a preload of the specified entry, waits for it only if a worker is already processing it.
+		// An entry that is still queued is removed from the queue instead and `PreloadResult::NotQueued` is returned.
+		PreloadResult TakePreloadedMetadata(StringView path, Json::Value& doc);
+		PreloadResult TakePreloadedGraphics(StringView path, DecodedGraphics& result);
 		static void ReadImageFromFile(std::unique_ptr<Stream>& s, std::uint8_t* data, std::int32_t width, std::int32_t height, std::int32_t channelCount);
 		// Copies a tile's edge pixels into its 1px atlas padding (so sampling never bleeds across tiles); `bytesPerPixel`
 		// is 1 for an indexed (R8) atlas or 4 for a baked RGBA atlas
@@ -404,6 +519,37 @@ namespace Jazz2
 #if defined(DEATH_DEBUG)
 		void MigrateGraphics(StringView path);
 #endif
+#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		static constexpr std::uint32_t MaxPreloadThreads = 4;
+
+		enum class PreloadState {
+			Queued,
+			InProgress,
+			Done
+		};
+
+		struct PreloadedMetadata;
+		struct PreloadedGraphics;
+
+		struct PreloadJob {
+			String Path;
+			bool IsGraphics;
+		};
+
+		void StartPreloadThreads();
+		void StopPreloadThreads();
+		// Waits until a worker finishes the entry, `_preloadMutex` must be locked
+		void WaitForPreloadedEntry(const PreloadState& state);
+
+		static void OnPreloadThread(void* param);
+#endif
+
+		// Marks a newly cached resource as the most recently used one and adds it to the resident size of its cache
+		template<class T>
+		void TrackCachedResource(CacheType type, T& resource) {
+			resource.LastUsed = ++_usageClock;
+			_cacheStats[(std::int32_t)type].ResidentSize += resource.ResidentSize;
+		}
 
 		bool _isHeadless;
 		bool _isLoading;
@@ -427,8 +573,39 @@ namespace Jazz2
 #endif
 			StringRefEqualTo> _cachedMetadata;
 		HashMap<Pair<String, std::uint16_t>, std::unique_ptr<GenericGraphicResource>> _cachedGraphics;
+		// Cached resource registered under a resource ID, the path tells apart IDs with colliding hashes
+		template<class T>
+		struct ResourceIdEntry
+		{
+			T* Resource;
+			String Path;
+		};
+
+		// Already cached resources by hashes of their resource IDs, see GetMetadataIdKey() and GetGraphicsIdKey()
+		HashMap<std::uint64_t, ResourceIdEntry<Metadata>, ResourceIdHash> _metadataById;
+		HashMap<std::uint64_t, ResourceIdEntry<GenericGraphicResource>, ResourceIdHash> _graphicsById;
 #if defined(WITH_AUDIO)
 		HashMap<String, std::unique_ptr<GenericSoundResource>> _cachedSounds;
+#endif
+		CacheStatistics _cacheStats[(std::int32_t)CacheType::Count];
+		// Incremented on every request, so resources can be ordered by their last use
+		std::uint32_t _usageClock;
+#if defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		Mutex _preloadMutex;
+		CondVariable _preloadQueueChanged;
+		CondVariable _preloadEntryFinished;
+		SmallVector<PreloadJob, 0> _preloadQueue;										// Guarded by _preloadMutex
+		HashMap<String, std::unique_ptr<PreloadedMetadata>> _preloadedMetadata;			// Guarded by _preloadMutex
+		HashMap<String, std::unique_ptr<PreloadedGraphics>> _preloadedGraphics;			// Guarded by _preloadMutex
+		bool _preloadShuttingDown;														// Guarded by _preloadMutex
+		std::uint32_t _preloadThreadCount;
+		Thread _preloadThreads[MaxPreloadThreads];
+		// Statistics of the current preload batch (main thread only), reported once the batch is fully processed
+		bool _preloadBatchActive;
+		TimeStamp _preloadStartTime;
+		float _preloadStallMs;
+		std::int32_t _preloadedMetadataCount;
+		std::int32_t _preloadedGraphicsCount;
 #endif
 		std::unique_ptr<UI::Font> _fonts[(std::int32_t)FontType::Count];
 		std::unique_ptr<Shader> _precompiledShaders[(std::int32_t)PrecompiledShader::Count];
@@ -10,6 +10,7 @@
 #include "../nCine/Audio/AudioBufferPlayer.h"
 
 #include <Base/TypeInfo.h>
+#include <Containers/SmallVector.h>
 
 namespace Death::IO
 {
@@ -56,6 +57,8 @@ namespace Jazz2
 		static constexpr std::int32_t SpritePlaneZ = MainPlaneZ + 10;
 		/** @brief Layer of players */
 		static constexpr std::int32_t PlayerZ = MainPlaneZ + 20;
+		/** @brief Number of collision query results that fit into the stack buffer without allocation */
+		static constexpr std::uint32_t QueryResultCapacity = 64;
 
 		/** @} */
 
@@ -161,12 +164,41 @@ namespace Jazz2
 			return IsPositionEmpty(self, aabb, params, &collider);
 		}
 
-		/** @brief Calls the callback function for all colliding objects with specified AABB */
-		virtual void FindCollisionActorsByAABB(const Actors::ActorBase* self, const AABBf& aabb, Function<bool(Actors::ActorBase*)>&& callback) = 0;
-		/** @brief Calls the callback function for all colliding objects with specified circle */
-		virtual void FindCollisionActorsByRadius(float x, float y, float radius, Function<bool(Actors::ActorBase*)>&& callback) = 0;
-		/** @brief Calls the callback function for all colliding players with specified AABB */
-		virtual void GetCollidingPlayers(const AABBf& aabb, Function<bool(Actors::ActorBase*)>&& callback) = 0;
+		/** @brief Appends all colliding objects with specified AABB to the list */
+		virtual void CollectCollisionActorsByAABB(const Actors::ActorBase* self, const AABBf& aabb, SmallVectorImpl<Actors::ActorBase*>& result) = 0;
+		/** @brief Appends all colliding objects with specified circle to the list */
+		virtual void CollectCollisionActorsByRadius(float x, float y, float radius, SmallVectorImpl<Actors::ActorBase*>& result) = 0;
+		/** @brief Appends all colliding players with specified AABB to the list */
+		virtual void CollectCollidingPlayers(const AABBf& aabb, SmallVectorImpl<Actors::ActorBase*>& result) = 0;
+
+		/**
+		 * @brief Calls the callback function for all colliding objects with specified AABB
+		 *
+		 * The callback is called with @ref Actors::ActorBase* and should return `false` to stop the enumeration.
+		 * Results are collected to a stack buffer first, so no allocation happens in the common case.
+		 */
+		template<typename Callback>
+		void FindCollisionActorsByAABB(const Actors::ActorBase* self, const AABBf& aabb, Callback&& callback) {
+			SmallVector<Actors::ActorBase*, QueryResultCapacity> result;
+			CollectCollisionActorsByAABB(self, aabb, result);
+			VisitQueryResult(result, callback, Actors::ActorState::CollideWithOtherActors);
+		}
+
+		/** @brief Calls the callback function for all colliding objects with specified circle, see @ref FindCollisionActorsByAABB() */
+		template<typename Callback>
+		void FindCollisionActorsByRadius(float x, float y, float radius, Callback&& callback) {
+			SmallVector<Actors::ActorBase*, QueryResultCapacity> result;
+			CollectCollisionActorsByRadius(x, y, radius, result);
+			VisitQueryResult(result, callback, Actors::ActorState::CollideWithOtherActors);
+		}
+
+		/** @brief Calls the callback function for all colliding players with specified AABB, see @ref FindCollisionActorsByAABB() */
+		template<typename Callback>
+		void GetCollidingPlayers(const AABBf& aabb, Callback&& callback) {
+			SmallVector<Actors::ActorBase*, QueryResultCapacity> result;
+			CollectCollidingPlayers(aabb, result);
+			VisitQueryResult(result, callback, Actors::ActorState::None);
+		}
 
 		/** @brief Broadcasts specified event to all other actors */
 		virtual void BroadcastTriggeredEvent(Actors::ActorBase* initiator, EventType eventType, std::uint8_t* eventParams) = 0;
@@ -246,5 +278,22 @@ namespace Jazz2
 		virtual float PlayerVerticalMovement(Actors::Player* player) = 0;
 		/** @brief Executes a rumble effect */
 		virtual void PlayerExecuteRumble(Actors::Player* player, StringView rumbleEffect) = 0;
+
+	private:
+		template<typename Callback>
+		static void VisitQueryResult(const SmallVectorImpl<Actors::ActorBase*>& result, Callback& callback, Actors::ActorState requiredState) {
+			for (Actors::ActorBase* actor : result) {
+				// The callback of a preceding actor could destroy the actor or change its state, so the filter of
+				// the query is applied again to skip actors it would no longer return
+				if ((actor->GetState() & (requiredState | Actors::ActorState::IsDestroyed)) != requiredState) {
+					continue;
+				}
+				if constexpr (std::is_void_v<decltype(callback(actor))>) {
+					callback(actor);
+				} else if (!callback(actor)) {
+					break;
+				}
+			}
+		}
 	};
 }
\ No newline at end of file
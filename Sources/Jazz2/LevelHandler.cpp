@@ -3,6 +3,7 @@
 #include "PreferencesCache.h"
 #include "Rendering/PlayerViewport.h"
 #include "UI/DiscordRpcClient.h"
+#include "UI/FormattedTextBlock.h"
 #include "UI/HUD.h"
 #include "UI/InGameConsole.h"
 #include "UI/Menu/InGameMenu.h"
@@ -110,7 +111,9 @@ namespace Jazz2
 #if defined(RHI_CAP_SHADERS) && defined(RHI_CAP_FRAMEBUFFERS)
 			_lightingMeshShader(nullptr), _blurShader(nullptr), _downsampleShader(nullptr), _combineShader(nullptr), _combineWithWaterShader(nullptr),
 #endif
-			_eventSpawner(this), _difficulty(GameDifficulty::Default), _isReforged(false),
+			_eventSpawner(this), _collisions(Collisions::IBroadPhase::Create(PreferencesCache::CollisionBroadPhase)),
+			_collisionQueryCount(0), _collisionQueryCacheHits(0), _emittedLightsFrame(UINT32_MAX),
+			_difficulty(GameDifficulty::Default), _isReforged(false),
 			_cheatsUsed(false), _checkpointCreated(false), _nextLevelType(ExitType::None),
 			_nextLevelTime(0.0f), _elapsedMillisecondsBegin(0), _elapsedFrames(0.0f), _checkpointFrames(0.0f),
 			_waterLevel(FLT_MAX), _weatherType(WeatherType::None), _pressedKeys(ValueInit, (std::size_t)Keys::Count),
@@ -517,6 +520,7 @@ namespace Jazz2
 				if (fs::IsReadableFile(scriptPathCaseInsensitive)) {
 #	if defined(WITH_ANGELSCRIPT)
 					_scripts = std::make_unique<Scripting::LevelScriptLoader>(this, scriptPathCaseInsensitive);
+					_scripts->GetProfiler().SetFrameBudget(PreferencesCache::ScriptFrameBudget);
 #	else
 					LOGW("Level requires scripting, but scripting support is disabled in this build");
 #	endif
@@ -548,7 +552,7 @@ namespace Jazz2
 				}
 			}
 
-			std::shared_ptr<Actors::Player> player = std::make_shared<Actors::Player>();
+			std::shared_ptr<Actors::Player> player = Actors::CreateActor<Actors::Player>();
 			std::uint8_t playerParams[2] = { (std::uint8_t)levelInit.PlayerCarryOvers[i].Type, (std::uint8_t)i };
 			player->OnActivated(Actors::ActorActivationDetails(
 				this,
@@ -570,7 +574,7 @@ namespace Jazz2
 
 	std::shared_ptr<Actors::Player> LevelHandler::CreateResumablePlayer(std::int32_t index)
 	{
-		return std::make_shared<Actors::Player>();
+		return Actors::CreateActor<Actors::Player>();
 	}
 
 	bool LevelHandler::IsCheatingAllowed(Actors::Player* player)
@@ -587,6 +591,9 @@ namespace Jazz2
 	{
 		ZoneScopedC(0x4876AF);
 
+		// Finish loading of assets that were preloaded in the background, but only a small slice per frame
+		ContentResolver::Get().ProcessPreloadedAssets(2.0f);
+
 		float timeMult = theApplication().GetTimeMult();
 
 		if (_pauseMenu == nullptr) {
@@ -728,6 +735,13 @@ namespace Jazz2
 					drawList->AddRect(aabbMin, aabbMax, ImColor(120, 200, 255, 180));
 					drawList->AddRect(aabbInnerMin, aabbInnerMax, ImColor(255, 255, 255));
 				}
+
+#	if defined(WITH_ANGELSCRIPT)
+				if (_scripts != nullptr) {
+					ShowScriptProfilerWindow();
+				}
+#	endif
+				ShowTextLayoutCacheWindow();
 			}
 #endif
 		}
@@ -930,7 +944,8 @@ namespace Jazz2
 
 		if (!actor->GetState(Actors::ActorState::ForceDisableCollisions)) {
 			actor->UpdateAABB();
-			actor->_collisionProxyID = _collisions.CreateProxy(actor->AABB, actor.get());
+			actor->_collisionProxyID = _collisions->CreateProxy(actor->AABB, actor.get());
+			_collisionQueryCache.Invalidate();
 		}
 
 		_actors.push_back(std::move(actor));
@@ -1059,78 +1074,94 @@ namespace Jazz2
 		return (*collider == nullptr);
 	}
 
-	void LevelHandler::FindCollisionActorsByAABB(const Actors::ActorBase* self, const AABBf& aabb, Function<bool(Actors::ActorBase*)>&& callback)
+	void LevelHandler::CollectCollisionActorsByAABB(const Actors::ActorBase* self, const AABBf& aabb, SmallVectorImpl<Actors::ActorBase*>& result)
 	{
-		struct QueryHelper {
-			const LevelHandler* Handler;
-			const Actors::ActorBase* Self;
-			const AABBf& AABB;
-			Function<bool(Actors::ActorBase*)>& Callback;
+		ZoneScopedC(0x4876AF);
 
-			bool OnCollisionQuery(std::int32_t nodeId) {
-				Actors::ActorBase* actor = (Actors::ActorBase*)Handler->_collisions.GetUserData(nodeId);
-				if (Self == actor || (actor->GetState() & (Actors::ActorState::CollideWithOtherActors | Actors::ActorState::IsDestroyed)) != Actors::ActorState::CollideWithOtherActors) {
-					return true;
-				}
-				if (actor->IsCollidingWith(AABB)) {
-					return Callback(actor);
-				}
-				return true;
+		for (void* userData : QueryCollisionCandidates(aabb)) {
+			Actors::ActorBase* actor = (Actors::ActorBase*)userData;
+			if (self == actor || (actor->GetState() & (Actors::ActorState::CollideWithOtherActors | Actors::ActorState::IsDestroyed)) != Actors::ActorState::CollideWithOtherActors) {
+				continue;
 			}
-		};
-
-		QueryHelper helper = { this, self, aabb, callback };
-		_collisions.Query(&helper, aabb);
+			if (actor->IsCollidingWith(aabb)) {
+				result.push_back(actor);
+			}
+		}
 	}
 
-	void LevelHandler::FindCollisionActorsByRadius(float x, float y, float radius, Function<bool(Actors::ActorBase*)>&& callback)
+	void LevelHandler::CollectCollisionActorsByRadius(float x, float y, float radius, SmallVectorImpl<Actors::ActorBase*>& result)
 	{
+		ZoneScopedC(0x4876AF);
+
 		AABBf aabb = AABBf(x - radius, y - radius, x + radius, y + radius);
 		float radiusSquared = (radius * radius);
 
-		struct QueryHelper {
-			const LevelHandler* Handler;
-			const float x, y;
-			const float RadiusSquared;
-			Function<bool(Actors::ActorBase*)>& Callback;
-
-			bool OnCollisionQuery(std::int32_t nodeId) {
-				Actors::ActorBase* actor = (Actors::ActorBase*)Handler->_collisions.GetUserData(nodeId);
-				if ((actor->GetState() & (Actors::ActorState::CollideWithOtherActors | Actors::ActorState::IsDestroyed)) != Actors::ActorState::CollideWithOtherActors) {
-					return true;
-				}
-
-				// Find the closest point to the circle within the rectangle
-				float closestX = std::clamp(x, actor->AABB.L, actor->AABB.R);
-				float closestY = std::clamp(y, actor->AABB.T, actor->AABB.B);
+		for (void* userData : QueryCollisionCandidates(aabb)) {
+			Actors::ActorBase* actor = (Actors::ActorBase*)userData;
+			if ((actor->GetState() & (Actors::ActorState::CollideWithOtherActors | Actors::ActorState::IsDestroyed)) != Actors::ActorState::CollideWithOtherActors) {
+				continue;
+			}
 
-				// Calculate the distance between the circle's center and this closest point
-				float distanceX = (x - closestX);
-				float distanceY = (y - closestY);
+			// Find the closest point to the circle within the rectangle
+			float closestX = std::clamp(x, actor->AABB.L, actor->AABB.R);
+			float closestY = std::clamp(y, actor->AABB.T, actor->AABB.B);
 
-				// If the distance is less than the circle's radius, an intersection occurs
-				float distanceSquared = (distanceX * distanceX) + (distanceY * distanceY);
-				if (distanceSquared < RadiusSquared) {
-					return Callback(actor);
-				}
+			// Calculate the distance between the circle's center and this closest point
+			float distanceX = (x - closestX);
+			float distanceY = (y - closestY);
 
-				return true;
+			// If the distance is less than the circle's radius, an intersection occurs
+			float distanceSquared = (distanceX * distanceX) + (distanceY * distanceY);
+			if (distanceSquared < radiusSquared) {
+				result.push_back(actor);
 			}
-		};
-
-		QueryHelper helper = { this, x, y, radiusSquared, callback };
-		_collisions.Query(&helper, aabb);
+		}
 	}
 
-	void LevelHandler::GetCollidingPlayers(const AABBf& aabb, Function<bool(Actors::ActorBase*)>&& callback)
+	void LevelHandler::CollectCollidingPlayers(const AABBf& aabb, SmallVectorImpl<Actors::ActorBase*>& result)
 	{
 		for (auto& player : _players) {
 			if (aabb.Overlaps(player->AABB)) {
-				if (!callback(player)) {
-					break;
-				}
+				result.push_back(player);
+			}
+		}
+	}
+
+	ArrayView<void* const> LevelHandler::QueryCollisionCandidates(const AABBf& aabb)
+	{
+		// Broad-phase is updated only in ResolveCollisions() and AddActor(), so identical queries in between return
+		// the same candidates and can be answered from the cache, exact tests are always performed by the caller
+		_collisionQueryCount++;
+
+		ArrayView<void* const> cached;
+		if (_collisionQueryCache.TryGet(aabb, cached)) {
+			_collisionQueryCacheHits++;
+			return cached;
+		}
+
+		struct QueryHelper : Collisions::IBroadPhase::IQueryCallback {
+			const Collisions::IBroadPhase* BroadPhase;
+			SmallVector<void*, QueryResultCapacity> Candidates;
+
+			QueryHelper(const Collisions::IBroadPhase* broadPhase)
+				: BroadPhase(broadPhase) {}
+
+			bool OnCollisionQuery(std::int32_t nodeId) override {
+				Candidates.push_back(BroadPhase->GetUserData(nodeId));
+				return true;
 			}
+		};
+
+		QueryHelper helper(_collisions.get());
+		_collisions->Query(&helper, aabb);
+		_collisionQueryCache.Store(aabb, helper.Candidates);
+
+		// Results are stored in the cache unless it's full, fall back to a fresh lookup otherwise
+		if (_collisionQueryCache.TryGet(aabb, cached)) {
+			return cached;
 		}
+		_collisionQueryOverflow = std::move(helper.Candidates);
+		return _collisionQueryOverflow;
 	}
 
 	void LevelHandler::BroadcastTriggeredEvent(Actors::ActorBase* initiator, EventType eventType, std::uint8_t* eventParams)
@@ -1586,7 +1617,7 @@ namespace Jazz2
 		});
 
 		if (!iceBlockFound) {
-			std::shared_ptr<Actors::Environment::IceBlock> iceBlock = std::make_shared<Actors::Environment::IceBlock>();
+			std::shared_ptr<Actors::Environment::IceBlock> iceBlock = Actors::CreateActor<Actors::Environment::IceBlock>();
 			iceBlock->OnActivated(Actors::ActorActivationDetails(
 				this,
 				Vector3i(x - 1, y - 2, ILevelHandler::MainPlaneZ)
@@ -1846,6 +1877,27 @@ namespace Jazz2
 		}
 	}
 
+	ArrayView<const LightEmitter> LevelHandler::GetEmittedLights()
+	{
+		// Every viewport asks for the lights while it's being drawn, but they don't depend on the viewport,
+		// so they are collected only by the first one in a frame and the others filter the same list
+		std::uint32_t frameCount = theApplication().GetFrameCount();
+		if (_emittedLightsFrame != frameCount) {
+			_emittedLightsFrame = frameCount;
+			_emittedLights.clear();
+
+			std::size_t actorsCount = _actors.size();
+			for (std::size_t i = 0; i < actorsCount; i++) {
+				// Most actors never emit any light, they are skipped without the virtual call
+				auto* actor = _actors[i].get();
+				if (actor->GetState(Actors::ActorState::EmitsLights)) {
+					actor->OnEmitLights(_emittedLights);
+				}
+			}
+		}
+		return _emittedLights;
+	}
+
 	void LevelHandler::ResolveCollisions(float timeMult)
 	{
 		ZoneScopedC(0x4876AF);
@@ -1856,7 +1908,7 @@ namespace Jazz2
 			if (actor->GetState(Actors::ActorState::IsDestroyed)) {
 				BeforeActorDestroyed(actor);
 				if (actor->_collisionProxyID != Collisions::NullNode) {
-					_collisions.DestroyProxy(actor->_collisionProxyID);
+					_collisions->DestroyProxy(actor->_collisionProxyID);
 					actor->_collisionProxyID = Collisions::NullNode;
 				}
 				it = _actors.eraseUnordered(it);
@@ -1869,14 +1921,14 @@ namespace Jazz2
 				}
 
 				actor->UpdateAABB();
-				_collisions.MoveProxy(actor->_collisionProxyID, actor->AABB, actor->_speed * timeMult);
+				_collisions->MoveProxy(actor->_collisionProxyID, actor->AABB, actor->_speed * timeMult);
 				actor->SetState(Actors::ActorState::IsDirty, false);
 			}
 			++it;
 		}
 
-		struct UpdatePairsHelper {
-			void OnPairAdded(void* proxyA, void* proxyB) {
+		struct UpdatePairsHelper : Collisions::IBroadPhase::IPairCallback {
+			void OnPairAdded(void* proxyA, void* proxyB) override {
 				Actors::ActorBase* actorA = (Actors::ActorBase*)proxyA;
 				Actors::ActorBase* actorB = (Actors::ActorBase*)proxyB;
 				if (((actorA->GetState() | actorB->GetState()) & (Actors::ActorState::CollideWithOtherActors | Actors::ActorState::IsDestroyed)) != Actors::ActorState::CollideWithOtherActors) {
@@ -1890,8 +1942,16 @@ namespace Jazz2
 				}
 			}
 		};
+		// Proxies were moved, so all cached query results are now stale
+		_collisionQueryCache.Invalidate();
+
 		UpdatePairsHelper helper;
-		_collisions.UpdatePairs(&helper);
+		_collisions->UpdatePairs(&helper);
+
+		TracyPlot("Collision queries", static_cast<std::int64_t>(_collisionQueryCount));
+		TracyPlot("Collision queries (cached)", static_cast<std::int64_t>(_collisionQueryCacheHits));
+		_collisionQueryCount = 0;
+		_collisionQueryCacheHits = 0;
 	}
 
 	void LevelHandler::AssignViewport(Actors::Player* player)
@@ -2610,6 +2670,78 @@ namespace Jazz2
 	}
 #endif
 
+#if defined(DEATH_DEBUG) && defined(WITH_IMGUI) && defined(WITH_ANGELSCRIPT)
+	void LevelHandler::ShowScriptProfilerWindow()
+	{
+		auto& profiler = _scripts->GetProfiler();
+
+		ImGui::Begin("Scripts", nullptr);
+
+		if (profiler.GetFrameBudget() > 0.0f) {
+			ImGui::Text("Last frame: %.2f ms (Budget: %.1f ms)", profiler.GetLastFrameTime(), profiler.GetFrameBudget());
+		} else {
+			ImGui::Text("Last frame: %.2f ms", profiler.GetLastFrameTime());
+		}
+
+		ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable | ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_BordersInner | ImGuiTableFlags_NoPadOuterX;
+		if (ImGui::BeginTable("functions", 7, flags, ImVec2(0.0f, 0.0f))) {
+			ImGui::TableSetupColumn("Function");
+			ImGui::TableSetupColumn("Last Frame");
+			ImGui::TableSetupColumn("Peak");
+			ImGui::TableSetupColumn("Total");
+			ImGui::TableSetupColumn("Calls");
+			ImGui::TableSetupColumn("Allocs");
+			ImGui::TableSetupColumn("Aborted");
+			ImGui::TableHeadersRow();
+
+			auto stats = profiler.GetStats();
+			for (std::uint32_t index : profiler.GetTopFunctions(32)) {
+				const auto& s = stats[index];
+				ImGui::TableNextRow();
+
+				ImGui::TableSetColumnIndex(0);
+				ImGui::TextUnformatted(s.Name.data(), s.Name.data() + s.Name.size());
+
+				ImGui::TableSetColumnIndex(1);
+				ImGui::Text("%.3f ms (%u)", s.LastFrameTime, s.LastFrameCallCount);
+
+				ImGui::TableSetColumnIndex(2);
+				ImGui::Text("%.3f ms", s.PeakFrameTime);
+
+				ImGui::TableSetColumnIndex(3);
+				ImGui::Text("%.1f ms", s.TotalTime);
+
+				ImGui::TableSetColumnIndex(4);
+				ImGui::Text("%u", s.CallCount);
+
+				ImGui::TableSetColumnIndex(5);
+				ImGui::Text("%u", s.AllocationCount);
+
+				ImGui::TableSetColumnIndex(6);
+				ImGui::Text("%u", s.AbortCount);
+			}
+			ImGui::EndTable();
+		}
+
+		ImGui::End();
+	}
+#endif
+
+#if defined(DEATH_DEBUG) && defined(WITH_IMGUI)
+	void LevelHandler::ShowTextLayoutCacheWindow()
+	{
+		auto stats = UI::FormattedTextBlock::GetLayoutCacheStatistics();
+		std::uint32_t total = stats.Hits + stats.Misses;
+
+		ImGui::Begin("Text Layout Cache", nullptr);
+		ImGui::Text("Entries: %u / %u", stats.Entries, stats.Capacity);
+		ImGui::Text("Hits: %u", stats.Hits);
+		ImGui::Text("Misses: %u", stats.Misses);
+		ImGui::Text("Hit rate: %.1f %%", total > 0 ? stats.Hits * 100.0f / total : 0.0f);
+		ImGui::End();
+	}
+#endif
+
 	LevelHandler::PlayerInput::PlayerInput()
 		: PressedActions(0), PressedActionsLast(0), Frozen(false)
 	{
@@ -10,8 +10,10 @@
 #include "Events/EventSpawner.h"
 #include "Tiles/ITileMapOwner.h"
 #include "Tiles/TileMap.h"
-#include "Collisions/DynamicTreeBroadPhase.h"
+#include "Collisions/IBroadPhase.h"
+#include "Collisions/QueryCache.h"
 #include "Input/RumbleProcessor.h"
+#include "Actors/ActorPool.h"
 #include "Input/ControlScheme.h"
 #include "Rendering/UpscaleRenderPass.h"
 
@@ -166,9 +168,9 @@ namespace Jazz2
 		std::shared_ptr<AudioBufferPlayer> PlayCommonSfx(StringView identifier, const Vector3f& pos, float gain = 1.0f, float pitch = 1.0f) override;
 		void WarpCameraToTarget(Actors::ActorBase* actor, bool fast = false) override;
 		bool IsPositionEmpty(Actors::ActorBase* self, const AABBf& aabb, Tiles::TileCollisionParams& params, Actors::ActorBase** collider) override;
-		void FindCollisionActorsByAABB(const Actors::ActorBase* self, const AABBf& aabb, Function<bool(Actors::ActorBase*)>&& callback) override;
-		void FindCollisionActorsByRadius(float x, float y, float radius, Function<bool(Actors::ActorBase*)>&& callback) override;
-		void GetCollidingPlayers(const AABBf& aabb, Function<bool(Actors::ActorBase*)>&& callback) override;
+		void CollectCollisionActorsByAABB(const Actors::ActorBase* self, const AABBf& aabb, SmallVectorImpl<Actors::ActorBase*>& result) override;
+		void CollectCollisionActorsByRadius(float x, float y, float radius, SmallVectorImpl<Actors::ActorBase*>& result) override;
+		void CollectCollidingPlayers(const AABBf& aabb, SmallVectorImpl<Actors::ActorBase*>& result) override;
 
 		void BroadcastTriggeredEvent(Actors::ActorBase* initiator, EventType eventType, std::uint8_t* eventParams) override;
 		void BeginLevelChange(Actors::ActorBase* initiator, ExitType exitType, StringView nextLevel = {}) override;
@@ -233,6 +235,8 @@ namespace Jazz2
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
 		// Hide these members from documentation before refactoring
+		// Declared first, so it's destroyed last and releases slabs of all actors of the level at once
+		Actors::ActorPool::LevelScope _actorPoolScope;
 		IRootController* _root;
 
 #if defined(RHI_CAP_SHADERS) && defined(RHI_CAP_FRAMEBUFFERS)
@@ -266,6 +270,8 @@ namespace Jazz2
 #endif
 		SmallVector<std::shared_ptr<Actors::ActorBase>, 0> _actors;
 		SmallVector<Actors::Player*, LevelInitialization::MaxPlayerCount> _players;
+		SmallVector<LightEmitter, 0> _emittedLights;
+		std::uint32_t _emittedLightsFrame;
 
 		String _levelName;
 		String _levelDisplayName;
@@ -286,7 +292,11 @@ namespace Jazz2
 		Events::EventSpawner _eventSpawner;
 		std::unique_ptr<Events::EventMap> _eventMap;
 		std::unique_ptr<Tiles::TileMap> _tileMap;
-		Collisions::DynamicTreeBroadPhase _collisions;
+		std::unique_ptr<Collisions::IBroadPhase> _collisions;
+		Collisions::QueryCache _collisionQueryCache;
+		std::uint32_t _collisionQueryCount;
+		std::uint32_t _collisionQueryCacheHits;
+		SmallVector<void*, 0> _collisionQueryOverflow;
 
 		Vector2i _viewSize;
 		Rectf _viewBoundsTarget;
@@ -348,6 +358,9 @@ namespace Jazz2
 		void ProcessWeather(float timeMult);
 		/** @brief Resolves collisions */
 		void ResolveCollisions(float timeMult);
+		ArrayView<void* const> QueryCollisionCandidates(const AABBf& aabb);
+		/** @brief Returns lights emitted by all actors in the current frame, collected only once for all viewports */
+		ArrayView<const LightEmitter> GetEmittedLights();
 		/** @brief Assigns viewport */
 		void AssignViewport(Actors::Player* player);
 		/** @brief Unassigns viewport */
@@ -392,6 +405,14 @@ namespace Jazz2
 #if defined(WITH_IMGUI)
 		ImVec2 WorldPosToScreenSpace(const Vector2f pos, const Rendering::PlayerViewport& viewport);
 #endif
+#if defined(DEATH_DEBUG) && defined(WITH_IMGUI) && defined(WITH_ANGELSCRIPT)
+		/** @brief Shows time spent in individual level script functions */
+		void ShowScriptProfilerWindow();
+#endif
+#if defined(DEATH_DEBUG) && defined(WITH_IMGUI)
+		/** @brief Shows usage of the layout cache of formatted text blocks */
+		void ShowTextLayoutCacheWindow();
+#endif
 
 	private:
 		bool TryInvokeCheat(StringView line);
@@ -2529,6 +2529,36 @@ namespace Jazz2::Multiplayer
 				SendMessage(peer, UI::MessageLevel::Confirm, { infoBuffer, length });
 			}
 			return true;
+		} else if (line == "/scripts"_s) {
+			if (isAdmin) {
+#if defined(WITH_ANGELSCRIPT)
+				if (_scripts == nullptr) {
+					SendMessage(peer, UI::MessageLevel::Confirm, "No level script is loaded"_s);
+					return true;
+				}
+
+				auto& profiler = _scripts->GetProfiler();
+				std::size_t length;
+				if (profiler.GetFrameBudget() > 0.0f) {
+					length = formatInto(infoBuffer, "Script load: {:.2f} ms (Budget: {:.1f} ms)", profiler.GetLastFrameTime(), profiler.GetFrameBudget());
+				} else {
+					length = formatInto(infoBuffer, "Script load: {:.2f} ms", profiler.GetLastFrameTime());
+				}
+				SendMessage(peer, UI::MessageLevel::Confirm, { infoBuffer, length });
+
+				auto stats = profiler.GetStats();
+				for (std::uint32_t index : profiler.GetTopFunctions(10)) {
+					const auto& s = stats[index];
+					length = formatInto(infoBuffer, "{}\t │ {:.2f} ms\t │ Peak: {:.2f} ms\t │ Calls: {}\t │ Allocs: {}{}",
+						s.Name, s.LastFrameTime, s.PeakFrameTime, s.CallCount, s.AllocationCount,
+						s.AbortCount > 0 ? " (Aborted)"_s : ""_s);
+					SendMessage(peer, UI::MessageLevel::Confirm, { infoBuffer, length });
+				}
+#else
+				SendMessage(peer, UI::MessageLevel::Confirm, "Scripting is not supported in this build"_s);
+#endif
+				return true;
+			}
 		} else if (line.hasPrefix("/set "_s)) {
 			if (isAdmin) {
 				auto [variableName, sep, value] = line.exceptPrefix("/set "_s).trimmedPrefix().partition(' ');
@@ -3137,9 +3167,9 @@ namespace Jazz2::Multiplayer
 		MpPlayer* ptr;
 
 		if (peerDesc->RemotePeer) {
-			newPlayer = std::make_shared<RemotePlayerOnServer>(peerDesc);
+			newPlayer = Actors::CreateActor<RemotePlayerOnServer>(peerDesc);
 		} else {
-			newPlayer = std::make_shared<LocalPlayerOnServer>(peerDesc);
+			newPlayer = Actors::CreateActor<LocalPlayerOnServer>(peerDesc);
 		}
 		ptr = newPlayer.get();
 
@@ -4868,7 +4898,7 @@ namespace Jazz2::Multiplayer
 			// resolves the correct team color when team coloring is enabled
 			peerDesc->Team = teamId;
 
-			std::shared_ptr<Actors::Multiplayer::RemotablePlayer> player = std::make_shared<Actors::Multiplayer::RemotablePlayer>(peerDesc);
+			std::shared_ptr<Actors::Multiplayer::RemotablePlayer> player = Actors::CreateActor<Actors::Multiplayer::RemotablePlayer>(peerDesc);
 			std::uint8_t playerParams[2] = { (std::uint8_t)playerType, 0 };
 			player->OnActivated(Actors::ActorActivationDetails(
 				this,
@@ -6177,6 +6207,13 @@ namespace Jazz2::Multiplayer
 
 			const auto& serverConfig = _networkManager->GetServerConfiguration();
 
+#if defined(WITH_ANGELSCRIPT)
+			if (_scripts != nullptr && serverConfig.ScriptFrameBudgetMs > 0) {
+				// A runaway script would otherwise freeze the server for all connected players
+				_scripts->GetProfiler().SetFrameBudget((float)serverConfig.ScriptFrameBudgetMs);
+			}
+#endif
+
 			if (serverConfig.GameMode == MpGameMode::Race || serverConfig.GameMode == MpGameMode::TeamRace) {
 				BuildRaceCheckpoints();
 			}
@@ -6259,7 +6296,7 @@ namespace Jazz2::Multiplayer
 			// Local players carry over through levelInit (ReceiveLevelCarryOver below), so make sure a leftover
 			// descriptor snapshot can't be applied on top of it by MpPlayer::OnActivatedAsync
 			peerDesc->HasCarryOver = false;
-			std::shared_ptr<Actors::Multiplayer::LocalPlayerOnServer> player = std::make_shared<Actors::Multiplayer::LocalPlayerOnServer>(peerDesc);
+			std::shared_ptr<Actors::Multiplayer::LocalPlayerOnServer> player = Actors::CreateActor<Actors::Multiplayer::LocalPlayerOnServer>(peerDesc);
 			std::uint8_t playerParams[2] = { (std::uint8_t)levelInit.PlayerCarryOvers[i].Type, (std::uint8_t)i };
 			player->OnActivated(Actors::ActorActivationDetails(
 				this,
@@ -6309,7 +6346,7 @@ namespace Jazz2::Multiplayer
 		peerDesc->LapStarted = TimeStamp::now();
 		peerDesc->PlayerName = PreferencesCache::GetEffectivePlayerName();
 		peerDesc->FurColor = PreferencesCache::PlayerFurColor;
-		return std::make_shared<Actors::Multiplayer::LocalPlayerOnServer>(peerDesc);
+		return Actors::CreateActor<Actors::Multiplayer::LocalPlayerOnServer>(peerDesc);
 	}
 
 	void MpLevelHandler::PrepareNextLevelInitialization(LevelInitialization& levelInit)
@@ -7329,7 +7366,7 @@ namespace Jazz2::Multiplayer
 					std::uint8_t playerIndex = FindFreePlayerId();
 					LOGI("Spawning player {} [{}]", playerIndex, peer);
 
-					std::shared_ptr<Actors::Multiplayer::RemotePlayerOnServer> player = std::make_shared<Actors::Multiplayer::RemotePlayerOnServer>(peerDesc);
+					std::shared_ptr<Actors::Multiplayer::RemotePlayerOnServer> player = Actors::CreateActor<Actors::Multiplayer::RemotePlayerOnServer>(peerDesc);
 					// In team-coloring modes, resolve the team BEFORE activating so the spawn-time recolor decision
 					// (GetEffectiveFurColor in OnActivatedAsync) loads the sprites indexed and applies the team color
 					// even for players with no custom color of their own. ApplyGameModeToPlayer below re-resolves to the
@@ -7487,7 +7524,7 @@ namespace Jazz2::Multiplayer
 					std::uint8_t playerIndex = FindFreePlayerId();
 					LOGI("Spawning player {} [{}] as spectator", playerIndex, peer);
 
-					std::shared_ptr<Actors::Multiplayer::RemotePlayerOnServer> player = std::make_shared<Actors::Multiplayer::RemotePlayerOnServer>(peerDesc);
+					std::shared_ptr<Actors::Multiplayer::RemotePlayerOnServer> player = Actors::CreateActor<Actors::Multiplayer::RemotePlayerOnServer>(peerDesc);
 					std::uint8_t playerParams[2] = { (std::uint8_t)PlayerType::Spectate, (std::uint8_t)playerIndex };
 					player->OnActivated(Actors::ActorActivationDetails(
 						this,
@@ -8184,14 +8221,14 @@ namespace Jazz2::Multiplayer
 			_suppressRemoting = true;
 
 			// Static home-base structure (drawn behind the flag)
-			auto baseActor = std::make_shared<Actors::Multiplayer::CtfBase>();
+			auto baseActor = Actors::CreateActor<Actors::Multiplayer::CtfBase>();
 			baseActor->OnActivated(Actors::ActorActivationDetails(this,
 				Vector3i((std::int32_t)pos.X, (std::int32_t)pos.Y, MainPlaneZ - 40), actorParams));
 			flag.BaseActor = baseActor;
 			AddActor(baseActor);
 
 			// Carryable flag (drawn in front of the base; the server moves it to follow its carrier)
-			auto flagActor = std::make_shared<Actors::Multiplayer::Flag>();
+			auto flagActor = Actors::CreateActor<Actors::Multiplayer::Flag>();
 			flagActor->OnActivated(Actors::ActorActivationDetails(this,
 				Vector3i((std::int32_t)pos.X, (std::int32_t)pos.Y, MainPlaneZ - 30), actorParams));
 			flag.Actor = flagActor;
@@ -8364,7 +8401,7 @@ namespace Jazz2::Multiplayer
 
 			// Lazily create the local base + flag actors for this team
 			if (info.BaseActor == nullptr) {
-				auto baseActor = std::make_shared<Actors::Multiplayer::CtfBase>();
+				auto baseActor = Actors::CreateActor<Actors::Multiplayer::CtfBase>();
 				std::uint8_t params[1] = { team };
 				baseActor->OnActivated(Actors::ActorActivationDetails(this,
 					Vector3i((std::int32_t)info.BasePos.X, (std::int32_t)info.BasePos.Y, MainPlaneZ - 40), params));
@@ -8372,7 +8409,7 @@ namespace Jazz2::Multiplayer
 				AddActor(baseActor);
 			}
 			if (info.FlagActor == nullptr) {
-				auto flagActor = std::make_shared<Actors::Multiplayer::Flag>();
+				auto flagActor = Actors::CreateActor<Actors::Multiplayer::Flag>();
 				std::uint8_t params[1] = { team };
 				flagActor->OnActivated(Actors::ActorActivationDetails(this,
 					Vector3i((std::int32_t)info.BasePos.X, (std::int32_t)info.BasePos.Y, MainPlaneZ - 30), params));
@@ -467,6 +467,11 @@ namespace Jazz2::Multiplayer
 					serverConfig.ReconnectWindowSecs = std::int32_t(reconnectWindowSecs);
 				}
 
+				double scriptFrameBudgetMs;
+				if (doc["ScriptFrameBudgetMs"].get(scriptFrameBudgetMs) == Json::SUCCESS) {
+					serverConfig.ScriptFrameBudgetMs = float(scriptFrameBudgetMs);
+				}
+
 				bool allowCheats;
 				if (doc["AllowCheats"].get(allowCheats) == Json::SUCCESS) {
 					serverConfig.AllowCheats = allowCheats;
@@ -130,6 +130,7 @@ namespace Jazz2::Multiplayer
 		-   @cpp "AllowedPlayerTypes" @ce : @m_span{m-label m-warning m-flat} integer @m_endspan Bitmask for allowed player types (@cpp 1 @ce - Jazz, @cpp 2 @ce - Spaz, @cpp 4 @ce - Lori)
 		-   @cpp "IdleKickTimeSecs" @ce : @m_span{m-label m-warning m-flat} integer @m_endspan Time in seconds after idle players are kicked (default is **never**)
 		-   @cpp "ReconnectWindowSecs" @ce : @m_span{m-label m-warning m-flat} integer @m_endspan Time window in seconds during which a disconnected player can reconnect and resume their progression (weapons, lives, score, gems), @cpp 0 @ce or less to disable (default is **300**, i.e. 5 minutes)
+		-   @cpp "ScriptFrameBudgetMs" @ce : @m_span{m-label m-warning m-flat} number @m_endspan Maximum time in milliseconds level scripts can run in one frame, scripts running longer are aborted (default is **unlimited**)
 		-   @cpp "AllowCheats" @ce : @m_span{m-label m-default m-flat} bool @m_endspan Whether cheats can be used on the server (default is **false**)
 			-   Admins can use cheats in any game mode, other players only in Cooperation
 			-   Cheats are applied only to the player that invoked them
@@ -256,6 +257,8 @@ namespace Jazz2::Multiplayer
 		std::int32_t IdleKickTimeSecs;
 		/** @brief Time window in seconds during which a disconnected player can reconnect and resume their progression, 0 or less to disable */
 		std::int32_t ReconnectWindowSecs;
+		/** @brief Maximum time level scripts can run in one frame, in milliseconds, 0 or less to disable */
+		float ScriptFrameBudgetMs;
 		/** @brief Whether cheats can be used, admins in any game mode, other players only in Cooperation */
 		bool AllowCheats;
 		/** @brief List of unique player IDs with admin rights, value contains list of privileges, or `*` for all privileges */
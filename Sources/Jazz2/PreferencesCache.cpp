@@ -96,6 +96,11 @@ namespace Jazz2
 	EpisodeEndOverwriteMode PreferencesCache::OverwriteEpisodeEnd = EpisodeEndOverwriteMode::Always;
 	char PreferencesCache::Language[6]{};
 	bool PreferencesCache::BypassCache = false;
+	Collisions::BroadPhaseType PreferencesCache::CollisionBroadPhase = Collisions::BroadPhaseType::DynamicTree;
+	float PreferencesCache::ScriptFrameBudget = 0.0f;
+	float PreferencesCache::DynamicResolutionTarget = 0.0f;
+	float PreferencesCache::DynamicResolutionMinScale = 0.5f;
+	float PreferencesCache::DynamicResolutionMaxScale = 1.0f;
 	float PreferencesCache::MasterVolume = 0.7f;
 	float PreferencesCache::SfxVolume = 0.8f;
 	float PreferencesCache::MusicVolume = 0.4f;
@@ -1240,6 +1245,36 @@ namespace
 				MasterVolume = 0.0f;
 			} else if (arg == "/reset-controls"_s) {
 				ControlScheme::Reset();
+			} else if (arg == "/broadphase:tree"_s) {
+				CollisionBroadPhase = Collisions::BroadPhaseType::DynamicTree;
+			} else if (arg == "/broadphase:grid"_s) {
+				CollisionBroadPhase = Collisions::BroadPhaseType::SpatialHashGrid;
+			} else if (arg.hasPrefix("/script-budget:"_s)) {
+				// Script time budget can be set only with command-line parameter
+				char* end;
+				float paramValue = strtof(arg.exceptPrefix("/script-budget:"_s).data(), &end);
+				if (paramValue > 0.0f) {
+					ScriptFrameBudget = paramValue;
+				}
+			} else if (arg.hasPrefix("/dynamic-resolution:"_s)) {
+				// Dynamic resolution can be set only with command-line parameter, in form of <ms>[,<min %>[,<max %>]]
+				char* end;
+				float paramValue = strtof(arg.exceptPrefix("/dynamic-resolution:"_s).data(), &end);
+				if (paramValue > 0.0f) {
+					DynamicResolutionTarget = paramValue;
+					if (*end == ',') {
+						float minPercent = strtof(end + 1, &end);
+						if (minPercent > 0.0f) {
+							DynamicResolutionMinScale = std::min(minPercent, 100.0f) / 100.0f;
+						}
+						if (*end == ',') {
+							float maxPercent = strtof(end + 1, &end);
+							if (maxPercent > 0.0f) {
+								DynamicResolutionMaxScale = std::min(maxPercent, 100.0f) / 100.0f;
+							}
+						}
+					}
+				}
 			}
 #	if defined(DEATH_TARGET_EMSCRIPTEN)
 			else if (arg == "/standalone"_s) {
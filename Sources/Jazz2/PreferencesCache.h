@@ -2,6 +2,7 @@
 
 #include "../Main.h"
 #include "WeaponType.h"
+#include "Collisions/IBroadPhase.h"
 #include "../nCine/AppConfiguration.h"
 #include "../nCine/Base/HashMap.h"
 
@@ -331,6 +332,16 @@ namespace Jazz2
 		static char Language[6];
 		/** @brief Whether the cache should be bypassed */
 		static bool BypassCache;
+		/** @brief Collision broad-phase implementation, it can be changed only with command-line parameter */
+		static Collisions::BroadPhaseType CollisionBroadPhase;
+		/** @brief Time budget of level scripts per frame in milliseconds (0 to disable), it can be changed only with command-line parameter */
+		static float ScriptFrameBudget;
+		/** @brief Rasterization time per frame in milliseconds the software renderer holds by scaling its resolution (0 to disable), it can be changed only with command-line parameter */
+		static float DynamicResolutionTarget;
+		/** @brief Smallest resolution scale of the software renderer under dynamic resolution scaling */
+		static float DynamicResolutionMinScale;
+		/** @brief Largest resolution scale of the software renderer under dynamic resolution scaling */
+		static float DynamicResolutionMaxScale;
 
 		// Sounds
 		/** @brief Master sound volume */
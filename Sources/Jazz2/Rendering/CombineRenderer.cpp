@@ -152,13 +152,9 @@ namespace Jazz2::Rendering
 		const bool viewHasWater = (viewWaterLevel < _bounds.H);
 		const float waterTime = _owner->_levelHandler->_elapsedFrames * 0.0018f;
 
-		// Collect every active light emitter, exactly like the shader-path LightingRenderer does
-		_swLightsCache.clear();
-		auto actors = _owner->_levelHandler->GetActors();
-		std::size_t actorsCount = actors.size();
-		for (std::size_t i = 0; i < actorsCount; i++) {
-			actors[i]->OnEmitLights(_swLightsCache);
-		}
+		// Lights of the whole level, collected once per frame and shared by all viewports, exactly like
+		// the shader-path LightingRenderer gets them
+		auto lights = _owner->_levelHandler->GetEmittedLights();
 
 		// The shader path clears the lighting buffer to (ambientLevel, 0) and blends the scene toward the
 		// ambient colour by (1 - light.r). A fully-lit level with no lights therefore leaves the scene
@@ -168,7 +164,7 @@ namespace Jazz2::Rendering
 		const float ambR = _owner->_ambientLight.X;
 		const float ambG = _owner->_ambientLight.Y;
 		const float ambB = _owner->_ambientLight.Z;
-		const bool fullyLit = (ambientLevel >= 0.999f && _swLightsCache.empty());
+		const bool fullyLit = (ambientLevel >= 0.999f && lights.empty());
 		if (fullyLit && !viewHasWater) {
 			return false;
 		}
@@ -236,7 +232,7 @@ namespace Jazz2::Rendering
 		const float halfW = vpW * 0.5f;
 		const float halfH = vpH * 0.5f;
 
-		for (const LightEmitter& light : _swLightsCache) {
+		for (const LightEmitter& light : lights) {
 			const float radiusFar = light.RadiusFar;
 			if (radiusFar <= 0.0f) {
 				continue;
@@ -263,6 +259,10 @@ namespace Jazz2::Rendering
 			const std::int32_t x1 = std::min(lmW - 1, (std::int32_t)(cx + rLm));
 			const std::int32_t y0 = std::max<std::int32_t>(0, (std::int32_t)(cy - rLm));
 			const std::int32_t y1 = std::min(lmH - 1, (std::int32_t)(cy + rLm));
+			if (x0 > x1 || y0 > y1) {
+				// The light is outside of this viewport
+				continue;
+			}
 
 			for (std::int32_t y = y0; y <= y1; y++) {
 				const float dy = (y - cy) / rLm;
@@ -58,14 +58,13 @@ namespace Jazz2::Rendering
 		// across frames to avoid per-frame allocations. See PrepareSoftwareLighting(). The lightmap must stay
 		// alive after the Visit phase (the software device reads it during the later Draw phase), so it is a
 		// per-viewport member rather than a stack buffer.
-		SmallVector<LightEmitter, 0> _swLightsCache;
 		// Half-resolution accumulation buffer, 2 floats/texel: R=intensity, G=brightness
 		SmallVector<float, 0> _swLightmap;
 
 		/**
 		 * @brief Builds the half-resolution dynamic lightmap on the CPU and hands it plus the water parameters to the software device (software backend)
 		 *
-		 * Runs in the Visit (queue-building) phase: collects the light emitters, splats them into @ref _swLightmap and
+		 * Runs in the Visit (queue-building) phase: takes the light emitters of the frame, splats them into @ref _swLightmap and
 		 * submits the map plus this viewport's rectangle, ambient colour and water parameters (waterline, wave time,
 		 * camera Y) to the device (SetPendingSoftwareLighting). The device applies the actual in-place combine -
 		 * dynamic lighting and the lightweight per-row water effect that replaces the CombineWithWater shader
@@ -19,7 +19,6 @@ namespace Jazz2::Rendering
 	LightingRenderer::LightingRenderer(PlayerViewport* owner)
 		: _owner(owner)
 	{
-		_emittedLightsCache.reserve(32);
 		setVisitOrderState(SceneNode::VisitOrderState::Disabled);
 	}
 
@@ -31,16 +30,10 @@ namespace Jazz2::Rendering
 		// there is no combine pass, so the scene is drawn without dynamic lighting
 		return true;
 #else
-		_emittedLightsCache.clear();
+		// Lights of the whole level, collected once per frame and shared by all viewports
+		auto lights = _owner->_levelHandler->GetEmittedLights();
 
-		// Collect all active light emitters
-		auto actors = _owner->_levelHandler->GetActors();
-		std::size_t actorsCount = actors.size();
-		for (std::size_t i = 0; i < actorsCount; i++) {
-			actors[i]->OnEmitLights(_emittedLightsCache);
-		}
-
-		// Every actor in the level emits, wherever it is, and in splitscreen each viewport collects the same set,
+		// Every actor in the level emits, wherever it is, and in splitscreen all viewports share the same list,
 		// so a light whose circle cannot reach this view is dropped before it costs any geometry. Nothing else
 		// culls them: the render queue only culls drawable nodes, and these are raw commands.
 		const Rectf cullingRect = RenderResources::GetCurrentViewport()->GetCullingRect();
@@ -48,7 +41,7 @@ namespace Jazz2::Rendering
 		const float cullMinY = cullingRect.Y, cullMaxY = cullingRect.Y + cullingRect.H;
 
 		_vertices.clear();
-		for (auto& light : _emittedLightsCache) {
+		for (auto& light : lights) {
 			// A light with no far radius covers no pixels at all (the quad the shader path built for it was
 			// zero-sized), and its normalized near radius would divide by zero
 			if (light.RadiusFar <= 0.0f) {
@@ -31,7 +31,6 @@ namespace Jazz2::Rendering
 
 	private:
 		PlayerViewport* _owner;
-		SmallVector<LightEmitter, 0> _emittedLightsCache;
 #if defined(RHI_CAP_SHADERS) && defined(RHI_CAP_FRAMEBUFFERS)
 		// Only the shader render path renders lights into a buffer; backends without cheap shaders skip lighting
 		// entirely (see RhiFwd.h). Every visible light of the viewport is accumulated into one vertex stream and
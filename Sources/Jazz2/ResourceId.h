@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../Main.h"
+
+#include <cstring>
+#include <type_traits>
+
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
+
+namespace Jazz2
+{
+	/**
+		@brief Relative path to a content resource with a precomputed hash
+
+		The hash is computed only once, when the identifier is constructed. Identifiers declared as `static constexpr`
+		(e.g., for literal paths in frequently spawned actors) are hashed entirely at compile time. @ref ContentResolver
+		looks up already cached resources by the hash and compares only the path stored with them, so requests that
+		hit the cache neither allocate nor hash the path again. Both kinds of path separators hash the same, so an identifier matches the same resource
+		on all platforms.
+
+		The identifier doesn't own the path, the referenced string must outlive it. Anything convertible to
+		@ref StringView converts to an identifier implicitly, so it can be passed directly to functions that accept it.
+		Such identifiers are hashed at the call site.
+	*/
+	class ResourceId
+	{
+	public:
+		/** @brief Creates an identifier from a relative path */
+		constexpr ResourceId(StringView path) noexcept
+			: _path(path), _hash(ComputeHash(path)) {}
+
+		/** @overload */
+		template<class T, typename std::enable_if<std::is_convertible<const T&, StringView>::value && !std::is_same<T, StringView>::value, int>::type = 0>
+		ResourceId(const T& path) noexcept
+			: ResourceId(StringView(path)) {}
+
+		/** @brief Returns the relative path */
+		constexpr StringView GetPath() const noexcept {
+			return _path;
+		}
+
+		/** @brief Returns the precomputed hash of the path */
+		constexpr std::uint64_t GetHash() const noexcept {
+			return _hash;
+		}
+
+		/** @brief Returns the relative path */
+		constexpr operator StringView() const noexcept {
+			return _path;
+		}
+
+		/** @brief Returns `true` if the identifier refers to the specified path, treating `\` the same as `/` */
+		bool Matches(StringView path) const noexcept {
+			if (path.size() != _path.size()) {
+				return false;
+			}
+			const char* data = _path.data();
+			const char* other = path.data();
+			// Paths are usually spelled the same, so compare them as a whole first
+			if (std::memcmp(data, other, path.size()) == 0) {
+				return true;
+			}
+			for (std::size_t i = 0; i < path.size(); i++) {
+				char c1 = (data[i] == '\\' ? '/' : data[i]);
+				char c2 = (other[i] == '\\' ? '/' : other[i]);
+				if (c1 != c2) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/** @brief Computes 64-bit FNV-1a hash of a relative path, treating `\` the same as `/` */
+		static constexpr std::uint64_t ComputeHash(StringView path) noexcept {
+			std::uint64_t hash = 0xcbf29ce484222325ull;
+			const char* data = path.data();
+			for (std::size_t i = 0; i < path.size(); i++) {
+				char c = data[i];
+				if (c == '\\') {
+					c = '/';
+				}
+				hash ^= (std::uint8_t)c;
+				hash *= 0x00000100000001b3ull;
+			}
+			return hash;
+		}
+
+	private:
+		StringView _path;
+		std::uint64_t _hash;
+	};
+
+	/** @brief Hash function for maps that are already keyed by @ref ResourceId::GetHash() */
+	struct ResourceIdHash
+	{
+		std::size_t operator()(std::uint64_t hash) const noexcept {
+			// The hash is already well distributed, only fold it to the native size
+			return (std::size_t)(hash ^ (hash >> 32));
+		}
+	};
+}
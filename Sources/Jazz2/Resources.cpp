@@ -4,7 +4,7 @@
 namespace Jazz2::Resources
 {
 	GenericGraphicResource::GenericGraphicResource() noexcept
-		: Flags(GenericGraphicResourceFlags::None), MaskStride(0)
+		: Flags(GenericGraphicResourceFlags::None), MaskStride(0), ResidentSize(0), LastUsed(0)
 	{
 	}
 
@@ -19,8 +19,9 @@ namespace Jazz2::Resources
 	}
 
 	GenericSoundResource::GenericSoundResource(std::unique_ptr<Stream> stream, StringView filename) noexcept
-		: Buffer(std::move(stream), filename), Flags(GenericSoundResourceFlags::None)
+		: Buffer(std::move(stream), filename), Flags(GenericSoundResourceFlags::None), LastUsed(0)
 	{
+		ResidentSize = (std::uint32_t)Buffer.bufferSize();
 	}
 
 	SoundResource::SoundResource() noexcept
@@ -28,7 +29,7 @@ namespace Jazz2::Resources
 	}
 
 	Metadata::Metadata() noexcept
-		: Flags(MetadataFlags::None)
+		: Flags(MetadataFlags::None), ResidentSize(0), LastUsed(0)
 	{
 	}
 
@@ -119,6 +119,10 @@ namespace Jazz2::Resources
 		SmallVector<FrameRect, 0> FrameRects;
 		/** @brief Distance between two rows of @ref Mask, in bits (the sheet width in pixels) */
 		std::int32_t MaskStride;
+		/** @brief Memory taken by the texture and the collision mask in bytes, counted against the cache budget */
+		std::uint32_t ResidentSize;
+		/** @brief Value of the resolver's usage clock when the resource was last requested */
+		std::uint32_t LastUsed;
 
 		/** @brief Creates a new instance */
 		GenericGraphicResource() noexcept;
@@ -270,6 +274,10 @@ namespace Jazz2::Resources
 		AudioBuffer Buffer;
 		/** @brief Resource flags */
 		GenericSoundResourceFlags Flags;
+		/** @brief Memory taken by the decoded samples in bytes, counted against the cache budget */
+		std::uint32_t ResidentSize;
+		/** @brief Value of the resolver's usage clock when the resource was last requested */
+		std::uint32_t LastUsed;
 
 		/**
 		 * @brief Creates a new instance from a stream
@@ -328,7 +336,7 @@ namespace Jazz2::Resources
 		*used* apart wants: the UI metadata describes every gamepad button label, touch button and menu icon in
 		the game, while a given run of the game only ever draws the labels of one gamepad type. Everything else
 		then costs a few dozen bytes of description instead of a decoded sheet and a texture, and the ordinary
-		mark-and-sweep of the resolver still releases whatever was loaded once the metadata itself goes away.
+		cache eviction of the resolver still releases whatever was loaded once the metadata itself goes away.
 
 		Deferral is opt-in because it trades a load that happens at a known time (a loading screen) for one that
 		happens at first draw, which is right for UI and wrong for an actor that must animate without hitching.
@@ -351,6 +359,10 @@ namespace Jazz2::Resources
 		HashMap<String, SoundResource> Sounds;
 		/** @brief Bounding box */
 		Vector2i BoundingBox;
+		/** @brief Approximate memory taken by the metadata itself in bytes (without linked resources), counted against the cache budget */
+		std::uint32_t ResidentSize;
+		/** @brief Value of the resolver's usage clock when the metadata was last requested */
+		std::uint32_t LastUsed;
 
 		/** @brief Creates a new instance */
 		Metadata() noexcept;
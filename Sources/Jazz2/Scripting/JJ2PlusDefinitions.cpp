@@ -226,9 +226,10 @@ namespace Jazz2::Scripting
 			}
 		}
 
-		// Native actor that hosts a script-controlled jjOBJ: each frame it applies the object's own velocity, runs the
-		// script behavior (a jjVOIDFUNCOBJ function or a jjBEHAVIORINTERFACE object) over the jjOBJ, then syncs the
-		// resulting position back to the actor. This is what makes jjAddObject objects script-controllable.
+		// Native actor that hosts a script-controlled jjOBJ: the object's own velocity and its script behavior
+		// (a jjVOIDFUNCOBJ function or a jjBEHAVIORINTERFACE object) are applied in batches by
+		// LevelScriptLoader::UpdateControlledObjects(), the actor then syncs the resulting position back each frame.
+		// This is what makes jjAddObject objects script-controllable.
 		// NOTE: in-world sprite drawing isn't implemented yet (the object is logic/position-only for now).
 		class ScriptLegacyObject : public Actors::ActorBase
 		{
@@ -315,38 +316,11 @@ namespace Jazz2::Scripting
 
 			void OnUpdate(float timeMult) override
 			{
-				// JJ2-style automatic motion, so a behavior can simply set speeds/acceleration
-				_obj->xSpeed += _obj->xAcc * timeMult;
-				_obj->ySpeed += _obj->yAcc * timeMult;
-				_obj->xPos += _obj->xSpeed * timeMult;
-				_obj->yPos += _obj->ySpeed * timeMult;
-
-				asIScriptFunction* behaviorFunc = _obj->behavior;
-				asIScriptObject* behaviorObj = _obj->behavior;
-				if (behaviorFunc != nullptr || behaviorObj != nullptr) {
-					asIScriptEngine* engine = _levelScripts->GetEngine();
-					asIScriptContext* ctx = engine->RequestContext();
-					if (behaviorObj != nullptr) {
-						asIScriptFunction* onBehave = behaviorObj->GetObjectType()->GetMethodByDecl("void onBehave(jjOBJ@ obj)");
-						if (onBehave != nullptr) {
-							ctx->Prepare(onBehave);
-							ctx->SetObject(behaviorObj);
-							ctx->SetArgObject(0, _obj);
-							ExecuteBehavior(ctx);
-						}
-					} else {
-						ctx->Prepare(behaviorFunc);
-						ctx->SetArgObject(0, _obj);
-						ExecuteBehavior(ctx);
-					}
-					engine->ReturnContext(ctx);
-				}
-
-				// Apply the (possibly script-adjusted) position/facing to the actor and expose the current frame
+				// The behavior already ran for this frame, apply the (possibly script-adjusted) position/facing
+				// to the actor and expose the current frame
 				MoveInstantly(Vector2f(_obj->xPos, _obj->yPos), Actors::MoveType::Absolute | Actors::MoveType::Force);
 				SetFacingLeft(_obj->direction < 0);
 				_obj->curFrame = (std::uint32_t)_renderer.CurrentFrame;
-				_obj->age++;
 			}
 
 		private:
@@ -354,15 +328,6 @@ namespace Jazz2::Scripting
 			jjOBJ* _obj;
 			std::int32_t _lastSetID = -1;
 			std::int32_t _lastAnimation = -1;
-
-			static void ExecuteBehavior(asIScriptContext* ctx)
-			{
-				std::int32_t r = ctx->Execute();
-				if (r == asEXECUTION_EXCEPTION) {
-					LOGE("An exception \"{}\" occurred in \"{}\". Please correct the code and try again.",
-						ctx->GetExceptionString(), ctx->GetExceptionFunction()->GetDeclaration());
-				}
-			}
 		};
 
 		void jjTEXTAPPEARANCE::constructor(void* self) {
@@ -3560,6 +3525,16 @@ namespace Jazz2::Scripting
 
 	LevelScriptLoader::~LevelScriptLoader()
 	{
+		for (auto& batch : _behaviorBatches) {
+			batch.Objects->Release();
+			if (batch.Instances != nullptr) {
+				batch.Instances->Release();
+			}
+		}
+		for (auto* obj : _controlledObjects) {
+			obj->Release();
+		}
+
 		// Release the reference each cached jjLAYER proxy holds (the script side may still hold its own references)
 		for (auto& pair : _layerProxies) {
 			if (pair.second != nullptr) {
@@ -3832,7 +3807,7 @@ namespace Jazz2::Scripting
 			obj->behavior = behaviorFunc;
 		}
 
-		auto wrapper = std::make_shared<Legacy::ScriptLegacyObject>(this, obj);
+		auto wrapper = Actors::CreateActor<Legacy::ScriptLegacyObject>(this, obj);
 		wrapper->OnActivated(Actors::ActorActivationDetails(_levelHandler,
 			Vector3i((std::int32_t)xPixel, (std::int32_t)yPixel, ILevelHandler::MainPlaneZ)));
 		_levelHandler->AddActor(wrapper);
@@ -3840,6 +3815,10 @@ namespace Jazz2::Scripting
 		std::int32_t id = _nextScriptObjectId++;
 		_scriptObjects.emplace(id, std::weak_ptr<Actors::ActorBase>(wrapper));
 		obj->objectID = (std::int16_t)id;
+
+		// Keep our own reference, so the object can be dropped from the list lazily once the actor is gone
+		obj->AddRef();
+		_controlledObjects.push_back(obj);
 		return id;
 	}
 
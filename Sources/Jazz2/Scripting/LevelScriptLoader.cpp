@@ -22,8 +22,11 @@
 #include "../Compatibility/JJ2Strings.h"
 #include "../UI/InGameConsole.h"
 
+#include "../../nCine/Base/Algorithms.h"
 #include "../../nCine/Base/Random.h"
 
+#include <Cryptography/xxHash.h>
+
 #if defined(DEATH_TRACE)
 #	define AS_LOG_EXCEPTION(ctx)																						\
 		do {																											\
@@ -66,7 +69,8 @@ namespace Jazz2::Scripting
 	}
 
 	LevelScriptLoader::LevelScriptLoader(LevelHandler* levelHandler, StringView scriptPath)
-		: _levelHandler(levelHandler), _onLevelUpdate(nullptr), _onLevelUpdateLastFrame(-1), _onDrawAmmo(nullptr),
+		: _levelHandler(levelHandler), _playerType(nullptr), _onLevelLoad(nullptr), _onLevelBegin(nullptr), _onLevelReload(nullptr),
+			_onLevelUpdate(nullptr), _onPlayer(nullptr), _onLevelUpdateLastFrame(-1), _onPlayerTimerEnd{}, _onRoast{}, _onDrawAmmo(nullptr),
 			_onDrawHealth(nullptr), _onDrawLives(nullptr), _onDrawPlayerTimer(nullptr), _onDrawScore(nullptr), _onDrawGameModeHUD(nullptr),
 			_enabledCallbacks(NoInit, 256)
 	{
@@ -141,11 +145,15 @@ namespace Jazz2::Scripting
 #if defined(DEATH_DEBUG)
 				levelHandler->_console->WriteLine(UI::MessageLevel::Debug, "Compiling script with \"Standard\" context"_s);
 #endif
-				RegisterStandardFunctions(GetEngine(), GetMainModule());
+				RegisterStandardFunctions(GetEngine());
 				break;
 		}
 
-		ScriptBuildResult r = Build();
+		// Compiled bytecode is cached per script, the file is overwritten if any source or the registered API changes
+		String bytecodeCachePath = fs::CombinePath({ ContentResolver::Get().GetCachePath(), "Scripts"_s,
+			format("{:x}.asc", Death::Cryptography::xxHash3(scriptPath.data(), scriptPath.size())) });
+
+		ScriptBuildResult r = Build(bytecodeCachePath);
 		if (r != ScriptBuildResult::Success) {
 			LOGE("Cannot compile the script. Please correct the code and try again.");
 #if defined(DEATH_DEBUG)
@@ -162,12 +170,18 @@ namespace Jazz2::Scripting
 		switch (GetContextType()) {
 			case ScriptContextType::Legacy:
 				_onLevelUpdate = GetMainModule()->GetFunctionByDecl("void onMain()");
+				_onPlayer = GetMainModule()->GetFunctionByDecl("void onPlayer(jjPLAYER@)");
 				_onDrawAmmo = GetMainModule()->GetFunctionByDecl("bool onDrawAmmo(jjPLAYER@ player, jjCANVAS@ canvas)");
 				_onDrawHealth = GetMainModule()->GetFunctionByDecl("bool onDrawHealth(jjPLAYER@ player, jjCANVAS@ canvas)");
 				_onDrawLives = GetMainModule()->GetFunctionByDecl("bool onDrawLives(jjPLAYER@ player, jjCANVAS@ canvas)");
 				_onDrawPlayerTimer = GetMainModule()->GetFunctionByDecl("bool onDrawPlayerTimer(jjPLAYER@ player, jjCANVAS@ canvas)");
 				_onDrawScore = GetMainModule()->GetFunctionByDecl("bool onDrawScore(jjPLAYER@ player, jjCANVAS@ canvas)");
 				_onDrawGameModeHUD = GetMainModule()->GetFunctionByDecl("bool onDrawGameModeHUD(jjPLAYER@ player, jjCANVAS@ canvas)");
+
+				GetMainModule()->SetDefaultNamespace("jjInternal");
+				_runFunctionBatch = GetMainModule()->GetFunctionByName("RunFunctionBatch");
+				_runMethodBatch = GetMainModule()->GetFunctionByName("RunMethodBatch");
+				GetMainModule()->SetDefaultNamespace("");
 				break;
 			case ScriptContextType::Standard:
 				_onLevelUpdate = GetMainModule()->GetFunctionByDecl("void onLevelUpdate(float)");
@@ -175,6 +189,8 @@ namespace Jazz2::Scripting
 				break;
 		}
 
+		BindCallbacks();
+
 		// Snapshot the level's palette so scripts see it via jjPalette and can restore it via jjPAL::reset()
 		CaptureLevelPalette();
 	}
@@ -215,12 +231,15 @@ namespace Jazz2::Scripting
 		}
 	}
 
-	void LevelScriptLoader::OnBeforeScriptCall()
+	void LevelScriptLoader::OnBeforeScriptCall(asIScriptContext* ctx)
 	{
+		_profiler.BeginCall(ctx);
 	}
 
-	void LevelScriptLoader::OnAfterScriptCall()
+	void LevelScriptLoader::OnAfterScriptCall(asIScriptContext* ctx)
 	{
+		_profiler.EndCall(ctx);
+
 		for (auto& p : _playerBackingStore) {
 			p.second->SyncPropertiesFromBackingStore();
 		}
@@ -228,94 +247,89 @@ namespace Jazz2::Scripting
 
 	void LevelScriptLoader::OnLevelLoad()
 	{
-		asIScriptFunction* func = GetMainModule()->GetFunctionByDecl("void onLevelLoad()");
-		if (func == nullptr) {
+		if (_onLevelLoad == nullptr) {
 			return;
 		}
 
-		OnBeforeScriptCall();
-		asIScriptContext* ctx = GetEngine()->RequestContext();
+		asIScriptContext* ctx = PrepareContext(_onLevelLoad);
+		OnBeforeScriptCall(ctx);
 
-		ctx->Prepare(func);
 		std::int32_t r = ctx->Execute();
 		if (r == asEXECUTION_EXCEPTION) {
 			AS_LOG_EXCEPTION(ctx);
 		}
 
-		GetEngine()->ReturnContext(ctx);
-		OnAfterScriptCall();
+		OnAfterScriptCall(ctx);
+		ReturnPreparedContext(ctx);
 	}
 
 	void LevelScriptLoader::OnLevelBegin()
 	{
-		asIScriptFunction* func = GetMainModule()->GetFunctionByDecl("void onLevelBegin()");
-		if (func == nullptr) {
+		if (_onLevelBegin == nullptr) {
 			return;
 		}
 
-		OnBeforeScriptCall();
-		asIScriptContext* ctx = GetEngine()->RequestContext();
+		asIScriptContext* ctx = PrepareContext(_onLevelBegin);
+		OnBeforeScriptCall(ctx);
 
-		ctx->Prepare(func);
 		std::int32_t r = ctx->Execute();
 		if (r == asEXECUTION_EXCEPTION) {
 			AS_LOG_EXCEPTION(ctx);
 		}
 
-		GetEngine()->ReturnContext(ctx);
-		OnAfterScriptCall();
+		OnAfterScriptCall(ctx);
+		ReturnPreparedContext(ctx);
 	}
 
 	void LevelScriptLoader::OnLevelReload()
 	{
-		asIScriptFunction* func = GetMainModule()->GetFunctionByDecl("void onLevelReload()");
-		if (func == nullptr) {
+		if (_onLevelReload == nullptr) {
 			return;
 		}
 
-		OnBeforeScriptCall();
-		asIScriptContext* ctx = GetEngine()->RequestContext();
+		asIScriptContext* ctx = PrepareContext(_onLevelReload);
+		OnBeforeScriptCall(ctx);
 
-		ctx->Prepare(func);
 		std::int32_t r = ctx->Execute();
 		if (r == asEXECUTION_EXCEPTION) {
 			AS_LOG_EXCEPTION(ctx);
 		}
 
-		GetEngine()->ReturnContext(ctx);
-		OnAfterScriptCall();
+		OnAfterScriptCall(ctx);
+		ReturnPreparedContext(ctx);
 	}
 
 	void LevelScriptLoader::OnLevelUpdate(float timeMult)
 	{
+		_profiler.BeginFrame();
+
 		switch (GetContextType()) {
 			case ScriptContextType::Legacy: {
-				asIScriptFunction* onPlayer = GetMainModule()->GetFunctionByDecl("void onPlayer(jjPLAYER@)");
-
-				if (_onLevelUpdate == nullptr && onPlayer == nullptr) {
+				if (_onLevelUpdate == nullptr && _onPlayer == nullptr) {
 					_onLevelUpdateLastFrame = (std::int32_t)_levelHandler->_elapsedFrames;
 					break;
 				}
 
 				// Legacy context requires fixed frame count per second
-				OnBeforeScriptCall();
-				asIScriptContext* ctx = GetEngine()->RequestContext();
-
 				// It should update at 70 FPS instead of 60 FPS
 				std::int32_t currentFrame = (std::int32_t)(_levelHandler->_elapsedFrames * (70.0f / 60.0f));
 				while (_onLevelUpdateLastFrame <= currentFrame) {
 					if (_onLevelUpdate != nullptr) {
-						ctx->Prepare(_onLevelUpdate);
+						asIScriptContext* ctx = PrepareContext(_onLevelUpdate);
+						OnBeforeScriptCall(ctx);
 						std::int32_t r = ctx->Execute();
 						if (r == asEXECUTION_EXCEPTION) {
 							AS_LOG_EXCEPTION(ctx);
 							// Don't call the method again if an exception occurs
 							//_onLevelUpdate = nullptr;
 						}
+						OnAfterScriptCall(ctx);
+						ReturnPreparedContext(ctx);
 					}
-					if (onPlayer != nullptr) {
+					if (_onPlayer != nullptr) {
 						for (auto* player : _levelHandler->_players) {
-							ctx->Prepare(onPlayer);
+							asIScriptContext* ctx = PrepareContext(_onPlayer);
+							OnBeforeScriptCall(ctx);
 
 							jjPLAYER* p = GetPlayerBackingStore(player);
 							ctx->SetArgObject(0, p);
@@ -326,13 +340,12 @@ namespace Jazz2::Scripting
 								// Don't call the method again if an exception occurs
 								//_onLevelUpdate = nullptr;
 							}
+							OnAfterScriptCall(ctx);
+							ReturnPreparedContext(ctx);
 						}
 					}
 					_onLevelUpdateLastFrame++;
 				}
-
-				GetEngine()->ReturnContext(ctx);
-				OnAfterScriptCall();
 				break;
 			}
 			case ScriptContextType::Standard: {
@@ -342,10 +355,9 @@ namespace Jazz2::Scripting
 				}
 
 				// Standard context supports floating frame rate
-				OnBeforeScriptCall();
-				asIScriptContext* ctx = GetEngine()->RequestContext();
+				asIScriptContext* ctx = PrepareContext(_onLevelUpdate);
+				OnBeforeScriptCall(ctx);
 
-				ctx->Prepare(_onLevelUpdate);
 				ctx->SetArgFloat(0, timeMult);
 				std::int32_t r = ctx->Execute();
 				if (r == asEXECUTION_EXCEPTION) {
@@ -354,8 +366,8 @@ namespace Jazz2::Scripting
 					_onLevelUpdate = nullptr;
 				}
 
-				GetEngine()->ReturnContext(ctx);
-				OnAfterScriptCall();
+				OnAfterScriptCall(ctx);
+				ReturnPreparedContext(ctx);
 				break;
 			}
 		}
@@ -368,28 +380,18 @@ namespace Jazz2::Scripting
 					LOGD("Player timer decremented ({})", it->second->_timerLeft);
 					if (it->second->_timerLeft <= 0.0f) {
 						it->second->_timerState = 0; // STOPPED
-						asIScriptFunction* func = (asIScriptFunction*)it->second->_timerCallback;
-						if (func == nullptr) {
-							func = GetMainModule()->GetFunctionByName("onPlayerTimerEnd");
-							if (func == nullptr) {
-								continue;
-							}
+						asIScriptFunction* timerCallback = (asIScriptFunction*)it->second->_timerCallback;
+						ScriptCallback callback = (timerCallback != nullptr ? BindCallback(timerCallback) : _onPlayerTimerEnd);
+						if (callback.Function == nullptr) {
+							continue;
 						}
 
-						OnBeforeScriptCall();
-						asIScriptContext* ctx = GetEngine()->RequestContext();
-
-						ctx->Prepare(func);
+						asIScriptContext* ctx = PrepareContext(callback.Function);
+						OnBeforeScriptCall(ctx);
 
-						std::int32_t typeId = 0;
-						if (func->GetParam(0, &typeId) >= 0) {
-							if ((typeId & (asTYPEID_OBJHANDLE | asTYPEID_APPOBJECT)) == (asTYPEID_OBJHANDLE | asTYPEID_APPOBJECT)) {
-								asITypeInfo* typeInfo = GetEngine()->GetTypeInfoById(typeId);
-								if (typeInfo->GetName() == "jjPLAYER"_s) {
-									jjPLAYER* p = GetPlayerBackingStore(player);
-									ctx->SetArgObject(0, p);
-								}
-							}
+						if (callback.PlayerParams & 0x01) {
+							jjPLAYER* p = GetPlayerBackingStore(player);
+							ctx->SetArgObject(0, p);
 						}
 
 						std::int32_t r = ctx->Execute();
@@ -397,13 +399,15 @@ namespace Jazz2::Scripting
 							AS_LOG_EXCEPTION(ctx);
 						}
 
-						GetEngine()->ReturnContext(ctx);
-						OnAfterScriptCall();
+						OnAfterScriptCall(ctx);
+						ReturnPreparedContext(ctx);
 					}
 				}
 			}
 		}
 
+		UpdateControlledObjects(timeMult);
+
 		// Push any script-modified jjLAYER properties into the engine layer descriptions (no-op if no jjLayers accessed)
 		SyncLayerProperties();
 	}
@@ -419,52 +423,39 @@ namespace Jazz2::Scripting
 			_enabledCallbacks.reset(callbackId);
 		}
 
-		char funcName[32];
-		std::size_t length = formatInto(funcName, "onFunction{}", callbackId);
-		funcName[length] = '\0';
-
-		asIScriptFunction* func = GetMainModule()->GetFunctionByName(funcName);
-		if (func != nullptr) {
-			OnBeforeScriptCall();
-			asIScriptContext* ctx = GetEngine()->RequestContext();
-
-			ctx->Prepare(func);
+		const ScriptCallback& callback = _onFunction[callbackId];
+		if (callback.Function == nullptr) {
+			LOGW("Callback function \"onFunction{}\" was not found in the script. Please correct the code and try again.", callbackId);
+			return;
+		}
 
-			std::int32_t paramIdx = 0;
-			std::int32_t typeId = 0;
-			if (func->GetParam(paramIdx, &typeId) >= 0) {
-				if ((typeId & (asTYPEID_OBJHANDLE | asTYPEID_APPOBJECT)) == (asTYPEID_OBJHANDLE | asTYPEID_APPOBJECT)) {
-					asITypeInfo* typeInfo = GetEngine()->GetTypeInfoById(typeId);
-					if (typeInfo->GetName() == "jjPLAYER"_s) {
-						if (auto* player = runtime_cast<Actors::Player>(initiator)) {
-							jjPLAYER* p = GetPlayerBackingStore(player);
-							ctx->SetArgObject(0, p);
-						} else {
-							// Player is required but wasn't provided
-							return;
-						}
-					}
-					paramIdx++;
-				}
-			}
-			if (func->GetParam(paramIdx, &typeId) >= 0) {
-				if (typeId == asTYPEID_BOOL || typeId == asTYPEID_INT8 || typeId == asTYPEID_UINT8) {
-					ctx->SetArgByte(1, eventParams[1]);
-					paramIdx++;
-				}
+		Actors::Player* player = nullptr;
+		if (callback.PlayerParams & 0x01) {
+			player = runtime_cast<Actors::Player>(initiator);
+			if (player == nullptr) {
+				// Player is required but wasn't provided
+				return;
 			}
+		}
 
-			std::int32_t r = ctx->Execute();
-			if (r == asEXECUTION_EXCEPTION) {
-				AS_LOG_EXCEPTION(ctx);
-			}
+		asIScriptContext* ctx = PrepareContext(callback.Function);
+		OnBeforeScriptCall(ctx);
 
-			GetEngine()->ReturnContext(ctx);
-			OnAfterScriptCall();
-			return;
+		if (player != nullptr) {
+			jjPLAYER* p = GetPlayerBackingStore(player);
+			ctx->SetArgObject(0, p);
+		}
+		if (callback.ByteParam >= 0) {
+			ctx->SetArgByte(callback.ByteParam, eventParams[1]);
 		}
 
-		LOGW("Callback function \"{}\" was not found in the script. Please correct the code and try again.", funcName);
+		std::int32_t r = ctx->Execute();
+		if (r == asEXECUTION_EXCEPTION) {
+			AS_LOG_EXCEPTION(ctx);
+		}
+
+		OnAfterScriptCall(ctx);
+		ReturnPreparedContext(ctx);
 	}
 
 	bool LevelScriptLoader::OnDraw(UI::HUD* hud, Actors::Player* player, const Rectf& view, DrawType type)
@@ -490,10 +481,8 @@ namespace Jazz2::Scripting
 			subVideoW = (std::int32_t)view.W;
 			subVideoH = (std::int32_t)view.H;
 
-			OnBeforeScriptCall();
-			asIScriptContext* ctx = GetEngine()->RequestContext();
-
-			ctx->Prepare(func);
+			asIScriptContext* ctx = PrepareContext(func);
+			OnBeforeScriptCall(ctx);
 
 			jjPLAYER* p = GetPlayerBackingStore(player);
 			ctx->SetArgObject(0, p);
@@ -508,8 +497,8 @@ namespace Jazz2::Scripting
 				AS_LOG_EXCEPTION(ctx);
 			}
 
-			GetEngine()->ReturnContext(ctx);
-			OnAfterScriptCall();
+			OnAfterScriptCall(ctx);
+			ReturnPreparedContext(ctx);
 
 			// TODO
 			asFreeMem(canvasWrapper);
@@ -527,45 +516,226 @@ namespace Jazz2::Scripting
 			}
 		}
 
-		asIScriptFunction* func = GetMainModule()->GetFunctionByName("onRoast");
-		if (func != nullptr) {
-			OnBeforeScriptCall();
-			asIScriptContext* ctx = GetEngine()->RequestContext();
+		if (_onRoast.Function != nullptr) {
+			asIScriptContext* ctx = PrepareContext(_onRoast.Function);
+			OnBeforeScriptCall(ctx);
 
-			ctx->Prepare(func);
+			if (_onRoast.PlayerParams & 0x01) {
+				jjPLAYER* p = GetPlayerBackingStore(player);
+				ctx->SetArgObject(0, p);
+			}
+			if (_onRoast.PlayerParams & 0x02) {
+				// TODO: Detect weapons properly
+				if (auto* killer = runtime_cast<Actors::Player>(collider)) {
+					jjPLAYER* p = GetPlayerBackingStore(killer);
+					ctx->SetArgObject(1, p);
+				} else {
+					ctx->SetArgObject(1, nullptr);
+				}
+			}
+
+			std::int32_t r = ctx->Execute();
+			if (r == asEXECUTION_EXCEPTION) {
+				AS_LOG_EXCEPTION(ctx);
+			}
 
+			OnAfterScriptCall(ctx);
+			ReturnPreparedContext(ctx);
+		}
+	}
+
+	LevelScriptLoader::ScriptCallback LevelScriptLoader::BindCallback(asIScriptFunction* func) const
+	{
+		ScriptCallback callback = { func, 0, -1 };
+		if (func == nullptr) {
+			return callback;
+		}
+
+		std::uint32_t paramCount = std::min(func->GetParamCount(), 8u);
+		for (std::uint32_t i = 0; i < paramCount; i++) {
 			std::int32_t typeId = 0;
-			if (func->GetParam(0, &typeId) >= 0) {
-				if ((typeId & (asTYPEID_OBJHANDLE | asTYPEID_APPOBJECT)) == (asTYPEID_OBJHANDLE | asTYPEID_APPOBJECT)) {
-					asITypeInfo* typeInfo = GetEngine()->GetTypeInfoById(typeId);
-					if (typeInfo->GetName() == "jjPLAYER"_s) {
-						jjPLAYER* p = GetPlayerBackingStore(player);
-						ctx->SetArgObject(0, p);
-					}
+			if (func->GetParam(i, &typeId) < 0) {
+				break;
+			}
+			if ((typeId & (asTYPEID_OBJHANDLE | asTYPEID_APPOBJECT)) == (asTYPEID_OBJHANDLE | asTYPEID_APPOBJECT)) {
+				if (_playerType != nullptr && GetEngine()->GetTypeInfoById(typeId) == _playerType) {
+					callback.PlayerParams |= (1 << i);
 				}
+			} else if (callback.ByteParam < 0 && (typeId == asTYPEID_BOOL || typeId == asTYPEID_INT8 || typeId == asTYPEID_UINT8)) {
+				callback.ByteParam = (std::int8_t)i;
 			}
-			if (func->GetParam(1, &typeId) >= 0) {
-				if ((typeId & (asTYPEID_OBJHANDLE | asTYPEID_APPOBJECT)) == (asTYPEID_OBJHANDLE | asTYPEID_APPOBJECT)) {
-					asITypeInfo* typeInfo = GetEngine()->GetTypeInfoById(typeId);
-					if (typeInfo->GetName() == "jjPLAYER"_s) {
-						// TODO: Detect weapons properly
-						if (auto* killer = runtime_cast<Actors::Player>(collider)) {
-							jjPLAYER* p = GetPlayerBackingStore(killer);
-							ctx->SetArgObject(0, p);
-						} else {
-							ctx->SetArgObject(0, nullptr);
-						}
-					}
+		}
+		return callback;
+	}
+
+	void LevelScriptLoader::BindCallbacks()
+	{
+		asIScriptModule* module = GetMainModule();
+		_playerType = GetEngine()->GetTypeInfoByName("jjPLAYER");
+
+		_onLevelLoad = module->GetFunctionByDecl("void onLevelLoad()");
+		_onLevelBegin = module->GetFunctionByDecl("void onLevelBegin()");
+		_onLevelReload = module->GetFunctionByDecl("void onLevelReload()");
+		_onPlayerTimerEnd = BindCallback(module->GetFunctionByName("onPlayerTimerEnd"));
+		_onRoast = BindCallback(module->GetFunctionByName("onRoast"));
+
+		// Text event callbacks are looked up by their number, so all of them are bound in a single pass over the module
+		_onFunction.resize(256);
+		for (auto& callback : _onFunction) {
+			callback = { nullptr, 0, -1 };
+		}
+		for (asUINT i = 0; i < module->GetFunctionCount(); i++) {
+			asIScriptFunction* func = module->GetFunctionByIndex(i);
+			StringView name = func->GetName();
+			if (!name.hasPrefix("onFunction"_s) || (func->GetNamespace() != nullptr && func->GetNamespace()[0] != '\0')) {
+				continue;
+			}
+			// Only the exact name that would be looked up for the callback number is accepted
+			StringView digits = name.exceptPrefix("onFunction"_s);
+			if (digits.empty() || digits.size() > 3 || (digits.size() > 1 && digits[0] == '0') ||
+				!std::all_of(digits.begin(), digits.end(), isDigit)) {
+				continue;
+			}
+			std::uint32_t callbackId = stou32(digits.data(), digits.size());
+			if (callbackId < _onFunction.size()) {
+				auto& callback = _onFunction[callbackId];
+				if (callback.Function == nullptr) {
+					callback = BindCallback(func);
+				} else {
+					// Overloaded functions are ambiguous, the same as with GetFunctionByName()
+					LOGW("Callback function \"{}\" is declared more than once", name);
+				}
+			}
+		}
+	}
+
+	asIScriptFunction* LevelScriptLoader::GetBehaveMethod(asITypeInfo* type)
+	{
+		auto it = _behaveMethods.find(type);
+		if (it != _behaveMethods.end()) {
+			return it->second;
+		}
+
+		asIScriptFunction* method = type->GetMethodByDecl("void onBehave(jjOBJ@ obj)");
+		_behaveMethods.emplace(type, method);
+		return method;
+	}
+
+	void LevelScriptLoader::UpdateControlledObjects(float timeMult)
+	{
+		if (_controlledObjects.empty()) {
+			return;
+		}
+
+		for (auto& batch : _behaviorBatches) {
+			batch.Count = 0;
+		}
+
+		// Single pass over all objects that drops despawned ones, applies velocity and sorts them into batches
+		std::size_t count = _controlledObjects.size();
+		std::size_t alive = 0;
+		for (std::size_t i = 0; i < count; i++) {
+			jjOBJ* obj = _controlledObjects[i];
+			if (!obj->get_isActive()) {
+				obj->Release();
+				continue;
+			}
+			_controlledObjects[alive++] = obj;
+
+			// JJ2-style automatic motion, so a behavior can simply set speeds/acceleration
+			obj->xSpeed += obj->xAcc * timeMult;
+			obj->ySpeed += obj->yAcc * timeMult;
+			obj->xPos += obj->xSpeed * timeMult;
+			obj->yPos += obj->ySpeed * timeMult;
+			obj->age++;
+
+			asIScriptObject* instance = obj->behavior;
+			asIScriptFunction* behavior = (instance != nullptr ? GetBehaveMethod(instance->GetObjectType()) : (asIScriptFunction*)obj->behavior);
+			if (behavior == nullptr) {
+				continue;
+			}
+
+			BehaviorBatch& batch = GetBehaviorBatch(behavior, instance != nullptr);
+			if (batch.Count >= batch.Objects->GetSize()) {
+				std::uint32_t capacity = std::max(batch.Count * 2, 16u);
+				batch.Objects->Reserve(capacity);
+				batch.Objects->Resize(batch.Count + 1);
+				if (batch.Instances != nullptr) {
+					batch.Instances->Reserve(capacity);
+					batch.Instances->Resize(batch.Count + 1);
 				}
 			}
+			batch.Objects->SetValue(batch.Count, &obj);
+			if (batch.Instances != nullptr) {
+				batch.Instances->SetValue(batch.Count, &instance);
+			}
+			batch.Count++;
+		}
+		_controlledObjects.resize(alive);
+
+		for (auto& batch : _behaviorBatches) {
+			if (batch.Count < batch.Objects->GetSize()) {
+				// Trailing handles from the last frame would keep despawned objects alive
+				batch.Objects->Resize(batch.Count);
+				if (batch.Instances != nullptr) {
+					batch.Instances->Resize(batch.Count);
+				}
+			}
+			if (batch.Count > 0) {
+				RunBehaviorBatch(batch);
+			}
+		}
+	}
+
+	LevelScriptLoader::BehaviorBatch& LevelScriptLoader::GetBehaviorBatch(asIScriptFunction* behavior, bool isMethod)
+	{
+		auto it = _behaviorBatchIndices.find(behavior);
+		if (it != _behaviorBatchIndices.end()) {
+			return _behaviorBatches[it->second];
+		}
+
+		asIScriptEngine* engine = GetEngine();
+		_behaviorBatchIndices.emplace(behavior, (std::uint32_t)_behaviorBatches.size());
+		BehaviorBatch& batch = _behaviorBatches.emplace_back();
+		batch.Behavior = behavior;
+		batch.Objects = CScriptArray::Create(engine->GetTypeInfoByDecl("array<jjOBJ@>"));
+		batch.Instances = (isMethod ? CScriptArray::Create(engine->GetTypeInfoByDecl("array<jjBEHAVIORINTERFACE@>")) : nullptr);
+		batch.Count = 0;
+		return batch;
+	}
+
+	void LevelScriptLoader::RunBehaviorBatch(BehaviorBatch& batch)
+	{
+		asIScriptFunction* runner = (batch.Instances != nullptr ? _runMethodBatch : _runFunctionBatch);
+		if (runner == nullptr) {
+			return;
+		}
 
+		_batchIndex = 0;
+		while (_batchIndex < batch.Count) {
+			asIScriptContext* ctx = PrepareContext(runner);
+			if (batch.Instances != nullptr) {
+				ctx->SetArgObject(0, batch.Instances);
+			} else {
+				ctx->SetArgObject(0, batch.Behavior);
+			}
+			ctx->SetArgObject(1, batch.Objects);
+
+			// Only the profiler is notified instead of the full OnBeforeScriptCall()/OnAfterScriptCall() pair that also
+			// synchronizes player backing stores, and the time is attributed to the behavior instead of the runner
+			_profiler.BeginCall(ctx, batch.Behavior);
 			std::int32_t r = ctx->Execute();
 			if (r == asEXECUTION_EXCEPTION) {
 				AS_LOG_EXCEPTION(ctx);
 			}
+			_profiler.EndCall(ctx);
+			ReturnPreparedContext(ctx);
 
-			GetEngine()->ReturnContext(ctx);
-			OnAfterScriptCall();
+			if (r != asEXECUTION_EXCEPTION) {
+				// Either all objects were processed or the script was aborted
+				break;
+			}
+			// Otherwise, continue with the object after the one that threw the exception
 		}
 	}
 
@@ -1559,6 +1729,33 @@ namespace Jazz2::Scripting
 		engine->RegisterGlobalFunction("int jjAddObject(uint8 eventID, float xPixel, float yPixel, uint16 creatorID = 0, CREATOR::Type creatorType = CREATOR::OBJECT, BEHAVIOR::Behavior behavior = BEHAVIOR::DEFAULT)", asFUNCTION(jjOBJ::jjAddObject), asCALL_CDECL);
 		engine->RegisterGlobalFunction("int jjAddObject(uint8 eventID, float xPixel, float xPixel, uint16 creatorID, CREATOR::Type creatorType, jjVOIDFUNCOBJ@ behavior)", asFUNCTION(jjOBJ::jjAddObjectEx), asCALL_CDECL);
 
+		// Runners that call one behavior for all objects of a batch in a single context, see UpdateControlledObjects()
+		engine->SetDefaultNamespace("jjInternal");
+		engine->RegisterGlobalProperty("uint BatchIndex", &_batchIndex);
+		engine->SetDefaultNamespace("");
+		static const char BatchLibrary[] = R"(
+namespace jjInternal
+{
+	void RunFunctionBatch(jjVOIDFUNCOBJ@ behavior, array<jjOBJ@>@ objects)
+	{
+		uint count = objects.length();
+		while (BatchIndex < count) {
+			behavior(objects[BatchIndex++]);
+		}
+	}
+
+	void RunMethodBatch(array<jjBEHAVIORINTERFACE@>@ instances, array<jjOBJ@>@ objects)
+	{
+		uint count = objects.length();
+		while (BatchIndex < count) {
+			uint i = BatchIndex++;
+			instances[i].onBehave(objects[i]);
+		}
+	}
+}
+)";
+		AddScriptSection("__jjInternal"_s, StringView(BatchLibrary, arraySize(BatchLibrary) - 1));
+
 		engine->RegisterObjectProperty("jjOBJ", "float xOrg", asOFFSET(jjOBJ, xOrg));
 		engine->RegisterObjectProperty("jjOBJ", "float yOrg", asOFFSET(jjOBJ, yOrg));
 		engine->RegisterObjectProperty("jjOBJ", "float xPos", asOFFSET(jjOBJ, xPos));
@@ -3471,7 +3668,7 @@ namespace Jazz2::Scripting
 		engine->RegisterGlobalProperty("const jjPAL Palette", &jjBackupPalette);
 	}
 
-	void LevelScriptLoader::RegisterStandardFunctions(asIScriptEngine* engine, asIScriptModule* module)
+	void LevelScriptLoader::RegisterStandardFunctions(asIScriptEngine* engine)
 	{
 		int r;
 		r = engine->RegisterGlobalFunction("int Random()", asFUNCTIONPR(asRandom, (), int), asCALL_CDECL); RETURN_ASSERT(r >= 0);
@@ -3503,7 +3700,7 @@ namespace Jazz2::Scripting
 		r = engine->RegisterGlobalFunction("void SetWeather(uint8, uint8)", asFUNCTION(asSetWeather), asCALL_CDECL); RETURN_ASSERT(r >= 0);
 
 		// Game-specific classes
-		ScriptActorWrapper::RegisterFactory(engine, module);
+		ScriptActorWrapper::RegisterFactory(engine, this);
 		ScriptPlayerWrapper::RegisterFactory(engine);
 	}
 
@@ -4,6 +4,7 @@
 
 #include "ScriptLoader.h"
 #include "JJ2PlusDefinitions.h"
+#include "ScriptProfiler.h"
 #include "../ILevelHandler.h"
 #include "../../nCine/Base/BitArray.h"
 
@@ -77,6 +78,11 @@ namespace Jazz2::Scripting
 			return _levelHandler;
 		}
 
+		/** @brief Returns profiler of all script calls */
+		ScriptProfiler& GetProfiler() {
+			return _profiler;
+		}
+
 		/**
 		 * @brief Plays a sound sample by its original sample index (see `SOUND::Sample`)
 		 *
@@ -113,10 +119,17 @@ namespace Jazz2::Scripting
 		/**
 		 * @brief Spawns a script-controlled object whose behavior function drives it each frame
 		 *
-		 * A host actor applies its velocity, calls the behavior over the jjOBJ, and syncs the position back. Returns a
-		 * script object ID. Used by `jjAddObject` when a custom behavior function is supplied.
+		 * Its velocity is applied and its behavior is called in @ref OnLevelUpdate() together with all other objects
+		 * sharing the same behavior, a host actor then syncs the position back. Returns a script object ID. Used by
+		 * `jjAddObject` when a custom behavior function is supplied.
 		 */
 		std::int32_t AddScriptControlledObject(std::uint8_t eventId, float xPixel, float yPixel, asIScriptFunction* behaviorFunc);
+		/**
+		 * @brief Returns `onBehave(jjOBJ@)` method of the specified `jjBEHAVIORINTERFACE` implementation
+		 *
+		 * The method is looked up only once per type. Returns `nullptr` if the type doesn't implement it.
+		 */
+		asIScriptFunction* GetBehaveMethod(asITypeInfo* type);
 
 		/**
 		 * @brief Returns the persistent `jjLAYER` proxy bound to the given level layer index
@@ -153,15 +166,34 @@ namespace Jazz2::Scripting
 		String OnProcessInclude(StringView includePath, StringView scriptPath) override;
 		void OnProcessPragma(StringView content, ScriptContextType& contextType) override;
 
-		/** @brief Called before a script function is called */
-		void OnBeforeScriptCall();
-		/** @brief Called after a script function is called */
-		void OnAfterScriptCall();
+		/** @brief Called before a script function is called, after its context is prepared */
+		void OnBeforeScriptCall(asIScriptContext* ctx);
+		/** @brief Called after a script function is called, before its context is returned */
+		void OnAfterScriptCall(asIScriptContext* ctx);
 
 	private:
+		// Script callback with its parameters bound once after the script is built
+		struct ScriptCallback {
+			asIScriptFunction* Function;
+			// Bit mask of parameters of type `jjPLAYER@`
+			std::uint8_t PlayerParams;
+			// Index of the first `bool`, `int8` or `uint8` parameter, or -1
+			std::int8_t ByteParam;
+		};
+
 		LevelHandler* _levelHandler;
+		ScriptProfiler _profiler;
+		asITypeInfo* _playerType;
+		asIScriptFunction* _onLevelLoad;
+		asIScriptFunction* _onLevelBegin;
+		asIScriptFunction* _onLevelReload;
 		asIScriptFunction* _onLevelUpdate;
+		asIScriptFunction* _onPlayer;
 		std::int32_t _onLevelUpdateLastFrame;
+		ScriptCallback _onPlayerTimerEnd;
+		ScriptCallback _onRoast;
+		SmallVector<ScriptCallback, 0> _onFunction;
+		HashMap<asITypeInfo*, asIScriptFunction*> _behaveMethods;
 		asIScriptFunction* _onDrawAmmo;
 		asIScriptFunction* _onDrawHealth;
 		asIScriptFunction* _onDrawLives;
@@ -191,6 +223,34 @@ namespace Jazz2::Scripting
 		HashMap<std::int32_t, std::weak_ptr<Actors::ActorBase>> _scriptObjects;
 		std::int32_t _nextScriptObjectId = 1;
 
+		// Script-controlled objects that share the same behavior, all of them are executed by a runner function in
+		// a single context, so the VM is entered only once per behavior instead of once per object. Handles are
+		// stored contiguously in script arrays that are refilled every frame, reusing their capacity.
+		struct BehaviorBatch {
+			// `jjVOIDFUNCOBJ` function or `onBehave()` method of a `jjBEHAVIORINTERFACE` implementation
+			asIScriptFunction* Behavior;
+			// `array<jjOBJ@>`
+			CScriptArray* Objects;
+			// `array<jjBEHAVIORINTERFACE@>` with instances the method is called on, `nullptr` for functions
+			CScriptArray* Instances;
+			std::uint32_t Count;
+		};
+
+		// All live script-controlled objects in order of spawning, each holds one reference
+		SmallVector<Legacy::jjOBJ*, 0> _controlledObjects;
+		SmallVector<BehaviorBatch, 0> _behaviorBatches;
+		HashMap<asIScriptFunction*, std::uint32_t> _behaviorBatchIndices;
+		asIScriptFunction* _runFunctionBatch = nullptr;
+		asIScriptFunction* _runMethodBatch = nullptr;
+		// Index of the next object of the running batch, it's advanced by the runner before each call, so the batch
+		// can continue with the next object if a behavior throws an exception
+		std::uint32_t _batchIndex = 0;
+
+		// Applies velocity of all script-controlled objects and runs their behaviors in batches
+		void UpdateControlledObjects(float timeMult);
+		BehaviorBatch& GetBehaviorBatch(asIScriptFunction* behavior, bool isMethod);
+		void RunBehaviorBatch(BehaviorBatch& batch);
+
 		// Persistent jjLAYER proxies keyed by engine layer index, created lazily when a script first accesses jjLayers[i].
 		// Each holds one AddRef'd reference (released in the destructor); SyncLayerProperties pushes their writable fields
 		// into the engine layer descriptions every frame so direct property writes (e.g., layer.xSpeed = N) take effect.
@@ -274,10 +334,12 @@ namespace Jazz2::Scripting
 		LevelScriptLoader& operator=(const LevelScriptLoader&) = delete;
 
 		Actors::ActorBase* CreateActorInstance(StringView typeName);
+		ScriptCallback BindCallback(asIScriptFunction* func) const;
+		void BindCallbacks();
 
 		static void RegisterBuiltInFunctions(asIScriptEngine* engine);
 		void RegisterLegacyFunctions(asIScriptEngine* engine);
-		void RegisterStandardFunctions(asIScriptEngine* engine, asIScriptModule* module);
+		void RegisterStandardFunctions(asIScriptEngine* engine);
 
 		static std::uint8_t asGetDifficulty();
 		static bool asIsReforged();
@@ -51,7 +51,7 @@ namespace Jazz2::Scripting
 		_isDead->Release();
 	}
 
-	void ScriptActorWrapper::RegisterFactory(asIScriptEngine* engine, asIScriptModule* module)
+	void ScriptActorWrapper::RegisterFactory(asIScriptEngine* engine, LevelScriptLoader* levelScripts)
 	{
 		static const char AsLibrary[] = R"(
 shared abstract class )" AsClassName R"(
@@ -168,7 +168,7 @@ shared abstract class CollectibleBase : )" AsClassName R"(
 		r = engine->RegisterObjectMethod(AsClassNameInternal, "void PlaySfx(const string &in, float, float)", asMETHOD(ScriptActorWrapper, asPlaySfx), asCALL_THISCALL); RETURN_ASSERT(r >= 0);
 		r = engine->RegisterObjectMethod(AsClassNameInternal, "void SetAnimation(int)", asMETHOD(ScriptActorWrapper, asSetAnimationState), asCALL_THISCALL); RETURN_ASSERT(r >= 0);
 
-		r = module->AddScriptSection("__" AsClassName, AsLibrary, arraySize(AsLibrary) - 1, 0); RETURN_ASSERT(r >= 0);
+		levelScripts->AddScriptSection("__" AsClassName, StringView(AsLibrary, arraySize(AsLibrary) - 1));
 	}
 
 	ScriptActorWrapper* ScriptActorWrapper::Factory(std::int32_t actorType)
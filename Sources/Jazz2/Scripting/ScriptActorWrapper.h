@@ -42,8 +42,8 @@ namespace Jazz2::Scripting
 		ScriptActorWrapper(LevelScriptLoader* levelScripts, asIScriptObject* obj);
 		~ScriptActorWrapper();
 
-		/** @brief Registers the actor factory to the specified **AngelScript** engine and module */
-		static void RegisterFactory(asIScriptEngine* engine, asIScriptModule* module);
+		/** @brief Registers the actor factory to the specified **AngelScript** engine and adds the base class to the main module of @p levelScripts */
+		static void RegisterFactory(asIScriptEngine* engine, LevelScriptLoader* levelScripts);
 		/** @brief Creates a new wrapper instance for the specified actor type */
 		static ScriptActorWrapper* Factory(std::int32_t actorType);
 
@@ -5,6 +5,7 @@
 
 #include <Containers/GrowableArray.h>
 #include <Containers/StringConcatenable.h>
+#include <Cryptography/xxHash.h>
 #include <IO/FileSystem.h>
 
 #if defined(DEATH_TARGET_WINDOWS) && !defined(CMAKE_BUILD)
@@ -25,12 +26,37 @@
 #   endif
 #endif
 
+using namespace Death::Cryptography;
 using namespace Death::IO;
 
 namespace Jazz2::Scripting
 {
+	namespace
+	{
+		constexpr std::uint16_t BytecodeCacheVersion = 1;
+
+		/** @brief Adapts @ref Stream to the binary stream interface used by the **AngelScript** bytecode reader and writer */
+		class BytecodeStream : public asIBinaryStream
+		{
+		public:
+			BytecodeStream(Stream& s)
+				: _s(s) {}
+
+			int Read(void* ptr, asUINT size) override {
+				return (_s.Read(ptr, size) == (std::int64_t)size ? 0 : -1);
+			}
+
+			int Write(const void* ptr, asUINT size) override {
+				return (_s.Write(ptr, size) == (std::int64_t)size ? 0 : -1);
+			}
+
+		private:
+			Stream& _s;
+		};
+	}
+
 	ScriptLoader::ScriptLoader()
-		: _module(nullptr), _scriptContextType(ScriptContextType::Unknown)
+		: _module(nullptr), _scriptContextType(ScriptContextType::Unknown), _preparedContextUsage(0), _sourceHash(0)
 	{
 		_engine = asCreateScriptEngine();
 		_engine->SetEngineProperty(asEP_COPY_SCRIPT_SECTIONS, true);
@@ -52,6 +78,9 @@ namespace Jazz2::Scripting
 
 	ScriptLoader::~ScriptLoader()
 	{
+		for (auto& entry : _preparedContexts) {
+			entry.Context->Release();
+		}
 		for (auto ctx : _contextPool) {
 			ctx->Release();
 		}
@@ -319,7 +348,8 @@ namespace Jazz2::Scripting
 		}
 
 		// Append the actual script
-		_module->AddScriptSection(path.data(), scriptContent.data(), scriptSize, 0);
+		_scriptSections.emplace_back(String(path), std::move(scriptContent));
+		_sourceHash = xxHash3(_scriptSections.back().Content.data(), _scriptSections.back().Content.size(), _sourceHash ^ xxHash3(path.data(), path.size()));
 
 		if (includes.size() > 0) {
 			// Load all included scripts
@@ -333,13 +363,44 @@ namespace Jazz2::Scripting
 		return contextType;
 	}
 
-	ScriptBuildResult ScriptLoader::Build()
+	void ScriptLoader::AddScriptSection(StringView name, StringView content)
 	{
-		std::int32_t r = _module->Build();
-		if (r < 0) {
-			return (ScriptBuildResult)r;
+		_scriptSections.emplace_back(String(name), String(content));
+		_sourceHash = xxHash3(content.data(), content.size(), _sourceHash ^ xxHash3(name.data(), name.size()));
+	}
+
+	ScriptBuildResult ScriptLoader::Build(StringView bytecodeCachePath)
+	{
+		// Preprocessing (and metadata extraction) has to run anyway, so the cache only saves the compilation itself
+		std::uint64_t cacheKey = 0;
+		bool loadedFromCache = false;
+		if (!bytecodeCachePath.empty()) {
+			std::uint64_t apiHash = GetRegisteredApiHash();
+			cacheKey = xxHash3(&_sourceHash, sizeof(_sourceHash), apiHash);
+			loadedFromCache = TryLoadBytecode(bytecodeCachePath, cacheKey);
+		}
+
+		if (!loadedFromCache) {
+			for (auto& section : _scriptSections) {
+				std::int32_t r = _module->AddScriptSection(section.Name.data(), section.Content.data(), section.Content.size(), 0);
+				if (r < 0) {
+					return ScriptBuildResult::BuildFailed;
+				}
+			}
+
+			std::int32_t r = _module->Build();
+			if (r < 0) {
+				return (ScriptBuildResult)r;
+			}
+
+			if (!bytecodeCachePath.empty()) {
+				SaveBytecode(bytecodeCachePath, cacheKey);
+			}
 		}
 
+		// Sources are not needed anymore
+		_scriptSections.clear();
+
 		// After the script has been built, the metadata strings should be stored for later lookup
 		for (auto& decl : _foundDeclarations) {
 			_module->SetDefaultNamespace(decl.Namespace.data());
@@ -500,6 +561,198 @@ namespace Jazz2::Scripting
 		_scriptContextType = value;
 	}
 
+	asIScriptContext* ScriptLoader::PrepareContext(asIScriptFunction* func)
+	{
+		// Prefer a context that executed the same function last time, Prepare() is much cheaper then
+		PreparedContext* target = nullptr;
+		for (auto& entry : _preparedContexts) {
+			if (!entry.InUse) {
+				if (entry.Function == func) {
+					target = &entry;
+					break;
+				}
+				// An unprepared context is as good as a new one, otherwise the least recently used one is replaced
+				if (target == nullptr || (target->Function != nullptr && (entry.Function == nullptr || entry.LastUsed < target->LastUsed))) {
+					target = &entry;
+				}
+			}
+		}
+
+		if (target == nullptr || (target->Function != func && target->Function != nullptr && _preparedContexts.size() < MaxPreparedContexts)) {
+			if (_preparedContexts.size() >= MaxPreparedContexts) {
+				// All contexts are executing (nested calls), so fall back to a temporary one from the pool
+				asIScriptContext* ctx = _engine->RequestContext();
+				ctx->Prepare(func);
+				return ctx;
+			}
+			target = &_preparedContexts.emplace_back();
+			target->Context = _engine->CreateContext();
+		}
+
+		target->Function = func;
+		target->LastUsed = ++_preparedContextUsage;
+		target->InUse = true;
+		target->Context->Prepare(func);
+		return target->Context;
+	}
+
+	void ScriptLoader::ReturnPreparedContext(asIScriptContext* ctx)
+	{
+		for (auto& entry : _preparedContexts) {
+			if (entry.Context == ctx) {
+				// The context stays prepared for the next call of the same function only if it holds no references.
+				// Otherwise the arguments of an unfinished call, the object of a method or the returned object
+				// would be kept alive by the cache until the same function is called again.
+				if (ctx->GetState() != asEXECUTION_FINISHED || entry.Function->GetObjectType() != nullptr ||
+					(entry.Function->GetReturnTypeId() & (asTYPEID_MASK_OBJECT | asTYPEID_OBJHANDLE)) != 0) {
+					ctx->Unprepare();
+					entry.Function = nullptr;
+				}
+				entry.InUse = false;
+				return;
+			}
+		}
+
+		_engine->ReturnContext(ctx);
+	}
+
+	std::uint64_t ScriptLoader::GetRegisteredApiHash() const
+	{
+		// Bytecode refers to registered functions, types and properties by their declarations, so they are hashed
+		// in the order of registration, together with the engine and the game version (built-in script sections
+		// are part of the source hash already)
+		std::uint64_t hash = xxHash3(NCINE_VERSION, sizeof(NCINE_VERSION) - 1, ANGELSCRIPT_VERSION);
+		auto append = [&hash](const char* str) {
+			if (str != nullptr) {
+				hash = xxHash3(str, std::strlen(str), hash);
+			} else {
+				hash = xxHash3(&hash, sizeof(hash));
+			}
+		};
+		auto appendValue = [&hash](std::int64_t value) {
+			hash = xxHash3(&value, sizeof(value), hash);
+		};
+
+		for (asUINT i = 0; i < _engine->GetObjectTypeCount(); i++) {
+			asITypeInfo* type = _engine->GetObjectTypeByIndex(i);
+			append(type->GetNamespace());
+			append(type->GetName());
+			appendValue((std::int64_t)type->GetFlags());
+			for (asUINT j = 0; j < type->GetBehaviourCount(); j++) {
+				asEBehaviours behaviour;
+				asIScriptFunction* func = type->GetBehaviourByIndex(j, &behaviour);
+				appendValue(behaviour);
+				append(func->GetDeclaration(true, true, true));
+			}
+			for (asUINT j = 0; j < type->GetFactoryCount(); j++) {
+				append(type->GetFactoryByIndex(j)->GetDeclaration(true, true, true));
+			}
+			for (asUINT j = 0; j < type->GetMethodCount(); j++) {
+				append(type->GetMethodByIndex(j)->GetDeclaration(true, true, true));
+			}
+			for (asUINT j = 0; j < type->GetPropertyCount(); j++) {
+				append(type->GetPropertyDeclaration(j, true));
+			}
+		}
+
+		for (asUINT i = 0; i < _engine->GetEnumCount(); i++) {
+			asITypeInfo* type = _engine->GetEnumByIndex(i);
+			append(type->GetNamespace());
+			append(type->GetName());
+			for (asUINT j = 0; j < type->GetEnumValueCount(); j++) {
+				std::int32_t value;
+				append(type->GetEnumValueByIndex(j, &value));
+				appendValue(value);
+			}
+		}
+
+		for (asUINT i = 0; i < _engine->GetFuncdefCount(); i++) {
+			asITypeInfo* type = _engine->GetFuncdefByIndex(i);
+			append(type->GetFuncdefSignature()->GetDeclaration(true, true, true));
+		}
+
+		for (asUINT i = 0; i < _engine->GetTypedefCount(); i++) {
+			asITypeInfo* type = _engine->GetTypedefByIndex(i);
+			append(type->GetNamespace());
+			append(type->GetName());
+			append(_engine->GetTypeDeclaration(type->GetTypedefTypeId(), true));
+		}
+
+		for (asUINT i = 0; i < _engine->GetGlobalFunctionCount(); i++) {
+			append(_engine->GetGlobalFunctionByIndex(i)->GetDeclaration(true, true, true));
+		}
+
+		for (asUINT i = 0; i < _engine->GetGlobalPropertyCount(); i++) {
+			const char* name; const char* nameSpace;
+			std::int32_t typeId; bool isConst;
+			_engine->GetGlobalPropertyByIndex(i, &name, &nameSpace, &typeId, &isConst);
+			append(nameSpace);
+			append(name);
+			append(_engine->GetTypeDeclaration(typeId, true));
+			appendValue(isConst ? 1 : 0);
+		}
+
+		return hash;
+	}
+
+	bool ScriptLoader::TryLoadBytecode(StringView path, std::uint64_t cacheKey)
+	{
+		auto s = fs::Open(path, FileAccess::Read);
+		if (s->GetSize() < 20) {
+			return false;
+		}
+
+		std::uint64_t signature = s->ReadValueAsLE<std::uint64_t>();
+		std::uint8_t fileType = s->ReadValue<std::uint8_t>();
+		std::uint16_t version = s->ReadValueAsLE<std::uint16_t>();
+		std::uint64_t storedCacheKey = s->ReadValueAsLE<std::uint64_t>();
+		if (signature != 0x2095A59FF0BFBBEF || fileType != ContentFileType::ScriptBytecode || version != BytecodeCacheVersion) {
+			LOGW("Invalid script bytecode cache \"{}\"", path);
+			return false;
+		}
+		if (storedCacheKey != cacheKey) {
+			LOGD("Script bytecode cache \"{}\" is outdated", path);
+			return false;
+		}
+
+		BytecodeStream stream(*s);
+		std::int32_t r = _module->LoadByteCode(&stream);
+		if (r < 0) {
+			LOGW("Cannot load script bytecode cache \"{}\" ({})", path, r);
+			// Loading failed half-way, so start again with an empty module
+			_module->Discard();
+			_module = _engine->GetModule("Main", asGM_ALWAYS_CREATE);
+			return false;
+		}
+
+		LOGD("Script loaded from bytecode cache \"{}\"", path);
+		return true;
+	}
+
+	void ScriptLoader::SaveBytecode(StringView path, std::uint64_t cacheKey)
+	{
+		fs::CreateDirectories(fs::GetDirectoryName(path));
+
+		auto s = fs::Open(path, FileAccess::Write);
+		if (!s->IsValid()) {
+			LOGW("Cannot create script bytecode cache \"{}\"", path);
+			return;
+		}
+
+		s->WriteValueAsLE<std::uint64_t>(0x2095A59FF0BFBBEF);
+		s->WriteValue<std::uint8_t>(ContentFileType::ScriptBytecode);
+		s->WriteValueAsLE<std::uint16_t>(BytecodeCacheVersion);
+		s->WriteValueAsLE<std::uint64_t>(cacheKey);
+
+		BytecodeStream stream(*s);
+		std::int32_t r = _module->SaveByteCode(&stream, false);
+		if (r < 0) {
+			LOGW("Cannot save script bytecode cache \"{}\" ({})", path, r);
+			s = nullptr;
+			fs::RemoveFile(path);
+		}
+	}
+
 	std::int32_t ScriptLoader::ExcludeCode(String& scriptContent, std::int32_t pos)
 	{
 		std::int32_t scriptSize = (std::int32_t)scriptContent.size();
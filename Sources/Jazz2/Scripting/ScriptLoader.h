@@ -96,11 +96,37 @@ namespace Jazz2::Scripting
 			return _scriptContextType;
 		}
 
+		/**
+			@brief Adds a script section from memory to the main module
+
+			The section is added to the module only during @ref Build() and only if the module cannot be loaded from
+			the bytecode cache, but its content is always part of the cache key.
+		*/
+		void AddScriptSection(StringView name, StringView content);
+
+		/**
+			@brief Returns a context prepared to execute the specified function
+
+			Contexts are kept prepared for the functions they executed last, so callbacks that are called repeatedly
+			(every frame or for every object) skip most of the setup in `Prepare()`. Arguments have to be set again
+			before each execution. The context must be returned with @ref ReturnPreparedContext(), which unprepares
+			it if it could still hold a reference to an object.
+		*/
+		asIScriptContext* PrepareContext(asIScriptFunction* func);
+		/** @brief Returns a context obtained from @ref PrepareContext() */
+		void ReturnPreparedContext(asIScriptContext* ctx);
+
 	protected:
 		/** @brief Adds a script path from file to the main module */
 		ScriptContextType AddScriptFromFile(StringView path, const HashMap<String, bool>& definedSymbols);
-		/** @brief Builds the main module and extracts metadata */
-		ScriptBuildResult Build();
+		/**
+			@brief Builds the main module and extracts metadata
+
+			If @p bytecodeCachePath is specified, the module is loaded from the bytecode stored there instead, as long
+			as it was compiled from the same preprocessed sources against the same registered API. Otherwise, the module
+			is compiled from sources and the bytecode is saved to @p bytecodeCachePath for the next time.
+		*/
+		ScriptBuildResult Build(StringView bytecodeCachePath = {});
 		/** @brief Sets context type */
 		void SetContextType(ScriptContextType value);
 
@@ -152,16 +178,36 @@ namespace Jazz2::Scripting
 			HashMap<std::int32_t, Array<String>> FuncMetadataMap;
 			HashMap<std::int32_t, Array<String>> VarMetadataMap;
 		};
+
+		struct PreparedContext {
+			asIScriptFunction* Function;
+			asIScriptContext* Context;
+			std::uint32_t LastUsed;
+			bool InUse;
+		};
+
+		struct ScriptSection {
+			ScriptSection(String name, String content)
+				: Name(std::move(name)), Content(std::move(content)) {}
+
+			String Name;
+			String Content;
+		};
 #endif
 
 		static constexpr asPWORD EngineToOwner = 0;
+		static constexpr std::uint32_t MaxPreparedContexts = 16;
 
 		asIScriptEngine* _engine;
 		asIScriptModule* _module;
 		ScriptContextType _scriptContextType;
 		SmallVector<asIScriptContext*, 4> _contextPool;
+		SmallVector<PreparedContext, 0> _preparedContexts;
+		std::uint32_t _preparedContextUsage;
 
 		HashMap<String, bool> _includedFiles;
+		SmallVector<ScriptSection, 0> _scriptSections;
+		std::uint64_t _sourceHash;
 		SmallVector<RawMetadataDeclaration, 0> _foundDeclarations;
 		HashMap<std::int32_t, Array<String>> _typeMetadataMap;
 		HashMap<std::int32_t, Array<String>> _funcMetadataMap;
@@ -173,6 +219,10 @@ namespace Jazz2::Scripting
 		std::int32_t ExtractMetadata(MutableStringView scriptContent, std::int32_t pos, SmallVectorImpl<String>& metadata);
 		std::int32_t ExtractDeclaration(StringView scriptContent, std::int32_t pos, String& name, String& declaration, MetadataType& type);
 
+		std::uint64_t GetRegisteredApiHash() const;
+		bool TryLoadBytecode(StringView path, std::uint64_t cacheKey);
+		void SaveBytecode(StringView path, std::uint64_t cacheKey);
+
 		static asIScriptContext* RequestContextCallback(asIScriptEngine* engine, void* param);
 		static void ReturnContextCallback(asIScriptEngine* engine, asIScriptContext* ctx, void* param);
 
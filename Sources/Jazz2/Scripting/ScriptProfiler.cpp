@@ -0,0 +1,174 @@
+﻿#if defined(WITH_ANGELSCRIPT)
+
+#include "ScriptProfiler.h"
+
+#include <algorithm>
+
+namespace Jazz2::Scripting
+{
+	ScriptProfiler::ScriptProfiler()
+		: _frameBudget(0.0f), _frameTime(0.0f), _lastFrameTime(0.0f), _linesUntilBudgetCheck(0)
+	{
+	}
+
+	void ScriptProfiler::SetFrameBudget(float value)
+	{
+		_frameBudget = std::max(value, 0.0f);
+	}
+
+	void ScriptProfiler::BeginFrame()
+	{
+		for (auto& stats : _stats) {
+			stats.LastFrameCallCount = stats.FrameCallCount;
+			stats.LastFrameTime = stats.FrameTime;
+			if (stats.PeakFrameTime < stats.FrameTime) {
+				stats.PeakFrameTime = stats.FrameTime;
+			}
+			stats.FrameCallCount = 0;
+			stats.FrameTime = 0.0f;
+		}
+
+		_lastFrameTime = _frameTime;
+		_frameTime = 0.0f;
+	}
+
+	void ScriptProfiler::BeginCall(asIScriptContext* ctx, asIScriptFunction* func)
+	{
+		if (_frameBudget > 0.0f) {
+			ctx->SetLineCallback(asMETHOD(ScriptProfiler, LineCallback), this, asCALL_THISCALL);
+			if (_callStack.empty()) {
+				_linesUntilBudgetCheck = LinesPerBudgetCheck;
+			}
+		} else {
+			ctx->ClearLineCallback();
+		}
+
+		auto& call = _callStack.emplace_back();
+		call.Context = ctx;
+		call.StatsIndex = GetOrCreateStats(func != nullptr ? func : ctx->GetFunction());
+		call.AllocationsAtStart = GetAllocationCount(ctx);
+		// Timestamp is taken last, so the bookkeeping above is not measured
+		call.Start = TimeStamp::now();
+	}
+
+	void ScriptProfiler::EndCall(asIScriptContext* ctx)
+	{
+		if (_callStack.empty() || _callStack.back().Context != ctx) {
+			LOGW("Script call ended in a different order than it began");
+			_callStack.clear();
+			return;
+		}
+
+		const ActiveCall& call = _callStack.back();
+		float elapsed = call.Start.millisecondsSince();
+
+		FunctionStats& stats = _stats[call.StatsIndex];
+		stats.CallCount++;
+		stats.FrameCallCount++;
+		stats.AllocationCount += GetAllocationCount(ctx) - call.AllocationsAtStart;
+		stats.TotalTime += elapsed;
+		stats.FrameTime += elapsed;
+
+		if (ctx->GetState() == asEXECUTION_ABORTED) {
+			stats.AbortCount++;
+			LOGW("Script function \"{}\" was aborted after {:.1f} ms, because it exceeded the frame budget of {:.1f} ms ({} aborts so far)",
+				stats.Name, elapsed, _frameBudget, stats.AbortCount);
+		}
+
+		_callStack.pop_back();
+		if (_callStack.empty()) {
+			// Only the outermost calls are counted, nested calls are already included in them
+			_frameTime += elapsed;
+		}
+	}
+
+	SmallVector<std::uint32_t, 0> ScriptProfiler::GetTopFunctions(std::uint32_t count) const
+	{
+		SmallVector<std::uint32_t, 0> result;
+		result.reserve(_stats.size());
+		for (std::uint32_t i = 0; i < (std::uint32_t)_stats.size(); i++) {
+			result.push_back(i);
+		}
+
+		auto isMoreExpensive = [this](std::uint32_t a, std::uint32_t b) {
+			const FunctionStats& sa = _stats[a];
+			const FunctionStats& sb = _stats[b];
+			if (sa.LastFrameTime != sb.LastFrameTime) {
+				return (sa.LastFrameTime > sb.LastFrameTime);
+			}
+			return (sa.TotalTime > sb.TotalTime);
+		};
+
+		if (count < result.size()) {
+			std::partial_sort(result.begin(), result.begin() + count, result.end(), isMoreExpensive);
+			result.resize(count);
+		} else {
+			std::sort(result.begin(), result.end(), isMoreExpensive);
+		}
+		return result;
+	}
+
+	void ScriptProfiler::Reset()
+	{
+		_stats.clear();
+		_statsIndices.clear();
+		_lastFrameTime = 0.0f;
+		_frameTime = 0.0f;
+	}
+
+	std::uint32_t ScriptProfiler::GetOrCreateStats(asIScriptFunction* func)
+	{
+		auto it = _statsIndices.find(func);
+		if (it != _statsIndices.end()) {
+			return it->second;
+		}
+
+		std::uint32_t index = (std::uint32_t)_stats.size();
+		FunctionStats& stats = _stats.emplace_back();
+		stats.Function = func;
+		stats.Name = func->GetDeclaration(true, true);
+		stats.CallCount = 0;
+		stats.LastFrameCallCount = 0;
+		stats.AllocationCount = 0;
+		stats.AbortCount = 0;
+		stats.TotalTime = 0.0;
+		stats.LastFrameTime = 0.0f;
+		stats.PeakFrameTime = 0.0f;
+		stats.FrameCallCount = 0;
+		stats.FrameTime = 0.0f;
+		_statsIndices.emplace(func, index);
+		return index;
+	}
+
+	void ScriptProfiler::LineCallback(asIScriptContext* ctx)
+	{
+		// Reading the clock on every line would be too expensive, so the budget is checked only once in a while
+		if (--_linesUntilBudgetCheck > 0) {
+			return;
+		}
+		_linesUntilBudgetCheck = LinesPerBudgetCheck;
+
+		if (_frameBudget <= 0.0f || _callStack.empty()) {
+			return;
+		}
+
+		// Only the outermost call that overran the budget by itself is aborted, the time of the preceding calls is not
+		// included, so callbacks that run after an expensive one in the same frame are not cut short
+		if (_callStack[0].Start.millisecondsSince() <= _frameBudget) {
+			return;
+		}
+
+		// Callbacks cannot be resumed later, so the script is aborted instead of suspended
+		ctx->Abort();
+	}
+
+	std::uint32_t ScriptProfiler::GetAllocationCount(asIScriptContext* ctx)
+	{
+		// Objects are either still alive or already destroyed, so their sum only grows with each new object
+		asUINT currentSize = 0, totalDestroyed = 0;
+		ctx->GetEngine()->GetGCStatistics(&currentSize, &totalDestroyed);
+		return (std::uint32_t)(currentSize + totalDestroyed);
+	}
+}
+
+#endif
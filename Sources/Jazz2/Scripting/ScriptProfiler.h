@@ -0,0 +1,128 @@
+﻿#pragma once
+
+#if defined(WITH_ANGELSCRIPT) || defined(DOXYGEN_GENERATING_OUTPUT)
+
+#include "../../Main.h"
+#include "../../nCine/Base/HashMap.h"
+#include "../../nCine/Base/TimeStamp.h"
+
+#include <angelscript.h>
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace Jazz2::Scripting
+{
+	/**
+		@brief Measures time spent in individual script callbacks and enforces a per-frame time budget
+
+		Every script call is wrapped in @ref BeginCall() and @ref EndCall(), which record wall time, number of calls
+		and number of garbage-collected objects created per function. Nested calls (e.g., a callback that triggers
+		another script callback through the engine) are measured separately, but only the outermost calls count
+		against the frame budget. If the budget is set, a line callback is installed to every executing context,
+		so an outermost call that alone runs past the budget (e.g., stuck in an infinite loop) is aborted instead
+		of freezing the game. Calls that only add up past the budget are not aborted, so one expensive callback
+		cannot cause the rest of the frame's callbacks to be cut short.
+
+		@experimental
+	*/
+	class ScriptProfiler
+	{
+	public:
+		/** @brief Statistics of a single script function */
+		struct FunctionStats {
+			/** @brief Profiled function */
+			asIScriptFunction* Function;
+			/** @brief Function declaration */
+			String Name;
+			/** @brief Total number of calls */
+			std::uint32_t CallCount;
+			/** @brief Number of calls in the last frame */
+			std::uint32_t LastFrameCallCount;
+			/** @brief Total number of garbage-collected objects created during the calls */
+			std::uint32_t AllocationCount;
+			/** @brief Number of calls aborted because the frame budget was exceeded */
+			std::uint32_t AbortCount;
+			/** @brief Total time spent in the function, in milliseconds */
+			double TotalTime;
+			/** @brief Time spent in the function in the last frame, in milliseconds */
+			float LastFrameTime;
+			/** @brief Maximum time spent in the function in a single frame, in milliseconds */
+			float PeakFrameTime;
+
+			// Accumulated in the current frame
+			std::uint32_t FrameCallCount;
+			float FrameTime;
+		};
+
+		ScriptProfiler();
+
+		ScriptProfiler(const ScriptProfiler&) = delete;
+		ScriptProfiler& operator=(const ScriptProfiler&) = delete;
+
+		/** @brief Returns time budget for all script calls in one frame, in milliseconds, 0 if disabled */
+		float GetFrameBudget() const {
+			return _frameBudget;
+		}
+		/** @brief Sets time budget for all script calls in one frame, in milliseconds, 0 to disable */
+		void SetFrameBudget(float value);
+
+		/** @brief Starts a new frame, it should be called before any script call of the frame */
+		void BeginFrame();
+		/**
+			@brief Called before the prepared context is executed
+
+			The call is attributed to @p func if specified, otherwise to the function the context was prepared for.
+		*/
+		void BeginCall(asIScriptContext* ctx, asIScriptFunction* func = nullptr);
+		/** @brief Called after the context is executed */
+		void EndCall(asIScriptContext* ctx);
+
+		/** @brief Returns time spent in all script calls in the last frame, in milliseconds */
+		float GetLastFrameTime() const {
+			return _lastFrameTime;
+		}
+		/** @brief Returns statistics of all functions called so far, in the order of the first call */
+		ArrayView<const FunctionStats> GetStats() const {
+			return _stats;
+		}
+		/**
+			@brief Returns indices into @ref GetStats() of the most expensive functions
+
+			Functions are ordered by time spent in the last frame, then by total time. At most @p count indices are
+			returned.
+		*/
+		SmallVector<std::uint32_t, 0> GetTopFunctions(std::uint32_t count) const;
+		/** @brief Resets all statistics */
+		void Reset();
+
+	private:
+		struct ActiveCall {
+			asIScriptContext* Context;
+			std::uint32_t StatsIndex;
+			TimeStamp Start;
+			std::uint32_t AllocationsAtStart;
+		};
+
+		// Number of executed lines between two checks of the time budget
+		static constexpr std::uint32_t LinesPerBudgetCheck = 64;
+
+		SmallVector<FunctionStats, 0> _stats;
+		HashMap<asIScriptFunction*, std::uint32_t> _statsIndices;
+		SmallVector<ActiveCall, 4> _callStack;
+		float _frameBudget;
+		float _frameTime;
+		float _lastFrameTime;
+		std::uint32_t _linesUntilBudgetCheck;
+
+		std::uint32_t GetOrCreateStats(asIScriptFunction* func);
+		void LineCallback(asIScriptContext* ctx);
+
+		static std::uint32_t GetAllocationCount(asIScriptContext* ctx);
+	};
+}
+
+#endif
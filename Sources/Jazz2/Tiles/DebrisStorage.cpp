@@ -0,0 +1,272 @@
+﻿#include "DebrisStorage.h"
+
+#if defined(DEATH_TARGET_X86)
+#	if defined(DEATH_TARGET_SSE2)
+#		include <IntrinsicsSse2.h>
+#	endif
+#elif defined(DEATH_TARGET_ARM)
+#	if defined(DEATH_TARGET_NEON)
+#		include <arm_neon.h>
+#	endif
+#endif
+
+#include <algorithm>
+
+namespace Jazz2::Tiles
+{
+	namespace
+	{
+		// Both kernels below are written once against these wrappers, the scalar one also handles the remainder
+		// of the vector loop. Operations are issued in the same order in all of them (and without FMA), so every
+		// backend produces bit-identical results.
+		struct ScalarLanes
+		{
+			static constexpr std::size_t Width = 1;
+			using Float = float;
+			using Mask = bool;
+
+			static Float Load(const float* src) { return *src; }
+			static void Store(float* dst, Float value) { *dst = value; }
+			static Float Set(float value) { return value; }
+			static Float Add(Float a, Float b) { return a + b; }
+			static Float Sub(Float a, Float b) { return a - b; }
+			static Float Mul(Float a, Float b) { return a * b; }
+			static Float Min(Float a, Float b) { return std::min(a, b); }
+			static Mask IsNonZero(Float a) { return (a != 0.0f); }
+			static Mask IsNotPositive(Float a) { return (a <= 0.0f); }
+			static Float Select(Mask mask, Float a, Float b) { return (mask ? a : b); }
+		};
+
+#if defined(DEATH_TARGET_SSE2)
+		struct VectorLanes
+		{
+			static constexpr std::size_t Width = 4;
+			using Float = __m128;
+			using Mask = __m128;
+
+			static Float Load(const float* src) { return _mm_loadu_ps(src); }
+			static void Store(float* dst, Float value) { _mm_storeu_ps(dst, value); }
+			static Float Set(float value) { return _mm_set1_ps(value); }
+			static Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+			static Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+			static Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+			// Operands are swapped, so the first one is returned for NaN like std::min() does
+			static Float Min(Float a, Float b) { return _mm_min_ps(b, a); }
+			static Mask IsNonZero(Float a) { return _mm_cmpneq_ps(a, _mm_setzero_ps()); }
+			static Mask IsNotPositive(Float a) { return _mm_cmple_ps(a, _mm_setzero_ps()); }
+			static Float Select(Mask mask, Float a, Float b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+		};
+#elif defined(DEATH_TARGET_NEON)
+		struct VectorLanes
+		{
+			static constexpr std::size_t Width = 4;
+			using Float = float32x4_t;
+			using Mask = uint32x4_t;
+
+			static Float Load(const float* src) { return vld1q_f32(src); }
+			static void Store(float* dst, Float value) { vst1q_f32(dst, value); }
+			static Float Set(float value) { return vdupq_n_f32(value); }
+			static Float Add(Float a, Float b) { return vaddq_f32(a, b); }
+			static Float Sub(Float a, Float b) { return vsubq_f32(a, b); }
+			static Float Mul(Float a, Float b) { return vmulq_f32(a, b); }
+			static Float Min(Float a, Float b) { return vminq_f32(a, b); }
+			static Mask IsNonZero(Float a) { return vmvnq_u32(vceqq_f32(a, vdupq_n_f32(0.0f))); }
+			static Mask IsNotPositive(Float a) { return vcleq_f32(a, vdupq_n_f32(0.0f)); }
+			static Float Select(Mask mask, Float a, Float b) { return vbslq_f32(mask, a, b); }
+		};
+#else
+		using VectorLanes = ScalarLanes;
+#endif
+
+		template<class L>
+		std::size_t UpdateLifetimeLanes(DebrisStorage& s, std::size_t i, std::size_t count, float timeMult)
+		{
+			const typename L::Float t = L::Set(timeMult);
+			const typename L::Float fadeOutSpeed = L::Set(-0.08f);
+
+			for (; i + L::Width <= count; i += L::Width) {
+				typename L::Float time = L::Sub(L::Load(&s.Time[i]), t);
+				L::Store(&s.Time[i], time);
+
+				// Time's up - fade out smoothly instead of popping while still partly visible (e.g., the Fire/Lightning
+				// death effects, whose own AlphaSpeed is too slow to reach zero within their lifetime)
+				typename L::Float alphaSpeed = L::Load(&s.AlphaSpeed[i]);
+				L::Store(&s.AlphaSpeed[i], L::Select(L::IsNotPositive(time), L::Min(alphaSpeed, fadeOutSpeed), alphaSpeed));
+			}
+			return i;
+		}
+
+		template<class L>
+		std::size_t IntegrateLanes(DebrisStorage& s, std::size_t i, std::size_t count, float timeMult)
+		{
+			const typename L::Float t = L::Set(timeMult);
+			const typename L::Float half = L::Set(0.5f);
+			const typename L::Float maxSpeed = L::Set(10.0f);
+
+			for (; i + L::Width <= count; i += L::Width) {
+				typename L::Float speedX = L::Load(&s.SpeedX[i]);
+				typename L::Float speedY = L::Load(&s.SpeedY[i]);
+				typename L::Float accelX = L::Load(&s.AccelerationX[i]);
+				typename L::Float accelY = L::Load(&s.AccelerationY[i]);
+
+				L::Store(&s.PosX[i], L::Add(L::Load(&s.PosX[i]), L::Add(L::Mul(speedX, t), L::Mul(L::Mul(L::Mul(half, accelX), t), t))));
+				L::Store(&s.PosY[i], L::Add(L::Load(&s.PosY[i]), L::Add(L::Mul(speedY, t), L::Mul(L::Mul(L::Mul(half, accelY), t), t))));
+
+				// Speed is clamped only while accelerating, a particle can be thrown faster than it could fall
+				L::Store(&s.SpeedX[i], L::Select(L::IsNonZero(accelX), L::Min(L::Add(speedX, L::Mul(accelX, t)), maxSpeed), speedX));
+				L::Store(&s.SpeedY[i], L::Select(L::IsNonZero(accelY), L::Min(L::Add(speedY, L::Mul(accelY, t)), maxSpeed), speedY));
+
+				L::Store(&s.Scale[i], L::Add(L::Load(&s.Scale[i]), L::Mul(L::Load(&s.ScaleSpeed[i]), t)));
+				L::Store(&s.Angle[i], L::Add(L::Load(&s.Angle[i]), L::Mul(L::Load(&s.AngleSpeed[i]), t)));
+				L::Store(&s.Alpha[i], L::Add(L::Load(&s.Alpha[i]), L::Mul(L::Load(&s.AlphaSpeed[i]), t)));
+			}
+			return i;
+		}
+	}
+
+	void DebrisStorage::clear()
+	{
+		PosX.clear();
+		PosY.clear();
+		SpeedX.clear();
+		SpeedY.clear();
+		AccelerationX.clear();
+		AccelerationY.clear();
+		Scale.clear();
+		ScaleSpeed.clear();
+		Angle.clear();
+		AngleSpeed.clear();
+		Alpha.clear();
+		AlphaSpeed.clear();
+		Time.clear();
+		Elasticity.clear();
+		Flags.clear();
+		Appearances.clear();
+	}
+
+	void DebrisStorage::shrink(std::size_t capacity)
+	{
+		PosX.shrink(capacity);
+		PosY.shrink(capacity);
+		SpeedX.shrink(capacity);
+		SpeedY.shrink(capacity);
+		AccelerationX.shrink(capacity);
+		AccelerationY.shrink(capacity);
+		Scale.shrink(capacity);
+		ScaleSpeed.shrink(capacity);
+		Angle.shrink(capacity);
+		AngleSpeed.shrink(capacity);
+		Alpha.shrink(capacity);
+		AlphaSpeed.shrink(capacity);
+		Time.shrink(capacity);
+		Elasticity.shrink(capacity);
+		Flags.shrink(capacity);
+		Appearances.shrink(capacity);
+	}
+
+	void DebrisStorage::push_back(const DestructibleDebris& debris)
+	{
+		PosX.push_back(debris.Pos.X);
+		PosY.push_back(debris.Pos.Y);
+		SpeedX.push_back(debris.Speed.X);
+		SpeedY.push_back(debris.Speed.Y);
+		AccelerationX.push_back(debris.Acceleration.X);
+		AccelerationY.push_back(debris.Acceleration.Y);
+		Scale.push_back(debris.Scale);
+		ScaleSpeed.push_back(debris.ScaleSpeed);
+		Angle.push_back(debris.Angle);
+		AngleSpeed.push_back(debris.AngleSpeed);
+		Alpha.push_back(debris.Alpha);
+		AlphaSpeed.push_back(debris.AlphaSpeed);
+		Time.push_back(debris.Time);
+		Elasticity.push_back(debris.Elasticity);
+		Flags.push_back(debris.Flags);
+		Appearances.push_back({ debris.Size, debris.FrameOffset, debris.TexScaleX, debris.TexBiasX, debris.TexScaleY,
+			debris.TexBiasY, debris.DiffuseTexture, debris.PaletteOffset, debris.Depth });
+	}
+
+	void DebrisStorage::RemoveExpired()
+	{
+		auto isAlive = [this](std::size_t i) {
+			return (Scale[i] > 0.0f && Alpha[i] > 0.0f);
+		};
+
+		// Holes are filled with live particles taken from the end, so only the removed particles cost anything
+		// and a frame without any expired particle is just a scan over two arrays
+		std::size_t count = size();
+		std::size_t i = 0;
+		while (true) {
+			while (i < count && isAlive(i)) {
+				i++;
+			}
+			while (i < count && !isAlive(count - 1)) {
+				count--;
+			}
+			if (i >= count) {
+				break;
+			}
+
+			count--;
+			MoveParticle(count, i);
+			i++;
+		}
+
+		if (count != size()) {
+			Resize(count);
+		}
+	}
+
+	void DebrisStorage::MoveParticle(std::size_t from, std::size_t to)
+	{
+		PosX[to] = PosX[from];
+		PosY[to] = PosY[from];
+		SpeedX[to] = SpeedX[from];
+		SpeedY[to] = SpeedY[from];
+		AccelerationX[to] = AccelerationX[from];
+		AccelerationY[to] = AccelerationY[from];
+		Scale[to] = Scale[from];
+		ScaleSpeed[to] = ScaleSpeed[from];
+		Angle[to] = Angle[from];
+		AngleSpeed[to] = AngleSpeed[from];
+		Alpha[to] = Alpha[from];
+		AlphaSpeed[to] = AlphaSpeed[from];
+		Time[to] = Time[from];
+		Elasticity[to] = Elasticity[from];
+		Flags[to] = Flags[from];
+		Appearances[to] = Appearances[from];
+	}
+
+	void DebrisStorage::Resize(std::size_t count)
+	{
+		PosX.resize(count);
+		PosY.resize(count);
+		SpeedX.resize(count);
+		SpeedY.resize(count);
+		AccelerationX.resize(count);
+		AccelerationY.resize(count);
+		Scale.resize(count);
+		ScaleSpeed.resize(count);
+		Angle.resize(count);
+		AngleSpeed.resize(count);
+		Alpha.resize(count);
+		AlphaSpeed.resize(count);
+		Time.resize(count);
+		Elasticity.resize(count);
+		Flags.resize(count);
+		Appearances.resize(count);
+	}
+
+	void DebrisStorage::UpdateLifetime(float timeMult)
+	{
+		std::size_t count = size();
+		std::size_t i = UpdateLifetimeLanes<VectorLanes>(*this, 0, count, timeMult);
+		UpdateLifetimeLanes<ScalarLanes>(*this, i, count, timeMult);
+	}
+
+	void DebrisStorage::Integrate(float timeMult)
+	{
+		std::size_t count = size();
+		std::size_t i = IntegrateLanes<VectorLanes>(*this, 0, count, timeMult);
+		IntegrateLanes<ScalarLanes>(*this, i, count, timeMult);
+	}
+}
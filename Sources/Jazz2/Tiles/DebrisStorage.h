@@ -0,0 +1,222 @@
+﻿#pragma once
+
+#include "../../Main.h"
+#include "../../nCine/Primitives/Vector2.h"
+
+#include <Containers/SmallVector.h>
+
+namespace nCine
+{
+	class Texture;
+}
+
+using namespace Death::Containers;
+
+namespace Jazz2::Tiles
+{
+	/** @brief Flags that modify behaviour of @ref DestructibleDebris, supports a bitwise combination of its member values */
+	enum class DebrisFlags {
+		None = 0x00,				/**< None */
+		Disappear = 0x01,			/**< Debris disappears over time */
+		Bounce = 0x02,				/**< Debris bounces off solid tiles */
+		AdditiveBlending = 0x04		/**< Debris is rendered with additive blending */
+	};
+
+	DEATH_ENUM_FLAGS(DebrisFlags);
+
+	/** @brief Describes a visual debris (particle effect) */
+	struct DestructibleDebris {
+		/** @brief Position */
+		nCine::Vector2f Pos;
+		/** @brief Depth (layer) */
+		std::uint16_t Depth;
+
+		/** @brief Size of the drawn area */
+		nCine::Vector2f Size;
+		/**
+			@brief Displacement of the drawn area from the centre of its logical frame cell
+
+			Zero for debris that is its own little quad. A trimmed sprite frame covers less than its
+			cell, so drawing it needs to know where inside that cell it belongs - otherwise the frame
+			is stretched over the whole cell (see @ref GenericGraphicResource::GetFrameOffset()).
+		*/
+		nCine::Vector2f FrameOffset;
+		/** @brief Speed */
+		nCine::Vector2f Speed;
+		/** @brief Acceleration */
+		nCine::Vector2f Acceleration;
+
+		/** @brief Scale */
+		float Scale;
+		/** @brief Scale change speed */
+		float ScaleSpeed;
+
+		/** @brief Angle */
+		float Angle;
+		/** @brief Angle change speed */
+		float AngleSpeed;
+
+		/** @brief Alpha */
+		float Alpha;
+		/** @brief Alpha change speed */
+		float AlphaSpeed;
+
+		/** @brief Time remaining until disposal */
+		float Time;
+
+		/** @brief Fraction of speed kept when bouncing off a solid tile (with @ref DebrisFlags::Bounce) */
+		float Elasticity = 0.8f;
+
+		/** @brief Texture horizontal scale */
+		float TexScaleX;
+		/** @brief Texture horizontal bias */
+		float TexBiasX;
+		/** @brief Texture vertical scale */
+		float TexScaleY;
+		/** @brief Texture vertical bias */
+		float TexBiasY;
+
+		/** @brief Diffuse texture */
+		nCine::Texture* DiffuseTexture;
+		/**
+		 * @brief Flat palette offset when @ref DiffuseTexture is an indexed sprite
+		 *
+		 * The sprite is recolored at draw time. `-1` when the texture holds baked colors (e.g., a tileset texture)
+		 * and must use the plain Sprite shader.
+		 */
+		std::int32_t PaletteOffset = -1;
+
+		/** @brief Behavior flags */
+		DebrisFlags Flags;
+	};
+
+	/**
+		@brief Live debris particles stored as a structure of arrays
+
+		Every simulated property has its own tightly packed array, so the per-frame update runs over them with
+		4-wide SSE2 or NEON vector operations instead of walking ~100 byte structures one at a time.
+		Properties needed only for drawing are kept together in @ref Appearances. Expired particles are removed in
+		bulk by compacting all arrays, holes are filled with particles from the end, so the order is not preserved.
+	*/
+	class DebrisStorage
+	{
+	public:
+		/** @brief Properties of a particle that don't change during its lifetime and are needed only for drawing */
+		struct Appearance {
+			nCine::Vector2f Size;
+			nCine::Vector2f FrameOffset;
+			float TexScaleX;
+			float TexBiasX;
+			float TexScaleY;
+			float TexBiasY;
+			nCine::Texture* DiffuseTexture;
+			std::int32_t PaletteOffset;
+			std::uint16_t Depth;
+		};
+
+		SmallVector<float, 0> PosX;
+		SmallVector<float, 0> PosY;
+		SmallVector<float, 0> SpeedX;
+		SmallVector<float, 0> SpeedY;
+		SmallVector<float, 0> AccelerationX;
+		SmallVector<float, 0> AccelerationY;
+		SmallVector<float, 0> Scale;
+		SmallVector<float, 0> ScaleSpeed;
+		SmallVector<float, 0> Angle;
+		SmallVector<float, 0> AngleSpeed;
+		SmallVector<float, 0> Alpha;
+		SmallVector<float, 0> AlphaSpeed;
+		SmallVector<float, 0> Time;
+		SmallVector<float, 0> Elasticity;
+		SmallVector<DebrisFlags, 0> Flags;
+		SmallVector<Appearance, 0> Appearances;
+
+		/** @brief Returns number of live particles */
+		std::size_t size() const {
+			return PosX.size();
+		}
+		/** @brief Returns `true` if there are no live particles */
+		bool empty() const {
+			return PosX.empty();
+		}
+		/** @brief Returns number of particles that fit into the storage without reallocation */
+		std::size_t capacity() const {
+			return PosX.capacity();
+		}
+
+		/** @brief Removes all particles */
+		void clear();
+		/** @brief Reduces capacity of the storage to the specified number of particles */
+		void shrink(std::size_t capacity);
+		/** @brief Adds a new particle */
+		void push_back(const DestructibleDebris& debris);
+
+		/** @brief Removes particles that shrank to nothing or faded out completely */
+		void RemoveExpired();
+		/** @brief Counts down lifetime of all particles, particles past their lifetime start to fade out quickly */
+		void UpdateLifetime(float timeMult);
+		/**
+			@brief Resolves collisions of particles with @ref DebrisFlags::Disappear or @ref DebrisFlags::Bounce flags
+
+			Each particle samples the collision mask only at its centre via @p isPointEmpty, which has signature
+			`bool(std::int32_t x, std::int32_t y)`. Particles with other flags are skipped without any lookup.
+		*/
+		template<class TIsPointEmpty>
+		void ResolveCollisions(float timeMult, TIsPointEmpty&& isPointEmpty);
+		/** @brief Integrates position, speed, scale, angle and alpha of all particles */
+		void Integrate(float timeMult);
+
+	private:
+		void MoveParticle(std::size_t from, std::size_t to);
+		void Resize(std::size_t count);
+	};
+
+	template<class TIsPointEmpty>
+	void DebrisStorage::ResolveCollisions(float timeMult, TIsPointEmpty&& isPointEmpty)
+	{
+		// Raw pointers, so the compiler doesn't have to reload the array addresses after every store
+		float* posX = PosX.data();
+		float* posY = PosY.data();
+		float* speedX = SpeedX.data();
+		float* speedY = SpeedY.data();
+		const DebrisFlags* flags = Flags.data();
+
+		std::size_t count = size();
+		for (std::size_t i = 0; i < count; i++) {
+			if ((flags[i] & (DebrisFlags::Disappear | DebrisFlags::Bounce)) == DebrisFlags::None) {
+				continue;
+			}
+
+			float nx = posX[i] + speedX[i] * timeMult;
+			float ny = posY[i] + speedY[i] * timeMult;
+			if (isPointEmpty((std::int32_t)nx, (std::int32_t)ny)) {
+				// Nothing...
+			} else if ((flags[i] & DebrisFlags::Disappear) == DebrisFlags::Disappear) {
+				ScaleSpeed[i] = -0.02f;
+				AlphaSpeed[i] = -0.006f;
+				speedX[i] = 0.0f;
+				speedY[i] = 0.0f;
+				AccelerationX[i] = 0.0f;
+				AccelerationY[i] = 0.0f;
+			} else {
+				// Place us to the ground only if no horizontal movement was
+				// involved (this prevents speeds resetting if the actor
+				// collides with a wall from the side while in the air)
+				if (isPointEmpty((std::int32_t)nx, (std::int32_t)posY[i])) {
+					if (speedY[i] > 0.0f) {
+						speedY[i] = -(Elasticity[i] * speedY[i]);
+					} else {
+						speedY[i] = 0.0f;
+					}
+				}
+
+				// If the actor didn't move all the way horizontally,
+				// it hit a wall (or was already touching it)
+				if (isPointEmpty((std::int32_t)posX[i], (std::int32_t)ny)) {
+					speedX[i] = -(Elasticity[i] * speedX[i]);
+					AngleSpeed[i] = -(Elasticity[i] * AngleSpeed[i]);
+				}
+			}
+		}
+	}
+}
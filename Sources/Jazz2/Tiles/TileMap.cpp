@@ -11,6 +11,10 @@
 
 #include <Containers/GrowableArray.h>
 
+#if defined(DEATH_TARGET_MSVC)
+#	include <intrin.h>
+#endif
+
 namespace Jazz2::Tiles
 {
 	namespace
@@ -38,6 +42,11 @@ namespace Jazz2::Tiles
 		// so this holds a modest layer or burst without reallocating
 		constexpr std::int32_t MinPooledMeshBuffers = 12;
 		constexpr std::int32_t MinMeshBufferCapacity = 48 * 128;
+		// Tiles per side of a cached layer chunk, and how many frames a chunk may go undrawn before its quads are
+		// released. A chunk is drawn whole even when only its corner is visible, so smaller chunks waste less
+		// of the few megabytes these consoles have - 8x8 tiles is 12 KB of vertices
+		constexpr std::int32_t LayerChunkSize = 8;
+		constexpr std::uint32_t LayerChunkEvictInterval = 300;
 #	if !defined(TILEMAP_USE_SINGLE_DRAW)
 		// Absolute ceiling on the render command pool for the fallback path that rents one command per visible
 		// particle (~840 bytes each on the Dreamcast). TileMap::MaxDebrisCount already bounds it for a single
@@ -52,9 +61,48 @@ namespace Jazz2::Tiles
 		constexpr std::int32_t MinDebrisCapacity = 0;
 		constexpr std::int32_t MinPooledMeshBuffers = 0;
 		constexpr std::int32_t MinMeshBufferCapacity = 0;
+		// 16x16 tiles is 48 KB of vertices, which still fits a single command; cached chunks are kept for the
+		// lifetime of the level
+		constexpr std::int32_t LayerChunkSize = 16;
+		constexpr std::uint32_t LayerChunkEvictInterval = 0;
 #	if !defined(TILEMAP_USE_SINGLE_DRAW)
 		constexpr std::int32_t MaxPooledRenderCommands = 0;
 #	endif
+#endif
+
+		std::uint32_t ReverseBits(std::uint32_t value)
+		{
+			value = ((value >> 1) & 0x55555555u) | ((value & 0x55555555u) << 1);
+			value = ((value >> 2) & 0x33333333u) | ((value & 0x33333333u) << 2);
+			value = ((value >> 4) & 0x0F0F0F0Fu) | ((value & 0x0F0F0F0Fu) << 4);
+			value = ((value >> 8) & 0x00FF00FFu) | ((value & 0x00FF00FFu) << 8);
+			return (value >> 16) | (value << 16);
+		}
+
+		std::int32_t FindLowestSetBit(std::uint32_t value)
+		{
+#if defined(DEATH_TARGET_MSVC)
+			unsigned long index;
+			_BitScanForward(&index, value);
+			return std::int32_t(index);
+#else
+			return __builtin_ctz(value);
+#endif
+		}
+
+		/** @brief Returns bits `from` to `to` (inclusive) set */
+		std::uint32_t GetBitRange(std::int32_t from, std::int32_t to)
+		{
+			return (~0u << from) & (~0u >> (31 - to));
+		}
+
+#if defined(TILEMAP_USE_SINGLE_DRAW)
+		/** @brief Divides and rounds towards negative infinity, `divisor` has to be positive */
+		std::int32_t FloorDivide(std::int32_t value, std::int32_t divisor)
+		{
+			std::int32_t result = value / divisor;
+			return (result * divisor > value ? result - 1 : result);
+		}
 #endif
 	}
 
@@ -272,6 +320,23 @@ namespace Jazz2::Tiles
 			}
 		}
 
+#if defined(TILEMAP_USE_SINGLE_DRAW)
+		_layerChunkFrame++;
+		if (LayerChunkEvictInterval > 0 && (_layerChunkFrame % LayerChunkEvictInterval) == 0) {
+			// Chunks the camera left long ago give their quads back and get rebuilt when they come into view again.
+			// Dropping the buffers whole is what frees the floats, clearing them would keep the capacity.
+			for (auto& grid : _layerChunks) {
+				for (auto& chunk : grid.Chunks) {
+					if (!chunk.Dirty && _layerChunkFrame - chunk.LastDrawnFrame >= LayerChunkEvictInterval) {
+						chunk.Vertices.clear();
+						chunk.AnimatedTiles.clear();
+						chunk.Dirty = true;
+					}
+				}
+			}
+		}
+#endif
+
 		// The command cache must be reset every frame,
 		// OnDraw() is called multiple times if multiple viewports are active
 		_renderCommandsCount = 0;
@@ -536,6 +601,102 @@ namespace Jazz2::Tiles
 		return (TileSet::GetTileMaskRow(tileSet->GetTileMask(tileId), py) & (1u << px)) == 0;
 	}
 
+	float TileMap::GetGroundDistance(float left, float right, float y, float maxDistance, bool downwards)
+	{
+		if (_sprLayerIndex == -1) {
+			return maxDistance;
+		}
+
+		Vector2i layoutSize = _layers[_sprLayerIndex].LayoutSize;
+		std::int32_t limitRightPx = layoutSize.X * TileSet::DefaultTileSize;
+		std::int32_t limitBottomPx = layoutSize.Y * TileSet::DefaultTileSize;
+
+		// Consider out-of-level coordinates as solid walls
+		if (left < 0.0f || right >= limitRightPx) {
+			return 0.0f;
+		}
+
+		float distance = maxDistance;
+		std::int32_t fromY = std::max((std::int32_t)std::floor(y), 0);
+		std::int32_t toY = (std::int32_t)std::floor(y + maxDistance);
+		if (toY >= limitBottomPx) {
+			if (_pitType == PitType::StandOnPlatform) {
+				distance = std::max(limitBottomPx - y, 0.0f);
+			}
+			toY = limitBottomPx - 1;
+		}
+		if (fromY <= toY) {
+			std::int32_t row = FindSolidRow((std::int32_t)left, (std::int32_t)right, fromY, toY, downwards);
+			if (row >= 0) {
+				return std::max(row - y, 0.0f);
+			}
+		}
+		return distance;
+	}
+
+	std::int32_t TileMap::FindSolidRow(std::int32_t x1, std::int32_t x2, std::int32_t fromY, std::int32_t toY, bool downwards)
+	{
+		Vector2i layoutSize = _layers[_sprLayerIndex].LayoutSize;
+		const LayerTile* sprLayerLayout = _layers[_sprLayerIndex].Layout.get();
+
+		std::int32_t tx1 = x1 / TileSet::DefaultTileSize;
+		std::int32_t tx2 = x2 / TileSet::DefaultTileSize;
+		std::int32_t tyFirst = fromY / TileSet::DefaultTileSize;
+		std::int32_t tyLast = toY / TileSet::DefaultTileSize;
+
+		for (std::int32_t ty = tyFirst; ; ty++) {
+			// Only rows between fromY and toY are considered, the rest of the boundary tiles is masked out
+			std::int32_t rowFrom = (ty == tyFirst ? fromY % TileSet::DefaultTileSize : 0);
+			std::int32_t rowTo = (ty == tyLast ? toY % TileSet::DefaultTileSize : TileSet::DefaultTileSize - 1);
+			std::uint32_t rowRange = GetBitRange(rowFrom, rowTo);
+
+			// All covered columns are merged into one word, bit y set = row y solid in any of them
+			std::uint32_t solidRows = 0;
+			for (std::int32_t tx = tx1; tx <= tx2; tx++) {
+				const LayerTile& tile = sprLayerLayout[ty * layoutSize.X + tx];
+				if (tile.HasSuspendType != SuspendType::None ||
+					((tile.Flags & LayerTileFlags::OneWay) == LayerTileFlags::OneWay && !downwards)) {
+					continue;
+				}
+
+				std::int32_t tileId = ResolveTileID(tile);
+				TileSet* tileSet = ResolveTileSet(tileId);
+				if (tileSet == nullptr || tileSet->IsTileMaskEmpty(tileId)) {
+					continue;
+				}
+				if (tileSet->IsTileMaskFilled(tileId)) {
+					solidRows = ~0u;
+					break;
+				}
+
+				std::int32_t left = std::max(x1 - tx * TileSet::DefaultTileSize, 0);
+				std::int32_t right = std::min(x2 - tx * TileSet::DefaultTileSize, TileSet::DefaultTileSize - 1);
+				if ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX) {
+					std::int32_t left2 = left;
+					left = (TileSet::DefaultTileSize - 1 - right);
+					right = (TileSet::DefaultTileSize - 1 - left2);
+				}
+
+				std::uint32_t columns = 0;
+				for (std::int32_t rx = left; rx <= right; rx++) {
+					columns |= tileSet->GetTileMaskColumn(tileId, rx);
+				}
+				if ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY) {
+					columns = ReverseBits(columns);
+				}
+				solidRows |= columns;
+			}
+
+			solidRows &= rowRange;
+			if (solidRows != 0) {
+				return ty * TileSet::DefaultTileSize + FindLowestSetBit(solidRows);
+			}
+			if (ty == tyLast) {
+				return -1;
+			}
+		}
+	}
+
 	bool TileMap::IsTileEmpty(const AABBf& aabb, TileCollisionParams& params)
 	{
 		if (_sprLayerIndex == -1) {
@@ -876,6 +1037,7 @@ namespace Jazz2::Tiles
 
 				tile.DestructFrameIndex = std::int16_t(tile.DestructFrameIndex + frameCount);
 				tile.TileID = anim.Tiles[tile.DestructFrameIndex].TileID;
+				InvalidateLayerChunk(_sprLayerIndex, tx, ty);
 				if (tile.DestructFrameIndex >= max) {
 					if (!soundName.empty()) {
 						_owner->PlayCommonSfx(soundName, Vector3f(tx * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2),
@@ -894,6 +1056,7 @@ namespace Jazz2::Tiles
 				std::int32_t frameCount = 1;
 				tile.DestructFrameIndex = std::int16_t(tile.DestructFrameIndex + frameCount);
 				tile.TileID = 0; // Set to empty tile
+				InvalidateLayerChunk(_sprLayerIndex, tx, ty);
 
 				if (!soundName.empty()) {
 					_owner->PlayCommonSfx(soundName, Vector3f(tx * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2),
@@ -1084,6 +1247,16 @@ namespace Jazz2::Tiles
 			float x3 = x1 + (TileSet::DefaultTileSize * 2) + cullingRect.W;
 			float y3 = y1 + (TileSet::DefaultTileSize * 2) + cullingRect.H;
 
+#if defined(TILEMAP_USE_SINGLE_DRAW)
+			// Standard tile layers backed by a single tileset are drawn from cached chunk meshes, one draw call per
+			// visible chunk (and texture chunk, when the device texture-size limit split the tileset atlas). Other
+			// renderer types (tinted/solid) and multi-tileset levels fall back to one command per tile.
+			if (rendererType == LayerRendererType::Default && _tileSets.size() == 1) {
+				DrawLayerChunks(renderQueue, layer, layerColor, x1, y1, x3, y3, tileAbsX, tileAbsY);
+				return;
+			}
+#endif
+
 #if defined(WITH_RHI_SOFTWARE)
 			// Whether every non-zero entry of the sprite palette (row 0, the one tile layers sample) is fully
 			// opaque. Combined with a tile's IsTileFilled() flag (no index-0 texel, the transparent base
@@ -1102,21 +1275,6 @@ namespace Jazz2::Tiles
 			}
 #endif
 
-			// Standard tile layers backed by a single tileset are drawn as one mesh (one draw call for the whole
-			// visible layer, or one per texture chunk when the device texture-size limit split the tileset
-			// atlas). Other renderer types (tinted/solid) and multi-tileset levels fall back to one command
-			// per tile.
-#if defined(TILEMAP_USE_SINGLE_DRAW)
-			bool meshMode = (rendererType == LayerRendererType::Default && _tileSets.size() == 1);
-			TileSet* meshTileSet = (meshMode ? _tileSets[0].Data.get() : nullptr);
-			// One vertex buffer per chunk, rented on first use - a layer usually touches only some of them.
-			// Indices rather than pointers, because renting can grow (and so reallocate) _meshVertices.
-			SmallVector<std::int32_t, 2> chunkVertices;
-			if DEATH_LIKELY(meshMode) {
-				chunkVertices.resize(meshTileSet->GetTextureCount(), -1);
-			}
-#endif
-
 			std::int32_t tile_xo = -1;
 			for (float x2 = x1; x2 <= x3; x2 += TileSet::DefaultTileSize) {
 				tileX = (tileX + 1) % tileCount.X;
@@ -1157,15 +1315,6 @@ namespace Jazz2::Tiles
 					const bool tileFilled = tileSet->IsTileFilled(tileId) && (!tileSet->IsIndexed || spritePaletteOpaque);
 #endif
 
-#if defined(TILEMAP_USE_SINGLE_DRAW)
-					// Which texture chunk holds this tile. Has to be read BEFORE ResolveTextureDiffuse(), which
-					// takes the ID by reference and rebases it into that chunk - afterwards the ID is always
-					// below TilesPerTexture and this would collapse to chunk 0, drawing the whole layer out of
-					// the first texture. A no-op single-texture lookup normally; only a device texture-size
-					// limit small enough to split the tileset atlas (the consoles) makes it matter.
-					const std::int32_t tileChunk = (tileSet->TilesPerTexture > 0 && tileId >= tileSet->TilesPerTexture
-						? tileId / tileSet->TilesPerTexture : 0);
-#endif
 					Texture* tileTexture = tileSet->ResolveTextureDiffuse(tileId);
 					if DEATH_UNLIKELY(tileTexture == nullptr) {
 						continue;
@@ -1192,20 +1341,6 @@ namespace Jazz2::Tiles
 						x2r = std::floor(x2r); y2r = std::floor(y2r);
 					}
 
-#if defined(TILEMAP_USE_SINGLE_DRAW)
-					if DEATH_LIKELY(meshMode) {
-						// Accumulate this tile into its chunk's mesh; the layer tint and palette are applied once
-						// per emitted mesh in EmitMesh(). The per-tile alpha rides along in the vertex color.
-						std::int32_t& verticesIndex = chunkVertices[tileChunk];
-						if (verticesIndex < 0) {
-							verticesIndex = RentMeshVertices();
-						}
-						AppendTileQuad(_meshVertices[verticesIndex], x2r, y2r, (float)TileSet::DefaultTileSize,
-							texScaleX, texBiasX, texScaleY, texBiasY, tile.Alpha / 255.0f);
-						continue;
-					}
-#endif
-
 					TileCommandUniforms* commandUniforms;
 					auto command = RentRenderCommand(rendererType, tileSet->IsIndexed, &commandUniforms);
 					command->SetType(RenderCommand::Type::TileMap);
@@ -1249,24 +1384,6 @@ namespace Jazz2::Tiles
 					renderQueue.AddCommand(command);
 				}
 			}
-
-#if defined(TILEMAP_USE_SINGLE_DRAW)
-			if DEATH_LIKELY(meshMode) {
-				// Whole visible layer is submitted as one command per touched texture chunk (or a few
-				// <=64 KB pieces for very large layers). Tiles within a layer never overlap, so the order
-				// between chunks doesn't matter - they all share the layer's depth.
-				for (std::int32_t chunk = 0; chunk < (std::int32_t)chunkVertices.size(); chunk++) {
-					const std::int32_t verticesIndex = chunkVertices[chunk];
-					if (verticesIndex < 0 || _meshVertices[verticesIndex].empty()) {
-						continue;
-					}
-					// Tiles use the default sprite palette (row 0, offset 0); every tile accumulated into these
-					// vertices resolved to this chunk of the tileset atlas
-					EmitMesh(renderQueue, _meshVertices[verticesIndex], *meshTileSet->TextureDiffuse[chunk],
-						meshTileSet->IsIndexed, 0, layerColor, layer.Description.Depth, RenderCommand::Type::TileMap, false);
-				}
-			}
-#endif
 		}
 	}
 
@@ -1379,29 +1496,219 @@ namespace Jazz2::Tiles
 		return verticesIndex;
 	}
 
-	void TileMap::AppendDebrisQuad(SmallVector<float, 0>& vertices, const DestructibleDebris& debris)
+	void TileMap::DrawLayerChunks(RenderQueue& renderQueue, TileMapLayer& layer, const Vector4f& layerColor,
+		float x1, float y1, float x3, float y3, std::int32_t tileAbsX, std::int32_t tileAbsY)
+	{
+		const std::int32_t layerIndex = (std::int32_t)(&layer - _layers.data());
+		if (_layerChunks.size() < _layers.size()) {
+			_layerChunks.resize(_layers.size());
+		}
+
+		Vector2i tileCount = layer.LayoutSize;
+		LayerChunkGrid& grid = _layerChunks[layerIndex];
+		if (grid.Chunks.empty()) {
+			grid.ChunksX = (tileCount.X + LayerChunkSize - 1) / LayerChunkSize;
+			grid.ChunksY = (tileCount.Y + LayerChunkSize - 1) / LayerChunkSize;
+			grid.Chunks.resize(grid.ChunksX * grid.ChunksY);
+		}
+
+		// The same tiles the per-tile loop in DrawLayer() visits: unwrapped tile N is drawn at x1 + (N - firstX) * size,
+		// and it maps to column N modulo the layer width when the layer repeats
+		const std::int32_t firstX = tileAbsX + 1;
+		const std::int32_t firstY = tileAbsY + 1;
+		std::int32_t fromX = firstX, toX = firstX + (std::int32_t)((x3 - x1) / TileSet::DefaultTileSize);
+		std::int32_t fromY = firstY, toY = firstY + (std::int32_t)((y3 - y1) / TileSet::DefaultTileSize);
+		if (!layer.Description.RepeatX) {
+			fromX = std::max(fromX, 0);
+			toX = std::min(toX, tileCount.X - 1);
+		}
+		if (!layer.Description.RepeatY) {
+			fromY = std::max(fromY, 0);
+			toY = std::min(toY, tileCount.Y - 1);
+		}
+		if (fromX > toX || fromY > toY) {
+			return;
+		}
+
+		TileSet* tileSet = _tileSets[0].Data.get();
+		// Animated tiles of all visible chunks are accumulated in world space into one pooled buffer per texture
+		// chunk, rented on first use. Indices rather than pointers, because renting can grow (and so reallocate)
+		// _meshVertices.
+		SmallVector<std::int32_t, 2> animatedVertices;
+		animatedVertices.resize(tileSet->GetTextureCount(), -1);
+
+		// A repeating layer can show the same chunk more than once, so chunks are visited per repetition of the
+		// layout. A chunk is always drawn whole, the part of it outside of the view is left to clipping.
+		for (std::int32_t wrapY = FloorDivide(fromY, tileCount.Y); wrapY <= FloorDivide(toY, tileCount.Y); wrapY++) {
+			const std::int32_t baseY = wrapY * tileCount.Y;
+			const std::int32_t chunkY1 = std::max(fromY - baseY, 0) / LayerChunkSize;
+			const std::int32_t chunkY2 = std::min(toY - baseY, tileCount.Y - 1) / LayerChunkSize;
+			for (std::int32_t chunkY = chunkY1; chunkY <= chunkY2; chunkY++) {
+				float originY = y1 + (float)((baseY + chunkY * LayerChunkSize - firstY) * TileSet::DefaultTileSize);
+
+				for (std::int32_t wrapX = FloorDivide(fromX, tileCount.X); wrapX <= FloorDivide(toX, tileCount.X); wrapX++) {
+					const std::int32_t baseX = wrapX * tileCount.X;
+					const std::int32_t chunkX1 = std::max(fromX - baseX, 0) / LayerChunkSize;
+					const std::int32_t chunkX2 = std::min(toX - baseX, tileCount.X - 1) / LayerChunkSize;
+					for (std::int32_t chunkX = chunkX1; chunkX <= chunkX2; chunkX++) {
+						float originX = x1 + (float)((baseX + chunkX * LayerChunkSize - firstX) * TileSet::DefaultTileSize);
+						float originYr = originY;
+						if (!PreferencesCache::UnalignedViewport) {
+							// Tile offsets within a chunk are whole pixels, so flooring the origin aligns every tile
+							// exactly as flooring each tile position would
+							originX = std::floor(originX); originYr = std::floor(originYr);
+						}
+
+						LayerChunk& chunk = grid.Chunks[chunkY * grid.ChunksX + chunkX];
+						if (chunk.Dirty) {
+							RebuildLayerChunk(layer, chunk, chunkX, chunkY);
+						}
+						chunk.LastDrawnFrame = _layerChunkFrame;
+
+						// Tiles use the default sprite palette (row 0, offset 0); every tile cached in a buffer
+						// resolved to that chunk of the tileset atlas. Tiles within a layer never overlap, so the
+						// order between the commands doesn't matter - they all share the layer's depth.
+						for (std::int32_t i = 0; i < (std::int32_t)chunk.Vertices.size(); i++) {
+							if (!chunk.Vertices[i].empty()) {
+								EmitMesh(renderQueue, chunk.Vertices[i], *tileSet->TextureDiffuse[i], tileSet->IsIndexed, 0,
+									layerColor, layer.Description.Depth, RenderCommand::Type::TileMap, false, Vector2f(originX, originYr));
+							}
+						}
+
+						for (std::uint16_t localIndex : chunk.AnimatedTiles) {
+							const std::int32_t localX = localIndex % LayerChunkSize;
+							const std::int32_t localY = localIndex / LayerChunkSize;
+							const LayerTile& tile = layer.Layout[(chunkX * LayerChunkSize + localX) + (chunkY * LayerChunkSize + localY) * tileCount.X];
+
+							std::int32_t textureChunk; Vector4f texRect;
+							if (!ResolveMeshTile(tile, textureChunk, texRect)) {
+								continue;
+							}
+							std::int32_t& verticesIndex = animatedVertices[textureChunk];
+							if (verticesIndex < 0) {
+								verticesIndex = RentMeshVertices();
+							}
+							AppendTileQuad(_meshVertices[verticesIndex], originX + (float)(localX * TileSet::DefaultTileSize),
+								originYr + (float)(localY * TileSet::DefaultTileSize), (float)TileSet::DefaultTileSize,
+								texRect.X, texRect.Y, texRect.Z, texRect.W, tile.Alpha / 255.0f);
+						}
+					}
+				}
+			}
+		}
+
+		for (std::int32_t i = 0; i < (std::int32_t)animatedVertices.size(); i++) {
+			const std::int32_t verticesIndex = animatedVertices[i];
+			if (verticesIndex >= 0 && !_meshVertices[verticesIndex].empty()) {
+				EmitMesh(renderQueue, _meshVertices[verticesIndex], *tileSet->TextureDiffuse[i], tileSet->IsIndexed, 0,
+					layerColor, layer.Description.Depth, RenderCommand::Type::TileMap, false);
+			}
+		}
+	}
+
+	void TileMap::RebuildLayerChunk(const TileMapLayer& layer, LayerChunk& chunk, std::int32_t chunkX, std::int32_t chunkY)
+	{
+		const std::int32_t textureCount = _tileSets[0].Data->GetTextureCount();
+		if ((std::int32_t)chunk.Vertices.size() < textureCount) {
+			chunk.Vertices.resize(textureCount);
+		}
+		for (auto& vertices : chunk.Vertices) {
+			vertices.clear();
+		}
+		chunk.AnimatedTiles.clear();
+
+		const std::int32_t tileX = chunkX * LayerChunkSize;
+		const std::int32_t tileY = chunkY * LayerChunkSize;
+		const std::int32_t width = std::min(LayerChunkSize, layer.LayoutSize.X - tileX);
+		const std::int32_t height = std::min(LayerChunkSize, layer.LayoutSize.Y - tileY);
+
+		for (std::int32_t y = 0; y < height; y++) {
+			for (std::int32_t x = 0; x < width; x++) {
+				const LayerTile& tile = layer.Layout[(tileX + x) + (tileY + y) * layer.LayoutSize.X];
+				if (tile.TileID >= _animatedTilesOffset) {
+					chunk.AnimatedTiles.push_back((std::uint16_t)(x + y * LayerChunkSize));
+					continue;
+				}
+
+				std::int32_t textureChunk; Vector4f texRect;
+				if (ResolveMeshTile(tile, textureChunk, texRect)) {
+					AppendTileQuad(chunk.Vertices[textureChunk], (float)(x * TileSet::DefaultTileSize), (float)(y * TileSet::DefaultTileSize),
+						(float)TileSet::DefaultTileSize, texRect.X, texRect.Y, texRect.Z, texRect.W, tile.Alpha / 255.0f);
+				}
+			}
+		}
+
+		chunk.Dirty = false;
+	}
+
+	bool TileMap::ResolveMeshTile(const LayerTile& tile, std::int32_t& textureChunk, Vector4f& texRect)
+	{
+		std::int32_t tileId = ResolveTileID(tile);
+		if (tileId == 0 || tile.Alpha == 0) {
+			return false;
+		}
+		TileSet* tileSet = ResolveTileSet(tileId);
+		if (tileSet == nullptr) {
+			return false;
+		}
+
+		// Which texture chunk holds this tile. Has to be read BEFORE ResolveTextureDiffuse(), which takes the ID by
+		// reference and rebases it into that chunk - afterwards the ID is always below TilesPerTexture and this would
+		// collapse to chunk 0, drawing the whole layer out of the first texture. A no-op single-texture lookup
+		// normally; only a device texture-size limit small enough to split the tileset atlas (the consoles) makes it matter.
+		textureChunk = (tileSet->TilesPerTexture > 0 && tileId >= tileSet->TilesPerTexture ? tileId / tileSet->TilesPerTexture : 0);
+		Texture* tileTexture = tileSet->ResolveTextureDiffuse(tileId);
+		if DEATH_UNLIKELY(tileTexture == nullptr) {
+			return false;
+		}
+
+		Vector2i texSize = tileTexture->GetSize();
+		float texScaleX = TileSet::DefaultTileSize / float(texSize.X);
+		float texBiasX = ((tileId % tileSet->TilesPerRow) * (TileSet::DefaultTileSize + 2.0f) + 1.0f) / float(texSize.X);
+		float texScaleY = TileSet::DefaultTileSize / float(texSize.Y);
+		float texBiasY = ((tileId / tileSet->TilesPerRow) * (TileSet::DefaultTileSize + 2.0f) + 1.0f) / float(texSize.Y);
+
+		if ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX) {
+			texBiasX += texScaleX;
+			texScaleX *= -1;
+		}
+		if ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY) {
+			texBiasY += texScaleY;
+			texScaleY *= -1;
+		}
+
+		texRect = Vector4f(texScaleX, texBiasX, texScaleY, texBiasY);
+		return true;
+	}
+
+	void TileMap::AppendDebrisQuad(SmallVector<float, 0>& vertices, const DebrisStorage& debris, std::size_t index)
 	{
+		const auto& appearance = debris.Appearances[index];
+		const float angle = debris.Angle[index];
+		const float scale = debris.Scale[index];
+		const float alpha = debris.Alpha[index];
+
 		// The sprite shader would have built this quad from the particle's model matrix: a unit quad scaled by
 		// Size, rotated around the centre of the drawn area and translated to Pos. The mesh stream is in world
 		// space, so the same Translation * RotationZ * Scaling * Translation is folded into the four corners here
 		// - which is the whole point, as it costs less than the three 4x4 multiplies the chain used to.
-		const float c = std::cos(debris.Angle);
-		const float s = std::sin(debris.Angle);
-		const float ns = std::sin(-debris.Angle);	// Never "-s", see the note in Matrix4x4::RotationZ()
-		const float xx = c * debris.Scale, xy = s * debris.Scale;
-		const float yx = ns * debris.Scale, yy = c * debris.Scale;
+		const float c = std::cos(angle);
+		const float s = std::sin(angle);
+		const float ns = std::sin(-angle);	// Never "-s", see the note in Matrix4x4::RotationZ()
+		const float xx = c * scale, xy = s * scale;
+		const float yx = ns * scale, yy = c * scale;
 		// Local extent of the quad before the rotation, centred on the drawn area (see GetFrameOffset())
-		const float localX = debris.FrameOffset.X - debris.Size.X * 0.5f;
-		const float localY = debris.FrameOffset.Y - debris.Size.Y * 0.5f;
+		const float localX = appearance.FrameOffset.X - appearance.Size.X * 0.5f;
+		const float localY = appearance.FrameOffset.Y - appearance.Size.Y * 0.5f;
 		// One corner plus the two rotated edge vectors, so the remaining three corners are additions
-		const float x0 = debris.Pos.X + xx * localX + yx * localY;
-		const float y0 = debris.Pos.Y + xy * localX + yy * localY;
-		const float ex = xx * debris.Size.X, ey = xy * debris.Size.X;
-		const float fx = yx * debris.Size.Y, fy = yy * debris.Size.Y;
+		const float x0 = debris.PosX[index] + xx * localX + yx * localY;
+		const float y0 = debris.PosY[index] + xy * localX + yy * localY;
+		const float ex = xx * appearance.Size.X, ey = xy * appearance.Size.X;
+		const float fx = yx * appearance.Size.Y, fy = yy * appearance.Size.Y;
 
 		// UVs at the quad corners, exactly as the sprite vertex stage maps them: u = px * texScaleX + texBiasX
-		const float u0 = debris.TexBiasX, v0 = debris.TexBiasY;
-		const float u1 = debris.TexScaleX + debris.TexBiasX, v1 = debris.TexScaleY + debris.TexBiasY;
+		const float u0 = appearance.TexBiasX, v0 = appearance.TexBiasY;
+		const float u1 = appearance.TexScaleX + appearance.TexBiasX, v1 = appearance.TexScaleY + appearance.TexBiasY;
 
 		// Same 8-float layout and same vertex order as AppendTileQuad(), so a particle is still recognized as a
 		// quad by the backends that fold the two triangles back into one four-vertex strip
@@ -1410,7 +1717,7 @@ namespace Jazz2::Tiles
 		float* v = vertices.data() + base;
 		auto put = [&](float px, float py, float pu, float pv) {
 			*v++ = px; *v++ = py; *v++ = pu; *v++ = pv;
-			*v++ = 1.0f; *v++ = 1.0f; *v++ = 1.0f; *v++ = debris.Alpha;
+			*v++ = 1.0f; *v++ = 1.0f; *v++ = 1.0f; *v++ = alpha;
 		};
 		put(x0,           y0,           u0, v0);
 		put(x0 + ex,      y0 + ey,      u1, v0);
@@ -1421,7 +1728,8 @@ namespace Jazz2::Tiles
 	}
 
 	void TileMap::EmitMesh(RenderQueue& renderQueue, SmallVector<float, 0>& vertices, const Texture& texture, bool indexed,
-		std::uint16_t paletteOffset, const Vector4f& color, std::uint16_t depth, RenderCommand::Type type, bool additiveBlending)
+		std::uint16_t paletteOffset, const Vector4f& color, std::uint16_t depth, RenderCommand::Type type, bool additiveBlending,
+		Vector2f origin)
 	{
 		constexpr std::uint32_t FloatsPerVertex = 8;
 		// Cap vertices per command to whatever the shared array buffer can actually hold, queried at runtime from the
@@ -1472,8 +1780,8 @@ namespace Jazz2::Tiles
 			geometry.SetHostVertexPointer(vertices.data() + firstVertex * FloatsPerVertex);
 			geometry.SetDrawParameters(PrimitiveType::Triangles, 0, count);
 
-			// Vertex positions are already in world space, so the model matrix is identity
-			command->SetTransformation(Matrix4x4f::Translation(0.0f, 0.0f, 0.0f));
+			// Vertex positions are in world space, only cached layer chunks are built relative to their origin
+			command->SetTransformation(Matrix4x4f::Translation(origin.X, origin.Y, 0.0f));
 			command->SetLayer(depth);
 			// Binds diffuse on unit 0 and, when the mesh is recolored at draw time, the palette on unit 1
 			ContentResolver::Get().BindSpritePalette(*command, texture, indexed, paletteOffset);
@@ -1653,6 +1961,9 @@ namespace Jazz2::Tiles
 				SetTileDestructibleEventParams(tile, TileDestructType::Collapse, tileParams[0]);
 				break;
 		}
+
+		// Destructible tiles start at the first frame of their animation instead of the animated tile itself
+		InvalidateLayerChunk(_sprLayerIndex, x, y);
 	}
 
 	/** @brief Overrides the diffuse texture of the specified tile */
@@ -1810,7 +2121,7 @@ namespace Jazz2::Tiles
 		}*/
 
 		for (std::int32_t i = 0; i < 4; i++) {
-			DestructibleDebris& debris = _debrisList.emplace_back();
+			DestructibleDebris debris = { };
 			debris.Pos = Vector2f(x * TileSet::DefaultTileSize + (i % 2) * QuarterSize, y * TileSet::DefaultTileSize + (i / 2) * QuarterSize);
 			debris.Depth = z;
 			debris.Size = Vector2f(QuarterSize, QuarterSize);
@@ -1836,6 +2147,7 @@ namespace Jazz2::Tiles
 			// The tileset atlas is indexed now, so recolor tile debris through palette row 0 (or -1 if baked)
 			debris.PaletteOffset = (tileSet->IsIndexed ? 0 : -1);
 			debris.Flags = DebrisFlags::None;
+			_debrisList.push_back(debris);
 		}
 	}
 
@@ -1866,7 +2178,7 @@ namespace Jazz2::Tiles
 			for (std::int32_t fx = 0; fx < debrisRect.W; fx += step) {
 				float currentSize = particleSize * Random().FastFloat(0.2f, 1.1f);
 
-				DestructibleDebris& debris = _debrisList.emplace_back();
+				DestructibleDebris debris = { };
 				debris.Pos = Vector2f(x + (isFacingLeft ? res->Base->FrameDimensions.X - frameOffset.X - fx : frameOffset.X + fx), y + frameOffset.Y + fy);
 				debris.Depth = (std::uint16_t)pos.Z;
 				debris.Size = Vector2f(currentSize, currentSize);
@@ -1893,6 +2205,7 @@ namespace Jazz2::Tiles
 				// Indexed sprite debris is recolored at draw time; -1 keeps a baked (e.g., tileset) texture on plain Sprite
 				debris.PaletteOffset = (((res->Base->Flags & GenericGraphicResourceFlags::Indexed) == GenericGraphicResourceFlags::Indexed) ? (std::int32_t)res->PaletteOffset : -1);
 				debris.Flags = DebrisFlags::Bounce;
+				_debrisList.push_back(debris);
 			}
 		}
 	}
@@ -1920,7 +2233,7 @@ namespace Jazz2::Tiles
 			Recti frameRect = res->Base->GetFrameRect(curAnimFrame);
 			Vector2i frameOffset = res->Base->GetFrameOffset(curAnimFrame);
 
-			DestructibleDebris& debris = _debrisList.emplace_back();
+			DestructibleDebris debris = { };
 			debris.Pos = Vector2f(x, y);
 			debris.Depth = (std::uint16_t)pos.Z;
 			// Sized by the frame's own area rather than the logical cell: with trimmed frames the two
@@ -1950,6 +2263,7 @@ namespace Jazz2::Tiles
 			// Indexed sprite debris is recolored at draw time; -1 keeps a baked texture on the plain Sprite shader
 			debris.PaletteOffset = (((res->Base->Flags & GenericGraphicResourceFlags::Indexed) == GenericGraphicResourceFlags::Indexed) ? (std::int32_t)res->PaletteOffset : -1);
 			debris.Flags = DebrisFlags::Bounce;
+			_debrisList.push_back(debris);
 		}
 	}
 
@@ -1957,77 +2271,17 @@ namespace Jazz2::Tiles
 	{
 		ZoneScopedC(0xA09359);
 
-		std::int32_t size = (std::int32_t)_debrisList.size();
-		for (std::int32_t i = 0; i < size; i++) {
-			DestructibleDebris& debris = _debrisList[i];
-
-			if (debris.Scale <= 0.0f || debris.Alpha <= 0.0f) {
-				std::swap(debris, _debrisList[size - 1]);
-				_debrisList.pop_back();
-				i--;
-				size--;
-				continue;
-			}
-
-			debris.Time -= timeMult;
-			if (debris.Time <= 0.0f) {
-				// Time's up - fade out smoothly instead of popping while still partly visible (e.g., the Fire/Lightning
-				// death effects, whose own AlphaSpeed is too slow to reach zero within their lifetime)
-				debris.AlphaSpeed = std::min(debris.AlphaSpeed, -0.08f);
-			}
-
-			if ((debris.Flags & (DebrisFlags::Disappear | DebrisFlags::Bounce)) != DebrisFlags::None) {
-				// Debris should collide with tilemap
-				float nx = debris.Pos.X + debris.Speed.X * timeMult;
-				float ny = debris.Pos.Y + debris.Speed.Y * timeMult;
-				// Debris is a few pixels across and destroys nothing, so it samples the collision mask at
-				// its centre rather than sweeping its whole box - a burst after an enemy dies is hundreds
-				// of these, and the box test carries setup a point sample does not need
-				if (IsTilePointEmpty((std::int32_t)nx, (std::int32_t)ny, true)) {
-					// Nothing...
-				} else if ((debris.Flags & DebrisFlags::Disappear) == DebrisFlags::Disappear) {
-					debris.ScaleSpeed = -0.02f;
-					debris.AlphaSpeed = -0.006f;
-					debris.Speed = Vector2f::Zero;
-					debris.Acceleration = Vector2f::Zero;
-				} else {
-					// Place us to the ground only if no horizontal movement was
-					// involved (this prevents speeds resetting if the actor
-					// collides with a wall from the side while in the air)
-					if (IsTilePointEmpty((std::int32_t)nx, (std::int32_t)debris.Pos.Y, true)) {
-						if (debris.Speed.Y > 0.0f) {
-							debris.Speed.Y = -(debris.Elasticity * debris.Speed.Y);
-							//OnHitFloorHook();
-						} else {
-							debris.Speed.Y = 0;
-							//OnHitCeilingHook();
-						}
-					}
-
-					// If the actor didn't move all the way horizontally,
-					// it hit a wall (or was already touching it)
-					if (IsTilePointEmpty((std::int32_t)debris.Pos.X, (std::int32_t)ny, true)) {
-						debris.Speed.X = -(debris.Elasticity * debris.Speed.X);
-						debris.AngleSpeed = -(debris.Elasticity * debris.AngleSpeed);
-						//OnHitWallHook();
-					}
-				}
-			}
-
-			debris.Pos.X += debris.Speed.X * timeMult + 0.5f * debris.Acceleration.X * timeMult * timeMult;
-			debris.Pos.Y += debris.Speed.Y * timeMult + 0.5f * debris.Acceleration.Y * timeMult * timeMult;
-
-			if (debris.Acceleration.X != 0.0f) {
-				debris.Speed.X = std::min(debris.Speed.X + debris.Acceleration.X * timeMult, 10.0f);
-			}
-			if (debris.Acceleration.Y != 0.0f) {
-				debris.Speed.Y = std::min(debris.Speed.Y + debris.Acceleration.Y * timeMult, 10.0f);
-			}
-
-			debris.Scale += debris.ScaleSpeed * timeMult;
-			debris.Angle += debris.AngleSpeed * timeMult;
-			debris.Alpha += debris.AlphaSpeed * timeMult;
-		}
+		// Each step is a separate pass over the whole storage, particles don't interact with each other, so it's the
+		// same as updating them one by one. Only collisions need the tile map, everything else is vectorized.
+		_debrisList.RemoveExpired();
+		_debrisList.UpdateLifetime(timeMult);
+		// Debris is a few pixels across and destroys nothing, so it samples the collision mask at
+		// its centre rather than sweeping its whole box - a burst after an enemy dies is hundreds
+		// of these, and the box test carries setup a point sample does not need
+		_debrisList.ResolveCollisions(timeMult, [this](std::int32_t x, std::int32_t y) {
+			return IsTilePointEmpty(x, y, true);
+		});
+		_debrisList.Integrate(timeMult);
 	}
 
 	void TileMap::DrawDebris(RenderQueue& renderQueue)
@@ -2049,28 +2303,38 @@ namespace Jazz2::Tiles
 		// one depth, so the whole effect ends up as a single draw instead of one command per particle.
 		_debrisMeshGroups.clear();
 
-		for (const auto& debris : _debrisList) {
-			if (!viewportRect.Contains(debris.Pos)) {
+		// Consecutive particles almost always come from the same burst, so the last group is tried first
+		std::int32_t lastGroup = -1;
+		std::size_t count = _debrisList.size();
+		for (std::size_t i = 0; i < count; i++) {
+			if (!viewportRect.Contains(Vector2f(_debrisList.PosX[i], _debrisList.PosY[i]))) {
 				continue;
 			}
 
-			const bool additiveBlending = ((debris.Flags & DebrisFlags::AdditiveBlending) == DebrisFlags::AdditiveBlending);
-			std::int32_t verticesIndex = -1;
-			// A handful of groups at most (the burst, the tile debris, the weather), so a linear scan beats a map
-			for (auto& group : _debrisMeshGroups) {
-				if (group.DiffuseTexture == debris.DiffuseTexture && group.PaletteOffset == debris.PaletteOffset &&
-					group.Depth == debris.Depth && group.AdditiveBlending == additiveBlending) {
-					verticesIndex = group.VerticesIndex;
-					break;
+			const auto& appearance = _debrisList.Appearances[i];
+			const bool additiveBlending = ((_debrisList.Flags[i] & DebrisFlags::AdditiveBlending) == DebrisFlags::AdditiveBlending);
+			auto matchesGroup = [&](const DebrisMeshGroup& group) {
+				return (group.DiffuseTexture == appearance.DiffuseTexture && group.PaletteOffset == appearance.PaletteOffset &&
+					group.Depth == appearance.Depth && group.AdditiveBlending == additiveBlending);
+			};
+
+			if (lastGroup < 0 || !matchesGroup(_debrisMeshGroups[lastGroup])) {
+				lastGroup = -1;
+				// A handful of groups at most (the burst, the tile debris, the weather), so a linear scan beats a map
+				for (std::int32_t j = 0; j < (std::int32_t)_debrisMeshGroups.size(); j++) {
+					if (matchesGroup(_debrisMeshGroups[j])) {
+						lastGroup = j;
+						break;
+					}
+				}
+				if (lastGroup < 0) {
+					lastGroup = (std::int32_t)_debrisMeshGroups.size();
+					_debrisMeshGroups.push_back({ appearance.DiffuseTexture, appearance.PaletteOffset, appearance.Depth,
+						additiveBlending, RentMeshVertices() });
 				}
-			}
-			if (verticesIndex < 0) {
-				verticesIndex = RentMeshVertices();
-				_debrisMeshGroups.push_back({ debris.DiffuseTexture, debris.PaletteOffset, debris.Depth,
-					additiveBlending, verticesIndex });
 			}
 
-			AppendDebrisQuad(_meshVertices[verticesIndex], debris);
+			AppendDebrisQuad(_meshVertices[_debrisMeshGroups[lastGroup].VerticesIndex], _debrisList, i);
 		}
 
 		for (const auto& group : _debrisMeshGroups) {
@@ -2086,8 +2350,9 @@ namespace Jazz2::Tiles
 		auto& resolver = ContentResolver::Get();
 		Texture* paletteTexture = resolver.GetPaletteTexture();
 
-		for (const auto& debris : _debrisList) {
-			if (!viewportRect.Contains(debris.Pos)) {
+		std::size_t count = _debrisList.size();
+		for (std::size_t i = 0; i < count; i++) {
+			if (!viewportRect.Contains(Vector2f(_debrisList.PosX[i], _debrisList.PosY[i]))) {
 				continue;
 			}
 
@@ -2102,45 +2367,48 @@ namespace Jazz2::Tiles
 			// on Sprite. Renting with that choice picks the same shader ConfigureSpriteShader() would, and
 			// hands back the instance uniforms already resolved - an exploding enemy emits hundreds of these
 			// in one frame, so a by-name lookup per uniform per debris is worth avoiding.
-			bool debrisIndexed = (debris.PaletteOffset >= 0);
+			const auto& appearance = _debrisList.Appearances[i];
+			bool debrisIndexed = (appearance.PaletteOffset >= 0);
 			TileCommandUniforms* commandUniforms;
 			auto command = RentRenderCommand(LayerRendererType::Default, debrisIndexed, &commandUniforms);
 			command->SetType(RenderCommand::Type::Particle);
 
-			if ((debris.Flags & DebrisFlags::AdditiveBlending) == DebrisFlags::AdditiveBlending) {
+			if ((_debrisList.Flags[i] & DebrisFlags::AdditiveBlending) == DebrisFlags::AdditiveBlending) {
 				command->GetMaterial().SetBlendingFactors(BlendingFactor::SrcAlpha, BlendingFactor::One);
 			} else {
 				command->GetMaterial().SetBlendingFactors(BlendingFactor::SrcAlpha, BlendingFactor::OneMinusSrcAlpha);
 			}
 
-			commandUniforms->TexRect->SetFloatValue(debris.TexScaleX, debris.TexBiasX, debris.TexScaleY, debris.TexBiasY);
-			commandUniforms->SpriteSize->SetFloatValue(debris.Size.X, debris.Size.Y);
-			commandUniforms->Color->SetFloatVector(Colorf(1.0f, 1.0f, 1.0f, debris.Alpha).Data());
+			commandUniforms->TexRect->SetFloatValue(appearance.TexScaleX, appearance.TexBiasX, appearance.TexScaleY, appearance.TexBiasY);
+			commandUniforms->SpriteSize->SetFloatValue(appearance.Size.X, appearance.Size.Y);
+			commandUniforms->Color->SetFloatVector(Colorf(1.0f, 1.0f, 1.0f, _debrisList.Alpha[i]).Data());
 
 			// Translation * RotationZ * Scaling * Translation, composed directly. Chaining the four
 			// operations meant three 4x4 multiplies per particle - and a burst of debris is hundreds of
 			// them in one frame - where the result is just a scaled rotation plus an offset origin.
-			const float c = std::cos(debris.Angle);
-			const float s = std::sin(debris.Angle);
-			const float ns = std::sin(-debris.Angle);	// Never "-s", see the note in Matrix4x4::RotationZ()
-			const float xx = c * debris.Scale, xy = s * debris.Scale;
-			const float yx = ns * debris.Scale, yy = c * debris.Scale;
-			const float localX = debris.FrameOffset.X - debris.Size.X * 0.5f;
-			const float localY = debris.FrameOffset.Y - debris.Size.Y * 0.5f;
+			const float angle = _debrisList.Angle[i];
+			const float scale = _debrisList.Scale[i];
+			const float c = std::cos(angle);
+			const float s = std::sin(angle);
+			const float ns = std::sin(-angle);	// Never "-s", see the note in Matrix4x4::RotationZ()
+			const float xx = c * scale, xy = s * scale;
+			const float yx = ns * scale, yy = c * scale;
+			const float localX = appearance.FrameOffset.X - appearance.Size.X * 0.5f;
+			const float localY = appearance.FrameOffset.Y - appearance.Size.Y * 0.5f;
 			command->SetTransformation(Matrix4x4f(
 				Vector4f(xx, xy, 0.0f, 0.0f),
 				Vector4f(yx, yy, 0.0f, 0.0f),
 				Vector4f(0.0f, 0.0f, 1.0f, 0.0f),
-				Vector4f(debris.Pos.X + xx * localX + yx * localY,
-					debris.Pos.Y + xy * localX + yy * localY, 0.0f, 1.0f)));
-			command->SetLayer(debris.Depth);
-			command->GetMaterial().SetTexture(0, *debris.DiffuseTexture);
+				Vector4f(_debrisList.PosX[i] + xx * localX + yx * localY,
+					_debrisList.PosY[i] + xy * localX + yy * localY, 0.0f, 1.0f)));
+			command->SetLayer(appearance.Depth);
+			command->GetMaterial().SetTexture(0, *appearance.DiffuseTexture);
 			if (debrisIndexed) {
 				if (paletteTexture != nullptr) {
 					command->GetMaterial().SetTexture(1, *paletteTexture);
 				}
 				if (commandUniforms->PaletteOffset != nullptr) {
-					commandUniforms->PaletteOffset->SetFloatValue((float)debris.PaletteOffset);
+					commandUniforms->PaletteOffset->SetFloatValue((float)appearance.PaletteOffset);
 				}
 			}
 
@@ -2177,6 +2445,7 @@ namespace Jazz2::Tiles
 					tile.DestructFrameIndex = (newState ? 1 : 0);
 					tile.TileID = (newState ? std::uint16_t(0) /*Empty*/ : std::uint16_t(tile.DestructAnimation));
 				}
+				InvalidateLayerChunk(_sprLayerIndex, i % layoutSize.X, i / layoutSize.X);
 			}
 		}
 	}
@@ -2253,9 +2522,33 @@ namespace Jazz2::Tiles
 			flags |= (std::uint8_t)LayerTileFlags::FlipY;
 		}
 		tile.Flags = (LayerTileFlags)flags;
+		InvalidateLayerChunk(layerIndex, x, y);
 		return true;
 	}
 
+	void TileMap::InvalidateLayerChunk(std::int32_t layerIndex, std::int32_t tx, std::int32_t ty)
+	{
+#if defined(TILEMAP_USE_SINGLE_DRAW)
+		if (layerIndex >= 0 && layerIndex < (std::int32_t)_layerChunks.size()) {
+			LayerChunkGrid& grid = _layerChunks[layerIndex];
+			if (!grid.Chunks.empty()) {
+				grid.Chunks[(ty / LayerChunkSize) * grid.ChunksX + (tx / LayerChunkSize)].Dirty = true;
+			}
+		}
+#endif
+	}
+
+	void TileMap::InvalidateLayerChunks(std::int32_t layerIndex)
+	{
+#if defined(TILEMAP_USE_SINGLE_DRAW)
+		if (layerIndex >= 0 && layerIndex < (std::int32_t)_layerChunks.size()) {
+			for (auto& chunk : _layerChunks[layerIndex].Chunks) {
+				chunk.Dirty = true;
+			}
+		}
+#endif
+	}
+
 	void TileMap::SaveTileForRollback(std::uint32_t tileIndex, const LayerTile& tile)
 	{
 		// Binary search keeps the list sorted by index and doubles as the duplicate check: only the first
@@ -2308,6 +2601,7 @@ namespace Jazz2::Tiles
 		for (const auto& saved : _sprLayerForRollback) {
 			layout[saved.TileIndex] = saved.Tile;
 		}
+		InvalidateLayerChunks(_sprLayerIndex);
 
 		std::memcpy(_triggerState.data(), _triggerStateForRollback.data(), _triggerState.sizeInBytes());
 	}
@@ -2355,6 +2649,7 @@ namespace Jazz2::Tiles
 		}
 
 		src.Read(_triggerState.data(), _triggerState.sizeInBytes());
+		InvalidateLayerChunks(_sprLayerIndex);
 	}
 
 	void TileMap::SerializeResumableToStream(Stream& dest, bool fromCheckpoint)
@@ -4,6 +4,7 @@
 #include "../ILevelHandler.h"
 #include "../PitType.h"
 #include "../SuspendType.h"
+#include "DebrisStorage.h"
 #include "LayerTypes.h"
 #include "TileSet.h"
 
@@ -213,81 +214,10 @@ namespace Jazz2::Tiles
 
 		/** @} */
 
-		/** @brief Flags that modify behaviour of @ref DestructibleDebris, supports a bitwise combination of its member values */
-		enum class DebrisFlags {
-			None = 0x00,				/**< None */
-			Disappear = 0x01,			/**< Debris disappears over time */
-			Bounce = 0x02,				/**< Debris bounces off solid tiles */
-			AdditiveBlending = 0x04		/**< Debris is rendered with additive blending */
-		};
-
-		DEATH_PRIVATE_ENUM_FLAGS(DebrisFlags);
-
-		/** @brief Describes a visual debris (particle effect) */
-		struct DestructibleDebris {
-			/** @brief Position */
-			Vector2f Pos;
-			/** @brief Depth (layer) */
-			std::uint16_t Depth;
-
-			/** @brief Size of the drawn area */
-			Vector2f Size;
-			/**
-				@brief Displacement of the drawn area from the centre of its logical frame cell
-
-				Zero for debris that is its own little quad. A trimmed sprite frame covers less than its
-				cell, so drawing it needs to know where inside that cell it belongs - otherwise the frame
-				is stretched over the whole cell (see @ref GenericGraphicResource::GetFrameOffset()).
-			*/
-			Vector2f FrameOffset;
-			/** @brief Speed */
-			Vector2f Speed;
-			/** @brief Acceleration */
-			Vector2f Acceleration;
-
-			/** @brief Scale */
-			float Scale;
-			/** @brief Scale change speed */
-			float ScaleSpeed;
-
-			/** @brief Angle */
-			float Angle;
-			/** @brief Angle change speed */
-			float AngleSpeed;
-
-			/** @brief Alpha */
-			float Alpha;
-			/** @brief Alpha change speed */
-			float AlphaSpeed;
-
-			/** @brief Time remaining until disposal */
-			float Time;
-
-			/** @brief Fraction of speed kept when bouncing off a solid tile (with @ref DebrisFlags::Bounce) */
-			float Elasticity = 0.8f;
-
-			/** @brief Texture horizontal scale */
-			float TexScaleX;
-			/** @brief Texture horizontal bias */
-			float TexBiasX;
-			/** @brief Texture vertical scale */
-			float TexScaleY;
-			/** @brief Texture vertical bias */
-			float TexBiasY;
-
-			/** @brief Diffuse texture */
-			Texture* DiffuseTexture;
-			/**
-			 * @brief Flat palette offset when @ref DiffuseTexture is an indexed sprite
-			 *
-			 * The sprite is recolored at draw time. `-1` when the texture holds baked colors (e.g., a tileset texture)
-			 * and must use the plain Sprite shader.
-			 */
-			std::int32_t PaletteOffset = -1;
-
-			/** @brief Behavior flags */
-			DebrisFlags Flags;
-		};
+		/** @brief Flags that modify behaviour of @ref DestructibleDebris, see @ref Tiles::DebrisFlags */
+		using DebrisFlags = Tiles::DebrisFlags;
+		/** @brief Describes a visual debris (particle effect), see @ref Tiles::DestructibleDebris */
+		using DestructibleDebris = Tiles::DestructibleDebris;
 
 		/**
 		 * @brief Creates a new instance
@@ -341,6 +271,17 @@ namespace Jazz2::Tiles
 			iteration and the whole destructible/collapsing tile machinery that a point sample cannot use.
 		*/
 		bool IsTilePointEmpty(std::int32_t x, std::int32_t y, bool downwards);
+		/**
+			@brief Returns distance from @p y down to the nearest solid pixel of the main (sprite) layer below a horizontal span
+
+			Answers "how far is the ground" in one pass over precomputed mask columns, instead of probing
+			@ref IsTileEmpty() repeatedly with boxes shifted by a pixel. Pixel columns containing @p left
+			to @p right are tested, out-of-level columns count as solid walls (distance 0) and the bottom of
+			the level is solid only for @ref PitType::StandOnPlatform. One-way tiles are solid only if
+			@p downwards is `true`, tiles with a suspend type never are, and destructible tiles are solid
+			until destroyed. Returns @p maxDistance if nothing solid was found within range.
+		*/
+		float GetGroundDistance(float left, float right, float y, float maxDistance, bool downwards = true);
 		/** @brief Returns `true` if tiles on the main (sprite) layer intersecting a given AABB can be destroyed */
 		bool CanBeDestroyed(const AABBf& aabb, TileCollisionParams& params);
 		/** @brief Returns suspend state of a given position */
@@ -557,7 +498,7 @@ namespace Jazz2::Tiles
 			RHI::UniformCache* PaletteOffset = nullptr;
 		};
 
-		SmallVector<DestructibleDebris, 0> _debrisList;
+		DebrisStorage _debrisList;
 		SmallVector<std::unique_ptr<RenderCommand>, 0> _renderCommands;
 		/// Instance-block uniforms of the correspondingly indexed pooled command. Resolving them by name costs
 		/// a linear scan of the block, which at one command per visible tile dominated the layer build - they
@@ -571,7 +512,8 @@ namespace Jazz2::Tiles
 
 #if defined(TILEMAP_USE_SINGLE_DRAW)
 		// Per-frame pools for aggregated meshes, replacing the per-tile and per-particle commands. One vertex buffer
-		// is filled per drawn tile layer and per debris group; each mesh is then split into chunks that individually
+		// is filled per texture chunk with the animated tiles of a drawn layer (static tiles come from the cached
+		// @ref LayerChunk meshes) and per debris group; each mesh is then split into chunks that individually
 		// fit the shared array buffer limit (64 KB), so a mesh emits one command per chunk (usually just one). Both
 		// pools grow on demand and reset in OnEndFrame(); host vertex pointers reference the buffers until the render
 		// queue is flushed, so a buffer is never reused within a frame (across viewports the counts simply keep growing).
@@ -596,6 +538,33 @@ namespace Jazz2::Tiles
 		};
 
 		SmallVector<DebrisMeshGroup, 4> _debrisMeshGroups;
+
+		/// Cached geometry of one square block of tiles of a layer. Static tiles only change through tile
+		/// destruction, triggers and scripts, which mark their chunk dirty (see @ref InvalidateLayerChunk()), so
+		/// the quads are built once and reused every frame. Animated tiles change frame on their own, they are
+		/// only listed here and appended to the per-frame pool instead.
+		struct LayerChunk
+		{
+			/// Static tiles in chunk-local space, one buffer per texture chunk of the tileset
+			SmallVector<SmallVector<float, 0>, 0> Vertices;
+			/// Chunk-local indices of the animated tiles
+			SmallVector<std::uint16_t, 0> AnimatedTiles;
+			/// Value of @ref _layerChunkFrame when the chunk was last drawn
+			std::uint32_t LastDrawnFrame = 0;
+			bool Dirty = true;
+		};
+
+		/// Chunk grid of one tile layer, allocated when the layer is first drawn as a mesh
+		struct LayerChunkGrid
+		{
+			SmallVector<LayerChunk, 0> Chunks;
+			std::int32_t ChunksX = 0;
+			std::int32_t ChunksY = 0;
+		};
+
+		/// Indexed the same as @ref _layers
+		SmallVector<LayerChunkGrid, 0> _layerChunks;
+		std::uint32_t _layerChunkFrame = 0;
 #endif
 
 		std::int32_t _texturedBackgroundLayer;
@@ -611,14 +580,27 @@ namespace Jazz2::Tiles
 			float texScaleX, float texBiasX, float texScaleY, float texBiasY, float alpha);
 		// Appends one particle's two triangles in the same layout, with its rotation, scale and frame offset already
 		// folded into the four corners - the quad the sprite shader would have synthesized from its model matrix
-		static void AppendDebrisQuad(SmallVector<float, 0>& vertices, const DestructibleDebris& debris);
+		static void AppendDebrisQuad(SmallVector<float, 0>& vertices, const DebrisStorage& debris, std::size_t index);
 		// Rents a mesh vertex buffer from the per-frame pool and returns its index (the pool can reallocate, so
 		// callers hold indices rather than pointers)
 		std::int32_t RentMeshVertices();
-		// Emits an accumulated mesh as one or more render commands (split into <=64 KB chunks)
+		// Emits an accumulated mesh as one or more render commands (split into <=64 KB chunks), translated by origin
 		void EmitMesh(RenderQueue& renderQueue, SmallVector<float, 0>& vertices, const Texture& texture, bool indexed,
-			std::uint16_t paletteOffset, const Vector4f& color, std::uint16_t depth, RenderCommand::Type type, bool additiveBlending);
+			std::uint16_t paletteOffset, const Vector4f& color, std::uint16_t depth, RenderCommand::Type type, bool additiveBlending,
+			Vector2f origin = Vector2f::Zero);
+		// Draws the visible part of a layer as one mesh per cached chunk; the arguments are the tile grid DrawLayer()
+		// computed - the first visible tile is (tileAbsX + 1, tileAbsY + 1) and is drawn at (x1, y1)
+		void DrawLayerChunks(RenderQueue& renderQueue, TileMapLayer& layer, const Vector4f& layerColor,
+			float x1, float y1, float x3, float y3, std::int32_t tileAbsX, std::int32_t tileAbsY);
+		// Rebuilds the cached quads of one chunk from the current layout
+		void RebuildLayerChunk(const TileMapLayer& layer, LayerChunk& chunk, std::int32_t chunkX, std::int32_t chunkY);
+		// Resolves the current frame of a tile to the tileset texture chunk holding it and the texture rectangle
+		// of its quad (scale/bias, with flipping folded in); returns false if there is nothing to draw
+		bool ResolveMeshTile(const LayerTile& tile, std::int32_t& textureChunk, Vector4f& texRect);
 #endif
+		// Marks the cached chunk holding the tile for rebuilding after the tile changed, or every chunk of the layer
+		void InvalidateLayerChunk(std::int32_t layerIndex, std::int32_t tx, std::int32_t ty);
+		void InvalidateLayerChunks(std::int32_t layerIndex);
 
 		void SaveTileForRollback(std::uint32_t tileIndex, const LayerTile& tile);
 
@@ -634,5 +616,7 @@ namespace Jazz2::Tiles
 
 		TileSet* ResolveTileSet(std::int32_t& tileId);
 		std::int32_t ResolveTileID(const LayerTile& tile) const;
+
+		std::int32_t FindSolidRow(std::int32_t x1, std::int32_t x2, std::int32_t fromY, std::int32_t toY, bool downwards);
 	};
 }
\ No newline at end of file
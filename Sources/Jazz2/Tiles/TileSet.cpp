@@ -26,6 +26,8 @@ namespace Jazz2::Tiles
 		_isColumnContiguous.resize(ValueInit, TileCount);
 		// 2 bytes per column (first/last solid row); zero-initialized by make_unique
 		_columnSpans = std::make_unique<std::uint8_t[]>((std::size_t)TileCount * DefaultTileSize * 2);
+		// 1 word per column (transposed mask), tiles without a mask stay empty
+		_maskColumns = std::make_unique<std::uint32_t[]>((std::size_t)TileCount * DefaultTileSize);
 
 		std::uint32_t maskMaxTiles = maskSize / MaskBytesPerTile;
 
@@ -49,6 +51,9 @@ namespace Jazz2::Tiles
 			if (maskFilled) {
 				_isMaskFilled.set(i);
 			}
+			if (!maskEmpty) {
+				UpdateTileMaskColumns(i);
+			}
 
 			// A tile is "filled" for rendering when its diffuse is fully opaque (used to cull hidden debris).
 			// The flag is computed from the diffuse alpha by the content loader; it is absent in headless
@@ -194,7 +199,22 @@ namespace Jazz2::Tiles
 		_isMaskFilled.set(tileId, maskFilled);
 		// Disable the column-span fast path for overridden masks, the per-pixel scan stays correct
 		_isColumnContiguous.set(tileId, false);
+		UpdateTileMaskColumns(tileId);
 
 		return true;
 	}
+
+	void TileSet::UpdateTileMaskColumns(std::int32_t tileId)
+	{
+		const std::uint8_t* maskOffset = &_mask[tileId * MaskBytesPerTile];
+		std::uint32_t* columns = &_maskColumns[(std::size_t)tileId * DefaultTileSize];
+		std::memset(columns, 0, DefaultTileSize * sizeof(std::uint32_t));
+
+		for (std::int32_t y = 0; y < DefaultTileSize; y++) {
+			std::uint32_t row = GetTileMaskRow(maskOffset, y);
+			for (std::int32_t x = 0; x < DefaultTileSize; x++) {
+				columns[x] |= ((row >> x) & 1u) << y;
+			}
+		}
+	}
 }
\ No newline at end of file
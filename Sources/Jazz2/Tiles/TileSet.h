@@ -163,6 +163,17 @@ namespace Jazz2::Tiles
 			return &_columnSpans[tileId * DefaultTileSize * 2];
 		}
 
+		/**
+		 * @brief Returns one column of a tile mask as a 32-bit word (bit `y` set = row `y` solid)
+		 *
+		 * The transposed counterpart of @ref GetTileMaskRow(), so vertical probes (distance to ground or ceiling)
+		 * resolve a whole column with a single bit scan instead of walking the rows.
+		 */
+		std::uint32_t GetTileMaskColumn(std::int32_t tileId, std::int32_t x) const
+		{
+			return _maskColumns[tileId * DefaultTileSize + x];
+		}
+
 		/** @brief Returns `true` if the texture of a tile is completely opaque (non-transparent) */
 		bool IsTileFilled(std::int32_t tileId) const
 		{
@@ -186,11 +197,14 @@ namespace Jazz2::Tiles
 
 	private:
 		std::unique_ptr<uint8_t[]> _mask;
+		std::unique_ptr<std::uint32_t[]> _maskColumns;
 		std::unique_ptr<std::uint8_t[]> _columnSpans;
 		std::unique_ptr<Color[]> _captionTile;
 		BitArray _isMaskEmpty;
 		BitArray _isMaskFilled;
 		BitArray _isTileFilled;
 		BitArray _isColumnContiguous;
+
+		void UpdateTileMaskColumns(std::int32_t tileId);
 	};
 }
\ No newline at end of file
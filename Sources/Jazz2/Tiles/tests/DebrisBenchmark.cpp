@@ -0,0 +1,192 @@
+// Simulates a debris burst with the former update loop and with DebrisStorage and compares their time and results
+// Built with -DNCINE_BUILD_BENCHMARKS=ON, usage: DebrisBenchmark [--count <particles>] [--frames <count>]
+
+#include "Jazz2/Tiles/DebrisStorage.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+using namespace Jazz2::Tiles;
+
+namespace
+{
+	// Small xorshift generator, so the particle stream doesn't depend on the standard library implementation
+	struct Random
+	{
+		std::uint32_t State;
+
+		float Next(float min, float max)
+		{
+			State ^= State << 13;
+			State ^= State >> 17;
+			State ^= State << 5;
+			return min + (max - min) * float(State >> 8) * (1.0f / 16777216.0f);
+		}
+	};
+
+	bool IsPointEmpty(std::int32_t x, std::int32_t y)
+	{
+		if (y >= 600 || x < 0 || x >= 2000) {
+			return false;
+		}
+		// A few solid blocks for the particles to bounce off
+		return ((x / 32) % 7 != 3 || (y / 32) % 5 != 2);
+	}
+
+	std::vector<DestructibleDebris> CreateBurst(std::int32_t count)
+	{
+		Random random = { 0x9E3779B9u };
+		std::vector<DestructibleDebris> result;
+		result.reserve(count);
+		for (std::int32_t i = 0; i < count; i++) {
+			DestructibleDebris debris = { };
+			debris.Pos = nCine::Vector2f(random.Next(200.0f, 1800.0f), random.Next(100.0f, 500.0f));
+			debris.Size = nCine::Vector2f(3.0f, 3.0f);
+			debris.Speed = nCine::Vector2f(random.Next(-4.0f, 4.0f), random.Next(-4.0f, -1.0f));
+			debris.Acceleration = nCine::Vector2f(0.0f, (i % 5) == 0 ? 0.0f : 0.2f);
+			debris.Scale = 1.0f;
+			debris.ScaleSpeed = ((i % 3) == 0 ? -0.002f : 0.0f);
+			debris.AngleSpeed = random.Next(-0.02f, 0.02f);
+			debris.Alpha = 1.0f;
+			debris.AlphaSpeed = random.Next(-0.01f, -0.002f);
+			debris.Time = random.Next(60.0f, 320.0f);
+			debris.Flags = ((i % 4) == 0 ? DebrisFlags::Disappear : ((i % 4) == 1 ? DebrisFlags::None : DebrisFlags::Bounce));
+			result.push_back(debris);
+		}
+		return result;
+	}
+
+	// The update loop as it was before the structure-of-arrays storage
+	void UpdateReference(std::vector<DestructibleDebris>& debrisList, float timeMult)
+	{
+		std::int32_t size = (std::int32_t)debrisList.size();
+		for (std::int32_t i = 0; i < size; i++) {
+			DestructibleDebris& debris = debrisList[i];
+
+			if (debris.Scale <= 0.0f || debris.Alpha <= 0.0f) {
+				std::swap(debris, debrisList[size - 1]);
+				debrisList.pop_back();
+				i--;
+				size--;
+				continue;
+			}
+
+			debris.Time -= timeMult;
+			if (debris.Time <= 0.0f) {
+				debris.AlphaSpeed = std::min(debris.AlphaSpeed, -0.08f);
+			}
+
+			if ((debris.Flags & (DebrisFlags::Disappear | DebrisFlags::Bounce)) != DebrisFlags::None) {
+				float nx = debris.Pos.X + debris.Speed.X * timeMult;
+				float ny = debris.Pos.Y + debris.Speed.Y * timeMult;
+				if (IsPointEmpty((std::int32_t)nx, (std::int32_t)ny)) {
+					// Nothing...
+				} else if ((debris.Flags & DebrisFlags::Disappear) == DebrisFlags::Disappear) {
+					debris.ScaleSpeed = -0.02f;
+					debris.AlphaSpeed = -0.006f;
+					debris.Speed = nCine::Vector2f::Zero;
+					debris.Acceleration = nCine::Vector2f::Zero;
+				} else {
+					if (IsPointEmpty((std::int32_t)nx, (std::int32_t)debris.Pos.Y)) {
+						if (debris.Speed.Y > 0.0f) {
+							debris.Speed.Y = -(debris.Elasticity * debris.Speed.Y);
+						} else {
+							debris.Speed.Y = 0;
+						}
+					}
+					if (IsPointEmpty((std::int32_t)debris.Pos.X, (std::int32_t)ny)) {
+						debris.Speed.X = -(debris.Elasticity * debris.Speed.X);
+						debris.AngleSpeed = -(debris.Elasticity * debris.AngleSpeed);
+					}
+				}
+			}
+
+			debris.Pos.X += debris.Speed.X * timeMult + 0.5f * debris.Acceleration.X * timeMult * timeMult;
+			debris.Pos.Y += debris.Speed.Y * timeMult + 0.5f * debris.Acceleration.Y * timeMult * timeMult;
+
+			if (debris.Acceleration.X != 0.0f) {
+				debris.Speed.X = std::min(debris.Speed.X + debris.Acceleration.X * timeMult, 10.0f);
+			}
+			if (debris.Acceleration.Y != 0.0f) {
+				debris.Speed.Y = std::min(debris.Speed.Y + debris.Acceleration.Y * timeMult, 10.0f);
+			}
+
+			debris.Scale += debris.ScaleSpeed * timeMult;
+			debris.Angle += debris.AngleSpeed * timeMult;
+			debris.Alpha += debris.AlphaSpeed * timeMult;
+		}
+	}
+
+	void UpdateStorage(DebrisStorage& storage, float timeMult)
+	{
+		storage.RemoveExpired();
+		storage.UpdateLifetime(timeMult);
+		storage.ResolveCollisions(timeMult, IsPointEmpty);
+		storage.Integrate(timeMult);
+	}
+
+	float TimeMultForFrame(std::int32_t frame)
+	{
+		// Slightly uneven frame times, as in a real session
+		return 1.0f + 0.25f * float((frame * 7) % 5 - 2) / 2.0f;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::int32_t count = 10000;
+	std::int32_t frames = 300;
+	for (std::int32_t i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+			count = std::atoi(argv[++i]);
+		} else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			frames = std::atoi(argv[++i]);
+		} else {
+			std::fprintf(stderr, "Usage: %s [--count <particles>] [--frames <count>]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	std::vector<DestructibleDebris> burst = CreateBurst(count);
+
+	std::vector<DestructibleDebris> reference = burst;
+	auto start = std::chrono::steady_clock::now();
+	for (std::int32_t frame = 0; frame < frames; frame++) {
+		UpdateReference(reference, TimeMultForFrame(frame));
+	}
+	double referenceMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	DebrisStorage storage;
+	for (const auto& debris : burst) {
+		storage.push_back(debris);
+	}
+	start = std::chrono::steady_clock::now();
+	for (std::int32_t frame = 0; frame < frames; frame++) {
+		UpdateStorage(storage, TimeMultForFrame(frame));
+	}
+	double storageMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	// The reference removes by swapping with the last element, so only the sets of particles can be compared
+	std::vector<std::pair<float, float>> expected, actual;
+	for (const auto& debris : reference) {
+		expected.emplace_back(debris.Pos.X, debris.Pos.Y);
+	}
+	for (std::size_t i = 0; i < storage.size(); i++) {
+		actual.emplace_back(storage.PosX[i], storage.PosY[i]);
+	}
+	std::sort(expected.begin(), expected.end());
+	std::sort(actual.begin(), actual.end());
+	bool matches = (expected == actual);
+
+	std::printf("%d particles, %d frames, %zu alive at the end\n", count, frames, actual.size());
+	std::printf("  array of structures:  %8.3f ms total, %7.4f ms/frame\n", referenceMs, referenceMs / frames);
+	std::printf("  structure of arrays:  %8.3f ms total, %7.4f ms/frame (%.2fx)\n", storageMs, storageMs / frames, referenceMs / storageMs);
+	std::printf("  results %s\n", matches ? "match" : "DIFFER");
+	return (matches ? 0 : 1);
+}
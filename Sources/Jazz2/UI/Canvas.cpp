@@ -1,13 +1,17 @@
 ﻿#include "Canvas.h"
 #include "../ContentResolver.h"
 
+#include "../../nCine/Graphics/RenderBatcher.h"
 #include "../../nCine/Graphics/RenderQueue.h"
+#include "../../nCine/Graphics/RenderResources.h"
 #include "../../nCine/Base/Random.h"
 
+#include <cstring>
+
 namespace Jazz2::UI
 {
 	Canvas::Canvas()
-		: AnimTime(0.0f), _renderCommandsCount(0), _currentRenderQueue(nullptr)
+		: AnimTime(0.0f), _renderCommandsCount(0), _currentRenderQueue(nullptr), _glyphRunsCount(0), _glyphRunsNesting(0)
 	{
 		setVisitOrderState(SceneNode::VisitOrderState::Disabled);
 	}
@@ -25,6 +29,10 @@ namespace Jazz2::UI
 
 		_renderCommandsCount = 0;
 		_currentRenderQueue = &renderQueue;
+		// Glyph runs of the previous frame were all submitted by the time it ended
+		DEATH_ASSERT(_glyphRunsCount == 0 && _glyphRunsNesting == 0);
+		_glyphRunsCount = 0;
+		_glyphRunsNesting = 0;
 
 		return false;
 	}
@@ -216,4 +224,89 @@ namespace Jazz2::UI
 			return command.get();
 		}
 	}
-}
\ No newline at end of file
+
+	void Canvas::BeginGlyphRuns()
+	{
+		_glyphRunsNesting++;
+	}
+
+	void Canvas::EndGlyphRuns()
+	{
+		DEATH_ASSERT(_glyphRunsNesting > 0);
+		_glyphRunsNesting--;
+		if (_glyphRunsNesting == 0) {
+			FlushGlyphRuns();
+		}
+	}
+
+	Canvas::GlyphRun* Canvas::FindGlyphRun(const RHI::ShaderProgram* shaderProgram, const Texture& texture, std::uint16_t layer)
+	{
+		for (std::int32_t i = 0; i < _glyphRunsCount; i++) {
+			GlyphRun& run = _glyphRuns[i];
+			if (run.GlyphTexture == &texture && run.Command->GetLayer() == layer && run.Command->GetMaterial().GetShaderProgram() == shaderProgram) {
+				return &run;
+			}
+		}
+		return nullptr;
+	}
+
+	Canvas::GlyphRun* Canvas::OpenGlyphRun(const Texture& texture)
+	{
+		if (_glyphRunsCount >= MaxGlyphRuns) {
+			// Only text that keeps switching colors and layers gets here, its runs are then just shorter
+			FlushGlyphRuns();
+		}
+		if (_glyphRunsCount >= std::int32_t(_glyphRuns.size())) {
+			_glyphRuns.emplace_back();
+		}
+
+		GlyphRun& run = _glyphRuns[_glyphRunsCount];
+		run.Command = RentRenderCommand();
+		run.GlyphTexture = &texture;
+		run.Count = 0;
+		run.Stride = 0;
+		_glyphRunsCount++;
+		return &run;
+	}
+
+	void Canvas::AddToGlyphRun(GlyphRun& run)
+	{
+		// Also writes the model matrix with the depth of the layer to the instance block, so the block is complete
+		run.Command->CommitNodeTransformation();
+
+		const RHI::UniformBlockCache* instanceBlock = run.Command->GetInstanceBlock();
+		if (run.Count == 0) {
+			run.Stride = RenderBatcher::GetInstanceStride(*run.Command);
+		}
+		const std::uint32_t offset = run.Count * run.Stride;
+		run.Instances.resize_for_overwrite(offset + run.Stride);
+		std::memcpy(&run.Instances[offset], instanceBlock->GetDataPointer(), instanceBlock->GetSize() - instanceBlock->GetAlignAmount());
+		run.Count++;
+	}
+
+	void Canvas::FlushGlyphRuns()
+	{
+		RenderBatcher& renderBatcher = RenderResources::GetRenderBatcher();
+		for (std::int32_t i = 0; i < _glyphRunsCount; i++) {
+			GlyphRun& run = _glyphRuns[i];
+			if (run.Count == 1) {
+				// The command still holds the only glyph, a batch of one would be just an extra copy
+				_currentRenderQueue->AddCommand(run.Command);
+				continue;
+			}
+
+			std::uint32_t start = 0;
+			while (start < run.Count) {
+				std::uint32_t count = run.Count - start;
+				RenderCommand* batchCommand = renderBatcher.CreateBatch(*run.Command, &run.Instances[start * run.Stride], count);
+				DEATH_ASSERT(batchCommand != nullptr && count > 0);
+				if (batchCommand == nullptr || count == 0) {
+					break;
+				}
+				_currentRenderQueue->AddCommand(batchCommand);
+				start += count;
+			}
+		}
+		_glyphRunsCount = 0;
+	}
+}
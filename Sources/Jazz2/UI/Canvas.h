@@ -68,13 +68,51 @@ namespace Jazz2::UI
 		/** @brief Draws a raw render command */
 		void DrawRenderCommand(RenderCommand* command);
 
+		/**
+		 * @brief Keeps glyph runs open until @ref EndGlyphRuns(), so text of several @ref Font::DrawString() calls can share them
+		 *
+		 * Every string is otherwise submitted as soon as it's laid out. Calls can be nested.
+		 */
+		void BeginGlyphRuns();
+		/** @brief Submits the glyph runs that were kept open since the outermost @ref BeginGlyphRuns() */
+		void EndGlyphRuns();
+
 	protected:
 		/** @brief Multiplier of game time for canvas rendering */
 		static constexpr float AnimTimeMultiplier = 0.014f;
 
 	private:
+#ifndef DOXYGEN_GENERATING_OUTPUT
+		// Doxygen 1.12.0 outputs also private structs/unions even if it shouldn't
+		struct GlyphRun
+		{
+			// Set up as a single glyph, it only lays out the instances and carries the material, it's queued
+			// itself only if the run has just one glyph
+			RenderCommand* Command;
+			const Texture* GlyphTexture;
+			std::uint32_t Count;
+			std::uint32_t Stride;
+			SmallVector<std::uint8_t, 0> Instances;
+		};
+#endif
+
+		/** @brief Maximum number of glyph runs open at once, a menu screen uses about a dozen */
+		static constexpr std::int32_t MaxGlyphRuns = 16;
+
 		std::int32_t _renderCommandsCount;
 		SmallVector<std::unique_ptr<RenderCommand>, 0> _renderCommands;
 		RenderQueue* _currentRenderQueue;
+		std::int32_t _glyphRunsCount;
+		std::int32_t _glyphRunsNesting;
+		SmallVector<GlyphRun, 0> _glyphRuns;
+
+		/** @brief Returns an open glyph run with the specified shader program, texture and layer, or `nullptr` */
+		GlyphRun* FindGlyphRun(const RHI::ShaderProgram* shaderProgram, const Texture& texture, std::uint16_t layer);
+		/** @brief Opens a new glyph run, its command has to be set up by the caller */
+		GlyphRun* OpenGlyphRun(const Texture& texture);
+		/** @brief Appends the glyph currently set up in the command of the run to the run */
+		void AddToGlyphRun(GlyphRun& run);
+		/** @brief Submits all open glyph runs as batched render commands */
+		void FlushGlyphRuns();
 	};
 }
\ No newline at end of file
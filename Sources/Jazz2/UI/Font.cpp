@@ -1,9 +1,12 @@
 ﻿#include "Font.h"
+#include "FormattedTextBlock.h"
 
 #include "../ContentResolver.h"
 #include "../Compatibility/JJ2Anims.h"
 
+#include "../../nCine/Graphics/RenderBatcher.h"
 #include "../../nCine/Graphics/RenderQueue.h"
+#include "../../nCine/Graphics/RenderResources.h"
 #include "../../nCine/Base/Random.h"
 
 #include <IO/Compression/DeflateStream.h>
@@ -142,6 +145,12 @@ namespace Jazz2::UI
 		_texture->SetMagFiltering(SamplerFilter::Linear);
 	}
 
+	Font::~Font()
+	{
+		// Fonts are recreated when the palette changes, a new one could end up at the same address
+		FormattedTextBlock::DiscardCachedLayouts(this);
+	}
+
 	std::int32_t Font::GetSizeInPixels() const
 	{
 		// TODO
@@ -417,6 +426,14 @@ namespace Jazz2::UI
 			alpha = std::min(color.A * 2.0f, 1.0f);
 		}
 
+		// Glyphs that share the shader and the layer are collected into a run, which is then submitted as a single
+		// batched command rather than as a command per glyph. Resolved again only when a formatting tag switches
+		// the shader. The runs are kept open until the end of the string, or of the text block being drawn.
+		Shader* glyphShader = nullptr;
+		RHI::ShaderProgram* glyphShaderProgram = nullptr;
+		bool useGlyphRuns = false;
+		canvas->BeginGlyphRuns();
+
 		idx = 0;
 		line = 0;
 		do {
@@ -591,26 +608,28 @@ namespace Jazz2::UI
 								glyph.Y / float(texSize.Y)
 							);
 
-							auto command = canvas->RentRenderCommand();
-							command->SetType(RenderCommand::Type::Text);
-							bool shaderChanged = (colorizeShader
-								? command->GetMaterial().SetShader(colorizeShader)
-								: command->GetMaterial().SetShaderProgramType(Material::ShaderProgramType::Sprite));
-							if (shaderChanged) {
-								command->GetMaterial().ReserveUniformsDataMemory();
-								command->GetGeometry().SetDrawParameters(PrimitiveType::TriangleStrip, 0, 4);
-								// Required to reset render command properly
-								//command->SetTransformation(command->transformation());
-
-								auto* textureUniform = command->GetMaterial().Uniform(Material::TextureUniformName);
-								if (textureUniform && textureUniform->GetIntValue(0) != 0) {
-									textureUniform->SetIntValue(0); // GL_TEXTURE0
-								}
+							if (glyphShaderProgram == nullptr || glyphShader != colorizeShader) {
+								glyphShader = colorizeShader;
+								glyphShaderProgram = (colorizeShader != nullptr
+									? colorizeShader->GetHandle()
+									: RenderResources::GetShaderProgram(Material::ShaderProgramType::Sprite));
+								useGlyphRuns = RenderBatcher::CanCreateBatch(glyphShaderProgram);
 							}
 
-							// Separate alpha blend so text (e.g. semi-transparent shadows) accumulates correct alpha coverage
-							// when drawn into an RGBA render target, harmless for opaque/RGB targets
-							command->GetMaterial().SetBlendingFactors(BlendingFactor::SrcAlpha, BlendingFactor::OneMinusSrcAlpha, BlendingFactor::One, BlendingFactor::OneMinusSrcAlpha);
+							const std::uint16_t layer = z - (charOffset & 1);
+							Canvas::GlyphRun* run = nullptr;
+							RenderCommand* command;
+							if (useGlyphRuns) {
+								run = canvas->FindGlyphRun(glyphShaderProgram, *_texture, layer);
+								if (run == nullptr) {
+									run = canvas->OpenGlyphRun(*_texture);
+									SetupGlyphCommand(run->Command, colorizeShader, layer);
+								}
+								command = run->Command;
+							} else {
+								command = canvas->RentRenderCommand();
+								SetupGlyphCommand(command, colorizeShader, layer);
+							}
 
 							auto* instanceBlock = command->GetInstanceBlock();
 							instanceBlock->GetUniform(Material::TexRectUniformName)->SetFloatVector(texCoords.Data());
@@ -618,10 +637,12 @@ namespace Jazz2::UI
 							instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(glyphColor.Data());
 
 							command->SetTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f));
-							command->SetLayer(z - (charOffset & 1));
-							command->GetMaterial().SetTexture(*_texture.get());
 
-							canvas->_currentRenderQueue->AddCommand(command);
+							if (run != nullptr) {
+								canvas->AddToGlyphRun(*run);
+							} else {
+								canvas->_currentRenderQueue->AddCommand(command);
+							}
 						}
 					}
 
@@ -633,6 +654,33 @@ namespace Jazz2::UI
 			idx = std::int32_t(cursor.second());
 		} while (idx < textLength);
 		charOffset++;
+
+		canvas->EndGlyphRuns();
+	}
+
+	void Font::SetupGlyphCommand(RenderCommand* command, Shader* colorizeShader, std::uint16_t layer)
+	{
+		command->SetType(RenderCommand::Type::Text);
+		bool shaderChanged = (colorizeShader
+			? command->GetMaterial().SetShader(colorizeShader)
+			: command->GetMaterial().SetShaderProgramType(Material::ShaderProgramType::Sprite));
+		if (shaderChanged) {
+			command->GetMaterial().ReserveUniformsDataMemory();
+			command->GetGeometry().SetDrawParameters(PrimitiveType::TriangleStrip, 0, 4);
+			// Required to reset render command properly
+			//command->SetTransformation(command->transformation());
+
+			auto* textureUniform = command->GetMaterial().Uniform(Material::TextureUniformName);
+			if (textureUniform && textureUniform->GetIntValue(0) != 0) {
+				textureUniform->SetIntValue(0); // GL_TEXTURE0
+			}
+		}
+
+		// Separate alpha blend so text (e.g. semi-transparent shadows) accumulates correct alpha coverage
+		// when drawn into an RGBA render target, harmless for opaque/RGB targets
+		command->GetMaterial().SetBlendingFactors(BlendingFactor::SrcAlpha, BlendingFactor::OneMinusSrcAlpha, BlendingFactor::One, BlendingFactor::OneMinusSrcAlpha);
+		command->SetLayer(layer);
+		command->GetMaterial().SetTexture(*_texture.get());
 	}
 
 	String Font::StripFormatting(StringView text)
@@ -55,6 +55,7 @@ namespace Jazz2::UI
 		 * @param palette  Palette used to colorize the font
 		 */
 		Font(const std::unique_ptr<Death::IO::Stream>& s, StringView path, const std::uint32_t* palette);
+		~Font();
 
 		/** @brief Returns font size in pixels */
 		std::int32_t GetSizeInPixels() const;
@@ -94,5 +95,7 @@ namespace Jazz2::UI
 
 		/** @brief Returns the glyph of the specified character, or the placeholder if the font doesn't have it */
 		const FontFormat::Glyph& GetGlyph(char32_t c) const;
+		/** @brief Sets up the material and the layer of a render command that draws glyphs */
+		void SetupGlyphCommand(RenderCommand* command, Shader* colorizeShader, std::uint16_t layer);
 	};
 }
\ No newline at end of file
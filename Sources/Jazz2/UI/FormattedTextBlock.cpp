@@ -1,12 +1,21 @@
 ﻿#include "FormattedTextBlock.h"
 
+#include <Cryptography/xxHash.h>
+
 using namespace Death::Containers;
 using namespace Death::Containers::Literals;
+using namespace Death::Cryptography;
 
 namespace Jazz2::UI
 {
-	FormattedTextBlock::Part::Part(std::uint32_t begin, std::uint32_t length, Vector2f location, float height, Colorf color, float scale, float charSpacing, bool allowVariance) noexcept
-		: Begin(begin), Length(length), Location(location), Height(height), CurrentColor(color), Scale(scale), CharSpacing(charSpacing), AllowVariance(allowVariance)
+	SmallVector<FormattedTextBlock::CachedLayout, 0> FormattedTextBlock::_cachedLayouts;
+	std::uint32_t FormattedTextBlock::_cachedLayoutsCounter = 0;
+	std::uint32_t FormattedTextBlock::_cachedLayoutsHits = 0;
+	std::uint32_t FormattedTextBlock::_cachedLayoutsMisses = 0;
+
+	FormattedTextBlock::Part::Part(std::uint32_t begin, std::uint32_t length, Vector2f location, float height, Colorf color, bool usesDefaultColor, float scale, float charSpacing, bool allowVariance) noexcept
+		: Begin(begin), Length(length), Location(location), Height(height), CurrentColor(color), Scale(scale), CharSpacing(charSpacing),
+			AllowVariance(allowVariance), UsesDefaultColor(usesDefaultColor)
 	{
 	}
 
@@ -20,6 +29,7 @@ namespace Jazz2::UI
 		Scale = other.Scale;
 		CharSpacing = other.CharSpacing;
 		AllowVariance = other.AllowVariance;
+		UsesDefaultColor = other.UsesDefaultColor;
 	}
 
 	FormattedTextBlock::Part::Part(Part&& other) noexcept
@@ -32,6 +42,7 @@ namespace Jazz2::UI
 		Scale = other.Scale;
 		CharSpacing = other.CharSpacing;
 		AllowVariance = other.AllowVariance;
+		UsesDefaultColor = other.UsesDefaultColor;
 	}
 
 	FormattedTextBlock::Part& FormattedTextBlock::Part::operator=(const Part& other) noexcept
@@ -44,6 +55,7 @@ namespace Jazz2::UI
 		Scale = other.Scale;
 		CharSpacing = other.CharSpacing;
 		AllowVariance = other.AllowVariance;
+		UsesDefaultColor = other.UsesDefaultColor;
 		return *this;
 	}
 
@@ -57,11 +69,12 @@ namespace Jazz2::UI
 		Scale = other.Scale;
 		CharSpacing = other.CharSpacing;
 		AllowVariance = other.AllowVariance;
+		UsesDefaultColor = other.UsesDefaultColor;
 		return *this;
 	}
 
-	FormattedTextBlock::BackgroundPart::BackgroundPart(Colorf color)
-		: CurrentColor(color)
+	FormattedTextBlock::BackgroundPart::BackgroundPart(Colorf color, bool usesDefaultColor)
+		: CurrentColor(color), UsesDefaultColor(usesDefaultColor)
 	{
 	}
 
@@ -155,6 +168,9 @@ namespace Jazz2::UI
 
 		std::int32_t charOffsetShadow = charOffset;
 
+		// The shadows and the text of all parts are then submitted together, each as a few glyph runs
+		canvas->BeginGlyphRuns();
+
 		auto it = _parts.begin();
 		while (it != _parts.end()) {
 			if (it->Location.Y + it->Height > bounds.H) {
@@ -188,10 +204,12 @@ namespace Jazz2::UI
 			// building a String here heap-allocated and copied every part of every frame for nothing
 			StringView textPart = (it->Begin == Ellipsis ? "..."_s : StringView(_text.data() + it->Begin, it->Length));
 			_font->DrawString(canvas, textPart, charOffset, p.X, p.Y, depth, Alignment::Left,
-				it->CurrentColor, it->Scale, it->AllowVariance ? angleOffset : 0.0f, varianceX, varianceY, speed, it->CharSpacing);
+				it->UsesDefaultColor ? _defaultColor : it->CurrentColor, it->Scale, it->AllowVariance ? angleOffset : 0.0f, varianceX, varianceY, speed, it->CharSpacing);
 
 			++it;
 		}
+
+		canvas->EndGlyphRuns();
 	}
 
 	Vector2f FormattedTextBlock::MeasureSize(Vector2f proposedSize)
@@ -236,11 +254,60 @@ namespace Jazz2::UI
 		_parts.clear();
 		_background.clear();
 
+		// Blocks are often recreated or switched back to a text they had before, so the layout may be already known
+		std::uint64_t fingerprint = GetLayoutFingerprint();
+		for (CachedLayout& layout : _cachedLayouts) {
+			if (IsSameLayout(layout, fingerprint)) {
+				layout.LastUsed = ++_cachedLayoutsCounter;
+				_parts.assign(layout.Parts);
+				_background.assign(layout.Background);
+				_cachedWidth = layout.CachedWidth;
+				_flags |= (layout.Flags & FormattedTextBlockFlags::Ellipsized);
+				_cachedLayoutsHits++;
+				return;
+			}
+		}
+
+		_cachedLayoutsMisses++;
+		ComputeLayout();
+
+		CachedLayout* target;
+		if (_cachedLayouts.size() < MaxCachedLayouts) {
+			target = &_cachedLayouts.emplace_back();
+		} else {
+			// Replace the least recently used layout
+			target = &_cachedLayouts[0];
+			for (CachedLayout& layout : _cachedLayouts) {
+				if (target->LastUsed > layout.LastUsed) {
+					target = &layout;
+				}
+			}
+		}
+
+		target->Fingerprint = fingerprint;
+		target->LastUsed = ++_cachedLayoutsCounter;
+		target->TextFont = _font;
+		target->ProposedWidth = _proposedWidth;
+		target->Scale = _defaultScale;
+		target->CharSpacing = _defaultCharSpacing;
+		target->LineSpacing = _defaultLineSpacing;
+		target->Align = _alignment;
+		target->Flags = _flags;
+		target->Text = _text;
+		target->Parts.assign(_parts);
+		target->Background.assign(_background);
+		target->CachedWidth = _cachedWidth;
+	}
+
+	void FormattedTextBlock::ComputeLayout()
+	{
 		char* unprocessedText = _text.data();
 		std::int32_t unprocessedLength = (std::int32_t)_text.size();
 		SmallVector<float, 1000> charFitWidths(DefaultInit, unprocessedLength + 1);
 
+		// Parts in the default color only keep the flag, the color itself is resolved in Draw()
 		Colorf currentColor = _defaultColor;
+		bool usesDefaultColor = true;
 		float scale = _defaultScale;
 		float charSpacing = _defaultCharSpacing;
 		float lineSpacing = _defaultLineSpacing;
@@ -308,6 +375,7 @@ namespace Jazz2::UI
 
 									// Swap red and blue channel, because Color stores it in 0xAABBGGRR format internally
 									currentColor = Uint32ToColorf(color);
+									usesDefaultColor = false;
 								}
 								break;
 							case 'u': // Underline
@@ -412,6 +480,7 @@ namespace Jazz2::UI
 										}
 										case 'c': {
 											currentColor = _defaultColor;
+											usesDefaultColor = true;
 											break;
 										}
 										case 'r': {
@@ -546,7 +615,7 @@ namespace Jazz2::UI
 				char* toPtr = (nextPtr[0] == L'\n' && nextPtr[-1] == L'\r' ? nextPtr - 1 : nextPtr);
 				std::int32_t partLength = (std::int32_t)(toPtr - unprocessedText);
 				Part& part = _parts.emplace_back((std::uint32_t)(unprocessedText - _text.data()), partLength, currentLocation,
-					size.Y * lineSpacing, currentColor, scale, charSpacing,
+					size.Y * lineSpacing, currentColor, usesDefaultColor, scale, charSpacing,
 					styleCount[(std::int32_t)StyleIndex::AllowVariance] > 0);
 
 				if (nextPtr[0] == L'\n') {
@@ -603,7 +672,7 @@ namespace Jazz2::UI
 						if (charFit > 2) {
 							charFit -= 2;
 							Part& part = _parts.emplace_back((std::uint32_t)(unprocessedText - _text.data()), charFit, currentLocation,
-								size.Y * lineSpacing, currentColor, scale, charSpacing,
+								size.Y * lineSpacing, currentColor, usesDefaultColor, scale, charSpacing,
 								styleCount[(std::int32_t)StyleIndex::AllowVariance] > 0);
 
 							if (styleCount[(std::int32_t)StyleIndex::DottedUnderline] > 0) {
@@ -614,7 +683,7 @@ namespace Jazz2::UI
 							maxWidth -= charFitWidths[charFit - 1];
 						}
 
-						InsertEllipsis(currentLocation, currentColor, scale, charSpacing, lineSpacing,
+						InsertEllipsis(currentLocation, currentColor, usesDefaultColor, scale, charSpacing, lineSpacing,
 							styleCount[(std::int32_t)StyleIndex::AllowVariance] > 0, maxWidth, charFitWidths.data());
 						skipTill = SkipTill::EndOfHighlight;
 						continue;
@@ -672,7 +741,7 @@ namespace Jazz2::UI
 						if (lastWhitespacePtr != nullptr) {
 							std::int32_t partLength = (std::int32_t)(lastWhitespacePtr - unprocessedText);
 							Part& part = _parts.emplace_back((std::uint32_t)(unprocessedText - _text.data()), partLength, currentLocation,
-								size.Y * lineSpacing, currentColor, scale, charSpacing,
+								size.Y * lineSpacing, currentColor, usesDefaultColor, scale, charSpacing,
 								styleCount[(std::int32_t)StyleIndex::AllowVariance] > 0);
 
 							if (styleCount[(std::int32_t)StyleIndex::DottedUnderline] > 0) {
@@ -713,7 +782,7 @@ namespace Jazz2::UI
 					if (charFit > 2) {
 						charFit -= 2;
 						Part& part = _parts.emplace_back((std::uint32_t)(unprocessedText - _text.data()), charFit, currentLocation,
-							size.Y * lineSpacing, currentColor, scale, charSpacing,
+							size.Y * lineSpacing, currentColor, usesDefaultColor, scale, charSpacing,
 							styleCount[(std::int32_t)StyleIndex::AllowVariance] > 0);
 
 						if (styleCount[(std::int32_t)StyleIndex::DottedUnderline] > 0) {
@@ -724,7 +793,7 @@ namespace Jazz2::UI
 						maxWidth -= charFitWidths[charFit - 1];
 					}
 
-					InsertEllipsis(currentLocation, currentColor, scale, charSpacing, lineSpacing,
+					InsertEllipsis(currentLocation, currentColor, usesDefaultColor, scale, charSpacing, lineSpacing,
 						styleCount[(std::int32_t)StyleIndex::AllowVariance] > 0, maxWidth, charFitWidths.data());
 					_flags |= FormattedTextBlockFlags::Ellipsized;
 
@@ -812,13 +881,13 @@ namespace Jazz2::UI
 		lineBeginIndex = (std::int32_t)_parts.size();
 	}
 
-	void FormattedTextBlock::InsertEllipsis(Vector2f& currentLocation, Colorf currentColor, float scale, float charSpacing, float lineSpacing, bool allowVariance, float maxWidth, float* charFitWidths)
+	void FormattedTextBlock::InsertEllipsis(Vector2f& currentLocation, Colorf currentColor, bool usesDefaultColor, float scale, float charSpacing, float lineSpacing, bool allowVariance, float maxWidth, float* charFitWidths)
 	{
 		std::int32_t charFit;
 		Vector2f size = _font->MeasureStringEx("..."_s, scale, charSpacing, maxWidth, &charFit, charFitWidths);
 		if (charFit > 0) {
 			_parts.emplace_back(Ellipsis, charFit, currentLocation,
-				size.Y * lineSpacing, currentColor, scale, charSpacing, allowVariance);
+				size.Y * lineSpacing, currentColor, usesDefaultColor, scale, charSpacing, allowVariance);
 			currentLocation.X += charFitWidths[charFit - 1];
 		}
 	}
@@ -829,7 +898,7 @@ namespace Jazz2::UI
 		// Max. thickness is 5px, because it's shared also with rounded rectangles (with height >= 6px)
 		std::int32_t thickness = std::clamp<std::int32_t>(ascent / 16, 1, 5);
 
-		BackgroundPart& underline = _background.emplace_back(part.CurrentColor);
+		BackgroundPart& underline = _background.emplace_back(part.CurrentColor, part.UsesDefaultColor);
 		underline.Bounds.X = part.Location.X;
 		underline.Bounds.Y = part.Location.Y + ((part.Height + ascent + 1) / 2) - thickness; // Perfectly aligned with Segoe UI font
 		underline.Bounds.W = width;
@@ -894,13 +963,8 @@ namespace Jazz2::UI
 
 	void FormattedTextBlock::SetDefaultColor(Colorf color)
 	{
-		if (_defaultColor == color) {
-			return;
-		}
-
+		// The layout doesn't depend on the default color, so it's kept
 		_defaultColor = color;
-		_parts.clear();
-		_background.clear();
 	}
 
 	void FormattedTextBlock::SetFont(Font* value)
@@ -1007,6 +1071,40 @@ namespace Jazz2::UI
 		_background.clear();
 	}
 
+	FormattedTextBlockCacheStatistics FormattedTextBlock::GetLayoutCacheStatistics()
+	{
+		return { _cachedLayoutsHits, _cachedLayoutsMisses, (std::uint32_t)_cachedLayouts.size(), MaxCachedLayouts };
+	}
+
+	void FormattedTextBlock::DiscardCachedLayouts(const Font* font)
+	{
+		for (std::size_t i = 0; i < _cachedLayouts.size(); ) {
+			if (_cachedLayouts[i].TextFont == font) {
+				_cachedLayouts.erase(&_cachedLayouts[i]);
+			} else {
+				i++;
+			}
+		}
+	}
+
+	std::uint64_t FormattedTextBlock::GetLayoutFingerprint() const
+	{
+		// Everything the layout depends on besides the text is mixed into the seed
+		float params[] = { _proposedWidth, _defaultScale, _defaultCharSpacing, _defaultLineSpacing };
+		std::uint64_t seed = xxHash3(params, sizeof(params), (std::uint64_t)(std::uintptr_t)_font);
+		seed ^= ((std::uint64_t)_alignment << 32) | (std::uint64_t)(_flags & FormattedTextBlockFlags::LayoutMask);
+		return xxHash3(_text.data(), _text.size(), seed);
+	}
+
+	bool FormattedTextBlock::IsSameLayout(const CachedLayout& layout, std::uint64_t fingerprint) const
+	{
+		// The fingerprint rejects almost all other layouts without touching the text
+		return (layout.Fingerprint == fingerprint && layout.TextFont == _font && layout.ProposedWidth == _proposedWidth &&
+			layout.Scale == _defaultScale && layout.CharSpacing == _defaultCharSpacing && layout.LineSpacing == _defaultLineSpacing &&
+			layout.Align == _alignment && (layout.Flags & FormattedTextBlockFlags::LayoutMask) == (_flags & FormattedTextBlockFlags::LayoutMask) &&
+			layout.Text == _text);
+	}
+
 	Colorf FormattedTextBlock::Uint32ToColorf(std::uint32_t value)
 	{
 		return Colorf((float)((value & 0x00ff0000) >> 16) / 255.0f, (float)((value & 0x0000ff00) >> 8) / 255.0f,
@@ -39,12 +39,34 @@ namespace Jazz2::UI
 		float LineSpacing = 1.0f;
 	};
 
+	/**
+		@brief Statistics of the layout cache shared by all formatted text blocks
+
+		See @ref FormattedTextBlock::GetLayoutCacheStatistics().
+	*/
+	struct FormattedTextBlockCacheStatistics
+	{
+		/** @brief Number of layouts restored from the cache since the start */
+		std::uint32_t Hits;
+		/** @brief Number of layouts that had to be computed since the start */
+		std::uint32_t Misses;
+		/** @brief Number of layouts currently held in the cache */
+		std::uint32_t Entries;
+		/** @brief Maximum number of layouts held in the cache */
+		std::uint32_t Capacity;
+	};
+
 	/**
 		@brief Formatted text block
 		
 		Lays out and renders a block of rich text to a canvas, splitting it into parts according to inline formatting,
 		alignment, scale, and spacing. It supports multiline layout with optional word wrapping and ellipsizing to fit
 		given bounds, and caches the computed layout for repeated drawing and measurement.
+
+		Computed layouts are also kept in a small cache shared by all instances, keyed by the text, font, scale,
+		spacing, alignment, proposed width and layout flags, so a block that is recreated or changed back to
+		a text it had before (e.g. chat lines or scoreboard rows rebuilt every frame) only has to copy the layout.
+		The default color is not part of the layout, it's resolved only when the text is drawn.
 	*/
 	class FormattedTextBlock
 	{
@@ -157,6 +179,11 @@ namespace Jazz2::UI
 			return (_flags & FormattedTextBlockFlags::Ellipsized) == FormattedTextBlockFlags::Ellipsized;
 		}
 
+		/** @brief Returns statistics of the layout cache shared by all instances */
+		static FormattedTextBlockCacheStatistics GetLayoutCacheStatistics();
+		/** @brief Removes all cached layouts that were computed with the specified font */
+		static void DiscardCachedLayouts(const Font* font);
+
 	private:
 		static constexpr std::uint32_t Ellipsis = UINT32_MAX;
 
@@ -172,8 +199,10 @@ namespace Jazz2::UI
 			float Scale;
 			float CharSpacing;
 			bool AllowVariance;
+			// The default color of the block is used instead of CurrentColor, so it can change without a new layout
+			bool UsesDefaultColor;
 
-			Part(std::uint32_t begin, std::uint32_t length, Vector2f location, float height, Colorf color, float scale, float charSpacing, bool allowVariance) noexcept;
+			Part(std::uint32_t begin, std::uint32_t length, Vector2f location, float height, Colorf color, bool usesDefaultColor, float scale, float charSpacing, bool allowVariance) noexcept;
 			
 			Part(const Part& other) noexcept;
 			Part(Part&& other) noexcept;
@@ -185,8 +214,9 @@ namespace Jazz2::UI
 		{
 			Rectf Bounds;
 			Colorf CurrentColor;
+			bool UsesDefaultColor;
 
-			BackgroundPart(Colorf color);
+			BackgroundPart(Colorf color, bool usesDefaultColor = false);
 		};
 #endif
 
@@ -195,11 +225,40 @@ namespace Jazz2::UI
 			Multiline = 0x01,
 			Wrapping = 0x02,
 
-			Ellipsized = 0x10
+			Ellipsized = 0x10,
+
+			LayoutMask = Multiline | Wrapping
 		};
 
 		DEATH_PRIVATE_ENUM_FLAGS(FormattedTextBlockFlags);
 
+		static constexpr std::uint32_t MaxCachedLayouts = 64;
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+		// Doxygen 1.12.0 outputs also private structs/unions even if it shouldn't
+		struct CachedLayout
+		{
+			std::uint64_t Fingerprint;
+			std::uint32_t LastUsed;
+			const Font* TextFont;
+			float ProposedWidth;
+			float Scale;
+			float CharSpacing;
+			float LineSpacing;
+			Alignment Align;
+			FormattedTextBlockFlags Flags;
+			String Text;
+			SmallVector<Part, 0> Parts;
+			SmallVector<BackgroundPart, 0> Background;
+			float CachedWidth;
+		};
+#endif
+
+		static SmallVector<CachedLayout, 0> _cachedLayouts;
+		static std::uint32_t _cachedLayoutsCounter;
+		static std::uint32_t _cachedLayoutsHits;
+		static std::uint32_t _cachedLayoutsMisses;
+
 		SmallVector<Part, 1> _parts;
 		SmallVector<BackgroundPart, 0> _background;
 		Font* _font;
@@ -214,8 +273,11 @@ namespace Jazz2::UI
 		Alignment _alignment;
 
 		void RecreateCache();
+		void ComputeLayout();
+		std::uint64_t GetLayoutFingerprint() const;
+		bool IsSameLayout(const CachedLayout& layout, std::uint64_t fingerprint) const;
 		void HandleEndOfLine(Vector2f currentLocation, std::int32_t& lineBeginIndex, std::int32_t& lineAlignIndex, std::int32_t& backgroundIndex);
-		void InsertEllipsis(Vector2f& currentLocation, Colorf currentColor, float scale, float charSpacing, float lineSpacing, bool allowVariance, float maxWidth, float* charFitWidths);
+		void InsertEllipsis(Vector2f& currentLocation, Colorf currentColor, bool usesDefaultColor, float scale, float charSpacing, float lineSpacing, bool allowVariance, float maxWidth, float* charFitWidths);
 		void InsertDottedUnderline(Part& part, float width);
 
 		static float PerformVerticalAlignment(SmallVectorImpl<Part>& processedParts, std::int32_t firstPartOfLine);
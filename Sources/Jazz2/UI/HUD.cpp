@@ -13,6 +13,10 @@
 #include "../../nCine/I18n.h"
 #include "../../nCine/Graphics/RenderQueue.h"
 
+#if defined(WITH_RHI_SOFTWARE)
+#	include "../../nCine/Graphics/RHI/Rhi.h"
+#endif
+
 #if defined(DEATH_TARGET_ANDROID)
 #	include "../../nCine/Backends/Android/AndroidApplication.h"
 #endif
@@ -260,15 +264,26 @@ namespace Jazz2::UI
 
 		// Performance Metrics
 		if (PreferencesCache::ShowPerformanceMetrics) {
-			i32tos((std::int32_t)std::round(theApplication().GetFrameTimer().GetAverageFps()), stringBuffer);
+			float metricsX = view.W - 4.0f;
+			float metricsY = view.Y + 1.0f;
 #if defined(DEATH_TARGET_ANDROID)
 			if (static_cast<AndroidApplication&>(theApplication()).IsScreenRound()) {
-				_smallFont->DrawString(this, stringBuffer, charOffset, view.W / 2 + 40.0f, view.Y + 6.0f, FontLayer,
-					Alignment::TopRight, Font::DefaultColor, 0.8f, 0.0f, 0.0f, 0.0f, 0.0f, 0.96f);
-			} else
+				metricsX = view.W / 2 + 40.0f;
+				metricsY = view.Y + 6.0f;
+			}
 #endif
-			_smallFont->DrawString(this, stringBuffer, charOffset, view.W - 4.0f, view.Y + 1.0f, FontLayer,
+			i32tos((std::int32_t)std::round(theApplication().GetFrameTimer().GetAverageFps()), stringBuffer);
+			_smallFont->DrawString(this, stringBuffer, charOffset, metricsX, metricsY, FontLayer,
 				Alignment::TopRight, Font::DefaultColor, 0.8f, 0.0f, 0.0f, 0.0f, 0.0f, 0.96f);
+
+#if defined(WITH_RHI_SOFTWARE)
+			// Current resolution scale of the software renderer under dynamic resolution scaling
+			if (PreferencesCache::DynamicResolutionTarget > 0.0f) {
+				std::size_t length = formatInto(stringBuffer, "{}%", (std::int32_t)std::round(RHI::Device::GetRenderScale() * 100.0f));
+				_smallFont->DrawString(this, { stringBuffer, length }, charOffset, metricsX, metricsY + 12.0f, FontLayer,
+					Alignment::TopRight, Font::DefaultColor, 0.8f, 0.0f, 0.0f, 0.0f, 0.0f, 0.96f);
+			}
+#endif
 		}
 
 		if (_transitionState >= TransitionState::WaitingForFadeIn && _transitionState <= TransitionState::FadeOut) {
@@ -110,6 +110,9 @@ namespace Jazz2::UI::Menu
 			}
 		};
 
+		// All text of the screen shares a few glyph runs instead of each string submitting its own
+		canvas->BeginGlyphRuns();
+
 		if (_transition.IsActive()) {
 			// Draw the outgoing section first, then the incoming one, each with its own animated transform
 			if (auto* outgoing = _transition.GetOutgoing()) {
@@ -124,6 +127,8 @@ namespace Jazz2::UI::Menu
 		} else if (!_sections.empty()) {
 			drawOne(_sections.back().get(), canvas);
 		}
+
+		canvas->EndGlyphRuns();
 	}
 
 	void MenuContainerBase::UpdateActiveSection(float timeMult)
@@ -0,0 +1,154 @@
+// Replays cached metadata requests of a spawn-heavy scene by string key and by resource ID and compares their time and results
+// Built with -DNCINE_BUILD_BENCHMARKS=ON, usage: ResourceIdBenchmark [--spawns <count>] [--frames <count>]
+
+#include "Jazz2/ResourceId.h"
+#include "nCine/Base/HashMap.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <Containers/String.h>
+#include <Containers/StringConcatenable.h>
+
+using namespace Death::Containers::Literals;
+using namespace Jazz2;
+using namespace nCine;
+
+namespace
+{
+	struct Entry
+	{
+		std::uint32_t LastUsed;
+	};
+
+	static constexpr ResourceId FrequentIds[] = {
+		"Common/Explosions"_s, "Weapon/Blaster"_s, "Weapon/Bouncer"_s, "Weapon/Freezer"_s, "Weapon/Seeker"_s,
+		"Weapon/RF"_s, "Weapon/Toaster"_s, "Weapon/TNT"_s, "Weapon/Pepper"_s, "Weapon/Electro"_s
+	};
+
+	static constexpr StringView OtherPaths[] = {
+		"Enemy/Turtle"_s, "Enemy/LabRat"_s, "Enemy/Lizard"_s, "Enemy/Sucker"_s, "Enemy/SuckerFloat"_s,
+		"Collectible/Gems"_s, "Collectible/Coins"_s, "Object/PowerUpMonitor"_s, "Object/BonusBirdChuck"_s,
+		"Interactive/PlayerJazz"_s, "Interactive/PlayerSpaz"_s, "Interactive/PlayerLori"_s
+	};
+
+	constexpr std::int32_t FrequentCount = sizeof(FrequentIds) / sizeof(FrequentIds[0]);
+	constexpr std::int32_t OtherCount = sizeof(OtherPaths) / sizeof(OtherPaths[0]);
+
+	struct IdEntry
+	{
+		Entry* Resource;
+		String Path;
+	};
+
+	// Mirrors ContentResolver caches, the string-keyed cache and the index by resource ID
+	HashMap<String, Entry*> _cachedByPath;
+	HashMap<std::uint64_t, IdEntry, ResourceIdHash> _cachedById;
+	std::uint32_t _usageClock;
+
+	Entry* RequestByPath(StringView path, bool forceIndexed)
+	{
+		String cacheKey = (forceIndexed ? String(path + "*"_s) : String(path));
+		auto it = _cachedByPath.find(cacheKey);
+		if (it == _cachedByPath.end()) {
+			return nullptr;
+		}
+		it->second->LastUsed = ++_usageClock;
+		return it->second;
+	}
+
+	Entry* RequestById(const ResourceId& id, bool forceIndexed)
+	{
+		auto it = _cachedById.find(forceIndexed ? ~id.GetHash() : id.GetHash());
+		if (it == _cachedById.end() || !id.Matches(it->second.Path)) {
+			return nullptr;
+		}
+		it->second.Resource->LastUsed = ++_usageClock;
+		return it->second.Resource;
+	}
+
+	// Every tenth spawn is something else than a shot or an explosion, players request the indexed variant
+	template<class TFrequent, class TOther>
+	std::uintptr_t Replay(std::int32_t spawns, std::int32_t frames, TFrequent&& requestFrequent, TOther&& requestOther)
+	{
+		std::uintptr_t checksum = 0;
+		std::uint32_t state = 0x9E3779B9u;
+		for (std::int32_t frame = 0; frame < frames; frame++) {
+			for (std::int32_t i = 0; i < spawns; i++) {
+				state ^= state << 13;
+				state ^= state >> 17;
+				state ^= state << 5;
+				if ((state % 10) != 0) {
+					checksum += (std::uintptr_t)requestFrequent(FrequentIds[(state >> 8) % FrequentCount]);
+				} else {
+					std::int32_t index = (state >> 8) % OtherCount;
+					checksum += (std::uintptr_t)requestOther(OtherPaths[index], OtherPaths[index].hasPrefix("Interactive/"_s));
+				}
+			}
+		}
+		return checksum;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::int32_t spawns = 200;
+	std::int32_t frames = 20000;
+	for (std::int32_t i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--spawns") == 0 && i + 1 < argc) {
+			spawns = std::atoi(argv[++i]);
+		} else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			frames = std::atoi(argv[++i]);
+		} else {
+			std::fprintf(stderr, "Usage: %s [--spawns <count>] [--frames <count>]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	static Entry entries[2 * (FrequentCount + OtherCount)] = { };
+	std::int32_t entryCount = 0;
+	auto addEntry = [&entryCount](const ResourceId& id, bool forceIndexed) {
+		Entry* entry = &entries[entryCount++];
+		_cachedByPath.emplace(forceIndexed ? String(id.GetPath() + "*"_s) : String(id.GetPath()), entry);
+		_cachedById.emplace(forceIndexed ? ~id.GetHash() : id.GetHash(), IdEntry{entry, id.GetPath()});
+	};
+	for (const auto& id : FrequentIds) {
+		addEntry(id, false);
+	}
+	for (const auto& path : OtherPaths) {
+		addEntry(path, false);
+		addEntry(path, true);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	std::uintptr_t byPath = Replay(spawns, frames,
+		[](const ResourceId& id) { return RequestByPath(id.GetPath(), false); },
+		[](StringView path, bool forceIndexed) { return RequestByPath(path, forceIndexed); });
+	double byPathMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	start = std::chrono::steady_clock::now();
+	std::uintptr_t byId = Replay(spawns, frames,
+		[](const ResourceId& id) { return RequestById(id, false); },
+		[](StringView path, bool forceIndexed) { return RequestById(path, forceIndexed); });
+	double byIdMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	// Every request hashes its path at the call site, as if no ID was declared constexpr
+	start = std::chrono::steady_clock::now();
+	std::uintptr_t byDynamicId = Replay(spawns, frames,
+		[](const ResourceId& id) { return RequestById(id.GetPath(), false); },
+		[](StringView path, bool forceIndexed) { return RequestById(path, forceIndexed); });
+	double byDynamicIdMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	bool matches = (byPath == byId && byPath == byDynamicId);
+	std::int64_t requests = (std::int64_t)spawns * frames;
+
+	std::printf("%d spawns per frame, %d frames, %lld requests\n", spawns, frames, (long long)requests);
+	std::printf("  string cache key:  %8.3f ms total, %6.2f ns/request\n", byPathMs, byPathMs * 1e6 / requests);
+	std::printf("  constexpr ID:      %8.3f ms total, %6.2f ns/request (%.2fx)\n", byIdMs, byIdMs * 1e6 / requests, byPathMs / byIdMs);
+	std::printf("  dynamic ID:        %8.3f ms total, %6.2f ns/request (%.2fx)\n", byDynamicIdMs, byDynamicIdMs * 1e6 / requests, byPathMs / byDynamicIdMs);
+	std::printf("  results %s\n", matches ? "match" : "DIFFER");
+	return (matches ? 0 : 1);
+}
@@ -24,6 +24,7 @@
 #include "nCine/IAppEventHandler.h"
 #include "nCine/tracy.h"
 #include "nCine/Base/Random.h"
+#include "nCine/Base/TimeStamp.h"
 #include "nCine/Graphics/BinaryShaderCache.h"
 #include "nCine/Graphics/RenderResources.h"
 #include "nCine/Input/IInputEventHandler.h"
@@ -58,6 +59,10 @@
 using namespace Jazz2::Multiplayer;
 #endif
 
+#if defined(WITH_RHI_SOFTWARE)
+#	include "nCine/Graphics/RHI/Rhi.h"
+#endif
+
 #if defined(DEATH_TRACE) && (defined(DEATH_TARGET_APPLE) || defined(DEATH_TARGET_UNIX))
 #	include "TermLogo.h"
 #endif
@@ -1805,6 +1810,13 @@ void GameEventHandler::OnBeginInitialize()
 	}
 #endif
 
+#if defined(WITH_RHI_SOFTWARE)
+	if (PreferencesCache::DynamicResolutionTarget > 0.0f) {
+		RHI::Device::SetDynamicResolution(PreferencesCache::DynamicResolutionTarget,
+			PreferencesCache::DynamicResolutionMinScale, PreferencesCache::DynamicResolutionMaxScale);
+	}
+#endif
+
 	resolver.CompileShaders();
 }
 
@@ -1992,6 +2004,7 @@ RecreateCache:
 	}
 
 	fs::CreateDirectories(resolver.GetCachePath());
+	TimeStamp conversionStarted = TimeStamp::now();
 
 	// Delete cache from previous versions
 	String animationsPath = fs::CombinePath(resolver.GetCachePath(), "Animations"_s);
@@ -2022,7 +2035,7 @@ RecreateCache:
 
 	RefreshCacheLevels(true);
 
-	LOGI("Cache was recreated");
+	LOGI("Cache was recreated in {:.1f} s", conversionStarted.secondsSince());
 	std::int64_t animsModified = fs::GetLastModificationTime(animsPath).ToUnixMilliseconds();
 	WriteCacheDescriptor(cachePath, currentVersion, animsModified);
 
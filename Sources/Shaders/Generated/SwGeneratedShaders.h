@@ -2548,7 +2548,7 @@ void BatchedWhiteMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentS
 
 		struct SwGeneratedUniformField { const char* name; std::uint32_t offset; std::uint32_t componentCount; };
 		using SwGeneratedComputeVaryingsFn = void (*)(void* inputs, const std::uint8_t* instanceBlock);
-		struct SwGeneratedShaderInfo { const char* name; nCine::RHI::Software::FragmentShaderFn fragment; std::uint32_t uniformsSize; const SwGeneratedUniformField* uniformFields; std::uint32_t uniformFieldCount; SwGeneratedComputeVaryingsFn computeVaryings; };
+		struct SwGeneratedShaderInfo { const char* name; nCine::RHI::Software::FragmentShaderFn fragment; nCine::RHI::Software::FragmentShaderSpanFn fragmentSpan; std::uint32_t uniformsSize; const SwGeneratedUniformField* uniformFields; std::uint32_t uniformFieldCount; SwGeneratedComputeVaryingsFn computeVaryings; };
 
 		const SwGeneratedUniformField Blur_Fields[] = {
 			{ "uPixelOffset", (std::uint32_t)offsetof(Blur_Uniforms, uPixelOffset), 2 },
@@ -2593,55 +2593,55 @@ void BatchedWhiteMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentS
 		};
 
 		const SwGeneratedShaderInfo SwGeneratedShaders[] = {
-			{ "BatchedShieldFire", &BatchedShieldFire_Fragment, (std::uint32_t)sizeof(BatchedShieldFire_Uniforms), nullptr, 0, &BatchedShieldFire_ComputeVaryings },
-			{ "BatchedShieldLightning", &BatchedShieldLightning_Fragment, (std::uint32_t)sizeof(BatchedShieldLightning_Uniforms), nullptr, 0, &BatchedShieldLightning_ComputeVaryings },
-			{ "Blur", &Blur_Fragment, (std::uint32_t)sizeof(Blur_Uniforms), Blur_Fields, 2, nullptr },
-			{ "Colorized", &Colorized_Fragment, (std::uint32_t)sizeof(Colorized_Uniforms), nullptr, 0, nullptr },
-			{ "BatchedColorized", &BatchedColorized_Fragment, (std::uint32_t)sizeof(BatchedColorized_Uniforms), nullptr, 0, nullptr },
-			{ "Combine", &Combine_Fragment, (std::uint32_t)sizeof(Combine_Uniforms), Combine_Fields, 2, &Combine_ComputeVaryings },
-			{ "CombineWithWaterLow", &CombineWithWaterLow_Fragment, (std::uint32_t)sizeof(CombineWithWaterLow_Uniforms), CombineWithWaterLow_Fields, 4, &CombineWithWaterLow_ComputeVaryings },
-			{ "DefaultBatchedMeshSprites", &DefaultBatchedMeshSprites_Fragment, (std::uint32_t)sizeof(DefaultBatchedMeshSprites_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultBatchedMeshSpritesNoTexture", &DefaultBatchedMeshSpritesNoTexture_Fragment, (std::uint32_t)sizeof(DefaultBatchedMeshSpritesNoTexture_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultBatchedSpritesNoTexture", &DefaultBatchedSpritesNoTexture_Fragment, (std::uint32_t)sizeof(DefaultBatchedSpritesNoTexture_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultImGui", &DefaultImGui_Fragment, (std::uint32_t)sizeof(DefaultImGui_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultMeshSprite", &DefaultMeshSprite_Fragment, (std::uint32_t)sizeof(DefaultMeshSprite_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultMeshSpriteNoTexture", &DefaultMeshSpriteNoTexture_Fragment, (std::uint32_t)sizeof(DefaultMeshSpriteNoTexture_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultSprite", &DefaultSprite_Fragment, (std::uint32_t)sizeof(DefaultSprite_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultBatchedSprites", &DefaultBatchedSprites_Fragment, (std::uint32_t)sizeof(DefaultBatchedSprites_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultSpriteNoTexture", &DefaultSpriteNoTexture_Fragment, (std::uint32_t)sizeof(DefaultSpriteNoTexture_Uniforms), nullptr, 0, nullptr },
-			{ "Downsample", &Downsample_Fragment, (std::uint32_t)sizeof(Downsample_Uniforms), Downsample_Fields, 1, nullptr },
-			{ "FrozenMask", &FrozenMask_Fragment, (std::uint32_t)sizeof(FrozenMask_Uniforms), nullptr, 0, nullptr },
-			{ "FrozenMask_USE_PALETTE", &FrozenMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(FrozenMask_USE_PALETTE_Uniforms), nullptr, 0, &FrozenMask_USE_PALETTE_ComputeVaryings },
-			{ "BatchedFrozenMask", &BatchedFrozenMask_Fragment, (std::uint32_t)sizeof(BatchedFrozenMask_Uniforms), nullptr, 0, nullptr },
-			{ "BatchedFrozenMask_USE_PALETTE", &BatchedFrozenMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(BatchedFrozenMask_USE_PALETTE_Uniforms), nullptr, 0, &BatchedFrozenMask_USE_PALETTE_ComputeVaryings },
-			{ "Outline", &Outline_Fragment, (std::uint32_t)sizeof(Outline_Uniforms), nullptr, 0, nullptr },
-			{ "BatchedOutline", &BatchedOutline_Fragment, (std::uint32_t)sizeof(BatchedOutline_Uniforms), nullptr, 0, nullptr },
-			{ "OutlinePalette", &OutlinePalette_Fragment, (std::uint32_t)sizeof(OutlinePalette_Uniforms), nullptr, 0, &OutlinePalette_ComputeVaryings },
-			{ "BatchedOutlinePalette", &BatchedOutlinePalette_Fragment, (std::uint32_t)sizeof(BatchedOutlinePalette_Uniforms), nullptr, 0, &BatchedOutlinePalette_ComputeVaryings },
-			{ "PaletteRemap", &PaletteRemap_Fragment, (std::uint32_t)sizeof(PaletteRemap_Uniforms), nullptr, 0, &PaletteRemap_ComputeVaryings },
-			{ "BatchedPaletteRemap", &BatchedPaletteRemap_Fragment, (std::uint32_t)sizeof(BatchedPaletteRemap_Uniforms), nullptr, 0, &BatchedPaletteRemap_ComputeVaryings },
-			{ "PartialWhiteMask", &PartialWhiteMask_Fragment, (std::uint32_t)sizeof(PartialWhiteMask_Uniforms), nullptr, 0, nullptr },
-			{ "PartialWhiteMask_USE_PALETTE", &PartialWhiteMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(PartialWhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &PartialWhiteMask_USE_PALETTE_ComputeVaryings },
-			{ "BatchedPartialWhiteMask", &BatchedPartialWhiteMask_Fragment, (std::uint32_t)sizeof(BatchedPartialWhiteMask_Uniforms), nullptr, 0, nullptr },
-			{ "BatchedPartialWhiteMask_USE_PALETTE", &BatchedPartialWhiteMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(BatchedPartialWhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &BatchedPartialWhiteMask_USE_PALETTE_ComputeVaryings },
-			{ "ResizeCrtApertureGrille", &ResizeCrtApertureGrille_Fragment, (std::uint32_t)sizeof(ResizeCrtApertureGrille_Uniforms), nullptr, 0, &ResizeCrtApertureGrille_ComputeVaryings },
-			{ "ResizeCrtShadowMask", &ResizeCrtShadowMask_Fragment, (std::uint32_t)sizeof(ResizeCrtShadowMask_Uniforms), nullptr, 0, &ResizeCrtShadowMask_ComputeVaryings },
-			{ "ShieldFire", &ShieldFire_Fragment, (std::uint32_t)sizeof(ShieldFire_Uniforms), nullptr, 0, &ShieldFire_ComputeVaryings },
-			{ "ShieldLightning", &ShieldLightning_Fragment, (std::uint32_t)sizeof(ShieldLightning_Uniforms), nullptr, 0, &ShieldLightning_ComputeVaryings },
-			{ "TexturedBackground", &TexturedBackground_Fragment, (std::uint32_t)sizeof(TexturedBackground_Uniforms), TexturedBackground_Fields, 4, nullptr },
-			{ "TexturedBackground_DITHER", &TexturedBackground_DITHER_Fragment, (std::uint32_t)sizeof(TexturedBackground_DITHER_Uniforms), TexturedBackground_DITHER_Fields, 4, nullptr },
-			{ "TexturedBackgroundCircle", &TexturedBackgroundCircle_Fragment, (std::uint32_t)sizeof(TexturedBackgroundCircle_Uniforms), TexturedBackgroundCircle_Fields, 4, nullptr },
-			{ "TexturedBackgroundCircle_DITHER", &TexturedBackgroundCircle_DITHER_Fragment, (std::uint32_t)sizeof(TexturedBackgroundCircle_DITHER_Uniforms), TexturedBackgroundCircle_DITHER_Fields, 4, nullptr },
-			{ "TileMapMesh", &TileMapMesh_Fragment, (std::uint32_t)sizeof(TileMapMesh_Uniforms), nullptr, 0, nullptr },
-			{ "Tinted", &Tinted_Fragment, (std::uint32_t)sizeof(Tinted_Uniforms), nullptr, 0, nullptr },
-			{ "Tinted_USE_PALETTE", &Tinted_USE_PALETTE_Fragment, (std::uint32_t)sizeof(Tinted_USE_PALETTE_Uniforms), nullptr, 0, &Tinted_USE_PALETTE_ComputeVaryings },
-			{ "BatchedTinted", &BatchedTinted_Fragment, (std::uint32_t)sizeof(BatchedTinted_Uniforms), nullptr, 0, nullptr },
-			{ "BatchedTinted_USE_PALETTE", &BatchedTinted_USE_PALETTE_Fragment, (std::uint32_t)sizeof(BatchedTinted_USE_PALETTE_Uniforms), nullptr, 0, &BatchedTinted_USE_PALETTE_ComputeVaryings },
-			{ "Transition", &Transition_Fragment, (std::uint32_t)sizeof(Transition_Uniforms), nullptr, 0, &Transition_ComputeVaryings },
-			{ "WhiteMask", &WhiteMask_Fragment, (std::uint32_t)sizeof(WhiteMask_Uniforms), nullptr, 0, nullptr },
-			{ "WhiteMask_USE_PALETTE", &WhiteMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(WhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &WhiteMask_USE_PALETTE_ComputeVaryings },
-			{ "BatchedWhiteMask", &BatchedWhiteMask_Fragment, (std::uint32_t)sizeof(BatchedWhiteMask_Uniforms), nullptr, 0, nullptr },
-			{ "BatchedWhiteMask_USE_PALETTE", &BatchedWhiteMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(BatchedWhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &BatchedWhiteMask_USE_PALETTE_ComputeVaryings },
+			{ "BatchedShieldFire", &BatchedShieldFire_Fragment, &sw::swFragmentSpan<&BatchedShieldFire_Fragment>, (std::uint32_t)sizeof(BatchedShieldFire_Uniforms), nullptr, 0, &BatchedShieldFire_ComputeVaryings },
+			{ "BatchedShieldLightning", &BatchedShieldLightning_Fragment, &sw::swFragmentSpan<&BatchedShieldLightning_Fragment>, (std::uint32_t)sizeof(BatchedShieldLightning_Uniforms), nullptr, 0, &BatchedShieldLightning_ComputeVaryings },
+			{ "Blur", &Blur_Fragment, &sw::swFragmentSpan<&Blur_Fragment>, (std::uint32_t)sizeof(Blur_Uniforms), Blur_Fields, 2, nullptr },
+			{ "Colorized", &Colorized_Fragment, &sw::swFragmentSpan<&Colorized_Fragment>, (std::uint32_t)sizeof(Colorized_Uniforms), nullptr, 0, nullptr },
+			{ "BatchedColorized", &BatchedColorized_Fragment, &sw::swFragmentSpan<&BatchedColorized_Fragment>, (std::uint32_t)sizeof(BatchedColorized_Uniforms), nullptr, 0, nullptr },
+			{ "Combine", &Combine_Fragment, &sw::swFragmentSpan<&Combine_Fragment>, (std::uint32_t)sizeof(Combine_Uniforms), Combine_Fields, 2, &Combine_ComputeVaryings },
+			{ "CombineWithWaterLow", &CombineWithWaterLow_Fragment, &sw::swFragmentSpan<&CombineWithWaterLow_Fragment>, (std::uint32_t)sizeof(CombineWithWaterLow_Uniforms), CombineWithWaterLow_Fields, 4, &CombineWithWaterLow_ComputeVaryings },
+			{ "DefaultBatchedMeshSprites", &DefaultBatchedMeshSprites_Fragment, &sw::swFragmentSpan<&DefaultBatchedMeshSprites_Fragment>, (std::uint32_t)sizeof(DefaultBatchedMeshSprites_Uniforms), nullptr, 0, nullptr },
+			{ "DefaultBatchedMeshSpritesNoTexture", &DefaultBatchedMeshSpritesNoTexture_Fragment, &sw::swFragmentSpan<&DefaultBatchedMeshSpritesNoTexture_Fragment>, (std::uint32_t)sizeof(DefaultBatchedMeshSpritesNoTexture_Uniforms), nullptr, 0, nullptr },
+			{ "DefaultBatchedSpritesNoTexture", &DefaultBatchedSpritesNoTexture_Fragment, &sw::swFragmentSpan<&DefaultBatchedSpritesNoTexture_Fragment>, (std::uint32_t)sizeof(DefaultBatchedSpritesNoTexture_Uniforms), nullptr, 0, nullptr },
+			{ "DefaultImGui", &DefaultImGui_Fragment, &sw::swFragmentSpan<&DefaultImGui_Fragment>, (std::uint32_t)sizeof(DefaultImGui_Uniforms), nullptr, 0, nullptr },
+			{ "DefaultMeshSprite", &DefaultMeshSprite_Fragment, &sw::swFragmentSpan<&DefaultMeshSprite_Fragment>, (std::uint32_t)sizeof(DefaultMeshSprite_Uniforms), nullptr, 0, nullptr },
+			{ "DefaultMeshSpriteNoTexture", &DefaultMeshSpriteNoTexture_Fragment, &sw::swFragmentSpan<&DefaultMeshSpriteNoTexture_Fragment>, (std::uint32_t)sizeof(DefaultMeshSpriteNoTexture_Uniforms), nullptr, 0, nullptr },
+			{ "DefaultSprite", &DefaultSprite_Fragment, &sw::swFragmentSpan<&DefaultSprite_Fragment>, (std::uint32_t)sizeof(DefaultSprite_Uniforms), nullptr, 0, nullptr },
+			{ "DefaultBatchedSprites", &DefaultBatchedSprites_Fragment, &sw::swFragmentSpan<&DefaultBatchedSprites_Fragment>, (std::uint32_t)sizeof(DefaultBatchedSprites_Uniforms), nullptr, 0, nullptr },
+			{ "DefaultSpriteNoTexture", &DefaultSpriteNoTexture_Fragment, &sw::swFragmentSpan<&DefaultSpriteNoTexture_Fragment>, (std::uint32_t)sizeof(DefaultSpriteNoTexture_Uniforms), nullptr, 0, nullptr },
+			{ "Downsample", &Downsample_Fragment, &sw::swFragmentSpan<&Downsample_Fragment>, (std::uint32_t)sizeof(Downsample_Uniforms), Downsample_Fields, 1, nullptr },
+			{ "FrozenMask", &FrozenMask_Fragment, &sw::swFragmentSpan<&FrozenMask_Fragment>, (std::uint32_t)sizeof(FrozenMask_Uniforms), nullptr, 0, nullptr },
+			{ "FrozenMask_USE_PALETTE", &FrozenMask_USE_PALETTE_Fragment, &sw::swFragmentSpan<&FrozenMask_USE_PALETTE_Fragment>, (std::uint32_t)sizeof(FrozenMask_USE_PALETTE_Uniforms), nullptr, 0, &FrozenMask_USE_PALETTE_ComputeVaryings },
+			{ "BatchedFrozenMask", &BatchedFrozenMask_Fragment, &sw::swFragmentSpan<&BatchedFrozenMask_Fragment>, (std::uint32_t)sizeof(BatchedFrozenMask_Uniforms), nullptr, 0, nullptr },
+			{ "BatchedFrozenMask_USE_PALETTE", &BatchedFrozenMask_USE_PALETTE_Fragment, &sw::swFragmentSpan<&BatchedFrozenMask_USE_PALETTE_Fragment>, (std::uint32_t)sizeof(BatchedFrozenMask_USE_PALETTE_Uniforms), nullptr, 0, &BatchedFrozenMask_USE_PALETTE_ComputeVaryings },
+			{ "Outline", &Outline_Fragment, &sw::swFragmentSpan<&Outline_Fragment>, (std::uint32_t)sizeof(Outline_Uniforms), nullptr, 0, nullptr },
+			{ "BatchedOutline", &BatchedOutline_Fragment, &sw::swFragmentSpan<&BatchedOutline_Fragment>, (std::uint32_t)sizeof(BatchedOutline_Uniforms), nullptr, 0, nullptr },
+			{ "OutlinePalette", &OutlinePalette_Fragment, &sw::swFragmentSpan<&OutlinePalette_Fragment>, (std::uint32_t)sizeof(OutlinePalette_Uniforms), nullptr, 0, &OutlinePalette_ComputeVaryings },
+			{ "BatchedOutlinePalette", &BatchedOutlinePalette_Fragment, &sw::swFragmentSpan<&BatchedOutlinePalette_Fragment>, (std::uint32_t)sizeof(BatchedOutlinePalette_Uniforms), nullptr, 0, &BatchedOutlinePalette_ComputeVaryings },
+			{ "PaletteRemap", &PaletteRemap_Fragment, &sw::swFragmentSpan<&PaletteRemap_Fragment>, (std::uint32_t)sizeof(PaletteRemap_Uniforms), nullptr, 0, &PaletteRemap_ComputeVaryings },
+			{ "BatchedPaletteRemap", &BatchedPaletteRemap_Fragment, &sw::swFragmentSpan<&BatchedPaletteRemap_Fragment>, (std::uint32_t)sizeof(BatchedPaletteRemap_Uniforms), nullptr, 0, &BatchedPaletteRemap_ComputeVaryings },
+			{ "PartialWhiteMask", &PartialWhiteMask_Fragment, &sw::swFragmentSpan<&PartialWhiteMask_Fragment>, (std::uint32_t)sizeof(PartialWhiteMask_Uniforms), nullptr, 0, nullptr },
+			{ "PartialWhiteMask_USE_PALETTE", &PartialWhiteMask_USE_PALETTE_Fragment, &sw::swFragmentSpan<&PartialWhiteMask_USE_PALETTE_Fragment>, (std::uint32_t)sizeof(PartialWhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &PartialWhiteMask_USE_PALETTE_ComputeVaryings },
+			{ "BatchedPartialWhiteMask", &BatchedPartialWhiteMask_Fragment, &sw::swFragmentSpan<&BatchedPartialWhiteMask_Fragment>, (std::uint32_t)sizeof(BatchedPartialWhiteMask_Uniforms), nullptr, 0, nullptr },
+			{ "BatchedPartialWhiteMask_USE_PALETTE", &BatchedPartialWhiteMask_USE_PALETTE_Fragment, &sw::swFragmentSpan<&BatchedPartialWhiteMask_USE_PALETTE_Fragment>, (std::uint32_t)sizeof(BatchedPartialWhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &BatchedPartialWhiteMask_USE_PALETTE_ComputeVaryings },
+			{ "ResizeCrtApertureGrille", &ResizeCrtApertureGrille_Fragment, &sw::swFragmentSpan<&ResizeCrtApertureGrille_Fragment>, (std::uint32_t)sizeof(ResizeCrtApertureGrille_Uniforms), nullptr, 0, &ResizeCrtApertureGrille_ComputeVaryings },
+			{ "ResizeCrtShadowMask", &ResizeCrtShadowMask_Fragment, &sw::swFragmentSpan<&ResizeCrtShadowMask_Fragment>, (std::uint32_t)sizeof(ResizeCrtShadowMask_Uniforms), nullptr, 0, &ResizeCrtShadowMask_ComputeVaryings },
+			{ "ShieldFire", &ShieldFire_Fragment, &sw::swFragmentSpan<&ShieldFire_Fragment>, (std::uint32_t)sizeof(ShieldFire_Uniforms), nullptr, 0, &ShieldFire_ComputeVaryings },
+			{ "ShieldLightning", &ShieldLightning_Fragment, &sw::swFragmentSpan<&ShieldLightning_Fragment>, (std::uint32_t)sizeof(ShieldLightning_Uniforms), nullptr, 0, &ShieldLightning_ComputeVaryings },
+			{ "TexturedBackground", &TexturedBackground_Fragment, &sw::swFragmentSpan<&TexturedBackground_Fragment>, (std::uint32_t)sizeof(TexturedBackground_Uniforms), TexturedBackground_Fields, 4, nullptr },
+			{ "TexturedBackground_DITHER", &TexturedBackground_DITHER_Fragment, &sw::swFragmentSpan<&TexturedBackground_DITHER_Fragment>, (std::uint32_t)sizeof(TexturedBackground_DITHER_Uniforms), TexturedBackground_DITHER_Fields, 4, nullptr },
+			{ "TexturedBackgroundCircle", &TexturedBackgroundCircle_Fragment, &sw::swFragmentSpan<&TexturedBackgroundCircle_Fragment>, (std::uint32_t)sizeof(TexturedBackgroundCircle_Uniforms), TexturedBackgroundCircle_Fields, 4, nullptr },
+			{ "TexturedBackgroundCircle_DITHER", &TexturedBackgroundCircle_DITHER_Fragment, &sw::swFragmentSpan<&TexturedBackgroundCircle_DITHER_Fragment>, (std::uint32_t)sizeof(TexturedBackgroundCircle_DITHER_Uniforms), TexturedBackgroundCircle_DITHER_Fields, 4, nullptr },
+			{ "TileMapMesh", &TileMapMesh_Fragment, &sw::swFragmentSpan<&TileMapMesh_Fragment>, (std::uint32_t)sizeof(TileMapMesh_Uniforms), nullptr, 0, nullptr },
+			{ "Tinted", &Tinted_Fragment, &sw::swFragmentSpan<&Tinted_Fragment>, (std::uint32_t)sizeof(Tinted_Uniforms), nullptr, 0, nullptr },
+			{ "Tinted_USE_PALETTE", &Tinted_USE_PALETTE_Fragment, &sw::swFragmentSpan<&Tinted_USE_PALETTE_Fragment>, (std::uint32_t)sizeof(Tinted_USE_PALETTE_Uniforms), nullptr, 0, &Tinted_USE_PALETTE_ComputeVaryings },
+			{ "BatchedTinted", &BatchedTinted_Fragment, &sw::swFragmentSpan<&BatchedTinted_Fragment>, (std::uint32_t)sizeof(BatchedTinted_Uniforms), nullptr, 0, nullptr },
+			{ "BatchedTinted_USE_PALETTE", &BatchedTinted_USE_PALETTE_Fragment, &sw::swFragmentSpan<&BatchedTinted_USE_PALETTE_Fragment>, (std::uint32_t)sizeof(BatchedTinted_USE_PALETTE_Uniforms), nullptr, 0, &BatchedTinted_USE_PALETTE_ComputeVaryings },
+			{ "Transition", &Transition_Fragment, &sw::swFragmentSpan<&Transition_Fragment>, (std::uint32_t)sizeof(Transition_Uniforms), nullptr, 0, &Transition_ComputeVaryings },
+			{ "WhiteMask", &WhiteMask_Fragment, &sw::swFragmentSpan<&WhiteMask_Fragment>, (std::uint32_t)sizeof(WhiteMask_Uniforms), nullptr, 0, nullptr },
+			{ "WhiteMask_USE_PALETTE", &WhiteMask_USE_PALETTE_Fragment, &sw::swFragmentSpan<&WhiteMask_USE_PALETTE_Fragment>, (std::uint32_t)sizeof(WhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &WhiteMask_USE_PALETTE_ComputeVaryings },
+			{ "BatchedWhiteMask", &BatchedWhiteMask_Fragment, &sw::swFragmentSpan<&BatchedWhiteMask_Fragment>, (std::uint32_t)sizeof(BatchedWhiteMask_Uniforms), nullptr, 0, nullptr },
+			{ "BatchedWhiteMask_USE_PALETTE", &BatchedWhiteMask_USE_PALETTE_Fragment, &sw::swFragmentSpan<&BatchedWhiteMask_USE_PALETTE_Fragment>, (std::uint32_t)sizeof(BatchedWhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &BatchedWhiteMask_USE_PALETTE_ComputeVaryings },
 		};
 
 		const SwGeneratedShaderInfo* FindGeneratedShader(const char* name)
@@ -1,6 +1,7 @@
 #include "PakFile.h"
 #include "BoundedFileStream.h"
 #include "FileSystem.h"
+#include "MemoryStream.h"
 #include "Compression/DeflateStream.h"
 #include "Compression/Lz4Stream.h"
 #include "Compression/Lzma2Stream.h"
@@ -12,6 +13,11 @@
 
 #include <algorithm>
 
+#if defined(DEATH_TARGET_ANDROID) || defined(DEATH_TARGET_APPLE) || defined(DEATH_TARGET_UNIX)
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+
 using namespace Death::Containers;
 using namespace Death::Containers::Literals;
 using namespace Death::Cryptography;
@@ -241,15 +247,70 @@ namespace Death { namespace IO {
 		return -1;
 	}
 	
+	/** @brief Provides only specified portion of a memory-mapped `.pak` file, keeps the mapping alive */
+	class MappedBoundedStream : public MemoryStream
+	{
+	public:
+		MappedBoundedStream(std::shared_ptr<const char> mappedData, std::uint64_t offset, std::uint32_t size);
+
+		void Dispose() override;
+
+	private:
+		std::shared_ptr<const char> _mappedData;
+	};
+
+	MappedBoundedStream::MappedBoundedStream(std::shared_ptr<const char> mappedData, std::uint64_t offset, std::uint32_t size)
+		: MemoryStream(mappedData.get() + offset, std::int64_t(size)), _mappedData(std::move(mappedData))
+	{
+	}
+
+	void MappedBoundedStream::Dispose()
+	{
+		MemoryStream::Dispose();
+		_mappedData = nullptr;
+	}
+
+	// Smaller files are usually covered by the kernel read-ahead of the neighbouring ones anyway
+	static constexpr std::uint32_t MinAdvisedSize = 64 * 1024;
+
+	static void AdviseSequentialRead(const char* data, std::uint32_t size)
+	{
+#if defined(DEATH_TARGET_ANDROID) || defined(DEATH_TARGET_APPLE) || defined(DEATH_TARGET_UNIX)
+		if (size < MinAdvisedSize) {
+			return;
+		}
+
+		// The range passed to madvise() must start at a page boundary
+		static const std::uintptr_t PageSize = std::uintptr_t(::sysconf(_SC_PAGESIZE));
+		std::uintptr_t begin = std::uintptr_t(data) & ~(PageSize - 1);
+		std::size_t length = std::size_t(std::uintptr_t(data) + size - begin);
+		::madvise(reinterpret_cast<void*>(begin), length, MADV_SEQUENTIAL);
+		::madvise(reinterpret_cast<void*>(begin), length, MADV_WILLNEED);
+#else
+		static_cast<void>(data);
+		static_cast<void>(size);
+#endif
+	}
+
+	static std::unique_ptr<Stream> CreateStoredStream(const std::shared_ptr<const char>& mappedData, StringView path, std::uint64_t offset, std::uint32_t size, std::int32_t bufferSize)
+	{
+		if (mappedData != nullptr) {
+			AdviseSequentialRead(mappedData.get() + offset, size);
+			return std::make_unique<MappedBoundedStream>(mappedData, offset, size);
+		}
+		return std::make_unique<BoundedFileStream>(path, offset, size, bufferSize);
+	}
+
 #if defined(WITH_ZLIB) || defined(WITH_MINIZ) || defined(WITH_LZ4) || defined(WITH_LZMA2) || defined(WITH_ZSTD)
 
 	using namespace Death::IO::Compression;
 
-	template<class T>
+	template<class T, class TUnderlying>
 	class CompressedBoundedStream : public Stream
 	{
 	public:
-		CompressedBoundedStream(StringView path, std::uint64_t offset, std::uint32_t uncompressedSize, std::uint32_t compressedSize, std::int32_t bufferSize);
+		template<class ...TArgs>
+		CompressedBoundedStream(std::uint32_t uncompressedSize, std::uint32_t compressedSize, TArgs&&... underlyingArgs);
 
 		CompressedBoundedStream(const CompressedBoundedStream&) = delete;
 		CompressedBoundedStream& operator=(const CompressedBoundedStream&) = delete;
@@ -265,75 +326,87 @@ namespace Death { namespace IO {
 		std::int64_t SetSize(std::int64_t size) override;
 
 	private:
-		BoundedFileStream _underlyingStream;
+		TUnderlying _underlyingStream;
 		T _compressedStream;
 		std::int64_t _uncompressedSize;
 	};
 
-	template<class T>
-	CompressedBoundedStream<T>::CompressedBoundedStream(StringView path, std::uint64_t offset, std::uint32_t uncompressedSize, std::uint32_t compressedSize, std::int32_t bufferSize)
-		: _underlyingStream(path, offset, compressedSize, bufferSize), _uncompressedSize(uncompressedSize)
+	template<class T, class TUnderlying>
+	template<class ...TArgs>
+	CompressedBoundedStream<T, TUnderlying>::CompressedBoundedStream(std::uint32_t uncompressedSize, std::uint32_t compressedSize, TArgs&&... underlyingArgs)
+		: _underlyingStream(std::forward<TArgs>(underlyingArgs)...), _uncompressedSize(uncompressedSize)
 	{
 		_compressedStream.Open(_underlyingStream, static_cast<std::int32_t>(compressedSize));
 	}
 
-	template<class T>
-	void CompressedBoundedStream<T>::Dispose()
+	template<class T, class TUnderlying>
+	void CompressedBoundedStream<T, TUnderlying>::Dispose()
 	{
 		_compressedStream.Dispose();
 		_underlyingStream.Dispose();
 	}
 
-	template<class T>
-	std::int64_t CompressedBoundedStream<T>::Seek(std::int64_t offset, SeekOrigin origin)
+	template<class T, class TUnderlying>
+	std::int64_t CompressedBoundedStream<T, TUnderlying>::Seek(std::int64_t offset, SeekOrigin origin)
 	{
 		return _compressedStream.Seek(offset, origin);
 	}
 
-	template<class T>
-	std::int64_t CompressedBoundedStream<T>::GetPosition() const
+	template<class T, class TUnderlying>
+	std::int64_t CompressedBoundedStream<T, TUnderlying>::GetPosition() const
 	{
 		return _compressedStream.GetPosition();
 	}
 
-	template<class T>
-	std::int64_t CompressedBoundedStream<T>::Read(void* destination, std::int64_t bytesToRead)
+	template<class T, class TUnderlying>
+	std::int64_t CompressedBoundedStream<T, TUnderlying>::Read(void* destination, std::int64_t bytesToRead)
 	{
 		return _compressedStream.Read(destination, bytesToRead);
 	}
 
-	template<class T>
-	std::int64_t CompressedBoundedStream<T>::Write(const void* source, std::int64_t bytesToWrite)
+	template<class T, class TUnderlying>
+	std::int64_t CompressedBoundedStream<T, TUnderlying>::Write(const void* source, std::int64_t bytesToWrite)
 	{
 		// Not supported
 		return Stream::Invalid;
 	}
 
-	template<class T>
-	bool CompressedBoundedStream<T>::Flush()
+	template<class T, class TUnderlying>
+	bool CompressedBoundedStream<T, TUnderlying>::Flush()
 	{
 		// Not supported
 		return true;
 	}
 
-	template<class T>
-	bool CompressedBoundedStream<T>::IsValid()
+	template<class T, class TUnderlying>
+	bool CompressedBoundedStream<T, TUnderlying>::IsValid()
 	{
 		return _underlyingStream.IsValid() && _compressedStream.IsValid();
 	}
 
-	template<class T>
-	std::int64_t CompressedBoundedStream<T>::GetSize() const
+	template<class T, class TUnderlying>
+	std::int64_t CompressedBoundedStream<T, TUnderlying>::GetSize() const
 	{
 		return _uncompressedSize;
 	}
 
-	template<class T>
-	std::int64_t CompressedBoundedStream<T>::SetSize(std::int64_t size)
+	template<class T, class TUnderlying>
+	std::int64_t CompressedBoundedStream<T, TUnderlying>::SetSize(std::int64_t size)
 	{
 		return Stream::Invalid;
 	}
 
+	template<class T>
+	static std::unique_ptr<Stream> CreateCompressedStream(const std::shared_ptr<const char>& mappedData, StringView path, std::uint64_t offset, std::uint32_t uncompressedSize, std::uint32_t compressedSize, std::int32_t bufferSize)
+	{
+		if (mappedData != nullptr) {
+			// Decompress straight from the mapping, the compressed data are read exactly once from start to end
+			AdviseSequentialRead(mappedData.get() + offset, compressedSize);
+			return std::make_unique<CompressedBoundedStream<T, MappedBoundedStream>>(uncompressedSize, compressedSize, mappedData, offset, compressedSize);
+		}
+		return std::make_unique<CompressedBoundedStream<T, BoundedFileStream>>(uncompressedSize, compressedSize, path, offset, compressedSize, bufferSize);
+	}
+
 #	if defined(WITH_ZLIB) || defined(WITH_MINIZ)
 	static void CopyToDeflate(Stream& input, Stream& output, std::int64_t& uncompressedSize)
 	{
@@ -364,9 +437,26 @@ namespace Death { namespace IO {
 #	endif
 #endif
 
-	PakFile::PakFile(StringView path)
+	PakFile::PakFile(StringView path, bool memoryMapped)
+		: _mappedSize(0)
 	{
-		std::unique_ptr<Stream> s = std::make_unique<FileStream>(path, FileAccess::Read);
+		std::unique_ptr<Stream> s;
+#if defined(DEATH_TARGET_ANDROID) || defined(DEATH_TARGET_APPLE) || defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+		if (memoryMapped) {
+			if (auto mapped = FileSystem::OpenAsMemoryMapped(path, FileAccess::Read)) {
+				if (mapped->data() != nullptr) {
+					auto owner = std::make_shared<Array<char, FileSystem::MapDeleter>>(std::move(*mapped));
+					_mappedSize = owner->size();
+					_mappedData = std::shared_ptr<const char>(owner, owner->data());
+					// The index is parsed from the mapping too, so mounting needs no reads at all
+					s = std::make_unique<MemoryStream>(_mappedData.get(), std::int64_t(_mappedSize));
+				}
+			}
+		}
+#endif
+		if (s == nullptr) {
+			s = std::make_unique<FileStream>(path, FileAccess::Read);
+		}
 		DEATH_ASSERT(s->GetSize() > FooterSize + 8, "Invalid .pak file", );
 
 		// Header size is 18 bytes
@@ -399,9 +489,17 @@ namespace Death { namespace IO {
 		_path = path;
 		_useHashIndex = (fileFlags & PakFileFlags::HashIndex) == PakFileFlags::HashIndex;
 
-		ConstructsItemsFromIndex(*s, nullptr,
+		if DEATH_UNLIKELY(!ConstructsItemsFromIndex(*s, nullptr,
 			(fileFlags & PakFileFlags::DeflateCompressedIndex) == PakFileFlags::DeflateCompressedIndex,
-			useRelativeOffsets, 0);
+			useRelativeOffsets, 0)) {
+			// Partially read index cannot be trusted, so the file is not mounted at all
+			LOGE("Failed to read index of .pak file \"{}\"", path);
+			_path = {};
+			_mountPoint = {};
+			_rootItems = {};
+			_mappedData = nullptr;
+			_mappedSize = 0;
+		}
 	}
 
 	StringView PakFile::GetMountPoint() const
@@ -419,6 +517,11 @@ namespace Death { namespace IO {
 		return !_path.empty();
 	}
 
+	bool PakFile::IsMemoryMapped() const
+	{
+		return (_mappedData != nullptr);
+	}
+
 	bool PakFile::FileExists(StringView path)
 	{
 		Item* foundItem = FindItem(path);
@@ -453,11 +556,11 @@ namespace Death { namespace IO {
 		PakPreferredCompression compression = PakPreferredCompression(std::uint32_t(foundItem->Flags & ItemFlags::CompressionFlags) >> CompressionFlagsShift);
 		switch (compression) {
 			case PakPreferredCompression::None: {
-				return std::make_unique<BoundedFileStream>(_path, foundItem->Offset, foundItem->UncompressedSize, bufferSize);
+				return CreateStoredStream(_mappedData, _path, foundItem->Offset, foundItem->UncompressedSize, bufferSize);
 			}
 			case PakPreferredCompression::Deflate: {
 #if defined(WITH_ZLIB) || defined(WITH_MINIZ)
-				return std::make_unique<CompressedBoundedStream<DeflateStream>>(_path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
+				return CreateCompressedStream<DeflateStream>(_mappedData, _path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
 #else
 #	if defined(DEATH_TRACE_VERBOSE_IO)
 				LOGE("File \"{}\" was compressed with an unsupported method (Deflate)", path);
@@ -467,7 +570,7 @@ namespace Death { namespace IO {
 			}
 			case PakPreferredCompression::Lz4: {
 #if defined(WITH_LZ4)
-				return std::make_unique<CompressedBoundedStream<Lz4Stream>>(_path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
+				return CreateCompressedStream<Lz4Stream>(_mappedData, _path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
 #else
 #	if defined(DEATH_TRACE_VERBOSE_IO)
 				LOGE("File \"{}\" was compressed with an unsupported method (LZ4)", path);
@@ -477,7 +580,7 @@ namespace Death { namespace IO {
 			}
 			case PakPreferredCompression::Zstd: {
 #if defined(WITH_ZSTD)
-				return std::make_unique<CompressedBoundedStream<ZstdStream>>(_path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
+				return CreateCompressedStream<ZstdStream>(_mappedData, _path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
 #else
 #	if defined(DEATH_TRACE_VERBOSE_IO)
 				LOGE("File \"{}\" was compressed with an unsupported method (Zstd)", path);
@@ -487,7 +590,7 @@ namespace Death { namespace IO {
 			}
 			case PakPreferredCompression::Lzma2Compressed: {
 #if defined(WITH_LZMA2)
-				return std::make_unique<CompressedBoundedStream<Lzma2Stream>>(_path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
+				return CreateCompressedStream<Lzma2Stream>(_mappedData, _path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
 #else
 #	if defined(DEATH_TRACE_VERBOSE_IO)
 				LOGE("File \"{}\" was compressed with an unsupported method (LZMA2)", path);
@@ -513,11 +616,11 @@ namespace Death { namespace IO {
 		PakPreferredCompression compression = PakPreferredCompression(std::uint32_t(foundItem->Flags & ItemFlags::CompressionFlags) >> CompressionFlagsShift);
 		switch (compression) {
 			case PakPreferredCompression::None: {
-				return std::make_unique<BoundedFileStream>(_path, foundItem->Offset, foundItem->UncompressedSize, bufferSize);
+				return CreateStoredStream(_mappedData, _path, foundItem->Offset, foundItem->UncompressedSize, bufferSize);
 			}
 			case PakPreferredCompression::Deflate: {
 #if defined(WITH_ZLIB) || defined(WITH_MINIZ)
-				return std::make_unique<CompressedBoundedStream<DeflateStream>>(_path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
+				return CreateCompressedStream<DeflateStream>(_mappedData, _path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
 #	else
 #		if defined(DEATH_TRACE_VERBOSE_IO)
 				LOGE("File 0x{:.16x} was compressed with an unsupported method (Deflate)", hashedPath);
@@ -527,7 +630,7 @@ namespace Death { namespace IO {
 			}
 			case PakPreferredCompression::Lz4: {
 #	if defined(WITH_LZ4)
-				return std::make_unique<CompressedBoundedStream<Lz4Stream>>(_path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
+				return CreateCompressedStream<Lz4Stream>(_mappedData, _path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
 #	else
 #		if defined(DEATH_TRACE_VERBOSE_IO)
 				LOGE("File 0x{:.16x} was compressed with an unsupported method (LZ4)", hashedPath);
@@ -537,7 +640,7 @@ namespace Death { namespace IO {
 			}
 			case PakPreferredCompression::Zstd: {
 #	if defined(WITH_ZSTD)
-				return std::make_unique<CompressedBoundedStream<ZstdStream>>(_path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
+				return CreateCompressedStream<ZstdStream>(_mappedData, _path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
 #	else
 #		if defined(DEATH_TRACE_VERBOSE_IO)
 				LOGE("File 0x{:.16x} was compressed with an unsupported method (Zstd)", hashedPath);
@@ -547,7 +650,7 @@ namespace Death { namespace IO {
 			}
 			case PakPreferredCompression::Lzma2Compressed: {
 #	if defined(WITH_LZMA2)
-				return std::make_unique<CompressedBoundedStream<Lzma2Stream>>(_path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
+				return CreateCompressedStream<Lzma2Stream>(_mappedData, _path, foundItem->Offset, foundItem->UncompressedSize, foundItem->Size, bufferSize);
 #	else
 #		if defined(DEATH_TRACE_VERBOSE_IO)
 				LOGE("File 0x{:.16x} was compressed with an unsupported method (LZMA2)", hashedPath);
@@ -561,9 +664,9 @@ namespace Death { namespace IO {
 		}
 	}
 
-	void PakFile::ConstructsItemsFromIndex(Stream& s, Item* parentItem, bool deflateCompressed, bool useRelativeOffsets, std::uint32_t depth)
+	bool PakFile::ConstructsItemsFromIndex(Stream& s, Item* parentItem, bool deflateCompressed, bool useRelativeOffsets, std::uint32_t depth)
 	{
-		DEATH_ASSERT(depth < MaxDepth, "Maximum directory structure depth reached", );
+		DEATH_ASSERT(depth < MaxDepth, "Maximum directory structure depth reached", false);
 
 		std::int64_t indexStartPosition = s.GetPosition();
 		
@@ -571,14 +674,20 @@ namespace Death { namespace IO {
 			? ReadIndexFromStreamDeflateCompressed(s, parentItem, useRelativeOffsets, indexStartPosition)
 			: ReadIndexFromStream(s, parentItem, useRelativeOffsets, indexStartPosition));
 
-		if DEATH_LIKELY(items != nullptr) {
-			for (auto& item : *items) {
-				if ((item.Flags & ItemFlags::Directory) == ItemFlags::Directory) {
-					s.Seek(std::int64_t(item.Offset), SeekOrigin::Begin);
-					ConstructsItemsFromIndex(s, &item, deflateCompressed, useRelativeOffsets, depth + 1);
+		if DEATH_UNLIKELY(items == nullptr) {
+			return false;
+		}
+
+		for (auto& item : *items) {
+			if ((item.Flags & ItemFlags::Directory) == ItemFlags::Directory) {
+				s.Seek(std::int64_t(item.Offset), SeekOrigin::Begin);
+				if (!ConstructsItemsFromIndex(s, &item, deflateCompressed, useRelativeOffsets, depth + 1)) {
+					return false;
 				}
 			}
 		}
+
+		return true;
 	}
 
 	Array<PakFile::Item>* PakFile::ReadIndexFromStream(Stream& s, Item* parentItem, bool useRelativeOffsets, std::int64_t indexStartPosition)
@@ -635,6 +744,12 @@ namespace Death { namespace IO {
 				if (HasCompressedSize(item.Flags)) {
 					item.Size = s.ReadVariableUint32();
 				}
+				// Streams over the mapping don't check bounds on their own, so a truncated or malformed file must be rejected here
+				std::uint64_t size = (HasCompressedSize(item.Flags) ? item.Size : item.UncompressedSize);
+				if DEATH_UNLIKELY(_mappedData != nullptr && (item.Offset > _mappedSize || size > _mappedSize - item.Offset)) {
+					LOGE("Item at 0x{:x} with size {} points outside of the .pak file", item.Offset, size);
+					return nullptr;
+				}
 			}
 		}
 
@@ -807,8 +922,9 @@ namespace Death { namespace IO {
 #if defined(DEATH_TARGET_WINDOWS)
 			strncpy_s(_fileNamePart, sizeof(_path) - (_fileNamePart - _path), fileName.data(), fileName.size());
 #else
-			strncpy(_fileNamePart, fileName.data(), std::min(sizeof(_path) - (_fileNamePart - _path), fileName.size()) - 1);
-			_path[sizeof(_path) - 1] = '\0';
+			std::size_t length = std::min(sizeof(_path) - (_fileNamePart - _path) - 1, fileName.size());
+			std::memcpy(_fileNamePart, fileName.data(), length);
+			_fileNamePart[length] = '\0';
 #endif
 			_index++;
 		}
@@ -957,7 +1073,7 @@ namespace Death { namespace IO {
 		std::int64_t offset = _outputStream->GetPosition();
 		std::int64_t uncompressedSize, size;
 
-		switch (preferredCompression) {
+		switch (SelectCompression(path, stream.GetSize() - stream.GetPosition(), preferredCompression)) {
 #if defined(WITH_ZLIB) || defined(WITH_MINIZ)
 			case PakPreferredCompression::Deflate: {
 				CopyToDeflate(stream, *_outputStream, uncompressedSize);
@@ -1025,6 +1141,42 @@ namespace Death { namespace IO {
 		return true;
 	}
 
+	PakPreferredCompression PakWriter::SelectCompression(StringView path, std::int64_t size, PakPreferredCompression preferredCompression)
+	{
+		// Small files are usually read often and in bulk (metadata, small sprites), so they prefer the fastest decoder
+		constexpr std::int64_t SmallFileSize = 16 * 1024;
+
+		if (preferredCompression == PakPreferredCompression::Auto) {
+			// Files that are already compressed on their own would only be decompressed twice
+			auto extension = FileSystem::GetExtension(path);
+			if (extension == "ogg"_s || extension == "mp3"_s || extension == "png"_s || extension == "webp"_s ||
+				extension == "jpg"_s || extension == "j2v"_s || extension == "zip"_s || extension == "pak"_s) {
+				return PakPreferredCompression::None;
+			}
+			preferredCompression = (size >= 0 && size < SmallFileSize ? PakPreferredCompression::Lz4 : PakPreferredCompression::Zstd);
+		}
+
+		switch (preferredCompression) {
+#if defined(WITH_LZ4)
+			case PakPreferredCompression::Lz4: return PakPreferredCompression::Lz4;
+#endif
+#if defined(WITH_ZSTD)
+			case PakPreferredCompression::Zstd: return PakPreferredCompression::Zstd;
+#endif
+#if defined(WITH_LZMA2)
+			case PakPreferredCompression::Lzma2Compressed: return PakPreferredCompression::Lzma2Compressed;
+#endif
+			case PakPreferredCompression::None: return PakPreferredCompression::None;
+			default:
+#if defined(WITH_ZLIB) || defined(WITH_MINIZ)
+				// Deflate is the fallback that every build of the game can read
+				return PakPreferredCompression::Deflate;
+#else
+				return PakPreferredCompression::None;
+#endif
+		}
+	}
+
 	bool PakWriter::FileExists(StringView path) const
 	{
 		if (_useHashIndex) {
@@ -22,7 +22,14 @@ namespace Death { namespace IO {
 		Deflate,			/**< Deflate */
 		Lz4,				/**< LZ4 */
 		Lzma2Compressed,	/**< LZMA2 */
-		Zstd				/**< Zstandard */
+		Zstd,				/**< Zstandard */
+
+		/**
+			Selected for each file based on its size and type --- already compressed formats are stored, small
+			files use LZ4 and larger files Zstandard. Deflate is used instead if the preferred method is not
+			available in the current build. Never stored in the container.
+		*/
+		Auto = 0x0F
 	};
 
 	/**
@@ -33,7 +40,15 @@ namespace Death { namespace IO {
 		friend class PakWriter;
 
 	public:
-		explicit PakFile(Containers::StringView path);
+		/**
+			@brief Opens a `.pak` file
+
+			If @p memoryMapped is @cpp true @ce, the whole file is mapped into memory once and kept mapped for the
+			lifetime of the container and all streams opened from it. Stored files are then served directly from
+			the mapping and compressed files are decompressed from it, without opening the file again for every
+			request. Falls back to regular file streams if the file cannot be mapped on the current platform.
+		*/
+		explicit PakFile(Containers::StringView path, bool memoryMapped = false);
 
 		PakFile(const PakFile&) = delete;
 		PakFile& operator=(const PakFile&) = delete;
@@ -48,6 +63,8 @@ namespace Death { namespace IO {
 		Containers::StringView GetPath() const;
 		
 		bool IsValid() const;
+		/** @brief Returns `true` if the container is served from a memory-mapped file */
+		bool IsMemoryMapped() const;
 
 		/** @brief Returns `true` if the specified path is a file */
 		bool FileExists(Containers::StringView path);
@@ -151,9 +168,12 @@ namespace Death { namespace IO {
 		Containers::String _path;
 		Containers::String _mountPoint;
 		Containers::Array<Item> _rootItems;
+		// Owns the whole mapped file, streams opened from the container share the ownership
+		std::shared_ptr<const char> _mappedData;
+		std::uint64_t _mappedSize;
 		bool _useHashIndex;
 
-		void ConstructsItemsFromIndex(Stream& s, Item* parentItem, bool deflateCompressed, bool useRelativeOffsets, std::uint32_t depth);
+		bool ConstructsItemsFromIndex(Stream& s, Item* parentItem, bool deflateCompressed, bool useRelativeOffsets, std::uint32_t depth);
 		Containers::Array<Item>* ReadIndexFromStream(Stream& s, Item* parentItem, bool useRelativeOffsets, std::int64_t indexStartPosition);
 		DEATH_NEVER_INLINE Containers::Array<Item>* ReadIndexFromStreamDeflateCompressed(Stream& s, Item* parentItem, bool useRelativeOffsets, std::int64_t indexStartPosition);
 		Item* FindItem(Containers::StringView path);
@@ -180,7 +200,12 @@ namespace Death { namespace IO {
 
 		bool IsValid() const;
 
-		/** @brief Adds a file to the `.pak` container */
+		/**
+			@brief Adds a file to the `.pak` container
+
+			If the @p preferredCompression method is not available in the current build, Deflate is used
+			instead, or the file is stored uncompressed if Deflate is not available either.
+		*/
 		bool AddFile(Stream& stream, Containers::StringView path, PakPreferredCompression preferredCompression = PakPreferredCompression::None);
 		/**
 			@brief Returns `true` if the container already contains a file at the specified path
@@ -208,6 +233,7 @@ namespace Death { namespace IO {
 		bool _useRelativeOffsets;
 
 		PakFile::Item* FindOrCreateParentItem(Containers::StringView& path);
+		static PakPreferredCompression SelectCompression(Containers::StringView path, std::int64_t size, PakPreferredCompression preferredCompression);
 		void WriteItemDescription(Stream& s, PakFile::Item& item, std::int64_t indexStartPosition);
 	};
 
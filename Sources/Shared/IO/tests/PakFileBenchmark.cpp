@@ -0,0 +1,227 @@
+// Reads all files of a .pak container through file streams and through the memory-mapped mode and compares their time and data
+// Built with -DNCINE_BUILD_BENCHMARKS=ON, usage: PakFileBenchmark [--pak <path>] [--files <count>] [--size <bytes>]
+//   [--compression none|deflate|lz4|zstd|auto] [--mode file|mapped|both] [--rounds <count>]
+
+#include "IO/FileSystem.h"
+#include "IO/MemoryStream.h"
+#include "IO/PakFile.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace Death::Containers;
+using namespace Death::IO;
+
+namespace
+{
+	// Small xorshift generator, so the file contents don't depend on the standard library implementation
+	struct Random
+	{
+		std::uint32_t State;
+
+		std::uint32_t Next()
+		{
+			State ^= State << 13;
+			State ^= State >> 17;
+			State ^= State << 5;
+			return State;
+		}
+	};
+
+	bool ParseCompression(const char* value, PakPreferredCompression& compression)
+	{
+		static const struct { const char* Name; PakPreferredCompression Value; } Methods[] = {
+			{ "none", PakPreferredCompression::None }, { "deflate", PakPreferredCompression::Deflate },
+			{ "lz4", PakPreferredCompression::Lz4 }, { "zstd", PakPreferredCompression::Zstd },
+			{ "auto", PakPreferredCompression::Auto }
+		};
+		for (const auto& method : Methods) {
+			if (std::strcmp(value, method.Name) == 0) {
+				compression = method.Value;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void CreateSyntheticPak(StringView pakPath, std::int32_t fileCount, std::int32_t averageSize, PakPreferredCompression compression, std::vector<String>& paths)
+	{
+		Random random = { 0x9E3779B9u };
+		PakWriter writer(pakPath);
+		std::vector<std::uint8_t> content;
+		for (std::int32_t i = 0; i < fileCount; i++) {
+			// Sizes from a few bytes up to twice the average, like a mix of metadata files and sprites
+			std::int32_t size = 1 + std::int32_t(random.Next() % std::uint32_t(averageSize * 2));
+			content.resize(size);
+			for (std::int32_t j = 0; j < size; j++) {
+				// Runs of repeated bytes, so the compressed variant actually compresses something
+				content[j] = std::uint8_t((random.Next() % 8) == 0 ? random.Next() : (j > 0 ? content[j - 1] : 0));
+			}
+
+			char path[64];
+			std::snprintf(path, sizeof(path), "Dir%02d/File%05d.bin", i % 32, i);
+			MemoryStream ms(content.data(), std::int64_t(content.size()));
+			writer.AddFile(ms, path, compression);
+			paths.emplace_back(path);
+		}
+		writer.Finalize();
+	}
+
+	void RepackPak(StringView sourcePath, StringView targetPath, PakPreferredCompression compression, const std::vector<String>& paths)
+	{
+		PakFile source(sourcePath);
+		PakWriter writer(targetPath);
+		writer.SetMountPoint(source.GetMountPoint());
+		for (const auto& path : paths) {
+			auto s = source.OpenFile(path);
+			MemoryStream ms(s->GetSize());
+			ms.FetchFromStream(*s);
+			ms.Seek(0, SeekOrigin::Begin);
+			writer.AddFile(ms, path, compression);
+		}
+		writer.Finalize();
+	}
+
+	struct Result
+	{
+		double MountMs;
+		double ReadMs;
+		std::uint64_t TotalBytes;
+		std::uint64_t Checksum;
+	};
+
+	Result ReadAll(StringView pakPath, const std::vector<String>& paths, bool memoryMapped, std::int32_t rounds)
+	{
+		Result result = { };
+		std::vector<std::uint8_t> buffer;
+
+		auto start = std::chrono::steady_clock::now();
+		PakFile pak(pakPath, memoryMapped);
+		result.MountMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		if (!pak.IsValid()) {
+			std::fprintf(stderr, "Failed to open \"%s\"\n", String::nullTerminatedView(pakPath).data());
+			std::exit(1);
+		}
+		if (memoryMapped && !pak.IsMemoryMapped()) {
+			std::fprintf(stderr, "Memory mapping is not supported, falling back to file streams\n");
+		}
+
+		start = std::chrono::steady_clock::now();
+		for (std::int32_t round = 0; round < rounds; round++) {
+			for (const auto& path : paths) {
+				auto s = pak.OpenFile(path);
+				if (s == nullptr) {
+					std::fprintf(stderr, "Failed to open \"%s\"\n", path.data());
+					std::exit(1);
+				}
+				std::int64_t size = s->GetSize();
+				buffer.resize(std::size_t(size));
+				s->Read(buffer.data(), size);
+				result.TotalBytes += std::uint64_t(size);
+				for (std::int64_t i = 0; i < size; i += 61) {
+					result.Checksum = result.Checksum * 31 + buffer[std::size_t(i)];
+				}
+			}
+		}
+		result.ReadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		return result;
+	}
+
+	void PrintResult(const char* name, const Result& result, std::size_t fileCount, std::int32_t rounds)
+	{
+		std::printf("  %-8s mount %8.3f ms, read %9.3f ms (%6.2f us/file, %7.1f MB/s)\n", name, result.MountMs, result.ReadMs,
+			result.ReadMs * 1000.0 / double(fileCount * rounds), double(result.TotalBytes) / (1024.0 * 1024.0) / (result.ReadMs / 1000.0));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const char* pakPath = nullptr;
+	const char* mode = "both";
+	std::int32_t fileCount = 4000;
+	std::int32_t averageSize = 16 * 1024;
+	std::int32_t rounds = 3;
+	PakPreferredCompression compression = PakPreferredCompression::None;
+	bool repack = false;
+	for (std::int32_t i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--pak") == 0 && i + 1 < argc) {
+			pakPath = argv[++i];
+		} else if (std::strcmp(argv[i], "--files") == 0 && i + 1 < argc) {
+			fileCount = std::atoi(argv[++i]);
+		} else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+			averageSize = std::atoi(argv[++i]);
+		} else if (std::strcmp(argv[i], "--compression") == 0 && i + 1 < argc && ParseCompression(argv[i + 1], compression)) {
+			repack = true;
+			i++;
+		} else if (std::strcmp(argv[i], "--mode") == 0 && i + 1 < argc) {
+			mode = argv[++i];
+		} else if (std::strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+			rounds = std::atoi(argv[++i]);
+		} else {
+			std::fprintf(stderr, "Usage: %s [--pak <path>] [--files <count>] [--size <bytes>] [--compression none|deflate|lz4|zstd|auto] [--mode file|mapped|both] [--rounds <count>]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	std::vector<String> paths;
+	String path;
+	if (pakPath != nullptr) {
+		// Hash-indexed containers store no paths, so only the regular ones can be enumerated
+		path = pakPath;
+		PakFile pak(path);
+		std::vector<String> directories = { String{} };
+		while (!directories.empty()) {
+			String directory = std::move(directories.back());
+			directories.pop_back();
+			for (auto item : PakFile::Directory(pak, directory)) {
+				if (pak.DirectoryExists(item)) {
+					directories.emplace_back(item);
+				} else {
+					paths.emplace_back(item);
+				}
+			}
+		}
+		if (repack) {
+			std::int64_t originalSize = fs::GetFileSize(path);
+			path = fs::CombinePath(fs::GetTempDirectory(), "PakFileBenchmark.pak");
+			auto start = std::chrono::steady_clock::now();
+			RepackPak(pakPath, path, compression, paths);
+			double repackMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			std::printf("Repacked in %.1f ms, %.2f MB -> %.2f MB\n", repackMs, double(originalSize) / (1024.0 * 1024.0),
+				double(fs::GetFileSize(path)) / (1024.0 * 1024.0));
+		}
+	} else {
+		path = fs::CombinePath(fs::GetTempDirectory(), "PakFileBenchmark.pak");
+		CreateSyntheticPak(path, fileCount, averageSize, compression, paths);
+		std::printf("Created %.2f MB\n", double(fs::GetFileSize(path)) / (1024.0 * 1024.0));
+	}
+
+	std::printf("%zu files, %d rounds\n", paths.size(), rounds);
+
+	bool runFile = (std::strcmp(mode, "file") == 0 || std::strcmp(mode, "both") == 0);
+	bool runMapped = (std::strcmp(mode, "mapped") == 0 || std::strcmp(mode, "both") == 0);
+	Result fileResult = { }, mappedResult = { };
+	if (runFile) {
+		fileResult = ReadAll(path, paths, false, rounds);
+		PrintResult("file", fileResult, paths.size(), rounds);
+	}
+	if (runMapped) {
+		mappedResult = ReadAll(path, paths, true, rounds);
+		PrintResult("mapped", mappedResult, paths.size(), rounds);
+	}
+
+	if (pakPath == nullptr || repack) {
+		fs::RemoveFile(path);
+	}
+
+	if (runFile && runMapped) {
+		bool matches = (fileResult.Checksum == mappedResult.Checksum && fileResult.TotalBytes == mappedResult.TotalBytes);
+		std::printf("  results %s\n", matches ? "match" : "DIFFER");
+		return (matches ? 0 : 1);
+	}
+	return 0;
+}
@@ -1301,7 +1301,9 @@ namespace
 		// computeVaryings is null unless the shader reads per-instance-constant varyings; the device calls it
 		// once per instance (with that instance's block pointer) to fill those varyings before the draw
 		out += "\t\tusing SwGeneratedComputeVaryingsFn = void (*)(void* inputs, const std::uint8_t* instanceBlock);\n";
-		out += "\t\tstruct SwGeneratedShaderInfo { const char* name; nCine::RHI::Software::FragmentShaderFn fragment; std::uint32_t uniformsSize; const SwGeneratedUniformField* uniformFields; std::uint32_t uniformFieldCount; SwGeneratedComputeVaryingsFn computeVaryings; };\n\n";
+		// fragmentSpan is the same fragment instantiated into the span entry point (SwShaderRuntime.h), which the
+		// scanline paths call once per run of pixels instead of calling the fragment through a pointer per pixel
+		out += "\t\tstruct SwGeneratedShaderInfo { const char* name; nCine::RHI::Software::FragmentShaderFn fragment; nCine::RHI::Software::FragmentShaderSpanFn fragmentSpan; std::uint32_t uniformsSize; const SwGeneratedUniformField* uniformFields; std::uint32_t uniformFieldCount; SwGeneratedComputeVaryingsFn computeVaryings; };\n\n";
 
 		for (const GeneratedShaderEntry& e : supported) {
 			if (e.Fields.empty()) {
@@ -1323,7 +1325,7 @@ namespace
 			for (const GeneratedShaderEntry& e : supported) {
 				String fieldsPtr = (e.Fields.empty() ? String("nullptr") : String(e.Prefix + "_Fields"));
 				String computeVaryingsPtr = (e.HasComputeVaryings ? String("&" + e.Prefix + "_ComputeVaryings") : String("nullptr"));
-				out += "\t\t\t{ \"" + e.Prefix + "\", &" + e.Prefix + "_Fragment, (std::uint32_t)sizeof(" + e.Prefix + "_Uniforms), " +
+				out += "\t\t\t{ \"" + e.Prefix + "\", &" + e.Prefix + "_Fragment, &sw::swFragmentSpan<&" + e.Prefix + "_Fragment>, (std::uint32_t)sizeof(" + e.Prefix + "_Uniforms), " +
 					fieldsPtr + ", " + Death::format("{}", e.Fields.size()) + ", " + computeVaryingsPtr + " },\n";
 			}
 			out += "\t\t};\n\n";
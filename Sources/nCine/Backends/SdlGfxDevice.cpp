@@ -738,7 +738,7 @@ namespace nCine::Backends
 #	endif
 	}
 
-	void SdlGfxDevice::resizeSoftwareTarget(int width, int height)
+	void SdlGfxDevice::resizeSoftwareTarget(int width, int height, bool resizeFramebuffer)
 	{
 		if (width <= 0 || height <= 0 || _softwareRenderer == nullptr) {
 			return;
@@ -764,7 +764,9 @@ namespace nCine::Backends
 		_softwareTextureWidth = width;
 		_softwareTextureHeight = height;
 		// Give the root screen viewport a CPU framebuffer of the same size to render into
-		RHI::Device::ResizeScreenFramebuffer(width, height);
+		if (resizeFramebuffer) {
+			RHI::Device::ResizeScreenFramebuffer(width, height);
+		}
 	}
 
 	void SdlGfxDevice::presentSoftware()
@@ -781,10 +783,12 @@ namespace nCine::Backends
 		// UpscaleRenderPass, which resizes it on the software backend); keep the streaming texture matched to
 		// that size so SDL_RenderCopyEx below stretches the low-resolution image up to the window. The window
 		// (drawable) size no longer drives the framebuffer size — this is what makes the software renderer draw
-		// the scene at the cheap internal resolution instead of the full window resolution.
+		// the scene at the cheap internal resolution instead of the full window resolution. The framebuffer
+		// already has its size here and may be smaller than the logical one under dynamic resolution scaling,
+		// so only the texture follows it.
 		if (fb.pixels != nullptr && fb.width > 0 && fb.height > 0 &&
 			(fb.width != _softwareTextureWidth || fb.height != _softwareTextureHeight)) {
-			resizeSoftwareTarget(fb.width, fb.height);
+			resizeSoftwareTarget(fb.width, fb.height, false);
 		}
 		if (_softwareTexture == nullptr) {
 			return;
@@ -121,8 +121,8 @@ namespace nCine::Backends
 
 		/** @brief Creates the SDL2 renderer and the initial streaming target for the software present path */
 		void initSoftwarePresent(bool hasVSync);
-		/** @brief (Re)creates the streaming texture and resizes the backend screen framebuffer to match */
-		void resizeSoftwareTarget(int width, int height);
+		/** @brief (Re)creates the streaming texture and, if @p resizeFramebuffer is set, resizes the backend screen framebuffer to match */
+		void resizeSoftwareTarget(int width, int height, bool resizeFramebuffer = true);
 		/** @brief Uploads and blits the backend screen framebuffer to the window (replaces the GL buffer swap) */
 		void presentSoftware();
 #endif
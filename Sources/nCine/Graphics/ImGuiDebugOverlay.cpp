@@ -23,6 +23,9 @@
 #endif
 
 #include "RenderStatistics.h"
+#if defined(WITH_RHI_SOFTWARE)
+#	include "RHI/Software/SwTileRenderer.h"
+#endif
 #if defined(WITH_LUA)
 #	include "LuaStatistics.h"
 #endif
@@ -1380,6 +1383,10 @@ namespace nCine
 			ImGui::SameLine(180.0f);
 			ImGui::PlotLines("##1", _plotValues[ValuesType::CulledNodes].get(), _numValues, _index, nullptr, 0.0f, FLT_MAX);
 		}
+#if defined(WITH_RHI_SOFTWARE)
+		const RHI::Software::SwTileRenderer::Statistics& tileStats = RHI::Software::SwTileRenderer::GetStatistics();
+		ImGui::Text("%u deferred draws (%u binned to tiles, %u culled)", tileStats.submittedCommands, tileStats.binnedCommands, tileStats.culledCommands);
+#endif
 
 		ImGui::Text("%u/%u VAOs (%u reuses, %u bindings)", vaoPool.size, vaoPool.capacity, vaoPool.reuses, vaoPool.bindings);
 		ImGui::Text("%u/%u RenderCommands in the pool (%u retrievals)", commandPool.usedSize, commandPool.usedSize + commandPool.freeSize, commandPool.retrievals);
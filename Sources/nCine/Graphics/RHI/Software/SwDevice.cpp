@@ -5,7 +5,9 @@
 #include "SwShaderProgram.h"
 #include "SwRenderTarget.h"
 #include "SwTexture.h"
+#include "SwTileRenderer.h"
 
+#include "../../../Base/TimeStamp.h"
 #include "../../../../Shaders/Generated/ShaderCompilerTypes.h"
 #include "../../../../Shaders/Generated/SwGeneratedShaders.h"
 
@@ -103,6 +105,12 @@ namespace nCine::RHI::Software
 	std::int32_t SwDevice::_defaultFbHeight = 0;
 	std::int32_t SwDevice::_defaultFbStride = 0;
 	std::vector<std::uint8_t> SwDevice::_screenPixels;
+	std::int32_t SwDevice::_screenWidth = 0;
+	std::int32_t SwDevice::_screenHeight = 0;
+	float SwDevice::_screenScale = 1.0f;
+	SwResolutionScaler SwDevice::_resolutionScaler;
+	float SwDevice::_postProcessingMilliseconds = 0.0f;
+	std::vector<float> SwDevice::_scaledLightmap;
 	std::vector<SwDevice::PendingSoftwareLight> SwDevice::_pendingSoftwareLights;
 
 	void SwDevice::SetBlendingEnabled(bool enabled)
@@ -340,6 +348,8 @@ namespace nCine::RHI::Software
 		_defaultFbWidth = framebuffer.width;
 		_defaultFbHeight = framebuffer.height;
 		_defaultFbStride = framebuffer.strideBytes;
+		// A caller-owned surface is drawn at its own size
+		_screenScale = 1.0f;
 	}
 
 	void SwDevice::ResizeScreenFramebuffer(std::int32_t width, std::int32_t height)
@@ -347,6 +357,16 @@ namespace nCine::RHI::Software
 		if (width <= 0 || height <= 0) {
 			return;
 		}
+		_screenWidth = width;
+		_screenHeight = height;
+		AllocateScreenFramebuffer();
+	}
+
+	void SwDevice::AllocateScreenFramebuffer()
+	{
+		const float scale = _resolutionScaler.GetScale();
+		const std::int32_t width = std::max(1, std::int32_t(std::lround(_screenWidth * scale)));
+		const std::int32_t height = std::max(1, std::int32_t(std::lround(_screenHeight * scale)));
 #if defined(RHI_USE_FB16)
 		// 16-bit mode: the screen buffer stores native-endian RGB565 (2 bytes per pixel - half the memory
 		// and present bandwidth); render-target textures stay RGBA8 (see SwRaster.h)
@@ -356,6 +376,8 @@ namespace nCine::RHI::Software
 #endif
 		const std::size_t required = std::size_t(width) * std::size_t(height) * ScreenBpp;
 		if (_screenPixels.size() != required) {
+			// The workers may still be rendering into the old store asynchronously
+			SwRaster::Synchronize();
 			_screenPixels.assign(required, 0);
 		}
 		Framebuffer fb;
@@ -364,6 +386,29 @@ namespace nCine::RHI::Software
 		fb.height = height;
 		fb.strideBytes = width * std::int32_t(ScreenBpp);
 		SetDefaultFramebuffer(fb);
+		_screenScale = scale;
+	}
+
+	Recti SwDevice::ToScreenPixels(const Recti& rect)
+	{
+		const float scaleX = float(_defaultFbWidth) / float(_screenWidth);
+		const float scaleY = float(_defaultFbHeight) / float(_screenHeight);
+		// Both edges are rounded, so rectangles sharing an edge (splitscreen viewports) still share it
+		const std::int32_t x0 = std::int32_t(std::lround(rect.X * scaleX));
+		const std::int32_t y0 = std::int32_t(std::lround(rect.Y * scaleY));
+		const std::int32_t x1 = std::int32_t(std::lround((rect.X + rect.W) * scaleX));
+		const std::int32_t y1 = std::int32_t(std::lround((rect.Y + rect.H) * scaleY));
+		return Recti(x0, y0, x1 - x0, y1 - y0);
+	}
+
+	void SwDevice::SetDynamicResolution(float targetMilliseconds, float minScale, float maxScale)
+	{
+		_resolutionScaler.Configure(targetMilliseconds, minScale, maxScale);
+	}
+
+	float SwDevice::GetRenderScale()
+	{
+		return _screenScale;
 	}
 
 	Framebuffer SwDevice::GetScreenFramebuffer()
@@ -393,6 +438,13 @@ namespace nCine::RHI::Software
 			}
 			_pendingSoftwareLights.clear();
 		}
+		SwTileRenderer::EndFrame();
+
+		// This frame is presented as it is, a new scale takes effect with the first draw into the screen in the
+		// next one (see ResolveFramebuffer)
+		const float frameMilliseconds = SwTileRenderer::GetStatistics().flushMilliseconds + _postProcessingMilliseconds;
+		_postProcessingMilliseconds = 0.0f;
+		_resolutionScaler.AddFrame(frameMilliseconds);
 	}
 
 	void SwDevice::SetPendingSoftwareLighting(const float* lightmap, std::int32_t lmW, std::int32_t lmH, std::int32_t scale,
@@ -466,7 +518,7 @@ namespace nCine::RHI::Software
 			// No lighting queued for this Combine draw: the scene stays as rasterized (fully lit)
 			return;
 		}
-		const PendingSoftwareLight light = _pendingSoftwareLights.front();
+		PendingSoftwareLight light = _pendingSoftwareLights.front();
 		_pendingSoftwareLights.erase(_pendingSoftwareLights.begin());
 
 		const bool hasLighting = (light.Lightmap != nullptr && light.LmW > 0 && light.LmH > 0);
@@ -484,6 +536,42 @@ namespace nCine::RHI::Software
 			return;
 		}
 
+		const TimeStamp startTime = TimeStamp::now();
+
+		if (_screenScale != 1.0f) {
+			// The compositor works in the logical size of the screen, so the entry is mapped onto the scaled store.
+			// The lightmap keeps its texel-to-pixel ratio, each texel of the resampled map takes the value under
+			// its center. The camera position only sets the phase of the waves, it's scaled to stay in sync.
+			const Recti rect = ToScreenPixels(Recti(light.VpX, light.VpY, light.VpW, light.VpH));
+			const float scaleX = float(_defaultFbWidth) / float(_screenWidth);
+			const float scaleY = float(_defaultFbHeight) / float(_screenHeight);
+			if (hasLighting && rect.W > 0 && rect.H > 0) {
+				const std::int32_t scale = light.Scale;
+				const std::int32_t scaledLmW = (rect.W + scale - 1) / scale;
+				const std::int32_t scaledLmH = (rect.H + scale - 1) / scale;
+				_scaledLightmap.resize(std::size_t(scaledLmW) * scaledLmH * 2);
+				for (std::int32_t ty = 0; ty < scaledLmH; ty++) {
+					const std::int32_t srcY = std::min(std::int32_t((ty + 0.5f) * scale / scaleY) / scale, light.LmH - 1);
+					const float* srcRow = light.Lightmap + std::size_t(srcY) * light.LmW * 2;
+					float* dstRow = _scaledLightmap.data() + std::size_t(ty) * scaledLmW * 2;
+					for (std::int32_t tx = 0; tx < scaledLmW; tx++) {
+						const std::int32_t srcX = std::min(std::int32_t((tx + 0.5f) * scale / scaleX) / scale, light.LmW - 1);
+						dstRow[tx * 2] = srcRow[srcX * 2];
+						dstRow[tx * 2 + 1] = srcRow[srcX * 2 + 1];
+					}
+				}
+				light.Lightmap = _scaledLightmap.data();
+				light.LmW = scaledLmW;
+				light.LmH = scaledLmH;
+			}
+			light.VpX = rect.X;
+			light.VpY = rect.Y;
+			light.VpW = rect.W;
+			light.VpH = rect.H;
+			light.WaterLevelPx *= scaleY;
+			light.WaterCamY *= scaleY;
+		}
+
 		// Clamp the viewport rectangle to the actual screen buffer (the compositor submits the unclamped rect)
 		const std::int32_t vpX = std::max(0, light.VpX);
 		const std::int32_t vpY = std::max(0, light.VpY);
@@ -599,6 +687,8 @@ namespace nCine::RHI::Software
 			SwStoreFbSpan565(fbRow16, g_fb16RowStage, vpW);
 #endif
 		}
+
+		_postProcessingMilliseconds += startTime.millisecondsSince();
 	}
 
 	bool SwDevice::ResolveFramebuffer(Framebuffer& out)
@@ -614,6 +704,11 @@ namespace nCine::RHI::Software
 			}
 		}
 		if (_defaultFbPixels != nullptr) {
+			// A scale picked at the end of the last frame is applied before the first draw into the owned screen
+			// buffer, so a frame is never split between two sizes
+			if (_screenScale != _resolutionScaler.GetScale() && !_screenPixels.empty() && _defaultFbPixels == _screenPixels.data()) {
+				AllocateScreenFramebuffer();
+			}
 			out.pixels = _defaultFbPixels;
 			out.width = _defaultFbWidth;
 			out.height = _defaultFbHeight;
@@ -767,6 +862,7 @@ namespace nCine::RHI::Software
 					generatedShader.computeVaryings(uniformScratch, inst);
 				}
 				ctx.fragmentShader = generatedShader.fragment;
+				ctx.fragmentShaderSpan = generatedShader.fragmentSpan;
 				ctx.fragmentShaderUserData = uniformScratch;
 				ctx.fragmentShaderUserDataSize = uniformsSize;
 				ctx.blendingEnabled = blendOn;
@@ -850,7 +946,15 @@ namespace nCine::RHI::Software
 		// alignment - from this one flag, so the effects never need a manual Y-flip.
 		const bool isFboTarget = (_currentRenderTarget != nullptr);
 
-		const Recti viewport = (_viewport.W > 0 && _viewport.H > 0) ? _viewport : Recti(0, 0, fb.width, fb.height);
+		Recti viewport = (_viewport.W > 0 && _viewport.H > 0) ? _viewport : Recti(0, 0, fb.width, fb.height);
+		ScissorState scissor = _scissor;
+		// Viewports and scissors of the screen are given in its logical size, the scaled buffer is smaller
+		if (!isFboTarget && _screenScale != 1.0f) {
+			if (_viewport.W > 0 && _viewport.H > 0) {
+				viewport = ToScreenPixels(viewport);
+			}
+			scissor.Rect = ToScreenPixels(scissor.Rect);
+		}
 
 		const std::uint8_t* projBytes = _currentProgram->ResolveUniform("uProjectionMatrix");
 		const std::uint8_t* viewBytes = _currentProgram->ResolveUniform("uViewMatrix");
@@ -915,7 +1019,7 @@ namespace nCine::RHI::Software
 		SwRaster::SetColorBuffer(fb.pixels, fb.width, fb.height, isFboTarget);
 		SwRaster::SetViewport(viewport.X, viewport.Y, viewport.W, viewport.H);
 		// nCine hands scissor rectangles in bottom-up (OpenGL) window coordinates; the engine flips them
-		SwRaster::SetScissor(_scissor.Enabled, _scissor.Rect.X, _scissor.Rect.Y, _scissor.Rect.W, _scissor.Rect.H);
+		SwRaster::SetScissor(scissor.Enabled, scissor.Rect.X, scissor.Rect.Y, scissor.Rect.W, scissor.Rect.H);
 
 		SwBlendFactor bsrc = SwBlendFactor::One, bdst = SwBlendFactor::Zero;
 		bool blendOn = _blending.Enabled;
@@ -928,13 +1032,16 @@ namespace nCine::RHI::Software
 		// procedural sprite quad (vertexData stays null, so FetchVertex synthesizes the four corners from ff).
 		// userDataSize is the byte size of the block userData points at, so the tile renderer can snapshot it
 		// when the draw is deferred (its storage is caller-stack memory); pass 0 when there is no callback.
-		auto drawQuad = [&](const FFState& ff, FragmentShaderFn fragmentShader, void* userData, std::uint32_t userDataSize) {
+		// fragmentShaderSpan is the span entry point of the same fragment, or null to shade pixel by pixel.
+		auto drawQuad = [&](const FFState& ff, FragmentShaderFn fragmentShader, FragmentShaderSpanFn fragmentShaderSpan,
+			void* userData, std::uint32_t userDataSize) {
 			DrawContext ctx;
 			for (std::uint32_t u = 0; u < MaxTextureUnits; u++) {
 				ctx.textures[u] = _boundTextures[u];
 			}
 			ctx.ff = ff;
 			ctx.fragmentShader = fragmentShader;
+			ctx.fragmentShaderSpan = fragmentShaderSpan;
 			ctx.fragmentShaderUserData = userData;
 			ctx.fragmentShaderUserDataSize = userDataSize;
 			// PaletteRemap(+Batched) draws qualify for the tile renderer's palette-LUT fast path (the
@@ -949,8 +1056,8 @@ namespace nCine::RHI::Software
 			ctx.blendingEnabled = blendOn;
 			ctx.blendSrc = bsrc;
 			ctx.blendDst = bdst;
-			ctx.scissorEnabled = _scissor.Enabled;
-			ctx.scissorRect = _scissor.Rect;
+			ctx.scissorEnabled = scissor.Enabled;
+			ctx.scissorRect = scissor.Rect;
 			SwRaster::SetDrawContext(ctx);
 			SwRaster::Draw(PrimitiveType::TriangleStrip, 0, 4);
 		};
@@ -995,7 +1102,7 @@ namespace nCine::RHI::Software
 				DispatchMeshVerticesImpl(primitive, firstVertex, numVertices, *generatedShader,
 					_currentProgram, pv, blockData, _boundUniformRanges[binding].Size, instanceStride,
 					samplerUnit("uTexture", 0), _boundTextures, blendOn, bsrc, bdst,
-					_scissor.Enabled, _scissor.Rect);
+					scissor.Enabled, scissor.Rect);
 				SwRaster::ClearDrawContext();
 				return;
 			}
@@ -1056,7 +1163,7 @@ namespace nCine::RHI::Software
 				if (generatedShader->computeVaryings != nullptr) {
 					generatedShader->computeVaryings(uniformScratch, inst);
 				}
-				drawQuad(ff, generatedShader->fragment, uniformScratch, uniformsSize);
+				drawQuad(ff, generatedShader->fragment, generatedShader->fragmentSpan, uniformScratch, uniformsSize);
 			}
 			SwRaster::ClearDrawContext();
 			return;
@@ -1082,7 +1189,7 @@ namespace nCine::RHI::Software
 					std::memcpy(ff.spriteSize, inst + kSpriteSizeOffset, sizeof(ff.spriteSize));
 					ff.hasTexture = true;
 					ff.textureUnit = uTextureUnit;
-					drawQuad(ff, nullptr, nullptr, 0);
+					drawQuad(ff, nullptr, nullptr, nullptr, 0);
 				}
 				break;
 			}
@@ -1102,7 +1209,7 @@ namespace nCine::RHI::Software
 					std::memcpy(ff.color, inst + kColorOffset, sizeof(ff.color));
 					std::memcpy(ff.spriteSize, inst + kSpriteSizeNoTexOffset, sizeof(ff.spriteSize));
 					ff.hasTexture = false;
-					drawQuad(ff, noTexFragment, nullptr, 0);
+					drawQuad(ff, noTexFragment, nullptr, nullptr, 0);
 				}
 				break;
 			}
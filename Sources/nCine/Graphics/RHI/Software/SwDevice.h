@@ -1,5 +1,6 @@
 #pragma once
 
+#include "SwResolutionScaler.h"
 #include "../RhiTypes.h"
 #include "../../../Primitives/Rect.h"
 #include "../../../Primitives/Colorf.h"
@@ -179,11 +180,27 @@ namespace nCine::RHI::Software
 			to give that framebuffer a CPU surface sized to the drawable, then reads it back each frame with
 			@ref GetScreenFramebuffer() to present it (the software counterpart of the GL default framebuffer +
 			buffer swap). The backend owns the pixel memory; it stays valid until the next resize.
+
+			The size is the logical one the screen is drawn in. While the dynamic resolution lowers the scale
+			(see @ref SetDynamicResolution()), the buffer is allocated smaller and the viewports and scissor
+			rectangles of the draws into it are mapped onto it, so it is presented stretched.
 		*/
 		static void ResizeScreenFramebuffer(std::int32_t width, std::int32_t height);
 		/** @brief Returns the owned screen back-buffer (pixels/size/stride) for the window backend to present */
 		static Framebuffer GetScreenFramebuffer();
 
+		/**
+			@brief Lets the device lower the resolution of the screen back-buffer to hold a rasterization time per frame
+
+			Every presented frame feeds the time spent flushing the tile renderer (including the native filter
+			passes) and compositing the software lighting into a @ref SwResolutionScaler, which moves the scale of
+			the screen back-buffer in steps between @p minScale and @p maxScale. A new scale takes effect with the
+			first draw into the screen in the next frame. A zero @p targetMilliseconds disables the controller.
+		*/
+		static void SetDynamicResolution(float targetMilliseconds, float minScale, float maxScale);
+		/** @brief Returns the scale of the screen back-buffer relative to its logical size (`1` unless lowered) */
+		static float GetRenderScale();
+
 		/**
 			@brief Renders any draws the tile renderer has deferred into the current color buffer
 
@@ -267,6 +284,17 @@ namespace nCine::RHI::Software
 		static std::int32_t _defaultFbStride;
 		/** @brief Backend-owned pixel store for the screen back-buffer (only used by the present path) */
 		static std::vector<std::uint8_t> _screenPixels;
+		/** @brief Logical size of the screen back-buffer, as requested by @ref ResizeScreenFramebuffer() */
+		static std::int32_t _screenWidth;
+		static std::int32_t _screenHeight;
+		/** @brief Scale the default framebuffer is allocated at, `1` for a caller-owned one */
+		static float _screenScale;
+		/** @brief Controller of the dynamic resolution, see @ref SetDynamicResolution() */
+		static SwResolutionScaler _resolutionScaler;
+		/** @brief Time spent compositing the software lighting in the current frame */
+		static float _postProcessingMilliseconds;
+		/** @brief Lightmap resampled to the scaled screen back-buffer (see @ref ApplyPendingSoftwareLighting()) */
+		static std::vector<float> _scaledLightmap;
 
 		/** @brief One queued software-lighting/water combine, submitted by the compositor and applied at the next Combine draw */
 		struct PendingSoftwareLight
@@ -283,6 +311,10 @@ namespace nCine::RHI::Software
 
 		/** @brief Resolves the color framebuffer that draws and clears write into (RT color 0, else default) */
 		static bool ResolveFramebuffer(Framebuffer& out);
+		/** @brief (Re)allocates the owned screen back-buffer at its logical size times the current scale */
+		static void AllocateScreenFramebuffer();
+		/** @brief Maps a rectangle in the logical size of the screen onto the scaled screen back-buffer */
+		static Recti ToScreenPixels(const Recti& rect);
 		/** @brief Runs the correct C++ effect for the bound program over the given draw range (@p firstVertex indexes the bound vertex buffer; only the vertex-attribute mesh path consumes it) */
 		static void Dispatch(PrimitiveType primitive, std::int32_t firstVertex, std::int32_t numVertices);
 		/** @brief Consumes the front queued software combine (lightmap and/or water effect) and blends it in place over its viewport rectangle */
@@ -91,6 +91,8 @@ namespace nCine::RHI::Software
 		// former two 16 KB stack arrays - stack a small-stack platform cannot afford.
 		constexpr std::int32_t MaxScanBuf = 4096;
 		alignas(32) std::uint8_t g_scanBuf[MaxScanBuf * 4];
+		// Per-pixel texture coordinates of the staged row, handed to a span fragment callback
+		alignas(32) float g_scanU[MaxScanBuf];
 
 #if defined(RHI_USE_FB16)
 		// RGBA8 staging row for the 16-bit screen framebuffer: each rasterizer row-loop iteration loads the
@@ -1811,7 +1813,27 @@ namespace nCine::RHI::Software
 					}
 
 					// Phase 2: apply fragment shader callback or vertex-color tint
-					if DEATH_UNLIKELY(ctx.fragmentShader != nullptr) {
+					if DEATH_UNLIKELY(ctx.fragmentShader != nullptr && ctx.fragmentShaderSpan != nullptr) {
+						const float invTexW = 1.0f / static_cast<float>(texW > 0 ? texW : 1);
+						std::int32_t txFixShader = txBase;
+						for (std::int32_t i = 0; i < scanWidth; i++) {
+							g_scanU[i] = txFixShader / 65536.0f * invTexW;
+							txFixShader += dtxFix;
+						}
+						FragmentShaderSpanInput spanInput;
+						spanInput.rgba = scanBuf;
+						spanInput.u = g_scanU;
+						spanInput.v = tyFix / 65536.0f / static_cast<float>(texH > 0 ? texH : 1);
+						spanInput.x = xMin;
+						spanInput.y = py;
+						spanInput.count = scanWidth;
+						spanInput.texWidth = texW;
+						spanInput.texHeight = texH;
+						spanInput.textures = ctx.textures;
+						spanInput.color = ctx.ff.color;
+						spanInput.userData = ctx.fragmentShaderUserData;
+						ctx.fragmentShaderSpan(spanInput);
+					} else if DEATH_UNLIKELY(ctx.fragmentShader != nullptr) {
 						FragmentShaderInput fsInput;
 						fsInput.v = tyFix / 65536.0f / static_cast<float>(texH > 0 ? texH : 1);
 						fsInput.texWidth = texW;
@@ -2785,6 +2807,9 @@ namespace nCine::RHI::Software
 		if (SwTileRenderer::GetPendingCommandCount() > 0) {
 			SwTileRenderer::DiscardPending();
 		}
+		// The previous target's draws may still be rasterized by the workers, they don't have to be waited for
+		// unless they render into this buffer or sample it
+		SwTileRenderer::SynchronizeSurface(g_state.colorBuffer);
 
 		const std::uint8_t rb = static_cast<std::uint8_t>(r * 255.0f);
 		const std::uint8_t gb = static_cast<std::uint8_t>(g * 255.0f);
@@ -2898,6 +2923,11 @@ namespace nCine::RHI::Software
 	{
 		SwTileRenderer::Flush();
 	}
+
+	void SwRaster::Synchronize()
+	{
+		SwTileRenderer::Synchronize();
+	}
 }
 
 #endif
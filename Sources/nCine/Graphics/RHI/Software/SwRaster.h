@@ -107,6 +107,31 @@ namespace nCine::RHI::Software
 	/** @brief Optional per-pixel fragment callback; runs after sampling, before blending */
 	using FragmentShaderFn = void (*)(const FragmentShaderInput& input);
 
+	/**
+		@brief Inputs of a horizontal run of pixels handed to an optional span fragment callback
+
+		The span counterpart of @ref FragmentShaderInput: the scanline paths gather a whole run of texels
+		into a staging row and shade all of it in a single call instead of calling the per-pixel callback
+		once per pixel. @ref rgba holds @ref count consecutive 4-byte pixels and @ref u the interpolated
+		texture coordinate of each of them; @ref v and @ref y are shared by the whole run, which starts at
+		destination pixel @ref x. Every pixel must end up exactly as the per-pixel callback would leave it.
+	*/
+	struct FragmentShaderSpanInput
+	{
+		std::uint8_t* rgba;					/**< In/out pixel colors (`count * 4` bytes, RGBA order), rewritten in place */
+		const float* u;						/**< Interpolated horizontal texture coordinate of each pixel (`count` floats) */
+		float v;							/**< Interpolated vertical texture coordinate shared by the run */
+		std::int32_t x, y;					/**< Destination coordinates of the first pixel */
+		std::int32_t count;					/**< Number of pixels in the run */
+		std::int32_t texWidth, texHeight;	/**< Dimensions of the primary (unit `ff.textureUnit`) texture */
+		const SwTexture* const* textures;	/**< The bound textures (@ref MaxTextureUnits entries) */
+		const float* color;					/**< Instance color (4 floats, RGBA) */
+		void* userData;						/**< Effect-owned parameter block, opaque to the rasterizer */
+	};
+
+	/** @brief Optional span entry point of a fragment callback; shades a whole run of pixels per call */
+	using FragmentShaderSpanFn = void (*)(const FragmentShaderSpanInput& input);
+
 #if defined(RHI_USE_FB16)
 	/**
 		@brief Packs one 4-byte RGBA working pixel into an RGB565 framebuffer texel (alpha is dropped)
@@ -420,6 +445,14 @@ namespace nCine::RHI::Software
 		FFState ff;
 		/** @brief Optional per-pixel fragment callback (null for the plain textured / tinted path) */
 		FragmentShaderFn fragmentShader = nullptr;
+		/**
+		 * @brief Optional span entry point of @ref fragmentShader
+		 *
+		 * Used by the scanline paths in place of calling @ref fragmentShader per pixel; the remaining paths
+		 * (per-pixel blending, affine quads, triangles) keep calling @ref fragmentShader, which stays the
+		 * reference. Ignored when @ref fragmentShader is null.
+		 */
+		FragmentShaderSpanFn fragmentShaderSpan = nullptr;
 		/** @brief Opaque parameter block passed to @ref fragmentShader */
 		void* fragmentShaderUserData = nullptr;
 		/**
@@ -531,6 +564,14 @@ namespace nCine::RHI::Software
 			it does not return until every worker thread has finished writing.
 		*/
 		static void Flush();
+
+		/**
+			@brief Waits for the draws the tile renderer is still rasterizing asynchronously
+
+			The commands queued for the current color buffer stay queued. The device calls this before
+			the storage of a texture is modified or released, so no worker reads it at the same time.
+		*/
+		static void Synchronize();
 	};
 }
 
@@ -0,0 +1,80 @@
+#include "SwResolutionScaler.h"
+
+#include <algorithm>
+
+namespace nCine::RHI::Software
+{
+	SwResolutionScaler::SwResolutionScaler()
+		: _targetMilliseconds(0.0f), _minScale(1.0f), _maxScale(1.0f), _scale(1.0f), _averageMilliseconds(0.0f),
+			_overBudgetFrames(0), _underBudgetFrames(0), _settleFrames(0)
+	{
+	}
+
+	void SwResolutionScaler::Configure(float targetMilliseconds, float minScale, float maxScale)
+	{
+		_targetMilliseconds = std::max(targetMilliseconds, 0.0f);
+		_maxScale = std::clamp(maxScale, ScaleStep, 1.0f);
+		_minScale = std::clamp(minScale, ScaleStep, _maxScale);
+		_scale = (IsEnabled() ? _maxScale : 1.0f);
+		_averageMilliseconds = 0.0f;
+		_overBudgetFrames = 0;
+		_underBudgetFrames = 0;
+		_settleFrames = 0;
+	}
+
+	bool SwResolutionScaler::AddFrame(float milliseconds)
+	{
+		if (!IsEnabled()) {
+			return false;
+		}
+		if (_settleFrames > 0) {
+			_settleFrames--;
+			return false;
+		}
+
+		_averageMilliseconds = (_averageMilliseconds > 0.0f
+			? _averageMilliseconds + (milliseconds - _averageMilliseconds) * SmoothingFactor
+			: milliseconds);
+
+		// Lowering reacts to the frames themselves, so a lone spike isn't carried over by the smoothed time
+		if (milliseconds > _targetMilliseconds) {
+			_underBudgetFrames = 0;
+			if (++_overBudgetFrames >= DownscaleFrames && _scale > _minScale) {
+				ChangeScale(std::max(_scale - ScaleStep, _minScale));
+				return true;
+			}
+			return false;
+		}
+
+		_overBudgetFrames = 0;
+		if (_averageMilliseconds > _targetMilliseconds) {
+			_underBudgetFrames = 0;
+			return false;
+		}
+		float nextScale = std::min(_scale + ScaleStep, _maxScale);
+		if (nextScale <= _scale) {
+			return false;
+		}
+		// The time grows with the pixel count, that is with the square of the scale
+		float growth = (nextScale * nextScale) / (_scale * _scale);
+		if (_averageMilliseconds * growth > _targetMilliseconds * UpscaleHeadroom) {
+			_underBudgetFrames = 0;
+			return false;
+		}
+		if (++_underBudgetFrames >= UpscaleFrames) {
+			ChangeScale(nextScale);
+			return true;
+		}
+		return false;
+	}
+
+	void SwResolutionScaler::ChangeScale(float scale)
+	{
+		// Estimate the time at the new scale, so the next decision doesn't start from the old surface
+		_averageMilliseconds *= (scale * scale) / (_scale * _scale);
+		_scale = scale;
+		_overBudgetFrames = 0;
+		_underBudgetFrames = 0;
+		_settleFrames = SettleFrames;
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+namespace nCine::RHI::Software
+{
+	/**
+		@brief Dynamic resolution controller of the screen back-buffer
+
+		The cost of a software-rendered frame grows with the number of pixels of the surface it is rasterized into.
+		The controller is fed the time the device spent on each frame's tile flushes and CPU lighting composite
+		(@ref AddFrame()) and picks the scale of the screen back-buffer relative to its logical size, so the frame
+		time stays below the target:
+		the scale drops by one @ref ScaleStep when the time exceeds the target for a few frames in a row, and
+		rises by one step only after the smoothed time predicted for the larger surface has fit in the target
+		with some headroom for a longer while. The different thresholds and waits keep the scale from oscillating
+		between two steps, and the frames right after a change are ignored while the time settles.
+	*/
+	class SwResolutionScaler
+	{
+	public:
+		/** @brief Difference between two adjacent scales */
+		static constexpr float ScaleStep = 0.125f;
+
+		SwResolutionScaler();
+
+		/**
+			@brief Sets the frame time to hold and the range of the scale, and restarts at the largest scale
+
+			@param targetMilliseconds  Rasterization time per frame to stay below, `0` disables the controller
+			@param minScale            Smallest allowed scale, in `(0, 1]`
+			@param maxScale            Largest allowed scale, in `[minScale, 1]`
+		*/
+		void Configure(float targetMilliseconds, float minScale, float maxScale);
+
+		/** @brief Returns `true` if the controller adjusts the scale */
+		inline bool IsEnabled() const {
+			return (_targetMilliseconds > 0.0f);
+		}
+
+		/** @brief Returns the current scale, `1` when disabled */
+		inline float GetScale() const {
+			return _scale;
+		}
+
+		/** @brief Feeds the tile flush and lighting composite time of one frame, returns `true` if the scale changed */
+		bool AddFrame(float milliseconds);
+
+	private:
+		// Frames over the target needed to lower the scale, and frames with room for the next step to raise it
+		static constexpr std::int32_t DownscaleFrames = 3;
+		static constexpr std::int32_t UpscaleFrames = 90;
+		// Frames ignored after a change, the first ones at a new size also pay for reallocating the surface
+		static constexpr std::int32_t SettleFrames = 8;
+		// The time predicted for the next larger scale has to fit in this fraction of the target
+		static constexpr float UpscaleHeadroom = 0.8f;
+		// Weight of the newest frame in the smoothed time
+		static constexpr float SmoothingFactor = 0.25f;
+
+		float _targetMilliseconds;
+		float _minScale;
+		float _maxScale;
+		float _scale;
+		float _averageMilliseconds;
+		std::int32_t _overBudgetFrames;
+		std::int32_t _underBudgetFrames;
+		std::int32_t _settleFrames;
+
+		void ChangeScale(float scale);
+	};
+}
@@ -510,6 +510,34 @@ namespace nCine::RHI::Software::sw
 		rgba[2] = quantize(c.b);
 		rgba[3] = quantize(c.a);
 	}
+
+	/**
+	 * @brief Span entry point of a transpiled fragment, shades a whole run of pixels in one call
+	 *
+	 * The transpiler registers `swFragmentSpan<Name_Fragment>` next to every per-pixel fragment. The fragment
+	 * is a template argument, so the loop calls it directly rather than through a pointer, which lets the
+	 * compiler inline its body, hoist the loads of the run-invariant inputs (uniforms, instance color,
+	 * texture descriptors) out of the loop and vectorize whatever is left. Each pixel is still computed by
+	 * exactly the same code, so the output is bit-identical to calling the fragment per pixel.
+	 */
+	template<FragmentShaderFn Fragment>
+	void swFragmentSpan(const FragmentShaderSpanInput& span)
+	{
+		FragmentShaderInput in;
+		in.v = span.v;
+		in.y = span.y;
+		in.texWidth = span.texWidth;
+		in.texHeight = span.texHeight;
+		in.textures = span.textures;
+		in.color = span.color;
+		in.userData = span.userData;
+		for (std::int32_t i = 0; i < span.count; i++) {
+			in.rgba = span.rgba + i * 4;
+			in.u = span.u[i];
+			in.x = span.x + i;
+			Fragment(in);
+		}
+	}
 }
 
 #if defined(_MSC_VER)
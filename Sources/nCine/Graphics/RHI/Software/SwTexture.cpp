@@ -49,6 +49,10 @@ namespace nCine::RHI::Software
 		// Clear from the device so a destroyed texture can't dangle in _boundTextures (a later deferred draw would
 		// dereference freed memory in Dispatch)
 		SwDevice::UnbindTexture(this);
+		// The workers may still be sampling the store or rendering into it asynchronously
+		if (!_pixels.empty()) {
+			SwRaster::Synchronize();
+		}
 	}
 
 	std::int32_t SwTexture::BytesPerPixel(PixelFormat format)
@@ -158,6 +162,8 @@ namespace nCine::RHI::Software
 		if (level != 0 || data == nullptr || _pixels.empty()) {
 			return;
 		}
+		// A window the tile renderer is rasterizing asynchronously may still sample the store
+		SwRaster::Synchronize();
 		const std::int32_t srcBpp = BytesPerPixel(format);
 		const std::int32_t dstBpp = BytesPerPixel(_format);
 		for (std::int32_t y = 0; y < height; y++) {
@@ -223,6 +229,8 @@ namespace nCine::RHI::Software
 		if (pixels == nullptr || _pixels.empty()) {
 			return;
 		}
+		// A render target may still be drawn by a window the tile renderer is rasterizing asynchronously
+		SwRaster::Synchronize();
 		const std::int32_t dstBpp = BytesPerPixel(format);
 		if (dstBpp <= 0 || dstBpp == _bytesPerPixel) {
 			// The store already matches the requested layout (the common case - native R8/RG8 reads back
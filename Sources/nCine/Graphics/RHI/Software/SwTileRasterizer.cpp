@@ -696,6 +696,7 @@ namespace nCine::RHI::Software
 			// aliases with ctx through FragmentShaderInput). Flush() already waits on workersActive before
 			// returning, so ctx is guaranteed not to be overwritten while workers run.
 			const FragmentShaderFn cachedShader = ctx.fragmentShader;
+			const FragmentShaderSpanFn cachedSpanShader = (cachedShader != nullptr ? ctx.fragmentShaderSpan : nullptr);
 
 			for (std::int32_t py = yMin; py <= yMax; py++, tyFix += dtyFix) {
 				// Tile-local row offset
@@ -812,6 +813,29 @@ namespace nCine::RHI::Software
 						// a LUT the submit-time validation accepted; kept so the two-pass result is always
 						// available): the gather already fetched the expanded texels, each pixel is a lookup.
 						ApplyPaletteLutScanline(*ctx.paletteLut, scanBuf, scanWidth);
+					} else if DEATH_UNLIKELY(cachedSpanShader != nullptr) {
+						// The whole run is shaded in one call, the texture coordinates are computed exactly
+						// like the per-pixel loop below does it, so the result is the same
+						alignas(16) float scanU[SwTileRenderer::TileSize];
+						const float invTexW = 1.0f / static_cast<float>(texW > 0 ? texW : 1);
+						std::int32_t txFixShader = txBase;
+						for (std::int32_t i = 0; i < scanWidth; i++) {
+							scanU[i] = txFixShader / 65536.0f * invTexW;
+							txFixShader += dtxFix;
+						}
+						FragmentShaderSpanInput spanInput;
+						spanInput.rgba = scanBuf;
+						spanInput.u = scanU;
+						spanInput.v = tyFix / 65536.0f / static_cast<float>(texH > 0 ? texH : 1);
+						spanInput.x = xMin;
+						spanInput.y = py;
+						spanInput.count = scanWidth;
+						spanInput.texWidth = texW;
+						spanInput.texHeight = texH;
+						spanInput.textures = ctx.textures;
+						spanInput.color = ctx.ff.color;
+						spanInput.userData = ctx.fragmentShaderUserData;
+						cachedSpanShader(spanInput);
 					} else if DEATH_UNLIKELY(cachedShader != nullptr) {
 						FragmentShaderInput fsInput;
 						fsInput.v = tyFix / 65536.0f / static_cast<float>(texH > 0 ? texH : 1);
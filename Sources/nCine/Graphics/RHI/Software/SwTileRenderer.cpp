@@ -3,6 +3,8 @@
 #include "SwTileRenderer.h"
 #include "SwShaderRuntime.h"	// sw::swTexture / sw::floor / sw::mod, replicated by the palette-LUT builder
 
+#include "../../../Base/TimeStamp.h"
+
 #include <Containers/SmallVector.h>
 
 #if defined(DEATH_ENABLE_NEON)
@@ -55,22 +57,17 @@ namespace nCine::RHI::Software
 				std::int32_t alphaByteOffset;
 			};
 
-			struct TileState
+			// Everything one flush window owns: the destination and its tile grid, the command arena with the
+			// vertex / parameter-block snapshots, the bins and the palette-LUT pool. The pipelined mode keeps
+			// two of them, so the main thread keeps submitting into one while the workers rasterize the other.
+			struct FlushWindow
 			{
-				bool initialized = false;
 				std::int32_t fbWidth = 0;
 				std::int32_t fbHeight = 0;
 				std::int32_t tilesX = 0;
 				std::int32_t tilesY = 0;
 				std::int32_t totalTiles = 0;
 
-				// Viewport snapshotted into each submitted command (mirrors SwRaster's viewport so the
-				// deferred vertex transform is identical to the immediate one)
-				std::int32_t viewportX = 0;
-				std::int32_t viewportY = 0;
-				std::int32_t viewportW = 0;
-				std::int32_t viewportH = 0;
-
 				// Command arena: grows on demand up to MaxCommands and keeps both its capacity and each
 				// slot's heap allocations (vertexStorage) across frames, so steady state allocates nothing -
 				// exactly like the former fixed array, minus the ~3.6 MB worst-case static footprint. Slots
@@ -88,6 +85,12 @@ namespace nCine::RHI::Software
 				SmallVector<SwPaletteLut, 0> paletteLuts;
 				SmallVector<PaletteLutKey, 0> paletteLutKeys;
 
+#if defined(WITH_THREADS)
+				// Render-target stores the commands sample, so a clear of one of them can tell whether it has
+				// to wait for this window while it is being rasterized asynchronously (see SynchronizeSurface)
+				SmallVector<const std::uint8_t*, 8> sampledTargets;
+#endif
+
 				// Current render target buffer
 				std::uint8_t* targetBuffer = nullptr;
 				bool isFboTarget = false;
@@ -96,6 +99,29 @@ namespace nCine::RHI::Software
 				// scratch either way; only the tile <-> framebuffer copies convert)
 				bool is16Bit = false;
 #endif
+			};
+
+			struct TileState
+			{
+				bool initialized = false;
+
+				// Viewport snapshotted into each submitted command (mirrors SwRaster's viewport so the
+				// deferred vertex transform is identical to the immediate one)
+				std::int32_t viewportX = 0;
+				std::int32_t viewportY = 0;
+				std::int32_t viewportW = 0;
+				std::int32_t viewportH = 0;
+
+				// The window accepting submissions, and the other one, which is either idle or (pipelined
+				// mode only) still being rasterized by the workers
+				FlushWindow windows[2];
+				FlushWindow* open = &windows[0];
+
+				// Whether SubmitCommand drops the commands hidden behind a tile-covering opaque command
+				bool occlusionCulling = true;
+				// Counters of the frame being submitted and of the last completed one (see EndFrame)
+				Statistics frameStats = {};
+				Statistics lastFrameStats = {};
 
 				// Worker threads for parallel tile processing
 #if defined(WITH_THREADS)
@@ -112,6 +138,12 @@ namespace nCine::RHI::Software
 				std::int32_t numSpawnedWorkers = 0; // Actual threads created — may be < MaxWorkers if spawn fails
 				bool shutdownRequested = false;
 
+				// Pipelined mode: Flush() on a target change hands the window to the workers and returns at
+				// once, only the next flush, a readback or the present waits for them (see SetPipelined)
+				bool pipelined = true;
+				// Window the workers are rasterizing, or nullptr; set and cleared by the main thread only
+				FlushWindow* rasterizing = nullptr;
+
 				// Work distribution
 				std::atomic<std::int32_t> nextTileIndex{0};
 				std::int32_t flushGeneration = 0; // Incremented each Flush to prevent worker re-entry
@@ -134,6 +166,10 @@ namespace nCine::RHI::Software
 							workers[i].Join();
 						}
 					}
+					// A window handed off by the pipelined mode is complete once the workers exited; textures
+					// destroyed later in the teardown must not wait on the destroyed primitives
+					rasterizing = nullptr;
+					initialized = false;
 				}
 #endif
 			};
@@ -225,8 +261,8 @@ namespace nCine::RHI::Software
 
 				// Most draws of a window share one palette / tint (tile layers submit runs of hundreds), so a
 				// most-recent-first linear scan almost always hits its first entry
-				for (std::int32_t i = std::int32_t(g_tile.paletteLutKeys.size()) - 1; i >= 0; i--) {
-					const PaletteLutKey& k = g_tile.paletteLutKeys[i];
+				for (std::int32_t i = std::int32_t(g_tile.open->paletteLutKeys.size()) - 1; i >= 0; i--) {
+					const PaletteLutKey& k = g_tile.open->paletteLutKeys[i];
 					if (k.palette == key.palette && k.paletteVersion == key.paletteVersion &&
 					    k.paletteOffset == key.paletteOffset &&
 					    k.tint[0] == key.tint[0] && k.tint[1] == key.tint[1] &&
@@ -240,8 +276,8 @@ namespace nCine::RHI::Software
 				// index bytes, with the identical float operations in the identical order so the results are
 				// bit-exact. floor(src.r * 255 + 0.5) recovers the index byte exactly (src.r is idx / 255), so
 				// per index everything but the per-pixel source-alpha factor collapses to constants.
-				g_tile.paletteLutKeys.push_back(key);
-				SwPaletteLut& lut = g_tile.paletteLuts.emplace_back();
+				g_tile.open->paletteLutKeys.push_back(key);
+				SwPaletteLut& lut = g_tile.open->paletteLuts.emplace_back();
 				lut.tintAlpha = ctx.ff.color[3];
 				lut.indexByteOffset = indexByteOffset;
 				lut.alphaByteOffset = alphaByteOffset;
@@ -270,7 +306,7 @@ namespace nCine::RHI::Software
 					// float the fragment's own sample would produce
 					lut.palAlphaByte[i] = std::uint8_t(std::int32_t(color.a * 255.0f + 0.5f));
 				}
-				return std::int32_t(g_tile.paletteLuts.size()) - 1;
+				return std::int32_t(g_tile.open->paletteLuts.size()) - 1;
 			}
 
 			// Per-tile scratch buffer (each worker uses its own slice; slot 0 belongs to the main thread,
@@ -314,12 +350,14 @@ namespace nCine::RHI::Software
 			// =====================================================================
 			// Copy tile buffer back to framebuffer
 			// =====================================================================
-			inline void CopyTileToFramebuffer(const std::uint8_t* tile, std::uint8_t* fb,
+			inline void CopyTileToFramebuffer(const FlushWindow& window, const std::uint8_t* tile,
 			                                  std::int32_t tileX, std::int32_t tileY,
-			                                  std::int32_t tileW, std::int32_t tileH,
-			                                  std::int32_t fbWidth, std::int32_t fbHeight,
-			                                  bool flipY)
+			                                  std::int32_t tileW, std::int32_t tileH)
 			{
+				std::uint8_t* fb = window.targetBuffer;
+				const std::int32_t fbWidth = window.fbWidth;
+				const std::int32_t fbHeight = window.fbHeight;
+				const bool flipY = window.isFboTarget;
 				const std::int32_t rowBytes = tileW * 4;
 				for (std::int32_t row = 0; row < tileH; row++) {
 					const std::uint8_t* src = tile + row * TileSize * 4;
@@ -328,7 +366,7 @@ namespace nCine::RHI::Software
 						continue;
 					}
 #if defined(RHI_USE_FB16)
-					if (g_tile.is16Bit) {
+					if (window.is16Bit) {
 						// Tiles are rasterized as RGBA8; the 565 conversion happens once here, per copied row
 						SwStoreFbSpan565(fb + (dstY * fbWidth + tileX) * 2, src, tileW);
 						continue;
@@ -342,12 +380,14 @@ namespace nCine::RHI::Software
 			// =====================================================================
 			// Copy framebuffer region into tile buffer (for read-modify-write blending)
 			// =====================================================================
-			inline void CopyFramebufferToTile(std::uint8_t* tile, const std::uint8_t* fb,
+			inline void CopyFramebufferToTile(const FlushWindow& window, std::uint8_t* tile,
 			                                  std::int32_t tileX, std::int32_t tileY,
-			                                  std::int32_t tileW, std::int32_t tileH,
-			                                  std::int32_t fbWidth, std::int32_t fbHeight,
-			                                  bool flipY)
+			                                  std::int32_t tileW, std::int32_t tileH)
 			{
+				const std::uint8_t* fb = window.targetBuffer;
+				const std::int32_t fbWidth = window.fbWidth;
+				const std::int32_t fbHeight = window.fbHeight;
+				const bool flipY = window.isFboTarget;
 				const std::int32_t rowBytes = tileW * 4;
 				for (std::int32_t row = 0; row < tileH; row++) {
 					std::uint8_t* dst = tile + row * TileSize * 4;
@@ -357,7 +397,7 @@ namespace nCine::RHI::Software
 						continue;
 					}
 #if defined(RHI_USE_FB16)
-					if (g_tile.is16Bit) {
+					if (window.is16Bit) {
 						SwLoadFbSpan565(dst, fb + (srcY * fbWidth + tileX) * 2, tileW);
 						continue;
 					}
@@ -367,23 +407,34 @@ namespace nCine::RHI::Software
 				}
 			}
 
+			// Whether an opaqueOverwrite command's cover rectangle contains the whole (edge-clipped) tile
+			inline bool CoversTile(const FlushWindow& window, const DeferredCommand& cmd, std::int32_t tileCol, std::int32_t tileRow)
+			{
+				const std::int32_t tileX = tileCol * TileSize;
+				const std::int32_t tileY = tileRow * TileSize;
+				const std::int32_t tileW = std::min(TileSize, window.fbWidth - tileX);
+				const std::int32_t tileH = std::min(TileSize, window.fbHeight - tileY);
+				return (cmd.coverMinX <= tileX && cmd.coverMinY <= tileY &&
+				        cmd.coverMaxX >= tileX + tileW - 1 && cmd.coverMaxY >= tileY + tileH - 1);
+			}
+
 			// =====================================================================
 			// Process a single tile: read back if needed, render all binned commands, copy back
 			// =====================================================================
-			void ProcessTile(std::int32_t tileIndex, std::int32_t workerIndex)
+			void ProcessTile(const FlushWindow& window, std::int32_t tileIndex, std::int32_t workerIndex)
 			{
-				const std::int32_t tileCol = tileIndex % g_tile.tilesX;
-				const std::int32_t tileRow = tileIndex / g_tile.tilesX;
+				const std::int32_t tileCol = tileIndex % window.tilesX;
+				const std::int32_t tileRow = tileIndex / window.tilesX;
 				const std::int32_t tileX = tileCol * TileSize;
 				const std::int32_t tileY = tileRow * TileSize;
-				const std::int32_t tileW = std::min(TileSize, g_tile.fbWidth - tileX);
-				const std::int32_t tileH = std::min(TileSize, g_tile.fbHeight - tileY);
+				const std::int32_t tileW = std::min(TileSize, window.fbWidth - tileX);
+				const std::int32_t tileH = std::min(TileSize, window.fbHeight - tileY);
 
 				if DEATH_UNLIKELY(tileW <= 0 || tileH <= 0) {
 					return;
 				}
 
-				const auto& bin = g_tile.tileBins[tileIndex];
+				const auto& bin = window.tileBins[tileIndex];
 				if (bin.empty()) {
 					return; // No commands touch this tile - nothing to do
 				}
@@ -391,37 +442,22 @@ namespace nCine::RHI::Software
 				// Thread-local scratch buffer
 				std::uint8_t* tileBuf = g_tileScratch[workerIndex];
 
-				// Reverse-painter cull: the last command that overwrites this whole tile independent of the
-				// destination (opaqueOverwrite + full cover, see SwTileRenderer.h) makes everything before it
-				// invisible here - each earlier pixel is overwritten - so the walk starts at that command and
-				// the framebuffer read-back is skipped entirely. In a side-scroller this is the common tile:
-				// solid ground/foreground covers it and the parallax layers behind cost nothing. Subsumes the
-				// former first-command rule (a non-blended background covering the tile), which as a bonus
-				// wrongly fired for an affine quad - a rotated quad does not cover its bounding box, so the
-				// tile corners outside it kept stale scratch; opaqueOverwrite is axis-aligned only.
-				std::size_t firstCmd = 0;
-				bool needsReadBack = true;
-				for (std::size_t i = bin.size(); i > 0;) {
-					const DeferredCommand& cmd = g_tile.commands[bin[--i]];
-					if (cmd.opaqueOverwrite &&
-					    cmd.coverMinX <= tileX && cmd.coverMinY <= tileY &&
-					    cmd.coverMaxX >= tileX + tileW - 1 && cmd.coverMaxY >= tileY + tileH - 1) {
-						firstCmd = i;
-						needsReadBack = false;
-						break;
-					}
-				}
-
+				// A first command that overwrites this whole tile independent of the destination (opaqueOverwrite
+				// + full cover, see SwTileRenderer.h) replaces every pixel, so the framebuffer read-back is
+				// skipped entirely. SubmitCommand already dropped everything binned before such a command, so it
+				// is always the first one. In a side-scroller this is the common tile: solid ground/foreground
+				// covers it and the parallax layers behind cost nothing. opaqueOverwrite is axis-aligned only,
+				// a rotated quad does not cover its bounding box.
+				const DeferredCommand& firstCmd = window.commands[bin[0]];
+				const bool needsReadBack = !(firstCmd.opaqueOverwrite && CoversTile(window, firstCmd, tileCol, tileRow));
 				if (needsReadBack) {
 					// Initialize the tile with current framebuffer contents (needed for correct blending)
-					CopyFramebufferToTile(tileBuf, g_tile.targetBuffer,
-					                      tileX, tileY, tileW, tileH,
-					                      g_tile.fbWidth, g_tile.fbHeight, g_tile.isFboTarget);
+					CopyFramebufferToTile(window, tileBuf, tileX, tileY, tileW, tileH);
 				}
 
-				// Render the visible suffix of the commands binned to this tile
-				for (std::size_t k = firstCmd; k < bin.size(); k++) {
-					const DeferredCommand& cmd = g_tile.commands[bin[k]];
+				// Render the commands binned to this tile, the ones hidden behind an opaque command are already culled
+				for (std::size_t k = 0; k < bin.size(); k++) {
+					const DeferredCommand& cmd = window.commands[bin[k]];
 					TileInternal::RenderCommandToTile(
 						cmd.ctx, &cmd.prep, cmd.primType, cmd.firstVertex, cmd.count,
 						tileBuf, tileX, tileY, tileW, tileH,
@@ -429,9 +465,7 @@ namespace nCine::RHI::Software
 				}
 
 				// Copy the tile back to the framebuffer
-				CopyTileToFramebuffer(tileBuf, g_tile.targetBuffer,
-				                      tileX, tileY, tileW, tileH,
-				                      g_tile.fbWidth, g_tile.fbHeight, g_tile.isFboTarget);
+				CopyTileToFramebuffer(window, tileBuf, tileX, tileY, tileW, tileH);
 			}
 
 #if defined(WITH_THREADS)
@@ -453,15 +487,16 @@ namespace nCine::RHI::Software
 						return;
 					}
 					g_tile.workerGeneration[workerIndex] = g_tile.flushGeneration;
+					const FlushWindow& window = *g_tile.rasterizing;
 					g_tile.mutex.Unlock();
 
 					// Process tiles using an atomic counter (work-stealing pattern)
 					while (true) {
 						std::int32_t idx = g_tile.nextTileIndex.fetch_add(1, std::memory_order_relaxed);
-						if (idx >= g_tile.totalTiles) {
+						if (idx >= window.totalTiles) {
 							break;
 						}
-						ProcessTile(idx, workerIndex + 1); // +1 because the main thread uses slot 0
+						ProcessTile(window, idx, workerIndex + 1); // +1 because the main thread uses slot 0
 					}
 
 					// Signal completion
@@ -475,6 +510,138 @@ namespace nCine::RHI::Software
 				}
 			}
 #endif
+
+			// Returns a window to its empty state, keeping the capacity of everything it holds
+			void ResetWindow(FlushWindow& window)
+			{
+				window.commandCount = 0;
+				for (std::int32_t i = 0; i < window.totalTiles; i++) {
+					window.tileBins[i].clear();
+				}
+				// The palette LUTs belong to the discarded commands (keys include per-window texture versions)
+				window.paletteLuts.clear();
+				window.paletteLutKeys.clear();
+#if defined(WITH_THREADS)
+				window.sampledTargets.clear();
+#endif
+			}
+
+			// Points an empty window at a destination surface and sizes its tile grid
+			void ConfigureWindow(FlushWindow& window, std::uint8_t* buffer, std::int32_t width, std::int32_t height, bool isFboTarget)
+			{
+				window.targetBuffer = buffer;
+				window.isFboTarget = isFboTarget;
+#if defined(RHI_USE_FB16)
+				// On the software backend a non-FBO target IS the screen framebuffer - the only 16-bit surface
+				window.is16Bit = !isFboTarget;
+#endif
+				window.fbWidth = width;
+				window.fbHeight = height;
+				window.tilesX = (width + TileSize - 1) >> TileSizeShift;
+				window.tilesY = (height + TileSize - 1) >> TileSizeShift;
+				window.totalTiles = window.tilesX * window.tilesY;
+				// Grow the bin table to the actual destination's tile count (never shrunk: bins keep their
+				// heap capacity so steady state allocates nothing; the largest target seen wins)
+				if (std::int32_t(window.tileBins.size()) < window.totalTiles) {
+					window.tileBins.resize(window.totalTiles);
+				}
+			}
+
+			// Fixes up the per-command pointers once submissions to the window are done and neither the command
+			// arena nor the LUT pool grows any further, so everything stays stable for every worker:
+			// - palette-LUT pool indices resolve into pointers
+			// - the self-referential ctx pointers (fragment userData, general-draw vertices) repoint at the
+			//   command's own storage; they held the submit-time caller pointers (dead by now, but never
+			//   dereferenced since) because arena growth may have MOVED the commands after submission
+			void FinalizeWindow(FlushWindow& window)
+			{
+				for (std::int32_t i = 0; i < window.commandCount; i++) {
+					DeferredCommand& cmd = window.commands[i];
+					cmd.ctx.paletteLut = (cmd.paletteLutIndex >= 0 ? &window.paletteLuts[cmd.paletteLutIndex] : nullptr);
+					if (cmd.ctx.fragmentShader != nullptr && cmd.ctx.fragmentShaderUserData != nullptr) {
+						cmd.ctx.fragmentShaderUserData = cmd.userDataStorage;
+					}
+					if (cmd.ctx.vertexData != nullptr) {
+						cmd.ctx.vertexData = cmd.vertexStorage.data();
+					}
+				}
+			}
+
+			// Adds the time spent in its scope to the frame's statistics, the device steers the dynamic
+			// resolution by it (see SwResolutionScaler)
+			struct FlushTimer
+			{
+				TimeStamp start = TimeStamp::now();
+
+				~FlushTimer() {
+					g_tile.frameStats.flushMilliseconds += start.millisecondsSince();
+				}
+			};
+
+#if defined(WITH_THREADS)
+			// Hands a finalized window to the workers, the previous one must have been waited for already
+			void DispatchWindow(FlushWindow& window)
+			{
+				g_tile.nextTileIndex.store(0, std::memory_order_relaxed);
+
+				g_tile.mutex.Lock();
+				g_tile.rasterizing = &window;
+				g_tile.flushGeneration++;
+				// Set the active count based on the successfully spawned threads
+				g_tile.workersActive.store(g_tile.numSpawnedWorkers, std::memory_order_release);
+				g_tile.workReady.Broadcast();
+				g_tile.mutex.Unlock();
+			}
+
+			// Waits for the workers to finish the window they are rasterizing (if any) and resets that window
+			void WaitForWorkers()
+			{
+				if (g_tile.rasterizing == nullptr) {
+					return;
+				}
+
+				g_tile.mutex.Lock();
+				while (g_tile.workersActive.load(std::memory_order_acquire) > 0) {
+					g_tile.workDone.Wait(g_tile.mutex);
+				}
+				g_tile.mutex.Unlock();
+
+				// Ensure all worker pixel writes are globally visible before the engine moves on to reuse
+				// the window, read the surface or flip buffers.
+				std::atomic_thread_fence(std::memory_order_acquire);
+
+				ResetWindow(*g_tile.rasterizing);
+				g_tile.rasterizing = nullptr;
+			}
+
+			// Flush() of the pipelined mode: hands the open window to the workers without waiting for them and
+			// redirects the submissions to the other window, which inherits the destination. At most one window
+			// is in flight, so the previous one is waited for first - which also keeps the windows in order when
+			// the new one reads what the previous one wrote (sampling a render target or blending over it).
+			void FlushAsync()
+			{
+				FlushWindow& window = *g_tile.open;
+				if (!g_tile.pipelined || g_tile.numSpawnedWorkers <= 0 || window.commandCount == 0 ||
+				    window.targetBuffer == nullptr || window.totalTiles == 0) {
+					Flush();
+					return;
+				}
+
+				FlushTimer timer;
+				WaitForWorkers();
+				FinalizeWindow(window);
+				DispatchWindow(window);
+
+				FlushWindow& next = g_tile.windows[&window == &g_tile.windows[0] ? 1 : 0];
+				ConfigureWindow(next, window.targetBuffer, window.fbWidth, window.fbHeight, window.isFboTarget);
+				g_tile.open = &next;
+			}
+#else
+			void FlushAsync()
+			{
+				Flush();
+			}
+#endif
 		}
 
 		// =====================================================================
@@ -528,11 +695,11 @@ namespace nCine::RHI::Software
 			}
 #endif
 			g_tile.initialized = true;
-			g_tile.fbWidth = 0;
-			g_tile.fbHeight = 0;
-			g_tile.totalTiles = 0;
-			g_tile.commandCount = 0;
-			g_tile.targetBuffer = nullptr;
+			g_tile.open->fbWidth = 0;
+			g_tile.open->fbHeight = 0;
+			g_tile.open->totalTiles = 0;
+			g_tile.open->commandCount = 0;
+			g_tile.open->targetBuffer = nullptr;
 		}
 
 		void Shutdown()
@@ -542,6 +709,8 @@ namespace nCine::RHI::Software
 			}
 
 #if defined(WITH_THREADS)
+			WaitForWorkers();
+
 			// Signal workers to exit
 			g_tile.mutex.Lock();
 			g_tile.shutdownRequested = true;
@@ -580,49 +749,35 @@ namespace nCine::RHI::Software
 
 			// The device sets the same target before every draw; do nothing (and never flush) when nothing
 			// changed so consecutive draws to the same surface keep batching into one flush.
-			if (buffer == g_tile.targetBuffer && width == g_tile.fbWidth &&
-			    height == g_tile.fbHeight && isFboTarget == g_tile.isFboTarget) {
+			if (buffer == g_tile.open->targetBuffer && width == g_tile.open->fbWidth &&
+			    height == g_tile.open->fbHeight && isFboTarget == g_tile.open->isFboTarget) {
 				return;
 			}
 
-			// The target is actually changing: flush whatever is still queued for the old one first
-			if (g_tile.commandCount > 0) {
-				Flush();
+			// The target is actually changing: flush whatever is still queued for the old one first (in the
+			// pipelined mode, the workers rasterize it while the draws for the new target are being submitted)
+			if (g_tile.open->commandCount > 0) {
+				FlushAsync();
 			}
 
 			// Sanity guard only (the bin table below is sized dynamically); a nonsensical target disables
 			// the layer until the next valid one
 			if DEATH_UNLIKELY(width > MaxSurfaceDimension || height > MaxSurfaceDimension || width <= 0 || height <= 0) {
-				g_tile.targetBuffer = nullptr;
-				g_tile.fbWidth = 0;
-				g_tile.fbHeight = 0;
-				g_tile.totalTiles = 0;
-				g_tile.isFboTarget = false;
+				g_tile.open->targetBuffer = nullptr;
+				g_tile.open->fbWidth = 0;
+				g_tile.open->fbHeight = 0;
+				g_tile.open->totalTiles = 0;
+				g_tile.open->isFboTarget = false;
 				return;
 			}
 
-			g_tile.targetBuffer = buffer;
-			g_tile.isFboTarget = isFboTarget;
-#if defined(RHI_USE_FB16)
-			// On the software backend a non-FBO target IS the screen framebuffer - the only 16-bit surface
-			g_tile.is16Bit = !isFboTarget;
-#endif
-			g_tile.fbWidth = width;
-			g_tile.fbHeight = height;
-			g_tile.tilesX = (width + TileSize - 1) >> TileSizeShift;
-			g_tile.tilesY = (height + TileSize - 1) >> TileSizeShift;
-			g_tile.totalTiles = g_tile.tilesX * g_tile.tilesY;
-			// Grow the bin table to the actual destination's tile count (never shrunk: bins keep their
-			// heap capacity so steady state allocates nothing; the largest target seen wins)
-			if (std::int32_t(g_tile.tileBins.size()) < g_tile.totalTiles) {
-				g_tile.tileBins.resize(g_tile.totalTiles);
-			}
+			ConfigureWindow(*g_tile.open, buffer, width, height, isFboTarget);
 		}
 
 		bool SubmitCommand(const DrawContext& ctx, PrimitiveType type,
 		                   std::int32_t firstVertex, std::int32_t count)
 		{
-			if DEATH_UNLIKELY(!g_tile.initialized || g_tile.targetBuffer == nullptr) {
+			if DEATH_UNLIKELY(!g_tile.initialized || g_tile.open->targetBuffer == nullptr) {
 				return false;
 			}
 
@@ -646,10 +801,10 @@ namespace nCine::RHI::Software
 				}
 			}
 
-			if DEATH_UNLIKELY(g_tile.commandCount >= MaxCommands) {
+			if DEATH_UNLIKELY(g_tile.open->commandCount >= MaxCommands) {
 				// Buffer full - flush and retry, or fall back to immediate
-				Flush();
-				if (g_tile.commandCount >= MaxCommands) return false;
+				FlushAsync();
+				if (g_tile.open->commandCount >= MaxCommands) return false;
 			}
 
 			// Use the viewport snapshot for the NDC→screen transform (mirrors SwRaster::SetViewport). Fall
@@ -661,8 +816,8 @@ namespace nCine::RHI::Software
 			if (vpW <= 0 || vpH <= 0) {
 				vpX = 0;
 				vpY = 0;
-				vpW = g_tile.fbWidth;
-				vpH = g_tile.fbHeight;
+				vpW = g_tile.open->fbWidth;
+				vpH = g_tile.open->fbHeight;
 			}
 
 			// Acquire a command slot, growing the arena on demand (geometric growth, capacity and each
@@ -670,11 +825,11 @@ namespace nCine::RHI::Software
 			// that is safe because their self-referential ctx pointers are only fixed up (and dereferenced)
 			// at Flush. A discarded command simply never increments commandCount, so the slot is reused by
 			// the next submission.
-			const std::int32_t cmdIdx = g_tile.commandCount;
-			if (cmdIdx >= std::int32_t(g_tile.commands.size())) {
-				g_tile.commands.emplace_back();
+			const std::int32_t cmdIdx = g_tile.open->commandCount;
+			if (cmdIdx >= std::int32_t(g_tile.open->commands.size())) {
+				g_tile.open->commands.emplace_back();
 			}
-			DeferredCommand& cmd = g_tile.commands[cmdIdx];
+			DeferredCommand& cmd = g_tile.open->commands[cmdIdx];
 			cmd.ctx = ctx;
 			// Snapshot the fragment-callback parameter block into the command's own storage (ctx points at
 			// caller-stack memory, which is still alive here). cmd.ctx.fragmentShaderUserData keeps the
@@ -695,7 +850,7 @@ namespace nCine::RHI::Software
 			// scissorRect.Y is stored in top-down screen space so the tile rasterizer can use it directly as a
 			// pixel-row clip. ctx.scissorRect.Y is bottom-up (the RHI scissor convention), so flip it here.
 			if DEATH_UNLIKELY(ctx.scissorEnabled) {
-				cmd.ctx.scissorRect.Y = g_tile.fbHeight - ctx.scissorRect.Y - ctx.scissorRect.H;
+				cmd.ctx.scissorRect.Y = g_tile.open->fbHeight - ctx.scissorRect.Y - ctx.scissorRect.H;
 			}
 
 			// Compute the screen-space AABB from the draw command
@@ -713,8 +868,8 @@ namespace nCine::RHI::Software
 				}
 				screenMinX = std::max(0, static_cast<std::int32_t>(cmd.prep.fxMin));
 				screenMinY = std::max(0, static_cast<std::int32_t>(cmd.prep.fyMin));
-				screenMaxX = std::min(g_tile.fbWidth - 1, static_cast<std::int32_t>(cmd.prep.fxMax));
-				screenMaxY = std::min(g_tile.fbHeight - 1, static_cast<std::int32_t>(cmd.prep.fyMax));
+				screenMaxX = std::min(g_tile.open->fbWidth - 1, static_cast<std::int32_t>(cmd.prep.fxMax));
+				screenMaxY = std::min(g_tile.open->fbHeight - 1, static_cast<std::int32_t>(cmd.prep.fyMax));
 				accurateBounds = true;
 			} else if (cmd.ctx.vertexData != nullptr) {
 				// General vertex-fed draw: bin by the transformed vertices' bounding box (the same NDC ->
@@ -735,24 +890,24 @@ namespace nCine::RHI::Software
 				}
 				screenMinX = std::max(0, static_cast<std::int32_t>(fxMin) - 1);
 				screenMinY = std::max(0, static_cast<std::int32_t>(fyMin) - 1);
-				screenMaxX = std::min(g_tile.fbWidth - 1, static_cast<std::int32_t>(fxMax) + 1);
-				screenMaxY = std::min(g_tile.fbHeight - 1, static_cast<std::int32_t>(fyMax) + 1);
+				screenMaxX = std::min(g_tile.open->fbWidth - 1, static_cast<std::int32_t>(fxMax) + 1);
+				screenMaxY = std::min(g_tile.open->fbHeight - 1, static_cast<std::int32_t>(fyMax) + 1);
 				accurateBounds = false;
 			} else {
 				// For non-procedural quads, use full framebuffer bounds (conservative)
 				cmd.prep.valid = false;
 				screenMinX = 0;
 				screenMinY = 0;
-				screenMaxX = g_tile.fbWidth - 1;
-				screenMaxY = g_tile.fbHeight - 1;
+				screenMaxX = g_tile.open->fbWidth - 1;
+				screenMaxY = g_tile.open->fbHeight - 1;
 				accurateBounds = false;
 			}
 
 			// Scissor clip — Y always flipped for tile culling because tile rows are indexed top-down in
 			// screen space but the framebuffer stores rows bottom-up.
 			if DEATH_UNLIKELY(ctx.scissorEnabled) {
-				std::int32_t scY0 = g_tile.fbHeight - ctx.scissorRect.Y - ctx.scissorRect.H;
-				std::int32_t scY1 = g_tile.fbHeight - 1 - ctx.scissorRect.Y;
+				std::int32_t scY0 = g_tile.open->fbHeight - ctx.scissorRect.Y - ctx.scissorRect.H;
+				std::int32_t scY1 = g_tile.open->fbHeight - 1 - ctx.scissorRect.Y;
 				screenMinX = std::max(screenMinX, ctx.scissorRect.X);
 				screenMinY = std::max(screenMinY, scY0);
 				screenMaxX = std::min(screenMaxX, ctx.scissorRect.X + ctx.scissorRect.W - 1);
@@ -783,7 +938,7 @@ namespace nCine::RHI::Software
 					} else if (cmd.paletteLutIndex >= 0) {
 						// Every LUT entry opaque and the source alpha a constant 1 - each sampled texel,
 						// whatever its index, lands on an opaque entry
-						const SwPaletteLut& lut = g_tile.paletteLuts[cmd.paletteLutIndex];
+						const SwPaletteLut& lut = g_tile.open->paletteLuts[cmd.paletteLutIndex];
 						overwrites = (lut.allOpaque && lut.alphaByteOffset == -1);
 					}
 				}
@@ -823,106 +978,175 @@ namespace nCine::RHI::Software
 			cmd.screenMaxX = screenMaxX;
 			cmd.screenMaxY = screenMaxY;
 			cmd.boundsAreAccurate = accurateBounds;
-			g_tile.commandCount++;
+			g_tile.open->commandCount++;
+
+#if defined(WITH_THREADS)
+			// Remember the render targets the command samples, so a clear of one of them waits only when
+			// this window might still be reading it (see SynchronizeSurface)
+			for (std::uint32_t unit = 0; unit < MaxTextureUnits; unit++) {
+				const SwTexture* texture = ctx.textures[unit];
+				if (texture != nullptr && texture->IsRenderTarget()) {
+					auto& sampledTargets = g_tile.open->sampledTargets;
+					const std::uint8_t* pixels = texture->GetPixels(0);
+					if (std::find(sampledTargets.begin(), sampledTargets.end(), pixels) == sampledTargets.end()) {
+						sampledTargets.push_back(pixels);
+					}
+				}
+			}
+#endif
 
 			// Bin into overlapping tiles (clamp to the valid tile range)
 			const std::int32_t tileMinCol = std::max(0, screenMinX >> TileSizeShift);
-			const std::int32_t tileMaxCol = std::min(g_tile.tilesX - 1, screenMaxX >> TileSizeShift);
+			const std::int32_t tileMaxCol = std::min(g_tile.open->tilesX - 1, screenMaxX >> TileSizeShift);
 			const std::int32_t tileMinRow = std::max(0, screenMinY >> TileSizeShift);
-			const std::int32_t tileMaxRow = std::min(g_tile.tilesY - 1, screenMaxY >> TileSizeShift);
-
+			const std::int32_t tileMaxRow = std::min(g_tile.open->tilesY - 1, screenMaxY >> TileSizeShift);
+
+			// Occlusion cull: a destination-independent full write (opaqueOverwrite, see SwTileRenderer.h) that
+			// covers a whole tile hides everything binned to that tile before it, so those entries are dropped
+			// here instead of being drawn and overwritten. The last such command is therefore always the first
+			// entry of its bin, which lets ProcessTile skip the framebuffer read-back by checking just that one.
+			const bool cullsTiles = (cmd.opaqueOverwrite && g_tile.occlusionCulling);
+			std::uint32_t culledCount = 0;
 			for (std::int32_t row = tileMinRow; row <= tileMaxRow; row++) {
 				for (std::int32_t col = tileMinCol; col <= tileMaxCol; col++) {
-					const std::int32_t tileIdx = row * g_tile.tilesX + col;
-					g_tile.tileBins[tileIdx].push_back(static_cast<std::uint16_t>(cmdIdx));
+					const std::int32_t tileIdx = row * g_tile.open->tilesX + col;
+					auto& bin = g_tile.open->tileBins[tileIdx];
+					if (cullsTiles && !bin.empty() && CoversTile(*g_tile.open, cmd, col, row)) {
+						culledCount += std::uint32_t(bin.size());
+						bin.clear();
+					}
+					bin.push_back(static_cast<std::uint16_t>(cmdIdx));
 				}
 			}
 
+			g_tile.frameStats.submittedCommands++;
+			g_tile.frameStats.binnedCommands += std::uint32_t((tileMaxRow - tileMinRow + 1) * (tileMaxCol - tileMinCol + 1));
+			g_tile.frameStats.culledCommands += culledCount;
+
 			return true;
 		}
 
 		void Flush()
 		{
-			if DEATH_UNLIKELY(!g_tile.initialized || g_tile.commandCount == 0) {
+			if DEATH_UNLIKELY(!g_tile.initialized) {
+				return;
+			}
+
+			FlushTimer timer;
+#if defined(WITH_THREADS)
+			// A window handed off by the pipelined mode lands first, the caller expects the pixels complete
+			WaitForWorkers();
+#endif
+
+			FlushWindow& window = *g_tile.open;
+			if (window.commandCount == 0) {
 				return;
 			}
 
 			// The target buffer must have been set via SetTargetBuffer()
-			if (g_tile.targetBuffer == nullptr || g_tile.totalTiles == 0) {
+			if (window.targetBuffer == nullptr || window.totalTiles == 0) {
 				DiscardPending();
 				return;
 			}
 
-			// Fix up the per-command pointers now that submissions are done for this window and neither the
-			// command arena nor the LUT pool grows any further, so everything stays stable for every worker:
-			// - palette-LUT pool indices resolve into pointers
-			// - the self-referential ctx pointers (fragment userData, general-draw vertices) repoint at the
-			//   command's own storage; they held the submit-time caller pointers (dead by now, but never
-			//   dereferenced since) because arena growth may have MOVED the commands after submission
-			for (std::int32_t i = 0; i < g_tile.commandCount; i++) {
-				DeferredCommand& cmd = g_tile.commands[i];
-				cmd.ctx.paletteLut = (cmd.paletteLutIndex >= 0 ? &g_tile.paletteLuts[cmd.paletteLutIndex] : nullptr);
-				if (cmd.ctx.fragmentShader != nullptr && cmd.ctx.fragmentShaderUserData != nullptr) {
-					cmd.ctx.fragmentShaderUserData = cmd.userDataStorage;
-				}
-				if (cmd.ctx.vertexData != nullptr) {
-					cmd.ctx.vertexData = cmd.vertexStorage.data();
-				}
-			}
+			FinalizeWindow(window);
 
 #if defined(WITH_THREADS)
 			// Multi-threaded tile processing using an atomic work counter
-			g_tile.nextTileIndex.store(0, std::memory_order_relaxed);
-
-			g_tile.mutex.Lock();
-			g_tile.flushGeneration++;
-			// Set the active count based on the successfully spawned threads
-			g_tile.workersActive.store(g_tile.numSpawnedWorkers, std::memory_order_release);
-			g_tile.workReady.Broadcast();
-			g_tile.mutex.Unlock();
+			DispatchWindow(window);
 
 			// The main thread also processes tiles (worker slot 0)
 			while (true) {
 				std::int32_t idx = g_tile.nextTileIndex.fetch_add(1, std::memory_order_relaxed);
-				if (idx >= g_tile.totalTiles) break;
-				ProcessTile(idx, 0);
+				if (idx >= window.totalTiles) break;
+				ProcessTile(window, idx, 0);
 			}
 
-			// Wait for all workers to finish
-			g_tile.mutex.Lock();
-			while (g_tile.workersActive.load(std::memory_order_acquire) > 0) {
-				g_tile.workDone.Wait(g_tile.mutex);
-			}
-			g_tile.mutex.Unlock();
-
-			// Ensure all worker pixel writes are globally visible before the engine moves on to
-			// DiscardPending or flipping buffers.
-			std::atomic_thread_fence(std::memory_order_acquire);
+			// Wait for all workers to finish, then reset the window for the next frame
+			WaitForWorkers();
 #else
 			// Single-threaded fallback: process tiles sequentially
-			for (std::int32_t i = 0; i < g_tile.totalTiles; i++) {
-				ProcessTile(i, 0);
+			for (std::int32_t i = 0; i < window.totalTiles; i++) {
+				ProcessTile(window, i, 0);
 			}
-#endif
 
 			// Reset for the next frame
-			DiscardPending();
+			ResetWindow(window);
+#endif
 		}
 
 		void DiscardPending()
 		{
-			g_tile.commandCount = 0;
-			for (std::int32_t i = 0; i < g_tile.totalTiles; i++) {
-				g_tile.tileBins[i].clear();
+			ResetWindow(*g_tile.open);
+		}
+
+		void SetOcclusionCulling(bool enabled)
+		{
+			g_tile.occlusionCulling = enabled;
+		}
+
+		void EndFrame()
+		{
+			g_tile.lastFrameStats = g_tile.frameStats;
+			g_tile.frameStats = {};
+		}
+
+		const Statistics& GetStatistics()
+		{
+			return g_tile.lastFrameStats;
+		}
+
+		void SetPipelined(bool enabled)
+		{
+#if defined(WITH_THREADS)
+			if (!enabled && g_tile.initialized) {
+				WaitForWorkers();
+			}
+			g_tile.pipelined = enabled;
+#else
+			static_cast<void>(enabled);
+#endif
+		}
+
+		bool IsPipelined()
+		{
+#if defined(WITH_THREADS)
+			return (g_tile.pipelined && g_tile.numSpawnedWorkers > 0);
+#else
+			return false;
+#endif
+		}
+
+		void Synchronize()
+		{
+#if defined(WITH_THREADS)
+			if (g_tile.initialized && g_tile.rasterizing != nullptr) {
+				FlushTimer timer;
+				WaitForWorkers();
+			}
+#endif
+		}
+
+		void SynchronizeSurface(const std::uint8_t* buffer)
+		{
+#if defined(WITH_THREADS)
+			const FlushWindow* window = g_tile.rasterizing;
+			if (!g_tile.initialized || window == nullptr || buffer == nullptr) {
+				return;
+			}
+			if (window->targetBuffer == buffer ||
+			    std::find(window->sampledTargets.begin(), window->sampledTargets.end(), buffer) != window->sampledTargets.end()) {
+				FlushTimer timer;
+				WaitForWorkers();
 			}
-			// The palette LUTs belong to the discarded commands (keys include per-window texture versions)
-			g_tile.paletteLuts.clear();
-			g_tile.paletteLutKeys.clear();
+#else
+			static_cast<void>(buffer);
+#endif
 		}
 
 		std::int32_t GetPendingCommandCount()
 		{
-			return g_tile.commandCount;
+			return g_tile.open->commandCount;
 		}
 	}
 }
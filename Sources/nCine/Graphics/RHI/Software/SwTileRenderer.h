@@ -29,6 +29,14 @@ namespace nCine::RHI::Software
 		caller runs it through the immediate rasterizer instead. @ref Flush() is called before the surface
 		is read back (present) or a different render target is bound, and it never returns until every
 		worker has finished writing, so the pixels are complete and race-free by the time it does.
+
+		In the pipelined mode (see @ref SetPipelined()), a change of the render target and a full command
+		arena don't wait for the workers. The state of one flush window (the command arena with its vertex
+		and parameter-block snapshots, the tile bins and the palette LUTs) is double-buffered, so the
+		window is handed off to the workers and the main thread continues submitting the draws for the next
+		target into the other window. Only @ref Flush(), @ref Synchronize() and @ref SynchronizeSurface()
+		wait for the workers, which happens at present, on a readback of a surface and before the CPU
+		writes to a surface or a texture directly.
 	*/
 	namespace SwTileRenderer
 	{
@@ -228,9 +236,9 @@ namespace nCine::RHI::Software
 			 * Set at submit time for an axis-aligned procedural quad whose write is destination-independent:
 			 * blending disabled, an opaque constant fill, or a palette draw whose LUT maps every index to an
 			 * opaque pixel - all under the fast blend pair, where an opaque source is a plain copy. Everything
-			 * drawn before such a command inside its cover rectangle is overwritten, so a tile it fully covers
-			 * starts its command walk there and skips the framebuffer read-back (the reverse-painter cull in
-			 * `ProcessTile`).
+			 * drawn before such a command inside its cover rectangle is overwritten, so @ref SubmitCommand()
+			 * drops everything binned before it to a tile it fully covers, and the tile skips the framebuffer
+			 * read-back (see @ref SetOcclusionCulling()).
 			 */
 			bool opaqueOverwrite;
 			/** @brief Inclusive screen-space pixel rectangle the command is guaranteed to overwrite (exact drawn extent, scissor applied; valid when @ref opaqueOverwrite) */
@@ -271,6 +279,19 @@ namespace nCine::RHI::Software
 			PreparedQuad prep;
 		};
 
+		/** @brief Per-frame counters of the deferred commands */
+		struct Statistics
+		{
+			/** @brief Commands accepted for deferral */
+			std::uint32_t submittedCommands;
+			/** @brief Entries added to the tile bins (one per command and tile it overlaps) */
+			std::uint32_t binnedCommands;
+			/** @brief Entries dropped from the tile bins because a later opaque command covers the whole tile */
+			std::uint32_t culledCommands;
+			/** @brief Time the calling thread spent in tile flushes, rasterizing or waiting for the workers, in milliseconds */
+			float flushMilliseconds;
+		};
+
 		/** @brief Spins up the worker pool and resets the queue (idempotent; called once at startup) */
 		void Initialize();
 
@@ -320,6 +341,51 @@ namespace nCine::RHI::Software
 		/** @brief Drops all queued commands without rendering them (e.g. after a full-surface clear) */
 		void DiscardPending();
 
+		/**
+			@brief Enables or disables the occlusion culling of tiles (enabled by default)
+
+			When enabled, a command that overwrites a whole tile regardless of the destination (see
+			@ref DeferredCommand::opaqueOverwrite) drops every command binned to that tile before it. Takes
+			effect for the commands submitted afterwards.
+		*/
+		void SetOcclusionCulling(bool enabled);
+
+		/** @brief Closes the frame's statistics, called by the device once per frame */
+		void EndFrame();
+
+		/** @brief Returns the statistics of the last completed frame */
+		const Statistics& GetStatistics();
+
+		/**
+			@brief Enables or disables the pipelined mode (enabled by default)
+
+			Has an effect only on a build with `WITH_THREADS` and when at least one worker thread is running,
+			otherwise every flush is rasterized synchronously. Disabling the mode waits for the window
+			the workers are still rasterizing.
+		*/
+		void SetPipelined(bool enabled);
+
+		/** @brief Returns `true` if flushes on a render-target change are rasterized asynchronously */
+		bool IsPipelined();
+
+		/**
+			@brief Waits until the workers finish the window handed off by the pipelined mode
+
+			Unlike @ref Flush(), the commands still queued for the current target stay queued. Must be called
+			before the CPU modifies or releases the storage of any texture, because the window may still be
+			sampling it. A no-op when nothing is in flight.
+		*/
+		void Synchronize();
+
+		/**
+			@brief Waits for the window handed off by the pipelined mode only if it uses the given surface
+
+			Used before the CPU writes to a surface directly (e.g. a clear), so binding and clearing the next
+			render target doesn't wait for the workers unless they are still rendering into that surface or
+			sampling it.
+		*/
+		void SynchronizeSurface(const std::uint8_t* buffer);
+
 		/** @brief Returns the number of commands currently queued */
 		std::int32_t GetPendingCommandCount();
 	}
@@ -14,13 +14,17 @@
 
 #include "nCine/Graphics/RHI/Software/SwBackend.h"
 #include "nCine/Graphics/RHI/Software/SwRaster.h"
+#include "nCine/Graphics/RHI/Software/SwResolutionScaler.h"
+#include "nCine/Graphics/RHI/Software/SwTileRenderer.h"
 #include "Shaders/Generated/DefaultSprite.h"
 #include "Shaders/Generated/TexturedBackground.h"
 #include "Shaders/Generated/TexturedBackgroundCircle.h"
 #include "Shaders/Generated/Combine.h"
 #include "Shaders/Generated/PaletteRemap.h"
+#include "Shaders/Generated/SwGeneratedShaders.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <cstdio>
@@ -1162,6 +1166,411 @@ bool RunPaletteTest(const char* baseDir)
 	return wroteAll;
 }
 
+// --- Span fragment entry points (bit-exactness against the per-pixel reference) ---
+//
+// Every generated fragment is registered with a span entry point the scanline paths call once per run of
+// pixels. The per-pixel fragment stays the reference: this draws the same sprite through each generated
+// shader twice straight through SwRaster, once with the span entry point and once without it, and requires
+// byte-identical targets. The sprite is placed off the tile grid so runs start and end mid-tile, and it is
+// drawn both opaque and with the fast blend pair (the two states the scanline paths accept).
+
+bool RunFragmentSpanTest(const char* baseDir)
+{
+	constexpr std::int32_t W = 96, H = 96;
+	std::printf("\n=== Span fragment entry points ===\n");
+
+	RHI::Texture texture(TextureTarget::Texture2D);
+	UploadRgba(texture, 16, 16, [](std::int32_t x, std::int32_t y, std::uint8_t* p) {
+		p[0] = std::uint8_t(x * 16);
+		p[1] = std::uint8_t(y * 16);
+		p[2] = std::uint8_t((x ^ y) * 16);
+		p[3] = std::uint8_t(64 + (x + y) * 6);
+	});
+
+	// Top-left ortho projection with the sprite translated to (5, 7), its corners span 83x77 pixels
+	float mvp[16];
+	BuildOrtho(W, H, mvp);
+	mvp[12] += mvp[0] * 5.0f;
+	mvp[13] += mvp[5] * 7.0f;
+
+	// Arbitrary but deterministic uniforms, the same for both draws of a shader
+	alignas(16) std::uint8_t userData[RHI::Software::MaxFragmentShaderUserDataSize];
+	for (std::uint32_t i = 0; i < RHI::Software::MaxFragmentShaderUserDataSize / sizeof(float); i++) {
+		const float value = 0.125f * float((i * 7) % 13) - 0.5f;
+		std::memcpy(userData + i * sizeof(float), &value, sizeof(float));
+	}
+
+	std::vector<std::uint8_t> reference(std::size_t(W) * H * 4);
+	std::vector<std::uint8_t> spans(std::size_t(W) * H * 4);
+
+	auto drawInto = [&](std::vector<std::uint8_t>& target, const RHI::Software::SwGeneratedShaderInfo& info, bool useSpan, bool blend) {
+		for (std::size_t i = 0; i < target.size(); i += 4) {
+			target[i] = 40; target[i + 1] = 80; target[i + 2] = 120; target[i + 3] = 255;
+		}
+		RHI::Software::SwRaster::SetColorBuffer(target.data(), W, H, false);
+		RHI::Software::SwRaster::SetViewport(0, 0, W, H);
+		RHI::Software::SwRaster::SetScissor(false, 0, 0, 0, 0);
+		RHI::Software::SwRaster::SetBlending(blend, RHI::Software::SwBlendFactor::SrcAlpha, RHI::Software::SwBlendFactor::OneMinusSrcAlpha);
+
+		RHI::Software::DrawContext ctx;
+		for (std::uint32_t u = 0; u < RHI::Software::MaxTextureUnits; u++) {
+			ctx.textures[u] = &texture;
+		}
+		std::memcpy(ctx.ff.mvpMatrix, mvp, sizeof(mvp));
+		std::memcpy(ctx.ff.texRect, kTexRectFull, sizeof(kTexRectFull));
+		ctx.ff.color[0] = 0.9f; ctx.ff.color[1] = 0.7f; ctx.ff.color[2] = 0.5f; ctx.ff.color[3] = 0.8f;
+		ctx.ff.spriteSize[0] = 83.0f;
+		ctx.ff.spriteSize[1] = 77.0f;
+		ctx.ff.hasTexture = true;
+		ctx.ff.textureUnit = 0;
+		ctx.fragmentShader = info.fragment;
+		ctx.fragmentShaderSpan = (useSpan ? info.fragmentSpan : nullptr);
+		ctx.fragmentShaderUserData = userData;
+		ctx.fragmentShaderUserDataSize = info.uniformsSize;
+		ctx.blendingEnabled = blend;
+		ctx.blendSrc = RHI::Software::SwBlendFactor::SrcAlpha;
+		ctx.blendDst = RHI::Software::SwBlendFactor::OneMinusSrcAlpha;
+		RHI::Software::SwRaster::SetDrawContext(ctx);
+		RHI::Software::SwRaster::Draw(PrimitiveType::TriangleStrip, 0, 4);
+		RHI::Software::SwRaster::ClearDrawContext();
+		RHI::Software::SwRaster::Flush();
+	};
+
+	bool wrote = true;
+	for (const RHI::Software::SwGeneratedShaderInfo& info : RHI::Software::SwGeneratedShaders) {
+		for (bool blend : { false, true }) {
+			drawInto(reference, info, false, blend);
+			drawInto(spans, info, true, blend);
+
+			std::size_t diffs = 0;
+			for (std::size_t i = 0; i < reference.size(); i++) {
+				if (reference[i] != spans[i]) {
+					diffs++;
+				}
+			}
+			g_checks++;
+			if (diffs == 0) {
+				std::printf("  ok   %-36s %s span == per-pixel\n", info.name, blend ? "blended" : "opaque ");
+			} else {
+				g_failures++;
+				std::printf("  FAIL %-36s %s span differs in %zu bytes\n", info.name, blend ? "blended" : "opaque ", diffs);
+			}
+		}
+		if (std::strcmp(info.name, "Tinted") == 0) {
+			char outputPath[512];
+			MakePath(baseDir, "sw_fragment_span.png", outputPath, sizeof(outputPath));
+			wrote = WritePng(outputPath, spans.data(), W, H, W * 4);
+			std::printf("PNG: %s (%s)\n", outputPath, wrote ? "ok" : "FAILED");
+		}
+	}
+
+	// Detach the tile renderer from the local buffers before they go out of scope
+	RHI::Software::SwRaster::SetColorBuffer(nullptr, 0, 0, false);
+	return wrote;
+}
+
+// --- Pipelined tile flush: off-screen passes rasterized asynchronously, identical to the synchronous flush ---
+//
+// Renders the same frames twice straight through SwRaster, once with the tile renderer's pipelined mode and
+// once without it, and requires byte-identical screens. Each frame renders sprites into one render target,
+// composites it into a second one, updates the sprite texture in the middle of the frame and composites the
+// second target into the screen, so every synchronization point (a target change, a clear of a sampled
+// target, a texture update and the present) is exercised. Also reports the frame time of both modes.
+
+bool RunPipelinedFlushTest(const char* baseDir)
+{
+	constexpr std::int32_t W = 320, H = 192;
+	constexpr std::int32_t Frames = 40;
+	std::printf("\n=== Pipelined tile flush ===\n");
+
+	RHI::Texture sprite(TextureTarget::Texture2D);
+	RHI::Texture sceneTarget(TextureTarget::Texture2D);
+	RHI::Texture compositeTarget(TextureTarget::Texture2D);
+	for (RHI::Texture* target : { &sceneTarget, &compositeTarget }) {
+		UploadRgba(*target, W, H, [](std::int32_t, std::int32_t, std::uint8_t* p) {
+			p[0] = 0; p[1] = 0; p[2] = 0; p[3] = 0;
+		});
+		target->SetRenderTarget(true);
+	}
+
+	// The sprite texture is allocated once and then only updated in place, the way glyph atlases are
+	std::vector<std::uint8_t> spriteTexels(16 * 16 * 4);
+	auto uploadSprite = [&sprite, &spriteTexels](std::int32_t frame) {
+		for (std::int32_t y = 0; y < 16; y++) {
+			for (std::int32_t x = 0; x < 16; x++) {
+				std::uint8_t* p = spriteTexels.data() + (y * 16 + x) * 4;
+				p[0] = std::uint8_t(x * 16 + frame);
+				p[1] = std::uint8_t(y * 16);
+				p[2] = std::uint8_t((x ^ y) * 16 + frame * 3);
+				p[3] = std::uint8_t(96 + (x + y) * 5);
+			}
+		}
+		sprite.TexSubImage2D(0, 0, 0, 16, 16, PixelFormat::RGBA8, false, spriteTexels.data());
+	};
+	sprite.TexImage2D(0, PixelFormat::RGBA8, false, 16, 16, spriteTexels.data());
+
+	auto drawQuad = [](const RHI::Texture* texture, float x, float y, float w, float h, float alpha) {
+		RHI::Software::DrawContext ctx;
+		ctx.textures[0] = texture;
+		BuildOrtho(W, H, ctx.ff.mvpMatrix);
+		ctx.ff.mvpMatrix[12] += ctx.ff.mvpMatrix[0] * x;
+		ctx.ff.mvpMatrix[13] += ctx.ff.mvpMatrix[5] * y;
+		std::memcpy(ctx.ff.texRect, kTexRectFull, sizeof(kTexRectFull));
+		ctx.ff.color[0] = 1.0f; ctx.ff.color[1] = 1.0f; ctx.ff.color[2] = 1.0f; ctx.ff.color[3] = alpha;
+		ctx.ff.spriteSize[0] = w;
+		ctx.ff.spriteSize[1] = h;
+		ctx.ff.hasTexture = true;
+		ctx.ff.textureUnit = 0;
+		ctx.blendingEnabled = true;
+		ctx.blendSrc = RHI::Software::SwBlendFactor::SrcAlpha;
+		ctx.blendDst = RHI::Software::SwBlendFactor::OneMinusSrcAlpha;
+		RHI::Software::SwRaster::SetDrawContext(ctx);
+		RHI::Software::SwRaster::Draw(PrimitiveType::TriangleStrip, 0, 4);
+		RHI::Software::SwRaster::ClearDrawContext();
+	};
+
+	auto drawSprites = [&](std::int32_t count, std::uint32_t seed) {
+		for (std::int32_t i = 0; i < count; i++) {
+			seed = seed * 1664525u + 1013904223u;
+			const float x = float((seed >> 8) % (W - 24));
+			const float y = float((seed >> 20) % (H - 24));
+			const float size = float(8 + (seed >> 4) % 40);
+			drawQuad(&sprite, x, y, size, size, 0.85f);
+		}
+	};
+
+	auto bindTarget = [](std::uint8_t* pixels, bool isFboTarget, float r, float g, float b) {
+		RHI::Software::SwRaster::SetColorBuffer(pixels, W, H, isFboTarget);
+		RHI::Software::SwRaster::SetViewport(0, 0, W, H);
+		RHI::Software::SwRaster::SetScissor(false, 0, 0, 0, 0);
+		RHI::Software::SwRaster::Clear(r, g, b, 1.0f);
+	};
+
+	std::vector<std::uint8_t> screens[2];
+	double frameMs[2] = { };
+	for (std::int32_t mode = 0; mode < 2; mode++) {
+		RHI::Software::SwTileRenderer::SetPipelined(mode != 0);
+		std::vector<std::uint8_t>& screen = screens[mode];
+		screen.assign(std::size_t(W) * H * 4, 0);
+
+		const auto start = std::chrono::steady_clock::now();
+		for (std::int32_t frame = 0; frame < Frames; frame++) {
+			uploadSprite(frame);
+
+			bindTarget(sceneTarget.MutablePixels(), true, 0.1f, 0.2f, 0.3f);
+			drawSprites(600, 17u + std::uint32_t(frame));
+
+			bindTarget(compositeTarget.MutablePixels(), true, 0.3f, 0.1f, 0.1f);
+			drawQuad(&sceneTarget, 0.0f, 0.0f, float(W), float(H), 0.9f);
+			// A texture update in the middle of the frame, while the first target may be still rasterized
+			uploadSprite(frame + 7);
+			drawSprites(200, 91u + std::uint32_t(frame));
+
+			bindTarget(screen.data(), false, 0.0f, 0.0f, 0.0f);
+			drawQuad(&compositeTarget, 0.0f, 0.0f, float(W), float(H), 0.95f);
+			drawSprites(100, 313u + std::uint32_t(frame));
+
+			// Present
+			RHI::Software::SwRaster::Flush();
+		}
+		frameMs[mode] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / Frames;
+	}
+
+	std::size_t diffs = 0;
+	for (std::size_t i = 0; i < screens[0].size(); i++) {
+		if (screens[0][i] != screens[1][i]) {
+			diffs++;
+		}
+	}
+	g_checks++;
+	if (diffs == 0) {
+		std::printf("  ok   pipelined == synchronous after %d frames\n", Frames);
+	} else {
+		g_failures++;
+		std::printf("  FAIL pipelined differs from synchronous in %zu bytes\n", diffs);
+	}
+	std::printf("  frame time: %.3f ms synchronous, %.3f ms pipelined%s\n", frameMs[0], frameMs[1],
+		RHI::Software::SwTileRenderer::IsPipelined() ? "" : " (no worker threads, flushes stay synchronous)");
+
+	char outputPath[512];
+	MakePath(baseDir, "sw_pipelined_flush.png", outputPath, sizeof(outputPath));
+	const bool wrote = WritePng(outputPath, screens[1].data(), W, H, W * 4);
+	std::printf("PNG: %s (%s)\n", outputPath, wrote ? "ok" : "FAILED");
+
+	// Detach the tile renderer from the local buffers before they go out of scope
+	RHI::Software::SwRaster::SetColorBuffer(nullptr, 0, 0, false);
+	return wrote;
+}
+
+// --- Tile occlusion culling: commands hidden behind opaque quads are dropped without changing a pixel ---
+//
+// Renders layered parallax-like content (blended sprites, opaque quads with blending disabled placed off the
+// tile grid, one of them scissored, then blended sprites on top) once with the tile renderer's occlusion
+// culling and once without it, and requires byte-identical targets and culled commands in the first case.
+
+bool RunOcclusionCullTest(const char* baseDir)
+{
+	constexpr std::int32_t W = 320, H = 192;
+	std::printf("\n=== Tile occlusion culling ===\n");
+
+	RHI::Texture texture(TextureTarget::Texture2D);
+	UploadRgba(texture, 16, 16, [](std::int32_t x, std::int32_t y, std::uint8_t* p) {
+		p[0] = std::uint8_t(x * 16);
+		p[1] = std::uint8_t(y * 16);
+		p[2] = std::uint8_t((x ^ y) * 16);
+		p[3] = std::uint8_t(80 + (x + y) * 5);
+	});
+
+	auto drawQuad = [&texture](float x, float y, float w, float h, bool blend, bool scissor) {
+		RHI::Software::SwRaster::SetScissor(scissor, 40, 30, 200, 100);
+		RHI::Software::DrawContext ctx;
+		ctx.textures[0] = &texture;
+		BuildOrtho(W, H, ctx.ff.mvpMatrix);
+		ctx.ff.mvpMatrix[12] += ctx.ff.mvpMatrix[0] * x;
+		ctx.ff.mvpMatrix[13] += ctx.ff.mvpMatrix[5] * y;
+		std::memcpy(ctx.ff.texRect, kTexRectFull, sizeof(kTexRectFull));
+		ctx.ff.color[0] = 1.0f; ctx.ff.color[1] = 0.9f; ctx.ff.color[2] = 0.8f; ctx.ff.color[3] = 0.9f;
+		ctx.ff.spriteSize[0] = w;
+		ctx.ff.spriteSize[1] = h;
+		ctx.ff.hasTexture = true;
+		ctx.ff.textureUnit = 0;
+		ctx.blendingEnabled = blend;
+		ctx.blendSrc = RHI::Software::SwBlendFactor::SrcAlpha;
+		ctx.blendDst = RHI::Software::SwBlendFactor::OneMinusSrcAlpha;
+		ctx.scissorEnabled = scissor;
+		ctx.scissorRect = Recti(40, 30, 200, 100);
+		RHI::Software::SwRaster::SetDrawContext(ctx);
+		RHI::Software::SwRaster::Draw(PrimitiveType::TriangleStrip, 0, 4);
+		RHI::Software::SwRaster::ClearDrawContext();
+	};
+
+	auto drawSprites = [&drawQuad](std::int32_t count, std::uint32_t seed) {
+		for (std::int32_t i = 0; i < count; i++) {
+			seed = seed * 1664525u + 1013904223u;
+			const float size = float(6 + (seed >> 4) % 48);
+			drawQuad(float((seed >> 8) % (W - 8)) - 4.0f, float((seed >> 20) % (H - 8)) - 4.0f, size, size, true, false);
+		}
+	};
+
+	std::vector<std::uint8_t> targets[2];
+	RHI::Software::SwTileRenderer::Statistics stats[2];
+	for (std::int32_t mode = 0; mode < 2; mode++) {
+		RHI::Software::SwTileRenderer::SetOcclusionCulling(mode == 0);
+		// Start a new frame of statistics, the previous tests submitted to the tile renderer as well
+		RHI::Software::SwTileRenderer::EndFrame();
+		std::vector<std::uint8_t>& target = targets[mode];
+		target.assign(std::size_t(W) * H * 4, 0);
+		RHI::Software::SwRaster::SetColorBuffer(target.data(), W, H, false);
+		RHI::Software::SwRaster::SetViewport(0, 0, W, H);
+		RHI::Software::SwRaster::Clear(0.2f, 0.3f, 0.4f, 1.0f);
+
+		drawSprites(300, 7u);
+		// Opaque layers off the tile grid, the partly covered tiles along their edges must keep what is behind
+		drawQuad(13.0f, 29.0f, 250.0f, 120.0f, false, false);
+		drawSprites(150, 11u);
+		drawQuad(-20.0f, 100.0f, 360.0f, 70.5f, false, false);
+		drawQuad(0.0f, 0.0f, float(W), float(H), false, true);
+		drawSprites(150, 23u);
+
+		RHI::Software::SwRaster::Flush();
+		RHI::Software::SwTileRenderer::EndFrame();
+		stats[mode] = RHI::Software::SwTileRenderer::GetStatistics();
+	}
+	RHI::Software::SwTileRenderer::SetOcclusionCulling(true);
+
+	std::size_t diffs = 0;
+	for (std::size_t i = 0; i < targets[0].size(); i++) {
+		if (targets[0][i] != targets[1][i]) {
+			diffs++;
+		}
+	}
+	g_checks++;
+	if (diffs == 0) {
+		std::printf("  ok   culled == unculled\n");
+	} else {
+		g_failures++;
+		std::printf("  FAIL culled differs from unculled in %zu bytes\n", diffs);
+	}
+	g_checks++;
+	if (stats[0].culledCommands > 0 && stats[1].culledCommands == 0 && stats[0].binnedCommands == stats[1].binnedCommands) {
+		std::printf("  ok   %u of %u binned commands culled\n", stats[0].culledCommands, stats[0].binnedCommands);
+	} else {
+		g_failures++;
+		std::printf("  FAIL unexpected statistics: %u/%u culled with culling, %u/%u without it\n",
+			stats[0].culledCommands, stats[0].binnedCommands, stats[1].culledCommands, stats[1].binnedCommands);
+	}
+
+	char outputPath[512];
+	MakePath(baseDir, "sw_occlusion_cull.png", outputPath, sizeof(outputPath));
+	const bool wrote = WritePng(outputPath, targets[0].data(), W, H, W * 4);
+	std::printf("PNG: %s (%s)\n", outputPath, wrote ? "ok" : "FAILED");
+
+	// Detach the tile renderer from the local buffers before they go out of scope
+	RHI::Software::SwRaster::SetColorBuffer(nullptr, 0, 0, false);
+	return wrote;
+}
+
+// The device feeds SwResolutionScaler the rasterization time of every frame and sizes the screen buffer by its
+// scale. This drives the controller with synthetic frame times whose cost follows the pixel count (the square of
+// the scale) and checks that it steps down under pressure only as far as the bounds allow, holds its scale when
+// the time sits between the two thresholds, and steps back up once the larger surface fits again.
+
+bool RunResolutionScalerTest(const char* baseDir)
+{
+	static_cast<void>(baseDir);
+	std::printf("\n=== Dynamic resolution scaling ===\n");
+
+	using RHI::Software::SwResolutionScaler;
+
+	auto check = [](const char* label, bool passed, float scale) {
+		g_checks++;
+		if (passed) {
+			std::printf("  ok   %-36s scale %.3f\n", label, scale);
+		} else {
+			g_failures++;
+			std::printf("  FAIL %-36s scale %.3f\n", label, scale);
+		}
+	};
+	// Runs the given number of frames that cost fullMs at full scale
+	auto run = [](SwResolutionScaler& scaler, float fullMs, std::int32_t frames) {
+		std::int32_t changes = 0;
+		for (std::int32_t i = 0; i < frames; i++) {
+			const float scale = scaler.GetScale();
+			if (scaler.AddFrame(fullMs * scale * scale)) {
+				changes++;
+			}
+		}
+		return changes;
+	};
+
+	SwResolutionScaler scaler;
+	check("disabled by default", !scaler.IsEnabled() && scaler.GetScale() == 1.0f && run(scaler, 100.0f, 100) == 0, scaler.GetScale());
+
+	// 20 ms at full scale against 10 ms: 0.625^2 * 20 = 7.8 ms is the first step that fits
+	scaler.Configure(10.0f, 0.5f, 1.0f);
+	check("starts at the largest scale", scaler.IsEnabled() && scaler.GetScale() == 1.0f, scaler.GetScale());
+	run(scaler, 20.0f, 200);
+	check("steps down under the target", scaler.GetScale() == 0.625f, scaler.GetScale());
+
+	// Room below the target but not for the next step (0.75^2 * 16 = 9 ms > 8 ms), the scale must hold
+	check("holds between the thresholds", run(scaler, 16.0f, 600) == 0 && scaler.GetScale() == 0.625f, scaler.GetScale());
+
+	// The load drops, so it climbs back to the full scale (1^2 * 6 = 6 ms fits)
+	run(scaler, 6.0f, 1000);
+	check("steps back up when there is room", scaler.GetScale() == 1.0f, scaler.GetScale());
+
+	// A load no scale can hold stops at the lower bound
+	run(scaler, 1000.0f, 200);
+	check("clamped to the smallest scale", scaler.GetScale() == 0.5f, scaler.GetScale());
+
+	// A single spike doesn't change the scale
+	scaler.Configure(10.0f, 0.5f, 0.75f);
+	scaler.AddFrame(50.0f);
+	check("ignores a single spike", run(scaler, 5.0f, 10) == 0 && scaler.GetScale() == 0.75f, scaler.GetScale());
+
+	return true;
+}
+
 int main(int argc, char** argv)
 {
 	// Unbuffered stdout so a crash in a later test cannot swallow the log of the earlier ones
@@ -1178,6 +1587,10 @@ int main(int argc, char** argv)
 	wroteAll = RunBackgroundWarpTest(baseDir) && wroteAll;
 	wroteAll = RunCombineTest(baseDir) && wroteAll;
 	wroteAll = RunPaletteTest(baseDir) && wroteAll;
+	wroteAll = RunFragmentSpanTest(baseDir) && wroteAll;
+	wroteAll = RunPipelinedFlushTest(baseDir) && wroteAll;
+	wroteAll = RunOcclusionCullTest(baseDir) && wroteAll;
+	wroteAll = RunResolutionScalerTest(baseDir) && wroteAll;
 
 	std::printf("\n=====================================\n");
 	std::printf("Total checks: %d, failures: %d, all PNGs written: %s\n", g_checks, g_failures, wroteAll ? "yes" : "no");
@@ -7,6 +7,7 @@
 #include "../ServiceLocator.h"
 #include "../Base/StaticHashMapIterator.h"
 
+#include <algorithm>
 #include <cstring> // for memcpy()
 
 namespace nCine
@@ -25,17 +26,7 @@ namespace nCine
 	void RenderBatcher::CreateBatches(const SmallVectorImpl<RenderCommand*>& srcQueue, SmallVectorImpl<RenderCommand*>& destQueue)
 	{
 		std::uint32_t minBatchSize, maxBatchSize;
-		std::uint32_t fixedBatchSize = theApplication().GetAppConfiguration().fixedBatchSize;
-		if (fixedBatchSize == 0) {
-			// A backend that publishes a hard ceiling (IntValues::MaxBatchSize) is one whose shaders were
-			// compiled for exactly that count, so it wants every batch to be that size rather than a range:
-			// clamping only the maximum would let short runs form extra small batches, and each of those
-			// still costs a whole instance block out of a uniform pool that is tiny on such backends.
-			const std::int32_t deviceMaxBatchSize = theServiceLocator().GetRhiCapabilities().GetValue(RHI::IRhiCapabilities::IntValues::MaxBatchSize);
-			if (deviceMaxBatchSize > 0) {
-				fixedBatchSize = std::uint32_t(deviceMaxBatchSize);
-			}
-		}
+		const std::uint32_t fixedBatchSize = GetFixedBatchSize();
 		if (fixedBatchSize > 0) {
 			minBatchSize = fixedBatchSize;
 			maxBatchSize = fixedBatchSize;
@@ -127,7 +118,7 @@ namespace nCine
 	{
 		DEATH_ASSERT(end > start);
 
-		const RenderCommand* refCommand = *start;
+		RenderCommand* refCommand = *start;
 		RenderCommand* batchCommand = nullptr;
 		RHI::UniformBlockCache* instancesBlock = nullptr;
 
@@ -143,10 +134,7 @@ namespace nCine
 		bool commandAdded = false;
 		batchCommand = RenderResources::GetRenderCommandPool().RetrieveOrAdd(batchedShader, commandAdded);
 
-		// Retrieving the original block instance size without the uniform buffer offset alignment
-		const RHI::UniformBlockCache* singleInstanceBlock = (*start)->GetInstanceBlock();
-		const std::uint32_t singleInstanceBlockSizePacked = singleInstanceBlock->GetSize() - singleInstanceBlock->GetAlignAmount(); // remove the uniform buffer offset alignment
-		const std::uint32_t singleInstanceBlockSize = singleInstanceBlockSizePacked + (16 - singleInstanceBlockSizePacked % 16) % 16; // but add the std140 vec4 layout alignment
+		const std::uint32_t singleInstanceBlockSize = GetInstanceStride(*refCommand);
 
 #if defined(NCINE_PROFILING)
 		batchCommand->SetType(refCommand->GetType());
@@ -155,21 +143,7 @@ namespace nCine
 		FATAL_ASSERT_MSG(instancesBlock != nullptr, "Batched shader does not have an \"{}\" uniform block", Material::InstancesBlockName);
 
 		const std::uint32_t nonBlockUniformsSize = batchCommand->GetMaterial().GetShaderProgram()->GetUniformsSize();
-		// Determine how much memory is needed by uniform blocks that are not for instances
-		std::uint32_t nonInstancesBlocksSize = 0;
-		const RHI::ShaderUniformBlocks::UniformHashMapType& allUniformBlocks = refCommand->GetMaterial().GetAllUniformBlocks();
-		for (const RHI::UniformBlockCache& uniformBlockCache : allUniformBlocks) {
-			// The instance block was already resolved, comparing addresses avoids a string comparison
-			if (&uniformBlockCache == singleInstanceBlock) {
-				continue;
-			}
-
-			RHI::UniformBlockCache* batchBlock = batchCommand->GetMaterial().UniformBlock(uniformBlockCache.uniformBlock()->GetName());
-			DEATH_ASSERT(batchBlock);
-			if (batchBlock) {
-				nonInstancesBlocksSize += uniformBlockCache.GetSize() - uniformBlockCache.GetAlignAmount();
-			}
-		}
+		const std::uint32_t nonInstancesBlocksSize = GetNonInstancesBlocksSize(*refCommand, *batchCommand);
 
 		// Set to true if at least one command in the batch has indices or forced by a rendering settings
 		bool batchingWithIndices = theApplication().GetRenderingSettings().batchingWithIndices;
@@ -192,32 +166,7 @@ namespace nCine
 		nextStart = it;
 
 		batchCommand->GetMaterial().SetUniformsDataPointer(AcquireMemory(nonBlockUniformsSize + nonInstancesBlocksSize + instancesBlockSize));
-		// Copying data for non-instances uniform blocks from the first command in the batch
-		for (const RHI::UniformBlockCache& uniformBlockCache : allUniformBlocks) {
-			if (&uniformBlockCache == singleInstanceBlock) {
-				continue;
-			}
-
-			RHI::UniformBlockCache* batchBlock = batchCommand->GetMaterial().UniformBlock(uniformBlockCache.uniformBlock()->GetName());
-			const bool dataCopied = batchBlock->CopyData(uniformBlockCache.GetDataPointer());
-			DEATH_ASSERT(dataCopied);
-			batchBlock->SetUsedSize(uniformBlockCache.usedSize());
-		}
-
-		// Setting sampler uniforms for GL_TEXTURE* units
-		const RHI::ShaderUniforms::UniformHashMapType& allUniforms = refCommand->GetMaterial().GetAllUniforms();
-		for (const RHI::UniformCache& uniformCache : allUniforms) {
-			if (uniformCache.GetUniform()->GetType() == ShaderCompiler::UniformType::Sampler2D) {
-				RHI::UniformCache* batchUniformCache = batchCommand->GetMaterial().Uniform(uniformCache.GetUniform()->GetName());
-				const std::int32_t refValue = uniformCache.GetIntValue(0);
-				const std::int32_t batchValue = batchUniformCache->GetIntValue(0);
-				// Also checking if the command has just been added, as the memory at the
-				// uniforms data pointer is not cleared and might contain the reference value
-				if (batchValue != refValue || commandAdded) {
-					batchUniformCache->SetIntValue(refValue);
-				}
-			}
-		}
+		CopySharedState(*refCommand, *batchCommand, commandAdded);
 
 		const std::uint32_t maxVertexDataSize = RenderResources::GetBuffersManager().Specs(RenderBuffersManager::BufferTypes::Array).maxSize;
 		const std::uint32_t maxIndexDataSize = RenderResources::GetBuffersManager().Specs(RenderBuffersManager::BufferTypes::ElementArray).maxSize;
@@ -360,16 +309,7 @@ namespace nCine
 			}
 		}
 
-		for (std::uint32_t i = 0; i < RHI::Texture::MaxTextureUnits; i++) {
-			batchCommand->GetMaterial().SetTexture(i, refCommand->GetMaterial().GetTexture(i));
-		}
-		batchCommand->GetMaterial().SetBlendingEnabled(refCommand->GetMaterial().IsBlendingEnabled());
-		batchCommand->GetMaterial().SetBlendingFactors(refCommand->GetMaterial().GetSrcBlendingFactor(), refCommand->GetMaterial().GetDestBlendingFactor());
-		// The hint is part of the material sort key, so every command of this batch carries the same value
-		batchCommand->GetMaterial().SetOpaqueContentHint(refCommand->GetMaterial().GetOpaqueContentHint());
 		batchCommand->SetBatchSize(std::int32_t(nextStart - start));
-		batchCommand->SetLayer(refCommand->GetLayer());
-		batchCommand->SetVisitOrder(refCommand->GetVisitOrder());
 
 		if (batchedShaderHasAttributes) {
 			const std::uint32_t totalVertices = instancesVertexDataSize / SizeVertexFormatAndIndex;
@@ -383,6 +323,152 @@ namespace nCine
 		return batchCommand;
 	}
 
+	RenderCommand* RenderBatcher::CreateBatch(RenderCommand& refCommand, const std::uint8_t* instances, std::uint32_t& count)
+	{
+		if (count == 0 || !CanCreateBatch(refCommand.GetMaterial().GetShaderProgram())) {
+			count = 0;
+			return nullptr;
+		}
+
+		RHI::ShaderProgram* batchedShader = RenderResources::GetBatchedShader(refCommand.GetMaterial().GetShaderProgram());
+
+		bool commandAdded = false;
+		RenderCommand* batchCommand = RenderResources::GetRenderCommandPool().RetrieveOrAdd(batchedShader, commandAdded);
+#if defined(NCINE_PROFILING)
+		batchCommand->SetType(refCommand.GetType());
+#endif
+		RHI::UniformBlockCache* instancesBlock = batchCommand->GetMaterial().UniformBlock(Material::InstancesBlockName);
+		FATAL_ASSERT_MSG(instancesBlock != nullptr, "Batched shader does not have an \"{}\" uniform block", Material::InstancesBlockName);
+
+		// The same limits as for collected commands, the instances block, the UBO and the maximum batch size
+		const std::uint32_t instanceStride = GetInstanceStride(refCommand);
+		const std::uint32_t nonBlockUniformsSize = batchedShader->GetUniformsSize();
+		const std::uint32_t nonInstancesBlocksSize = GetNonInstancesBlocksSize(refCommand, *batchCommand);
+		std::uint32_t maxCount = std::min(std::uint32_t(instancesBlock->GetSize()), UboMaxSize - nonBlockUniformsSize - nonInstancesBlocksSize) / instanceStride;
+		maxCount = std::min(maxCount, theApplication().GetRenderingSettings().maxBatchSize);
+		const std::uint32_t shaderBatchSize = batchedShader->GetBatchSize();
+		if (shaderBatchSize > 0 && maxCount > shaderBatchSize) {
+			maxCount = shaderBatchSize;
+		}
+		if (count > maxCount) {
+			count = maxCount;
+		}
+
+		const std::uint32_t instancesBlockSize = count * instanceStride;
+		batchCommand->GetMaterial().SetUniformsDataPointer(AcquireMemory(nonBlockUniformsSize + nonInstancesBlocksSize + instancesBlockSize));
+		CopySharedState(refCommand, *batchCommand, commandAdded);
+
+		const bool dataCopied = instancesBlock->CopyData(0, instances, instancesBlockSize);
+		DEATH_ASSERT(dataCopied);
+		instancesBlock->SetUsedSize(instancesBlockSize);
+
+		batchCommand->SetBatchSize(std::int32_t(count));
+		batchCommand->GetGeometry().SetDrawParameters(PrimitiveType::Triangles, 0, 6 * std::int32_t(count));
+		return batchCommand;
+	}
+
+	bool RenderBatcher::CanCreateBatch(const RHI::ShaderProgram* shaderProgram)
+	{
+		if (!theApplication().GetRenderingSettings().batchingEnabled || GetFixedBatchSize() > 0) {
+			// Batches built on the side would be of any size, a backend that needs them all the same size
+			// gets the single commands instead, so its batcher can still pack them
+			return false;
+		}
+
+		// Only quads expanded from the instances block alone, the vertices of the commands aren't available
+		const RHI::ShaderProgram* batchedShader = RenderResources::GetBatchedShader(shaderProgram);
+		return (batchedShader != nullptr && batchedShader->GetAttributeCount() <= 1);
+	}
+
+	std::uint32_t RenderBatcher::GetInstanceStride(RenderCommand& refCommand)
+	{
+		// Retrieving the original block instance size without the uniform buffer offset alignment
+		const RHI::UniformBlockCache* singleInstanceBlock = refCommand.GetInstanceBlock();
+		const std::uint32_t singleInstanceBlockSizePacked = singleInstanceBlock->GetSize() - singleInstanceBlock->GetAlignAmount(); // remove the uniform buffer offset alignment
+		return singleInstanceBlockSizePacked + (16 - singleInstanceBlockSizePacked % 16) % 16; // but add the std140 vec4 layout alignment
+	}
+
+	void RenderBatcher::CopySharedState(RenderCommand& refCommand, RenderCommand& batchCommand, bool commandAdded)
+	{
+		const RHI::UniformBlockCache* singleInstanceBlock = refCommand.GetInstanceBlock();
+
+		// Copying data for non-instances uniform blocks from the first command in the batch
+		const RHI::ShaderUniformBlocks::UniformHashMapType& allUniformBlocks = refCommand.GetMaterial().GetAllUniformBlocks();
+		for (const RHI::UniformBlockCache& uniformBlockCache : allUniformBlocks) {
+			if (&uniformBlockCache == singleInstanceBlock) {
+				continue;
+			}
+
+			RHI::UniformBlockCache* batchBlock = batchCommand.GetMaterial().UniformBlock(uniformBlockCache.uniformBlock()->GetName());
+			const bool dataCopied = batchBlock->CopyData(uniformBlockCache.GetDataPointer());
+			DEATH_ASSERT(dataCopied);
+			batchBlock->SetUsedSize(uniformBlockCache.usedSize());
+		}
+
+		// Setting sampler uniforms for GL_TEXTURE* units
+		const RHI::ShaderUniforms::UniformHashMapType& allUniforms = refCommand.GetMaterial().GetAllUniforms();
+		for (const RHI::UniformCache& uniformCache : allUniforms) {
+			if (uniformCache.GetUniform()->GetType() == ShaderCompiler::UniformType::Sampler2D) {
+				RHI::UniformCache* batchUniformCache = batchCommand.GetMaterial().Uniform(uniformCache.GetUniform()->GetName());
+				const std::int32_t refValue = uniformCache.GetIntValue(0);
+				const std::int32_t batchValue = batchUniformCache->GetIntValue(0);
+				// Also checking if the command has just been added, as the memory at the
+				// uniforms data pointer is not cleared and might contain the reference value
+				if (batchValue != refValue || commandAdded) {
+					batchUniformCache->SetIntValue(refValue);
+				}
+			}
+		}
+
+		for (std::uint32_t i = 0; i < RHI::Texture::MaxTextureUnits; i++) {
+			batchCommand.GetMaterial().SetTexture(i, refCommand.GetMaterial().GetTexture(i));
+		}
+		batchCommand.GetMaterial().SetBlendingEnabled(refCommand.GetMaterial().IsBlendingEnabled());
+		batchCommand.GetMaterial().SetBlendingFactors(refCommand.GetMaterial().GetSrcBlendingFactor(), refCommand.GetMaterial().GetDestBlendingFactor());
+		// The hint is part of the material sort key, so every command of this batch carries the same value
+		batchCommand.GetMaterial().SetOpaqueContentHint(refCommand.GetMaterial().GetOpaqueContentHint());
+		batchCommand.SetLayer(refCommand.GetLayer());
+		batchCommand.SetVisitOrder(refCommand.GetVisitOrder());
+	}
+
+	std::uint32_t RenderBatcher::GetNonInstancesBlocksSize(RenderCommand& refCommand, RenderCommand& batchCommand)
+	{
+		const RHI::UniformBlockCache* singleInstanceBlock = refCommand.GetInstanceBlock();
+
+		// Determine how much memory is needed by uniform blocks that are not for instances
+		std::uint32_t nonInstancesBlocksSize = 0;
+		const RHI::ShaderUniformBlocks::UniformHashMapType& allUniformBlocks = refCommand.GetMaterial().GetAllUniformBlocks();
+		for (const RHI::UniformBlockCache& uniformBlockCache : allUniformBlocks) {
+			// The instance block was already resolved, comparing addresses avoids a string comparison
+			if (&uniformBlockCache == singleInstanceBlock) {
+				continue;
+			}
+
+			RHI::UniformBlockCache* batchBlock = batchCommand.GetMaterial().UniformBlock(uniformBlockCache.uniformBlock()->GetName());
+			DEATH_ASSERT(batchBlock);
+			if (batchBlock) {
+				nonInstancesBlocksSize += uniformBlockCache.GetSize() - uniformBlockCache.GetAlignAmount();
+			}
+		}
+		return nonInstancesBlocksSize;
+	}
+
+	std::uint32_t RenderBatcher::GetFixedBatchSize()
+	{
+		std::uint32_t fixedBatchSize = theApplication().GetAppConfiguration().fixedBatchSize;
+		if (fixedBatchSize == 0) {
+			// A backend that publishes a hard ceiling (IntValues::MaxBatchSize) is one whose shaders were
+			// compiled for exactly that count, so it wants every batch to be that size rather than a range:
+			// clamping only the maximum would let short runs form extra small batches, and each of those
+			// still costs a whole instance block out of a uniform pool that is tiny on such backends.
+			const std::int32_t deviceMaxBatchSize = theServiceLocator().GetRhiCapabilities().GetValue(RHI::IRhiCapabilities::IntValues::MaxBatchSize);
+			if (deviceMaxBatchSize > 0) {
+				fixedBatchSize = std::uint32_t(deviceMaxBatchSize);
+			}
+		}
+		return fixedBatchSize;
+	}
+
 	unsigned char* RenderBatcher::AcquireMemory(std::uint32_t bytes)
 	{
 		FATAL_ASSERT(bytes <= UboMaxSize);
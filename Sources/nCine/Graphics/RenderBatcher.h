@@ -1,5 +1,7 @@
 #pragma once
 
+#include "RHI/RhiFwd.h"
+
 #include <memory>
 
 #include <Containers/SmallVector.h>
@@ -32,9 +34,27 @@ namespace nCine
 		 * @param destQueue  Destination queue that receives batched and pass-through commands
 		 */
 		void CreateBatches(const SmallVectorImpl<RenderCommand*>& srcQueue, SmallVectorImpl<RenderCommand*>& destQueue);
+		/**
+		 * @brief Creates a batched command directly from packed instance data
+		 *
+		 * For callers that know up front that a run of quads shares one material, e.g. the glyphs of a string,
+		 * and would otherwise submit one command per quad only for them to be collected again. Each instance is
+		 * written in the layout of the instance block of @p refCommand, @ref GetInstanceStride() bytes apart.
+		 * The state shared by the batch is copied from @p refCommand, which doesn't have to be queued itself.
+		 *
+		 * @param refCommand  Command that provides the material, the layer and the instance layout
+		 * @param instances   Packed instance data
+		 * @param count       Number of instances, receives the number of instances that fit into the batch
+		 * @return Batched render command, or `nullptr` if @ref CanCreateBatch() is `false` for the shader
+		 */
+		RenderCommand* CreateBatch(RenderCommand& refCommand, const std::uint8_t* instances, std::uint32_t& count);
 		/** @brief Marks all managed buffers as free for reuse in the next frame */
 		void Reset();
 
+		/** @brief Returns `true` if @ref CreateBatch() can build batches of commands with the specified shader program */
+		static bool CanCreateBatch(const RHI::ShaderProgram* shaderProgram);
+		/** @brief Returns the distance between consecutive instances in a batch of commands like the specified one */
+		static std::uint32_t GetInstanceStride(RenderCommand& refCommand);
 	private:
 		/** @brief Maximum uniform block size supported by the driver, used as the per-buffer capacity */
 		static std::uint32_t UboMaxSize;
@@ -72,6 +92,13 @@ namespace nCine
 		 */
 		RenderCommand* CollectCommands(SmallVectorImpl<RenderCommand*>::const_iterator start, SmallVectorImpl<RenderCommand*>::const_iterator end, SmallVectorImpl<RenderCommand*>::const_iterator& nextStart);
 
+		/** @brief Copies uniform blocks, samplers, textures, blending and the layer of the reference command to the batch */
+		void CopySharedState(RenderCommand& refCommand, RenderCommand& batchCommand, bool commandAdded);
+		/** @brief Returns the size of the uniform blocks other than the instances one that a batch has to hold */
+		static std::uint32_t GetNonInstancesBlocksSize(RenderCommand& refCommand, RenderCommand& batchCommand);
+		/** @brief Returns the batch size the backend or the configuration requires, or 0 if batches can be of any size */
+		static std::uint32_t GetFixedBatchSize();
+
 		/** @brief Reserves a contiguous region from a managed buffer, creating a new one if needed */
 		std::uint8_t* AcquireMemory(std::uint32_t bytes);
 		/** @brief Appends a new managed RAM buffer of the specified size */
@@ -7,6 +7,8 @@
 #include "../Base/Algorithms.h"
 #include "../tracy_opengl.h"
 
+#include <cstring>
+
 namespace nCine
 {
 	RenderQueue::RenderQueue()
@@ -78,8 +80,11 @@ namespace nCine
 		const bool batchingEnabled = theApplication().GetRenderingSettings().batchingEnabled;
 
 		// Sorting the queues with the relevant orders
-		sort(_opaqueQueue.begin(), _opaqueQueue.end(), descendingOrder);
-		sort(_transparentQueue.begin(), _transparentQueue.end(), ascendingOrder);
+		{
+			ZoneScopedNC("Sorting", 0x81A861);
+			SortQueue(_opaqueQueue, true);
+			SortQueue(_transparentQueue, false);
+		}
 
 		SmallVectorImpl<RenderCommand*>* opaques = batchingEnabled ? &_opaqueBatchedQueue : &_opaqueQueue;
 		SmallVectorImpl<RenderCommand*>* transparents = batchingEnabled ? &_transparentBatchedQueue : &_transparentQueue;
@@ -227,4 +232,32 @@ namespace nCine
 
 		RenderResources::GetRenderBatcher().Reset();
 	}
+
+	void RenderQueue::SortQueue(SmallVectorImpl<RenderCommand*>& queue, bool descending)
+	{
+		const std::uint32_t count = (std::uint32_t)queue.size();
+		if (count < RenderSortKeyThreshold) {
+			sort(queue.begin(), queue.end(), descending ? descendingOrder : ascendingOrder);
+			return;
+		}
+
+		// Large queues are sorted by keys copied out of the commands, so sorting doesn't have to come back to them.
+		// Descending order is ascending order of inverted keys.
+		_sortKeys.resize_for_overwrite(count);
+		for (std::uint32_t i = 0; i < count; i++) {
+			const RenderCommand* command = queue[i];
+			_sortKeys[i] = (descending
+				? RenderSortEntry { ~command->GetMaterialSortKey(), ~command->GetIdSortKey(), i }
+				: RenderSortEntry { command->GetMaterialSortKey(), command->GetIdSortKey(), i });
+		}
+
+		_sortScratch.resize_for_overwrite(count);
+		const RenderSortEntry* sortedKeys = SortRenderEntries(_sortKeys.data(), _sortScratch.data(), count);
+
+		_sortedCommands.resize_for_overwrite(count);
+		for (std::uint32_t i = 0; i < count; i++) {
+			_sortedCommands[i] = queue[sortedKeys[i].Index];
+		}
+		std::memcpy(queue.data(), _sortedCommands.data(), count * sizeof(RenderCommand*));
+	}
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RenderCommand.h"
+#include "RenderQueueSort.h"
 
 #include <Containers/SmallVector.h>
 
@@ -35,6 +36,13 @@ namespace nCine
 		void Clear();
 
 	private:
+		/** @brief Sort keys of the queue being sorted, in the order the commands were added */
+		SmallVector<RenderSortEntry, 0> _sortKeys;
+		/** @brief Scratch space of the sort, shared by both queues */
+		SmallVector<RenderSortEntry, 0> _sortScratch;
+		/** @brief Scratch space for reordering a queue after its keys were sorted */
+		SmallVector<RenderCommand*, 0> _sortedCommands;
+
 		/** @brief Array of opaque render command pointers */
 		SmallVector<RenderCommand*, 0> _opaqueQueue;
 		/** @brief Array of opaque batched render command pointers */
@@ -43,6 +51,9 @@ namespace nCine
 		SmallVector<RenderCommand*, 0> _transparentQueue;
 		/** @brief Array of transparent batched render command pointers */
 		SmallVector<RenderCommand*, 0> _transparentBatchedQueue;
+
+		/** @brief Sorts a queue, large ones by their copied-out keys */
+		void SortQueue(SmallVectorImpl<RenderCommand*>& queue, bool descending);
 	};
 
 }
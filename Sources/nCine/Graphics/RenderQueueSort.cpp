@@ -0,0 +1,71 @@
+#include "RenderQueueSort.h"
+
+#include <utility>
+
+namespace nCine
+{
+	namespace
+	{
+		// Bytes of the ID sort key first (the least significant part), then the bytes of the material sort key
+		constexpr std::int32_t DigitCount = 12;
+
+		inline std::uint32_t GetDigit(const RenderSortEntry& entry, std::int32_t digit)
+		{
+			return (digit < 4
+				? (entry.IdKey >> (digit * 8))
+				: std::uint32_t(entry.MaterialKey >> ((digit - 4) * 8))) & 0xFF;
+		}
+	}
+
+	RenderSortEntry* SortRenderEntries(RenderSortEntry* entries, RenderSortEntry* scratch, std::uint32_t count)
+	{
+		if (count == 0) {
+			return entries;
+		}
+
+		// Histograms of all digits are gathered in a single pass, the counts don't depend on the order
+		std::uint32_t histograms[DigitCount][256] = {};
+		for (std::uint32_t i = 0; i < count; i++) {
+			const std::uint32_t idKey = entries[i].IdKey;
+			const std::uint32_t lowerKey = std::uint32_t(entries[i].MaterialKey);
+			const std::uint32_t upperKey = std::uint32_t(entries[i].MaterialKey >> 32);
+			for (std::int32_t byte = 0; byte < 4; byte++) {
+				histograms[byte][(idKey >> (byte * 8)) & 0xFF]++;
+				histograms[4 + byte][(lowerKey >> (byte * 8)) & 0xFF]++;
+				histograms[8 + byte][(upperKey >> (byte * 8)) & 0xFF]++;
+			}
+		}
+
+		RenderSortEntry* src = entries;
+		RenderSortEntry* dst = scratch;
+		for (std::int32_t digit = 0; digit < DigitCount; digit++) {
+			std::uint32_t* histogram = histograms[digit];
+			// A digit shared by every entry can't change the order. Layers and visit orders only span a part of
+			// their range and IDs are mostly small, so this usually leaves just a few of the twelve passes.
+			if (histogram[GetDigit(src[0], digit)] == count) {
+				continue;
+			}
+
+			std::uint32_t offset = 0;
+			for (std::int32_t i = 0; i < 256; i++) {
+				std::uint32_t bucketSize = histogram[i];
+				histogram[i] = offset;
+				offset += bucketSize;
+			}
+			if (digit < 4) {
+				const std::int32_t shift = digit * 8;
+				for (std::uint32_t i = 0; i < count; i++) {
+					dst[histogram[(src[i].IdKey >> shift) & 0xFF]++] = src[i];
+				}
+			} else {
+				const std::int32_t shift = (digit - 4) * 8;
+				for (std::uint32_t i = 0; i < count; i++) {
+					dst[histogram[std::uint32_t(src[i].MaterialKey >> shift) & 0xFF]++] = src[i];
+				}
+			}
+			std::swap(src, dst);
+		}
+
+		return src;
+	}
+}
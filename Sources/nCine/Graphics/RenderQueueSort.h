@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+namespace nCine
+{
+	/**
+		@brief Sort key of one queued render command together with its position in the queue
+
+		Holds a copy of the command's material sort key (layer, visit order and material hash) and its ID sort key,
+		so a queue can be ordered without touching the commands themselves, which are scattered in memory. The
+		commands are dereferenced only once, afterwards, through @ref Index.
+	*/
+	struct RenderSortEntry
+	{
+		/** @brief Material sort key, see @ref RenderCommand::GetMaterialSortKey() */
+		std::uint64_t MaterialKey;
+		/** @brief ID sort key used to order commands with the same material sort key */
+		std::uint32_t IdKey;
+		/** @brief Index of the command in the queue */
+		std::uint32_t Index;
+	};
+
+	/**
+		@brief Smallest queue that is sorted by copied-out keys
+
+		Below this, copying the keys out and the passes of the radix sort cost more than comparing the commands
+		directly, measured with `tests/RenderQueueSortBenchmark.cpp --sweep`.
+	*/
+	static constexpr std::uint32_t RenderSortKeyThreshold = 2560;
+
+	/**
+		@brief Sorts render command entries in ascending order of material sort key and then ID sort key
+
+		The entries are sorted with a stable LSD radix sort over the bytes of both keys, skipping the bytes every
+		entry shares (usually most of them). Descending order is obtained by sorting bitwise-inverted keys.
+		@p scratch has to hold at least @p count entries. Returns either @p entries or @p scratch, whichever
+		ended up holding the sorted entries.
+	*/
+	RenderSortEntry* SortRenderEntries(RenderSortEntry* entries, RenderSortEntry* scratch, std::uint32_t count);
+}
@@ -0,0 +1,278 @@
+// Sorts queues shaped like game frames by comparing the commands and by copied-out keys and compares their time and order
+// Built with -DNCINE_BUILD_BENCHMARKS=ON, usage: RenderQueueSortBenchmark [--frames <count>] [--sweep]
+
+#include "nCine/Graphics/RenderQueueSort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace nCine;
+
+namespace
+{
+	// Stands in for `RenderCommand`, which is a few hundred bytes (model matrix, material, geometry) with the sort keys
+	// somewhere in the middle
+	struct Command
+	{
+		std::uint8_t Before[96];
+		std::uint64_t MaterialKey;
+		std::uint32_t IdKey;
+		std::uint8_t After[300];
+	};
+
+	struct Random
+	{
+		std::uint32_t State;
+
+		std::uint32_t Next()
+		{
+			State ^= State << 13;
+			State ^= State >> 17;
+			State ^= State << 5;
+			return State;
+		}
+	};
+
+	struct Scenario
+	{
+		const char* Name;
+		bool Opaque;
+		std::vector<std::unique_ptr<Command>> Storage;
+		std::vector<Command*> Queue;
+	};
+
+	// Material sort key as `RenderCommand::CalculateMaterialSortKey()` builds it
+	std::uint64_t MakeMaterialKey(std::uint16_t layer, std::uint16_t visitOrder, std::uint32_t materialHash)
+	{
+		return (std::uint64_t((std::uint32_t(layer) << 16) + visitOrder) << 32) | materialHash;
+	}
+
+	void AddCommands(Scenario& scenario, Random& random, std::int32_t count, std::uint16_t layer, std::uint16_t visitOrder,
+		std::uint32_t idKey, const std::uint32_t* materials, std::int32_t materialCount)
+	{
+		for (std::int32_t i = 0; i < count; i++) {
+			auto command = std::make_unique<Command>();
+			command->MaterialKey = MakeMaterialKey(layer, visitOrder, materials[random.Next() % materialCount]);
+			command->IdKey = idKey;
+			scenario.Queue.push_back(command.get());
+			scenario.Storage.push_back(std::move(command));
+		}
+	}
+
+	void Finalize(Scenario& scenario, Random& random)
+	{
+		// Pooled commands end up all over the heap, shuffling which one goes where spreads them the same way
+		for (std::size_t i = scenario.Storage.size() - 1; i > 0; i--) {
+			std::size_t j = random.Next() % (i + 1);
+			std::swap(*scenario.Storage[i], *scenario.Storage[j]);
+		}
+	}
+
+	Scenario CreateSoftwareLevel(std::int32_t tilesPerLayer)
+	{
+		Scenario scenario = { "level, per-tile commands", false };
+		Random random = { 0x9E3779B9u };
+		std::uint32_t tileMaterials[] = { random.Next(), random.Next() };
+		std::uint32_t spriteMaterials[24];
+		for (auto& material : spriteMaterials) {
+			material = random.Next();
+		}
+		std::uint32_t textMaterial = random.Next();
+
+		// The tile map is a single node, so every tile of a layer shares the visit order and the ID
+		static const std::uint16_t LayerDepths[] = { 100, 200, 300, 400, 450, 500, 550, 600 };
+		for (std::uint16_t depth : LayerDepths) {
+			AddCommands(scenario, random, tilesPerLayer, depth, 12, 12, tileMaterials, 2);
+		}
+		// Actors and their attachments, each its own node
+		for (std::int32_t i = 0; i < 180; i++) {
+			AddCommands(scenario, random, 1, std::uint16_t(480 + (random.Next() % 40)), std::uint16_t(20 + i), std::uint32_t(40 + i), spriteMaterials, 24);
+		}
+		// HUD text and icons
+		AddCommands(scenario, random, 160, 800, 250, 300, &textMaterial, 1);
+		AddCommands(scenario, random, 12, 800, 251, 301, spriteMaterials, 4);
+		Finalize(scenario, random);
+		return scenario;
+	}
+
+	Scenario CreateMeshLevel()
+	{
+		Scenario scenario = { "level, tile-map meshes", false };
+		Random random = { 0x85EBCA6Bu };
+		std::uint32_t tileMaterial = random.Next();
+		std::uint32_t spriteMaterials[24];
+		for (auto& material : spriteMaterials) {
+			material = random.Next();
+		}
+		std::uint32_t textMaterial = random.Next();
+
+		static const std::uint16_t LayerDepths[] = { 100, 200, 300, 400, 450, 500, 550, 600 };
+		for (std::uint16_t depth : LayerDepths) {
+			AddCommands(scenario, random, 6, depth, 12, 12, &tileMaterial, 1);
+		}
+		for (std::int32_t i = 0; i < 180; i++) {
+			AddCommands(scenario, random, 1, std::uint16_t(480 + (random.Next() % 40)), std::uint16_t(20 + i), std::uint32_t(40 + i), spriteMaterials, 24);
+		}
+		AddCommands(scenario, random, 160, 800, 250, 300, &textMaterial, 1);
+		Finalize(scenario, random);
+		return scenario;
+	}
+
+	Scenario CreateMenu()
+	{
+		Scenario scenario = { "menu, one command per glyph", false };
+		Random random = { 0xC2B2AE35u };
+		std::uint32_t textMaterials[] = { random.Next(), random.Next() };
+		std::uint32_t spriteMaterials[8];
+		for (auto& material : spriteMaterials) {
+			material = random.Next();
+		}
+
+		AddCommands(scenario, random, 20, 0, 1, 1, spriteMaterials, 8);
+		for (std::int32_t i = 0; i < 60; i++) {
+			// One text node per menu item, drawn over the background
+			AddCommands(scenario, random, 40, 100, std::uint16_t(2 + i), std::uint32_t(2 + i), textMaterials, 2);
+		}
+		Finalize(scenario, random);
+		return scenario;
+	}
+
+	Scenario CreateOpaque()
+	{
+		Scenario scenario = { "opaque sprites, front to back", true };
+		Random random = { 0x27D4EB2Fu };
+		std::uint32_t spriteMaterials[32];
+		for (auto& material : spriteMaterials) {
+			material = random.Next();
+		}
+
+		for (std::int32_t i = 0; i < 2000; i++) {
+			AddCommands(scenario, random, 1, std::uint16_t(random.Next() % 1000), std::uint16_t(i), std::uint32_t(i), spriteMaterials, 32);
+		}
+		Finalize(scenario, random);
+		return scenario;
+	}
+
+	void SortReference(std::vector<Command*>& queue, bool descending)
+	{
+		if (descending) {
+			std::sort(queue.begin(), queue.end(), [](const Command* a, const Command* b) {
+				return (a->MaterialKey != b->MaterialKey ? a->MaterialKey > b->MaterialKey : a->IdKey > b->IdKey);
+			});
+		} else {
+			std::sort(queue.begin(), queue.end(), [](const Command* a, const Command* b) {
+				return (a->MaterialKey != b->MaterialKey ? a->MaterialKey < b->MaterialKey : a->IdKey < b->IdKey);
+			});
+		}
+	}
+
+	// Mirrors RenderQueue::SortQueue(), small queues are sorted by comparing the commands unless `forceKeys` is set
+	void SortEntries(std::vector<Command*>& queue, bool descending, std::vector<RenderSortEntry>& keys,
+		std::vector<RenderSortEntry>& scratch, std::vector<Command*>& sorted, bool forceKeys = false)
+	{
+		std::uint32_t count = (std::uint32_t)queue.size();
+		if (count < RenderSortKeyThreshold && !forceKeys) {
+			SortReference(queue, descending);
+			return;
+		}
+
+		keys.resize(count);
+		for (std::uint32_t i = 0; i < count; i++) {
+			const Command* command = queue[i];
+			keys[i] = (descending
+				? RenderSortEntry { ~command->MaterialKey, ~command->IdKey, i }
+				: RenderSortEntry { command->MaterialKey, command->IdKey, i });
+		}
+
+		scratch.resize(count);
+		const RenderSortEntry* sortedKeys = SortRenderEntries(keys.data(), scratch.data(), count);
+		sorted.resize(count);
+		for (std::uint32_t i = 0; i < count; i++) {
+			sorted[i] = queue[sortedKeys[i].Index];
+		}
+		std::memcpy(queue.data(), sorted.data(), count * sizeof(Command*));
+	}
+
+	bool HaveSameOrder(const std::vector<Command*>& a, const std::vector<Command*>& b)
+	{
+		// Commands with equal keys may come in any order, so only the keys are compared
+		for (std::size_t i = 0; i < a.size(); i++) {
+			if (a[i]->MaterialKey != b[i]->MaterialKey || a[i]->IdKey != b[i]->IdKey) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Sorts the scenario's queue in every frame both ways, starting from the order the commands were added in
+	bool Run(const Scenario& scenario, std::int32_t frames, bool forceKeys, double& referenceMs, double& entriesMs)
+	{
+		static std::vector<Command*> referenceQueue, entriesQueue, sorted;
+		static std::vector<RenderSortEntry> keys, scratch;
+		referenceMs = 0.0;
+		entriesMs = 0.0;
+		for (std::int32_t frame = 0; frame < frames; frame++) {
+			referenceQueue = scenario.Queue;
+			auto start = std::chrono::steady_clock::now();
+			SortReference(referenceQueue, scenario.Opaque);
+			referenceMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			entriesQueue = scenario.Queue;
+			start = std::chrono::steady_clock::now();
+			SortEntries(entriesQueue, scenario.Opaque, keys, scratch, sorted, forceKeys);
+			entriesMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+		return HaveSameOrder(referenceQueue, entriesQueue);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::int32_t frames = 2000;
+	bool sweep = false;
+	for (std::int32_t i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			frames = std::atoi(argv[++i]);
+		} else if (std::strcmp(argv[i], "--sweep") == 0) {
+			sweep = true;
+		} else {
+			std::fprintf(stderr, "Usage: %s [--frames <count>] [--sweep]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	bool allMatch = true;
+	double referenceMs, entriesMs;
+
+	if (sweep) {
+		// Grows the per-tile level and always sorts by keys, to find where they start to pay off (RenderSortKeyThreshold)
+		static const std::int32_t TilesPerLayer[] = { 25, 50, 100, 150, 200, 250, 300, 400 };
+		for (std::int32_t tiles : TilesPerLayer) {
+			Scenario scenario = CreateSoftwareLevel(tiles);
+			bool matches = Run(scenario, frames, true, referenceMs, entriesMs);
+			allMatch &= matches;
+			std::printf("%5zu commands: pointer sort %7.4f ms/frame, key sort %7.4f ms/frame (%.2fx)%s\n", scenario.Queue.size(),
+				referenceMs / frames, entriesMs / frames, referenceMs / entriesMs, matches ? "" : ", order DIFFERS");
+		}
+		return (allMatch ? 0 : 1);
+	}
+
+	Scenario scenarios[] = { CreateSoftwareLevel(300), CreateMeshLevel(), CreateMenu(), CreateOpaque() };
+	for (Scenario& scenario : scenarios) {
+		bool matches = Run(scenario, frames, false, referenceMs, entriesMs);
+		allMatch &= matches;
+
+		std::printf("%s: %zu commands, %d frames\n", scenario.Name, scenario.Queue.size(), frames);
+		std::printf("  pointer sort:  %8.3f ms total, %7.4f ms/frame\n", referenceMs, referenceMs / frames);
+		std::printf("  key sort:      %8.3f ms total, %7.4f ms/frame (%.2fx)\n", entriesMs, entriesMs / frames, referenceMs / entriesMs);
+		std::printf("  order %s\n", matches ? "matches" : "DIFFERS");
+	}
+
+	return (allMatch ? 0 : 1);
+}
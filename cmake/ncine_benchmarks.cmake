@@ -0,0 +1,75 @@
+# Standalone benchmarks, each next to the code it measures in a `tests` directory. A benchmark compiles only
+# the sources it measures, rather than the engine or the base layer, so it builds in seconds and needs none of
+# the game's dependencies. They are host tools and are never installed, and their numbers are only worth
+# comparing in a Release configuration.
+
+function(ncine_add_benchmark target)
+	add_executable(${target} ${ARGN})
+	target_include_directories(${target} PRIVATE
+		${NCINE_SOURCE_DIR}
+		${NCINE_SOURCE_DIR}/Shared
+		${NCINE_SOURCE_DIR}/Dependencies
+	)
+	target_compile_features(${target} PRIVATE cxx_std_17)
+	set_target_properties(${target} PROPERTIES FOLDER "Benchmarks")
+endfunction()
+
+ncine_add_benchmark(ActorPoolBenchmark
+	${NCINE_SOURCE_DIR}/Jazz2/Actors/tests/ActorPoolBenchmark.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Actors/ActorPool.cpp
+	${NCINE_SOURCE_DIR}/Shared/Containers/SmallVector.cpp
+)
+
+ncine_add_benchmark(BroadPhaseBenchmark
+	${NCINE_SOURCE_DIR}/Jazz2/Collisions/tests/BroadPhaseBenchmark.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTree.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTreeBroadPhase.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Collisions/IBroadPhase.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Collisions/SpatialHashGrid.cpp
+	${NCINE_SOURCE_DIR}/Shared/Containers/SmallVector.cpp
+)
+
+ncine_add_benchmark(DebrisBenchmark
+	${NCINE_SOURCE_DIR}/Jazz2/Tiles/tests/DebrisBenchmark.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Tiles/DebrisStorage.cpp
+	${NCINE_SOURCE_DIR}/Shared/Containers/SmallVector.cpp
+)
+
+ncine_add_benchmark(PakFileBenchmark
+	${NCINE_SOURCE_DIR}/Shared/IO/tests/PakFileBenchmark.cpp
+	${NCINE_SOURCE_DIR}/Shared/IO/BoundedFileStream.cpp
+	${NCINE_SOURCE_DIR}/Shared/IO/FileStream.cpp
+	${NCINE_SOURCE_DIR}/Shared/IO/FileSystem.cpp
+	${NCINE_SOURCE_DIR}/Shared/IO/MemoryStream.cpp
+	${NCINE_SOURCE_DIR}/Shared/IO/PakFile.cpp
+	${NCINE_SOURCE_DIR}/Shared/IO/Stream.cpp
+	${NCINE_SOURCE_DIR}/Shared/IO/Compression/DeflateStream.cpp
+	${NCINE_SOURCE_DIR}/Shared/Base/Format.cpp
+	${NCINE_SOURCE_DIR}/Shared/Containers/DateTime.cpp
+	${NCINE_SOURCE_DIR}/Shared/Containers/SmallVector.cpp
+	${NCINE_SOURCE_DIR}/Shared/Containers/String.cpp
+	${NCINE_SOURCE_DIR}/Shared/Containers/StringUtils.cpp
+	${NCINE_SOURCE_DIR}/Shared/Containers/StringView.cpp
+	${NCINE_SOURCE_DIR}/Shared/Cryptography/xxHash.cpp
+	${NCINE_SOURCE_DIR}/Shared/Cpu.cpp
+	${NCINE_SOURCE_DIR}/Shared/Environment.cpp
+	${NCINE_SOURCE_DIR}/Shared/Utf8.cpp
+)
+# Only Deflate is measured here, LZ4 and Zstd would need their stream sources and libraries too
+if(TARGET ZLIB::ZLIB)
+	target_link_libraries(PakFileBenchmark PRIVATE ZLIB::ZLIB)
+	target_compile_definitions(PakFileBenchmark PRIVATE "WITH_ZLIB")
+endif()
+
+ncine_add_benchmark(ResourceIdBenchmark
+	${NCINE_SOURCE_DIR}/Jazz2/tests/ResourceIdBenchmark.cpp
+	${NCINE_SOURCE_DIR}/Shared/Containers/String.cpp
+	${NCINE_SOURCE_DIR}/Shared/Containers/StringView.cpp
+	${NCINE_SOURCE_DIR}/Shared/Cryptography/xxHash.cpp
+	${NCINE_SOURCE_DIR}/Shared/Cpu.cpp
+)
+
+ncine_add_benchmark(RenderQueueSortBenchmark
+	${NCINE_SOURCE_DIR}/nCine/Graphics/tests/RenderQueueSortBenchmark.cpp
+	${NCINE_SOURCE_DIR}/nCine/Graphics/RenderQueueSort.cpp
+)
@@ -130,6 +130,7 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/nCine/Graphics/RenderCommand.h
 	${NCINE_SOURCE_DIR}/nCine/Graphics/RenderCommandPool.h
 	${NCINE_SOURCE_DIR}/nCine/Graphics/RenderQueue.h
+	${NCINE_SOURCE_DIR}/nCine/Graphics/RenderQueueSort.h
 	${NCINE_SOURCE_DIR}/nCine/Graphics/RenderResources.h
 	${NCINE_SOURCE_DIR}/nCine/Graphics/RenderStatistics.h
 	${NCINE_SOURCE_DIR}/nCine/Graphics/RenderVaoPool.h
@@ -188,6 +189,7 @@ if(NCINE_PREFERRED_RHI STREQUAL "Software")
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwBuffer.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwDebug.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwDevice.h
+		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwResolutionScaler.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwRaster.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwRenderTarget.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwRhiCapabilities.h
@@ -310,12 +312,14 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/Jazz2/PlayerType.h
 	${NCINE_SOURCE_DIR}/Jazz2/PreferencesCache.h
 	${NCINE_SOURCE_DIR}/Jazz2/Resources.h
+	${NCINE_SOURCE_DIR}/Jazz2/ResourceId.h
 	${NCINE_SOURCE_DIR}/Jazz2/ShieldType.h
 	${NCINE_SOURCE_DIR}/Jazz2/SuspendType.h
 	${NCINE_SOURCE_DIR}/Jazz2/WarpFlags.h
 	${NCINE_SOURCE_DIR}/Jazz2/WeaponType.h
 	${NCINE_SOURCE_DIR}/Jazz2/WeatherType.h
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/ActorBase.h
+	${NCINE_SOURCE_DIR}/Jazz2/Actors/ActorPool.h
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Player.h
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/PlayerCorpse.h
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/SolidObjectBase.h
@@ -426,6 +430,9 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Weapons/TNT.h
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTree.h
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTreeBroadPhase.h
+	${NCINE_SOURCE_DIR}/Jazz2/Collisions/IBroadPhase.h
+	${NCINE_SOURCE_DIR}/Jazz2/Collisions/QueryCache.h
+	${NCINE_SOURCE_DIR}/Jazz2/Collisions/SpatialHashGrid.h
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/AnimSetMapping.h
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/EventConverter.h
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Anims.h
@@ -438,6 +445,7 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Strings.h
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Tileset.h
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Version.h
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/ParallelConversion.h
 	${NCINE_SOURCE_DIR}/Jazz2/Events/EventMap.h
 	${NCINE_SOURCE_DIR}/Jazz2/Events/EventSpawner.h
 	${NCINE_SOURCE_DIR}/Jazz2/Input/ControlScheme.h
@@ -460,6 +468,8 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptActorWrapper.h
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptLoader.h
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptPlayerWrapper.h
+	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptProfiler.h
+	${NCINE_SOURCE_DIR}/Jazz2/Tiles/DebrisStorage.h
 	${NCINE_SOURCE_DIR}/Jazz2/Tiles/ITileMapOwner.h
 	${NCINE_SOURCE_DIR}/Jazz2/Tiles/TileCollisionParams.h
 	${NCINE_SOURCE_DIR}/Jazz2/Tiles/TileDestructType.h
@@ -300,8 +300,10 @@ endif()
 cmake_dependent_option(NCINE_RHI_USE_FB16 "Use 16-bit (RGB565) color surfaces instead of RGBA8" OFF "NCINE_PREFERRED_RHI STREQUAL Software OR NCINE_PREFERRED_RHI STREQUAL OpenGL" OFF)
 
 cmake_dependent_option(NCINE_WITH_BACKWARD "Enable integration with Backward library for exception handling" ON "(APPLE OR LINUX OR (WIN32 AND NOT WINDOWS_PHONE AND NOT WINDOWS_STORE)) AND NOT EMSCRIPTEN AND NOT NCINE_BUILD_ANDROID AND NOT VITA" OFF)
-#option(NCINE_WITH_LZ4 "Enable LZ4 compression support" OFF)
-#option(NCINE_WITH_ZSTD "Enable Zstd compression support" OFF)
+# LZ4 and Zstd are used for newly written .pak files, Deflate remains supported for reading and as fallback,
+# so they are enabled by default only where the libraries can be built from source
+cmake_dependent_option(NCINE_WITH_LZ4 "Enable LZ4 compression support" ON "NCINE_DOWNLOAD_DEPENDENCIES;NOT EMSCRIPTEN" OFF)
+cmake_dependent_option(NCINE_WITH_ZSTD "Enable Zstd compression support" ON "NCINE_DOWNLOAD_DEPENDENCIES;NOT EMSCRIPTEN" OFF)
 option(NCINE_WITH_WEBP "Enable WebP image file support" OFF)
 option(NCINE_WITH_AUDIO "Enable OpenAL support and thus sound" ON)
 cmake_dependent_option(NCINE_WITH_VORBIS "Enable Ogg Vorbis audio file support" ON "NCINE_WITH_AUDIO" OFF)
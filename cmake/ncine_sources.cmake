@@ -92,6 +92,7 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/nCine/Graphics/RenderCommand.cpp
 	${NCINE_SOURCE_DIR}/nCine/Graphics/RenderCommandPool.cpp
 	${NCINE_SOURCE_DIR}/nCine/Graphics/RenderQueue.cpp
+	${NCINE_SOURCE_DIR}/nCine/Graphics/RenderQueueSort.cpp
 	${NCINE_SOURCE_DIR}/nCine/Graphics/RenderResources.cpp
 	${NCINE_SOURCE_DIR}/nCine/Graphics/RenderStatistics.cpp
 	${NCINE_SOURCE_DIR}/nCine/Graphics/RenderVaoPool.cpp
@@ -135,6 +136,7 @@ if(NCINE_PREFERRED_RHI STREQUAL "Software")
 	list(APPEND SOURCES
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwBuffer.cpp
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwDevice.cpp
+		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwResolutionScaler.cpp
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwRaster.cpp
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwRenderTarget.cpp
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwShaderProgram.cpp
@@ -277,6 +279,7 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/Jazz2/PreferencesCache.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Resources.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/ActorBase.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Actors/ActorPool.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Player.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/PlayerCorpse.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/SolidObjectBase.cpp
@@ -387,6 +390,9 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Weapons/TNT.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTree.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Collisions/DynamicTreeBroadPhase.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Collisions/IBroadPhase.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Collisions/QueryCache.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Collisions/SpatialHashGrid.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Events/EventMap.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Events/EventSpawner.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Input/ControlScheme.cpp
@@ -408,6 +414,8 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptActorWrapper.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptLoader.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptPlayerWrapper.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Scripting/ScriptProfiler.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Tiles/DebrisStorage.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Tiles/TileMap.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Tiles/TileSet.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/UI/Canvas.cpp